@@ -71,6 +71,7 @@ set (SLIB_CORE_FILES
  "${SLIB_PATH}/src/slib/core/asset.cpp"
  "${SLIB_PATH}/src/slib/core/async.cpp"
  "${SLIB_PATH}/src/slib/core/async_epoll.cpp"
+ "${SLIB_PATH}/src/slib/core/async_uring.cpp"
  "${SLIB_PATH}/src/slib/core/atomic.cpp"
  "${SLIB_PATH}/src/slib/core/base.cpp"
  "${SLIB_PATH}/src/slib/core/charset.cpp"
@@ -111,8 +112,11 @@ set (SLIB_CORE_FILES
  "${SLIB_PATH}/src/slib/core/service.cpp"
  "${SLIB_PATH}/src/slib/core/setting.cpp"
  "${SLIB_PATH}/src/slib/core/spin_lock.cpp"
+ "${SLIB_PATH}/src/slib/core/arena.cpp"
+ "${SLIB_PATH}/src/slib/core/slab_allocator.cpp"
  "${SLIB_PATH}/src/slib/core/string.cpp"
  "${SLIB_PATH}/src/slib/core/string_buffer.cpp"
+ "${SLIB_PATH}/src/slib/core/string_builder.cpp"
  "${SLIB_PATH}/src/slib/core/string_op.cpp"
  "${SLIB_PATH}/src/slib/core/string_param.cpp"
  "${SLIB_PATH}/src/slib/core/string_view.cpp"
@@ -120,10 +124,12 @@ set (SLIB_CORE_FILES
  "${SLIB_PATH}/src/slib/core/system_unix.cpp"
  "${SLIB_PATH}/src/slib/core/thread.cpp"
  "${SLIB_PATH}/src/slib/core/thread_pool.cpp"
+ "${SLIB_PATH}/src/slib/core/parallel_sort.cpp"
  "${SLIB_PATH}/src/slib/core/thread_unix.cpp"
  "${SLIB_PATH}/src/slib/core/time.cpp"
  "${SLIB_PATH}/src/slib/core/time_unix.cpp"
  "${SLIB_PATH}/src/slib/core/timer.cpp"
+ "${SLIB_PATH}/src/slib/core/timer_wheel.cpp"
  "${SLIB_PATH}/src/slib/core/variant.cpp"
  "${SLIB_PATH}/src/slib/core/xml.cpp"
 
@@ -180,6 +186,7 @@ set (SLIB_CORE_FILES
  "${SLIB_PATH}/src/slib/network/http_common.cpp"
  "${SLIB_PATH}/src/slib/network/http_io.cpp"
  "${SLIB_PATH}/src/slib/network/http_server.cpp"
+ "${SLIB_PATH}/src/slib/network/http_static_cache.cpp"
  "${SLIB_PATH}/src/slib/network/http_openssl.cpp"
  "${SLIB_PATH}/src/slib/network/icmp.cpp"
  "${SLIB_PATH}/src/slib/network/ip_address.cpp"
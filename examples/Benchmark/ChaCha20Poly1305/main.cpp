@@ -0,0 +1,250 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+
+#include <slib/core.h>
+#include <slib/crypto.h>
+
+#if defined(SLIB_ARCH_IS_X64) || defined(SLIB_ARCH_IS_X86)
+#	if defined(SLIB_COMPILER_IS_VC)
+#		include <intrin.h>
+#	else
+#		include <x86intrin.h>
+#	endif
+#	define BENCHMARK_USE_RDTSC
+#endif
+
+using namespace slib;
+
+#define TOTAL_BYTES (64 << 20)
+
+/*
+	Reference: scalar ChaCha20 (one block per call) and Poly1305 with 26-bit limbs,
+	same as the implementation before the SIMD kernels were introduced
+*/
+namespace reference
+{
+
+#define ROTATE(v, c) (((v) << (c)) | ((v) >> (32 - (c))))
+#define QUARTERROUND(a,b,c,d) \
+	x[a] += x[b]; x[d] = ROTATE(x[d]^x[a], 16); \
+	x[c] += x[d]; x[b] = ROTATE(x[b]^x[c], 12); \
+	x[a] += x[b]; x[d] = ROTATE(x[d]^x[a], 8); \
+	x[c] += x[d]; x[b] = ROTATE(x[b]^x[c], 7);
+
+	static void ChaChaBlock(const sl_uint32 input[16], sl_uint8 output[64])
+	{
+		sl_uint32 x[16];
+		sl_uint32 i;
+		for (i = 0; i < 16; i++) {
+			x[i] = input[i];
+		}
+		for (i = 20; i > 0; i -= 2) {
+			QUARTERROUND(0, 4, 8, 12)
+			QUARTERROUND(1, 5, 9, 13)
+			QUARTERROUND(2, 6, 10, 14)
+			QUARTERROUND(3, 7, 11, 15)
+			QUARTERROUND(0, 5, 10, 15)
+			QUARTERROUND(1, 6, 11, 12)
+			QUARTERROUND(2, 7, 8, 13)
+			QUARTERROUND(3, 4, 9, 14)
+		}
+		for (i = 0; i < 16; i++) {
+			MIO::writeUint32LE(output + (i << 2), x[i] + input[i]);
+		}
+	}
+
+	class Poly1305
+	{
+	public:
+		sl_uint32 r[5];
+		sl_uint32 h[5];
+		sl_uint32 pad[4];
+
+	public:
+		void start(const sl_uint8* key)
+		{
+			r[0] = MIO::readUint32LE(key) & 0x3ffffff;
+			r[1] = (MIO::readUint32LE(key + 3) >> 2) & 0x3ffff03;
+			r[2] = (MIO::readUint32LE(key + 6) >> 4) & 0x3ffc0ff;
+			r[3] = (MIO::readUint32LE(key + 9) >> 6) & 0x3f03fff;
+			r[4] = (MIO::readUint32LE(key + 12) >> 8) & 0x00fffff;
+			for (sl_uint32 i = 0; i < 5; i++) {
+				h[i] = 0;
+			}
+			for (sl_uint32 i = 0; i < 4; i++) {
+				pad[i] = MIO::readUint32LE(key + 16 + (i << 2));
+			}
+		}
+
+		// input: 16 * nBlocks bytes
+		void update(const sl_uint8* m, sl_size nBlocks)
+		{
+			sl_uint32 r0 = r[0], r1 = r[1], r2 = r[2], r3 = r[3], r4 = r[4];
+			sl_uint32 s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+			sl_uint32 h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+			for (sl_size i = 0; i < nBlocks; i++) {
+				h0 += MIO::readUint32LE(m) & 0x3ffffff;
+				h1 += (MIO::readUint32LE(m + 3) >> 2) & 0x3ffffff;
+				h2 += (MIO::readUint32LE(m + 6) >> 4) & 0x3ffffff;
+				h3 += (MIO::readUint32LE(m + 9) >> 6) & 0x3ffffff;
+				h4 += (MIO::readUint32LE(m + 12) >> 8) | (1 << 24);
+				sl_uint64 d0 = ((sl_uint64)h0 * r0) + ((sl_uint64)h1 * s4) + ((sl_uint64)h2 * s3) + ((sl_uint64)h3 * s2) + ((sl_uint64)h4 * s1);
+				sl_uint64 d1 = ((sl_uint64)h0 * r1) + ((sl_uint64)h1 * r0) + ((sl_uint64)h2 * s4) + ((sl_uint64)h3 * s3) + ((sl_uint64)h4 * s2);
+				sl_uint64 d2 = ((sl_uint64)h0 * r2) + ((sl_uint64)h1 * r1) + ((sl_uint64)h2 * r0) + ((sl_uint64)h3 * s4) + ((sl_uint64)h4 * s3);
+				sl_uint64 d3 = ((sl_uint64)h0 * r3) + ((sl_uint64)h1 * r2) + ((sl_uint64)h2 * r1) + ((sl_uint64)h3 * r0) + ((sl_uint64)h4 * s4);
+				sl_uint64 d4 = ((sl_uint64)h0 * r4) + ((sl_uint64)h1 * r3) + ((sl_uint64)h2 * r2) + ((sl_uint64)h3 * r1) + ((sl_uint64)h4 * r0);
+				h0 = (sl_uint32)d0 & 0x3ffffff; d1 += (sl_uint32)(d0 >> 26);
+				h1 = (sl_uint32)d1 & 0x3ffffff; d2 += (sl_uint32)(d1 >> 26);
+				h2 = (sl_uint32)d2 & 0x3ffffff; d3 += (sl_uint32)(d2 >> 26);
+				h3 = (sl_uint32)d3 & 0x3ffffff; d4 += (sl_uint32)(d3 >> 26);
+				h4 = (sl_uint32)d4 & 0x3ffffff;
+				h0 += ((sl_uint32)(d4 >> 26)) * 5;
+				h1 += h0 >> 26; h0 &= 0x3ffffff;
+				m += 16;
+			}
+			h[0] = h0; h[1] = h1; h[2] = h2; h[3] = h3; h[4] = h4;
+		}
+
+		void finish(sl_uint8* mac)
+		{
+			sl_uint32 h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+			sl_uint32 c = h1 >> 26; h1 &= 0x3ffffff;
+			h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+			h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+			h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+			h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+			h1 += c;
+			sl_uint32 g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+			sl_uint32 g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+			sl_uint32 g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+			sl_uint32 g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+			sl_uint32 g4 = h4 + c - (1 << 26);
+			sl_uint32 mask = (g4 >> 31) - 1;
+			h0 = (h0 & ~mask) | (g0 & mask);
+			h1 = (h1 & ~mask) | (g1 & mask);
+			h2 = (h2 & ~mask) | (g2 & mask);
+			h3 = (h3 & ~mask) | (g3 & mask);
+			h4 = (h4 & ~mask) | (g4 & mask);
+			h0 = (h0 | (h1 << 26));
+			h1 = ((h1 >> 6) | (h2 << 20));
+			h2 = ((h2 >> 12) | (h3 << 14));
+			h3 = ((h3 >> 18) | (h4 << 8));
+			sl_uint64 f = (sl_uint64)h0 + pad[0]; MIO::writeUint32LE(mac, (sl_uint32)f);
+			f = (sl_uint64)h1 + pad[1] + (f >> 32); MIO::writeUint32LE(mac + 4, (sl_uint32)f);
+			f = (sl_uint64)h2 + pad[2] + (f >> 32); MIO::writeUint32LE(mac + 8, (sl_uint32)f);
+			f = (sl_uint64)h3 + pad[3] + (f >> 32); MIO::writeUint32LE(mac + 12, (sl_uint32)f);
+		}
+
+	};
+
+	// RFC 8439 AEAD without AAD, `len` is a multiple of 64
+	static void Encrypt(const sl_uint8* key, sl_uint32 senderId, const sl_uint8* iv, const sl_uint8* src, sl_uint8* dst, sl_size len, sl_uint8* tag)
+	{
+		sl_uint32 input[16];
+		input[0] = 0x61707865;
+		input[1] = 0x3320646e;
+		input[2] = 0x79622d32;
+		input[3] = 0x6b206574;
+		for (sl_uint32 i = 0; i < 8; i++) {
+			input[4 + i] = MIO::readUint32LE(key + (i << 2));
+		}
+		input[12] = 0;
+		input[13] = senderId;
+		input[14] = MIO::readUint32LE(iv);
+		input[15] = MIO::readUint32LE(iv + 4);
+		sl_uint8 block[64];
+		ChaChaBlock(input, block);
+		Poly1305 auth;
+		auth.start(block);
+		for (sl_size i = 0; i < len; i += 64) {
+			input[12]++;
+			ChaChaBlock(input, block);
+			for (sl_uint32 k = 0; k < 64; k++) {
+				dst[i + k] = src[i + k] ^ block[k];
+			}
+		}
+		auth.update(dst, len >> 4);
+		sl_uint8 lens[16];
+		MIO::writeUint64LE(lens, 0);
+		MIO::writeUint64LE(lens + 8, len);
+		auth.update(lens, 1);
+		auth.finish(tag);
+	}
+
+}
+
+static sl_uint64 GetTicks()
+{
+#if defined(BENCHMARK_USE_RDTSC)
+	return __rdtsc();
+#else
+	return (sl_uint64)(Time::now().toInt());
+#endif
+}
+
+static void Run(sl_size size)
+{
+	sl_uint8 key[32];
+	sl_uint8 iv[8];
+	Math::randomMemory(key, sizeof(key));
+	Math::randomMemory(iv, sizeof(iv));
+	Memory memInput = Memory::create(size);
+	Memory memOutput = Memory::create(size);
+	sl_uint8* input = (sl_uint8*)(memInput.getData());
+	sl_uint8* output = (sl_uint8*)(memOutput.getData());
+	Math::randomMemory(input, size);
+	sl_size nLoops = TOTAL_BYTES / size;
+
+	sl_uint8 tag[16], tagReference[16];
+	ChaCha20_Poly1305 cipher;
+	cipher.setKey(key);
+
+	sl_uint64 t0 = GetTicks();
+	for (sl_size i = 0; i < nLoops; i++) {
+		cipher.encrypt(1, iv, sl_null, 0, input, output, size, tag);
+	}
+	sl_uint64 t1 = GetTicks();
+	for (sl_size i = 0; i < nLoops; i++) {
+		reference::Encrypt(key, 1, iv, input, output, size, tagReference);
+	}
+	sl_uint64 t2 = GetTicks();
+
+	double total = (double)(nLoops * size);
+	double current = (double)(t1 - t0) / total;
+	double ref = (double)(t2 - t1) / total;
+#if defined(BENCHMARK_USE_RDTSC)
+	const char* unit = "cycles/byte";
+#else
+	const char* unit = "us/byte";
+#endif
+	Println("%d bytes: SLib %.2f, Reference %.2f %s (x%.1f)%s", size, current, ref, unit, ref / current, Base::equalsMemory(tag, tagReference, 16) ? "" : " (TAG MISMATCH)");
+}
+
+int main(int argc, const char * argv[])
+{
+	Run(64);
+	Run(1024);
+	Run(1024 * 1024);
+	return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/crypto.h>
+
+using namespace slib;
+
+#define TEST_DURATION 2000
+#define BATCH_SIZE 64
+
+/*
+	Reference: double-and-add in the affine coordinates (an inversion per group operation),
+	same as the implementation before the secp256k1 engine was introduced
+*/
+namespace reference
+{
+
+	static ECPoint DoublePoint(const EllipticCurve& curve, const ECPoint& pt)
+	{
+		if (pt.isO()) {
+			return pt;
+		}
+		const BigInt& p = curve.p;
+		ECPoint ret;
+		BigInt x2 = pt.x * pt.x;
+		BigInt lambda = BigInt::mod_NonNegativeRemainder((x2 + x2 + x2 + curve.a) * BigInt::inverseMod(pt.y + pt.y, p), p);
+		ret.x = BigInt::mod_NonNegativeRemainder((lambda * lambda) - pt.x - pt.x, p);
+		ret.y = BigInt::mod_NonNegativeRemainder((lambda * (pt.x - ret.x)) - pt.y, p);
+		return ret;
+	}
+
+	static ECPoint AddPoint(const EllipticCurve& curve, const ECPoint& p1, const ECPoint& p2)
+	{
+		if (p1.isO()) {
+			return p2;
+		} else if (p2.isO()) {
+			return p1;
+		}
+		const BigInt& p = curve.p;
+		if (p1.x == p2.x) {
+			if (p1.y + p2.y == p) {
+				return ECPoint();
+			} else {
+				return DoublePoint(curve, p1);
+			}
+		}
+		ECPoint ret;
+		BigInt lambda = BigInt::mod_NonNegativeRemainder((p2.y - p1.y) * BigInt::inverseMod(p2.x - p1.x, p), p);
+		ret.x = BigInt::mod_NonNegativeRemainder((lambda * lambda) - p1.x - p2.x, p);
+		ret.y = BigInt::mod_NonNegativeRemainder((lambda * (p1.x - ret.x)) - p1.y, p);
+		return ret;
+	}
+
+	static ECPoint MultiplyPoint(const EllipticCurve& curve, const ECPoint& pt, const BigInt& k)
+	{
+		sl_size nBits = k.getMostSignificantBits();
+		ECPoint ret;
+		ECPoint pt2 = pt;
+		for (sl_size i = 0; i < nBits; i++) {
+			if (k.getBit((sl_uint32)i)) {
+				ret = AddPoint(curve, ret, pt2);
+			}
+			pt2 = DoublePoint(curve, pt2);
+		}
+		return ret;
+	}
+
+	static ECDSA_Signature Sign(const EllipticCurve& curve, const ECPrivateKey& key, const BigInt& z, const BigInt& k)
+	{
+		ECPoint kG = MultiplyPoint(curve, curve.G, k);
+		ECDSA_Signature ret;
+		ret.r = BigInt::mod_NonNegativeRemainder(kG.x, curve.n);
+		ret.s = BigInt::mod_NonNegativeRemainder(BigInt::inverseMod(k, curve.n) * (z + ret.r * key.d), curve.n);
+		return ret;
+	}
+
+	static sl_bool Verify(const EllipticCurve& curve, const ECPublicKey& key, const BigInt& z, const ECDSA_Signature& signature)
+	{
+		BigInt s1 = BigInt::inverseMod(signature.s, curve.n);
+		BigInt u1 = BigInt::mod_NonNegativeRemainder(z * s1, curve.n);
+		BigInt u2 = BigInt::mod_NonNegativeRemainder(signature.r * s1, curve.n);
+		ECPoint kG = AddPoint(curve, MultiplyPoint(curve, curve.G, u1), MultiplyPoint(curve, key.Q, u2));
+		if (kG.isO()) {
+			return sl_false;
+		}
+		return BigInt::mod_NonNegativeRemainder(kG.x, curve.n) == signature.r;
+	}
+
+	static BigInt GetSharedKey(const EllipticCurve& curve, const ECPrivateKey& keyLocal, const ECPublicKey& keyRemote)
+	{
+		return MultiplyPoint(curve, keyRemote.Q, keyLocal.d).x;
+	}
+
+}
+
+template <class FN>
+static double Measure(FN fn)
+{
+	sl_uint32 n = 0;
+	TimeCounter t;
+	sl_uint64 elapsed;
+	do {
+		fn();
+		n++;
+		elapsed = t.getElapsedMilliseconds();
+	} while (elapsed < TEST_DURATION);
+	return (double)elapsed / (double)n;
+}
+
+int main(int argc, const char * argv[])
+{
+	const EllipticCurve& curve = EllipticCurve::secp256k1();
+	Println("secp256k1");
+
+	ECPrivateKey key;
+	key.generate(curve);
+	ECPrivateKey keyRemote;
+	keyRemote.generate(curve);
+	sl_uint8 hash[32];
+	Math::randomMemory(hash, sizeof(hash));
+	BigInt z = BigInt::fromBytesBE(hash, sizeof(hash));
+	BigInt k = BigInt::mod_NonNegativeRemainder(BigInt::random(256), curve.n - 1) + 1;
+
+	ECDSA_Signature signature;
+	double sign = Measure([&]() {
+		BigInt _k = k;
+		signature = ECDSA::sign(curve, key, z, &_k);
+	});
+	ECDSA_Signature signatureReference;
+	double signReference = Measure([&]() {
+		signatureReference = reference::Sign(curve, key, z, k);
+	});
+	sl_bool flagMatch = signature.r == signatureReference.r && signature.s == signatureReference.s;
+	Println("  sign: SLib %.3fms, Reference %.3fms (x%.1f)%s", sign, signReference, signReference / sign, flagMatch ? "" : " (MISMATCH)");
+
+	sl_bool flagValid = sl_false;
+	double verify = Measure([&]() {
+		flagValid = ECDSA::verify(curve, key, z, signature);
+	});
+	sl_bool flagValidReference = sl_false;
+	double verifyReference = Measure([&]() {
+		flagValidReference = reference::Verify(curve, key, z, signature);
+	});
+	flagMatch = flagValid && flagValidReference;
+	Println("  verify: SLib %.3fms, Reference %.3fms (x%.1f)%s", verify, verifyReference, verifyReference / verify, flagMatch ? "" : " (MISMATCH)");
+
+	ECPublicKey keys[BATCH_SIZE];
+	BigInt zs[BATCH_SIZE];
+	ECDSA_Signature signatures[BATCH_SIZE];
+	for (sl_uint32 i = 0; i < BATCH_SIZE; i++) {
+		ECPrivateKey keyPrivate;
+		keyPrivate.generate(curve);
+		keys[i] = keyPrivate;
+		Math::randomMemory(hash, sizeof(hash));
+		zs[i] = BigInt::fromBytesBE(hash, sizeof(hash));
+		signatures[i] = ECDSA::sign(curve, keyPrivate, zs[i]);
+	}
+	double verifyBatch = Measure([&]() {
+		flagValid = ECDSA::verifyBatch(curve, keys, zs, signatures, BATCH_SIZE);
+	}) / BATCH_SIZE;
+	Println("  verifyBatch: SLib %.3fms per signature (x%.2f of verify)%s", verifyBatch, verify / verifyBatch, flagValid ? "" : " (INVALID)");
+
+	BigInt shared;
+	double ecdh = Measure([&]() {
+		shared = ECDH::getSharedKey(curve, key, keyRemote);
+	});
+	BigInt sharedReference;
+	double ecdhReference = Measure([&]() {
+		sharedReference = reference::GetSharedKey(curve, key, keyRemote);
+	});
+	flagMatch = shared == sharedReference && shared == ECDH::getSharedKey(curve, keyRemote, key);
+	Println("  ECDH: SLib %.3fms, Reference %.3fms (x%.1f)%s", ecdh, ecdhReference, ecdhReference / ecdh, flagMatch ? "" : " (MISMATCH)");
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+#define COUNT_KEYS 1000000
+
+template <class MAP, class KEY>
+static void Run(const char* name, const List<KEY>& keys, MAP& map)
+{
+	sl_size n = keys.getCount();
+	KEY* k = keys.getData();
+	sl_uint64 tInsert, tFind, tMiss, tRemove;
+	sl_size found = 0;
+	{
+		TimeCounter t;
+		for (sl_size i = 0; i < n; i++) {
+			map.put(k[i], (sl_uint32)i);
+		}
+		tInsert = t.getElapsedMilliseconds();
+	}
+	{
+		TimeCounter t;
+		for (sl_size i = 0; i < n; i++) {
+			if (map.getItemPointer(k[i])) {
+				found++;
+			}
+		}
+		tFind = t.getElapsedMilliseconds();
+	}
+	{
+		// the second half of the keys are removed, and looked up again (miss)
+		TimeCounter t;
+		for (sl_size i = n / 2; i < n; i++) {
+			map.remove(k[i]);
+		}
+		tRemove = t.getElapsedMilliseconds();
+	}
+	{
+		TimeCounter t;
+		for (sl_size i = n / 2; i < n; i++) {
+			if (map.getItemPointer(k[i])) {
+				found++;
+			}
+		}
+		tMiss = t.getElapsedMilliseconds();
+	}
+	Println("[%s] insert: %dms, find: %dms, remove: %dms, find(miss): %dms (found=%d, count=%d)", name, tInsert, tFind, tRemove, tMiss, found, map.getCount());
+}
+
+template <class KEY>
+static void RunAll(const char* title, const List<KEY>& keys)
+{
+	Println("%s: %d keys", title, keys.getCount());
+	{
+		CHashMap<KEY, sl_uint32> map;
+		Run("HashMap", keys, map);
+	}
+	{
+		HashTable<KEY, sl_uint32> map;
+		Run("HashTable", keys, map);
+	}
+	{
+		FlatHashMap<KEY, sl_uint32> map;
+		Run("FlatHashMap", keys, map);
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	Math::srand(1);
+	{
+		List<sl_uint64> keys;
+		for (sl_uint32 i = 0; i < COUNT_KEYS; i++) {
+			keys.add_NoLock(((sl_uint64)(Math::randomInt()) << 32) ^ (sl_uint64)(Math::randomInt()) ^ i);
+		}
+		RunAll("Integer", keys);
+	}
+	{
+		List<String> keys;
+		for (sl_uint32 i = 0; i < COUNT_KEYS; i++) {
+			keys.add_NoLock(String::format("key-%08x-%d", Math::randomInt(), i));
+		}
+		RunAll("String", keys);
+	}
+	{
+		// byte hash throughput (HashBytes)
+		Memory mem = Memory::create(1 << 20);
+		Base::resetMemory(mem.getData(), 0x5a, mem.getSize());
+		sl_size sum = 0;
+		TimeCounter t;
+		for (sl_uint32 i = 0; i < 1000; i++) {
+			sum += HashBytes(mem.getData(), mem.getSize());
+		}
+		Println("[HashBytes] 1GB: %dms (%d)", t.getElapsedMilliseconds(), (sl_uint32)sum);
+		sum = 0;
+		t.reset();
+		sl_uint32 key[4] = {0};
+		for (sl_uint32 i = 0; i < 10000000; i++) {
+			key[0] = i;
+			sum += HashBytes(key, sizeof(key));
+		}
+		Println("[HashBytes] 10M x 16 bytes: %dms (%d)", t.getElapsedMilliseconds(), (sl_uint32)sum);
+	}
+	return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/crypto.h>
+
+using namespace slib;
+
+#define TEST_DURATION 2000
+
+/*
+	Reference: Montgomery exponentiation on 32-bit elements with binary exponent scanning,
+	same as the implementation before the 64-bit limb arithmetic was introduced
+*/
+namespace reference
+{
+
+	// c = c + a * b, returns overflow
+	static sl_uint32 MulAdd(sl_uint32* c, sl_size m, const sl_uint32* a, sl_size n, sl_uint32 b)
+	{
+		sl_uint32 of = 0;
+		sl_size i;
+		for (i = 0; i < n; i++) {
+			sl_uint64 k = a[i];
+			k *= b;
+			k += of;
+			k += c[i];
+			c[i] = (sl_uint32)k;
+			of = (sl_uint32)(k >> 32);
+		}
+		for (; i < m && of; i++) {
+			sl_uint32 sum = c[i] + of;
+			of = sum < of ? 1 : 0;
+			c[i] = sum;
+		}
+		return of;
+	}
+
+	// A = A * B * R^-1 mod M
+	static void MontMul(BigInt& A, const BigInt& B, const BigInt& M, sl_uint32 MI)
+	{
+		CBigInt* a = A.ref.get();
+		CBigInt* b = B.ref.get();
+		CBigInt* m = M.ref.get();
+		sl_size nM = m->length;
+		sl_size nB = Math::min(nM, b->length);
+		sl_size nOut = nM * 2 + 1;
+		List<sl_uint32> buf;
+		buf.setCount(nOut);
+		sl_uint32* out = buf.getData();
+		Base::zeroMemory(out, nOut * 4);
+		for (sl_size i = 0; i < nM; i++) {
+			sl_uint32 cB = i < a->length ? a->elements[i] : 0;
+			sl_uint32 cM = (out[0] + cB * b->elements[0]) * MI;
+			MulAdd(out, nOut, b->elements, nB, cB);
+			MulAdd(out, nOut, m->elements, nM, cM);
+			nOut--;
+			out++;
+		}
+		A = BigInt::fromBytesLE(out, (nM + 1) * 4);
+		if (A >= M) {
+			A = A - M;
+		}
+	}
+
+	static BigInt PowMontgomery(const BigInt& A, const BigInt& E, const BigInt& _M)
+	{
+		BigInt M = _M.compact();
+		sl_size nM = M.getMostSignificantElements();
+		sl_uint32 M0 = M.getElements()[0];
+		sl_uint32 K = M0;
+		K += ((M0 + 2) & 4) << 1;
+		for (sl_uint32 i = 32; i >= 8; i /= 2) {
+			K *= (2 - (M0 * K));
+		}
+		sl_uint32 MI = 0 - K;
+		BigInt R2 = BigInt::mod(BigInt::shiftLeft(1, nM * 64), M);
+		BigInt T = BigInt::mod(A, M);
+		MontMul(T, R2, M, MI);
+		BigInt C = R2;
+		MontMul(C, 1, M, MI);
+		sl_size nbE = E.getMostSignificantBits();
+		for (sl_size ib = 0; ib < nbE; ib++) {
+			if (E.getBit((sl_uint32)ib)) {
+				MontMul(C, T, M, MI);
+			}
+			MontMul(T, T, M, MI);
+		}
+		MontMul(C, 1, M, MI);
+		return C;
+	}
+
+	static BigInt ExecutePublic(const RSAPublicKey& key, const BigInt& T)
+	{
+		return PowMontgomery(T, key.E, key.N);
+	}
+
+	static BigInt ExecutePrivate(const RSAPrivateKey& key, const BigInt& T)
+	{
+		BigInt TP = PowMontgomery(T, key.DP, key.P);
+		BigInt TQ = PowMontgomery(T, key.DQ, key.Q);
+		BigInt C = BigInt::mod_NonNegativeRemainder((TP - TQ) * key.IQ, key.P);
+		return TQ + C * key.Q;
+	}
+
+}
+
+template <class FN>
+static double Measure(FN fn)
+{
+	sl_uint32 n = 0;
+	TimeCounter t;
+	sl_uint64 elapsed;
+	do {
+		fn();
+		n++;
+		elapsed = t.getElapsedMilliseconds();
+	} while (elapsed < TEST_DURATION);
+	return (double)elapsed / (double)n;
+}
+
+static void Run(sl_uint32 nBits)
+{
+	Println("RSA-%d: generating key...", nBits);
+	RSAPrivateKey key;
+	key.generate(nBits);
+	sl_uint32 n = key.getLength();
+	Memory memInput = Memory::create(n);
+	Memory memOutput = Memory::create(n);
+	Memory memVerify = Memory::create(n);
+	sl_uint8* input = (sl_uint8*)(memInput.getData());
+	sl_uint8* output = (sl_uint8*)(memOutput.getData());
+	sl_uint8* verified = (sl_uint8*)(memVerify.getData());
+	Math::randomMemory(input, n);
+	input[0] = 0;
+	BigInt T = BigInt::fromBytesBE(input, n);
+
+	double sign = Measure([&]() {
+		RSA::executePrivate(key, input, output);
+	});
+	BigInt S = BigInt::fromBytesBE(output, n);
+	BigInt S_Reference;
+	double signReference = Measure([&]() {
+		S_Reference = reference::ExecutePrivate(key, T);
+	});
+	double verify = Measure([&]() {
+		RSA::executePublic(key, output, verified);
+	});
+	BigInt V_Reference;
+	double verifyReference = Measure([&]() {
+		V_Reference = reference::ExecutePublic(key, S);
+	});
+	sl_bool flagMatch = S == S_Reference && V_Reference == T && BigInt::fromBytesBE(verified, n) == T;
+	Println("  sign: SLib %.3fms, Reference %.3fms (x%.1f)", sign, signReference, signReference / sign);
+	Println("  verify: SLib %.3fms, Reference %.3fms (x%.1f)%s", verify, verifyReference, verifyReference / verify, flagMatch ? "" : " (MISMATCH)");
+}
+
+int main(int argc, const char * argv[])
+{
+	Run(2048);
+	Run(4096);
+	return 0;
+}
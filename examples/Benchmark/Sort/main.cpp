@@ -0,0 +1,101 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+#define COUNT_ELEMENTS 10000000
+
+typedef void (*SortFunction)(sl_uint64* data, sl_size n, const Ref<ThreadPool>& pool);
+
+static void RunOne(const char* name, const List<sl_uint64>& input, SortFunction fn, const Ref<ThreadPool>& pool)
+{
+	List<sl_uint64> list = input.duplicate();
+	sl_uint64* data = list.getData();
+	sl_size n = list.getCount();
+	TimeCounter t;
+	fn(data, n, pool);
+	sl_uint64 elapsed = t.getElapsedMilliseconds();
+	sl_bool flagSorted = sl_true;
+	for (sl_size i = 1; i < n; i++) {
+		if (data[i - 1] > data[i]) {
+			flagSorted = sl_false;
+			break;
+		}
+	}
+	Println("  [%s] %dms%s", name, elapsed, flagSorted ? "" : " (NOT SORTED)");
+}
+
+static void RunAll(const char* title, const List<sl_uint64>& input, const Ref<ThreadPool>& pool, sl_bool flagRunQuickSort = sl_true)
+{
+	Println("%s: %d elements", title, input.getCount());
+	if (flagRunQuickSort) {
+		RunOne("QuickSort", input, [](sl_uint64* data, sl_size n, const Ref<ThreadPool>& pool) {
+			QuickSort::sortAsc(data, n);
+		}, pool);
+	}
+	RunOne("IntroSort", input, [](sl_uint64* data, sl_size n, const Ref<ThreadPool>& pool) {
+		IntroSort::sortAsc(data, n);
+	}, pool);
+	RunOne("MergeSort", input, [](sl_uint64* data, sl_size n, const Ref<ThreadPool>& pool) {
+		MergeSort::sortAsc(data, n);
+	}, pool);
+	RunOne("RadixSort", input, [](sl_uint64* data, sl_size n, const Ref<ThreadPool>& pool) {
+		RadixSort::sortAsc(data, n);
+	}, pool);
+	RunOne("ParallelSort", input, [](sl_uint64* data, sl_size n, const Ref<ThreadPool>& pool) {
+		ParallelSort::sortAsc(data, n, Compare<sl_uint64>(), pool);
+	}, pool);
+}
+
+int main(int argc, const char * argv[])
+{
+	Math::srand(1);
+	Ref<ThreadPool> pool = ThreadPool::createWorkStealing();
+	Println("Threads: %d", ParallelSort::getThreadsCount(pool));
+	List<sl_uint64> input;
+	input.setCount_NoLock(COUNT_ELEMENTS);
+	sl_uint64* data = input.getData();
+	sl_size i;
+	for (i = 0; i < COUNT_ELEMENTS; i++) {
+		data[i] = ((sl_uint64)(Math::randomInt()) << 32) ^ (sl_uint64)(Math::randomInt());
+	}
+	RunAll("Random", input, pool);
+	for (i = 0; i < COUNT_ELEMENTS; i++) {
+		data[i] = i;
+	}
+	RunAll("Sorted", input, pool);
+	for (i = 0; i < COUNT_ELEMENTS; i++) {
+		data[i] = COUNT_ELEMENTS - i;
+	}
+	RunAll("Reversed", input, pool);
+	for (i = 0; i < COUNT_ELEMENTS; i++) {
+		data[i] = Math::randomInt() % 16;
+	}
+	// QuickSort is quadratic on this input
+	RunAll("Many duplicates (16 distinct values)", input, pool, sl_false);
+	pool->release();
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#include <slib/core.h>
+
+using namespace slib;
+
+#define COUNT_EMPTY_TASKS 1000000
+#define FORK_JOIN_DEPTH 20
+
+class Counter : public Referable
+{
+public:
+	sl_int64 count;
+	sl_int64 total;
+	Ref<Event> event;
+	
+public:
+	Counter(sl_int64 _total): count(0), total(_total)
+	{
+		event = Event::create(sl_false);
+	}
+	
+	void done()
+	{
+		if (Base::interlockedIncrement64(&count) == total) {
+			event->set();
+		}
+	}
+	
+};
+
+static sl_uint64 RunEmptyTasks(const Ref<ThreadPool>& pool)
+{
+	Ref<Counter> counter = new Counter(COUNT_EMPTY_TASKS);
+	TimeCounter t;
+	for (sl_uint32 i = 0; i < COUNT_EMPTY_TASKS; i++) {
+		pool->dispatch([counter]() {
+			counter->done();
+		});
+	}
+	counter->event->wait();
+	return t.getElapsedMilliseconds();
+}
+
+static void Fork(ThreadPool* pool, Counter* counter, sl_uint32 depth)
+{
+	if (depth) {
+		Ref<Counter> ref = counter;
+		pool->dispatch([pool, ref, depth]() {
+			Fork(pool, ref.get(), depth - 1);
+		});
+		pool->dispatch([pool, ref, depth]() {
+			Fork(pool, ref.get(), depth - 1);
+		});
+	} else {
+		counter->done();
+	}
+}
+
+static sl_uint64 RunForkJoin(const Ref<ThreadPool>& pool)
+{
+	Ref<Counter> counter = new Counter(((sl_int64)1) << FORK_JOIN_DEPTH);
+	TimeCounter t;
+	Fork(pool.get(), counter.get(), FORK_JOIN_DEPTH);
+	counter->event->wait();
+	return t.getElapsedMilliseconds();
+}
+
+int main(int argc, const char * argv[])
+{
+	sl_uint32 nThreads = System::getProcessorsCount();
+	if (argc > 1) {
+		String(argv[1]).parseUint32(10, &nThreads);
+	}
+	Println("Threads: %d", nThreads);
+	
+	{
+		Ref<ThreadPool> pool = ThreadPool::create(nThreads, nThreads);
+		Println("[Default] %d empty tasks: %dms", COUNT_EMPTY_TASKS, RunEmptyTasks(pool));
+		Println("[Default] fork/join (%d leaves): %dms", 1 << FORK_JOIN_DEPTH, RunForkJoin(pool));
+		pool->release();
+	}
+	{
+		Ref<ThreadPool> pool = ThreadPool::createWorkStealing(nThreads);
+		Println("[WorkStealing] %d empty tasks: %dms", COUNT_EMPTY_TASKS, RunEmptyTasks(pool));
+		Println("[WorkStealing] fork/join (%d leaves): %dms", 1 << FORK_JOIN_DEPTH, RunForkJoin(pool));
+		pool->release();
+	}
+	
+	return 0;
+}
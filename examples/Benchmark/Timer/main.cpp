@@ -0,0 +1,123 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#include <slib/core.h>
+
+using namespace slib;
+
+#define COUNT_TIMERS 1000000
+#define MIN_INTERVAL 1000
+#define MAX_INTERVAL 2000
+
+class Counter : public Referable
+{
+public:
+	sl_int64 count;
+	sl_int64 total;
+	Ref<Event> event;
+	
+public:
+	Counter(sl_int64 _total): count(0), total(_total)
+	{
+		event = Event::create(sl_false);
+	}
+	
+	void done()
+	{
+		if (Base::interlockedIncrement64(&count) == total) {
+			event->set();
+		}
+	}
+	
+};
+
+static sl_uint64 GetInterval(sl_uint32 i)
+{
+	return MIN_INTERVAL + (i * 7919) % (MAX_INTERVAL - MIN_INTERVAL);
+}
+
+static void RunDelayedTasks(const Ref<DispatchLoop>& loop, sl_uint32 nCount)
+{
+	Ref<Counter> counter = new Counter(nCount / 2);
+	List< Ref<TimerWheelEntry> > entries;
+	entries.setCount_NoLock(nCount);
+	Ref<TimerWheelEntry>* p = entries.getData();
+	
+	TimeCounter t;
+	for (sl_uint32 i = 0; i < nCount; i++) {
+		p[i] = loop->setTimeout([counter]() {
+			counter->done();
+		}, GetInterval(i));
+	}
+	Println("[Delayed] schedule %d tasks: %dms", nCount, t.getElapsedMilliseconds());
+	
+	t.reset();
+	for (sl_uint32 i = 1; i < nCount; i += 2) {
+		p[i]->cancel();
+	}
+	Println("[Delayed] cancel %d tasks: %dms", nCount / 2, t.getElapsedMilliseconds());
+	
+	t.reset();
+	counter->event->wait();
+	Println("[Delayed] all tasks fired %dms after scheduling completed", t.getElapsedMilliseconds());
+}
+
+static void RunTimers(const Ref<DispatchLoop>& loop, sl_uint32 nCount)
+{
+	Ref<Counter> counter = new Counter(nCount);
+	List< Ref<Timer> > timers;
+	timers.setCount_NoLock(nCount);
+	Ref<Timer>* p = timers.getData();
+	
+	TimeCounter t;
+	for (sl_uint32 i = 0; i < nCount; i++) {
+		p[i] = Timer::startWithLoop(loop, [counter](Timer*) {
+			counter->done();
+		}, GetInterval(i));
+	}
+	Println("[Timer] start %d timers: %dms", nCount, t.getElapsedMilliseconds());
+	
+	t.reset();
+	counter->event->wait();
+	Println("[Timer] %d ticks %dms after starting completed", nCount, t.getElapsedMilliseconds());
+	
+	t.reset();
+	for (sl_uint32 i = 0; i < nCount; i++) {
+		p[i]->stop();
+	}
+	Println("[Timer] stop %d timers: %dms", nCount, t.getElapsedMilliseconds());
+}
+
+int main(int argc, const char * argv[])
+{
+	sl_uint32 nCount = COUNT_TIMERS;
+	if (argc > 1) {
+		String(argv[1]).parseUint32(10, &nCount);
+	}
+	
+	Ref<DispatchLoop> loop = DispatchLoop::create();
+	RunDelayedTasks(loop, nCount);
+	RunTimers(loop, nCount);
+	loop->release();
+	
+	return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/core/file_btree.h>
+
+#include <map>
+
+using namespace slib;
+
+/*
+	Randomized put/remove checks of BTree and FileBTree against std::map.
+	The items are periodically compared by iterating the tree, and `getCount()` is checked.
+*/
+
+typedef std::map<sl_uint64, sl_uint64> ReferenceMap;
+
+template <class TREE>
+static sl_bool CheckItems(TREE& tree, const ReferenceMap& reference)
+{
+	BTreePosition pos;
+	sl_uint64 key, value;
+	sl_size n = 0;
+	ReferenceMap::const_iterator it = reference.begin();
+	if (tree.moveToFirst(pos, &key, &value)) {
+		do {
+			if (it == reference.end() || it->first != key || it->second != value) {
+				return sl_false;
+			}
+			++it;
+			n++;
+		} while (tree.moveToNext(pos, &key, &value));
+	}
+	return n == reference.size() && tree.getCount() == reference.size();
+}
+
+template <class TREE>
+static sl_bool CheckRandomOperations(TREE& tree, ReferenceMap& reference, sl_uint32 nOperations, sl_uint32 keyRange)
+{
+	for (sl_uint32 i = 0; i < nOperations; i++) {
+		sl_uint64 key = Math::randomInt() % keyRange;
+		if (Math::randomInt() % 3) {
+			sl_uint64 value = Math::randomInt();
+			if (!(tree.put(key, value))) {
+				Println("  put(%d) failed", key);
+				return sl_false;
+			}
+			reference[key] = value;
+		} else {
+			sl_bool flagRemoved = tree.remove(key);
+			sl_bool flagExpected = reference.erase(key) > 0;
+			if (flagRemoved != flagExpected) {
+				Println("  remove(%d) returned %d", key, flagRemoved);
+				return sl_false;
+			}
+		}
+		if ((i % 16 == 15 || i + 1 == nOperations) && !(CheckItems(tree, reference))) {
+			Println("  mismatch after %d operations", i + 1);
+			return sl_false;
+		}
+		sl_uint64 keyFind = Math::randomInt() % keyRange;
+		sl_uint64 value;
+		ReferenceMap::iterator it = reference.find(keyFind);
+		if (tree.get(keyFind, &value) != (it != reference.end()) || (it != reference.end() && it->second != value)) {
+			Println("  get(%d) mismatch", keyFind);
+			return sl_false;
+		}
+	}
+	return sl_true;
+}
+
+template <class TREE>
+static sl_bool CheckAscendingRemoval(TREE& tree, sl_uint32 n)
+{
+	ReferenceMap reference;
+	for (sl_uint32 i = 0; i < n; i++) {
+		tree.put(i, i);
+		reference[i] = i;
+	}
+	for (sl_uint32 i = 0; i < n; i++) {
+		if (!(tree.remove(i))) {
+			Println("  remove(%d) failed", i);
+			return sl_false;
+		}
+		reference.erase(i);
+		if (!(CheckItems(tree, reference))) {
+			Println("  mismatch after remove(%d)", i);
+			return sl_false;
+		}
+	}
+	return sl_true;
+}
+
+static void Report(const String& name, sl_bool flagSuccess, sl_bool& flagAll)
+{
+	Println("%s: %s", name, flagSuccess ? "OK" : "FAILED");
+	if (!flagSuccess) {
+		flagAll = sl_false;
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	static const sl_uint32 orders[] = { 3, 4, 5, 8, 16 };
+	sl_bool flagAll = sl_true;
+	String pathTemp = System::getTempDirectory();
+
+	for (sl_uint32 order : orders) {
+		{
+			BTree<sl_uint64, sl_uint64> tree(order);
+			Report(String::format("BTree(%d) ascending removal", order), CheckAscendingRemoval(tree, 1000), flagAll);
+		}
+		{
+			BTree<sl_uint64, sl_uint64> tree(order);
+			ReferenceMap reference;
+			Report(String::format("BTree(%d) random", order), CheckRandomOperations(tree, reference, 10000, 1000), flagAll);
+		}
+		String path = String::format("%s/test_btree_%d.db", pathTemp, order);
+		File::deleteFile(path);
+		File::deleteFile(path + "-journal");
+		{
+			FileBTree<sl_uint64, sl_uint64> tree(order);
+			Report(String::format("FileBTree(%d) ascending removal", order), tree.open(path, 8) && CheckAscendingRemoval(tree, 1000), flagAll);
+		}
+		{
+			// reopens the file between the rounds, and removes all items in the last round
+			ReferenceMap reference;
+			sl_bool flagSuccess = sl_true;
+			for (sl_uint32 round = 0; round < 10 && flagSuccess; round++) {
+				FileBTree<sl_uint64, sl_uint64> tree(order);
+				flagSuccess = tree.open(path, 8) && CheckItems(tree, reference) && CheckRandomOperations(tree, reference, 1000, 1500);
+				if (flagSuccess && round == 9) {
+					ReferenceMap items = reference;
+					for (auto& item : items) {
+						if (!(tree.remove(item.first))) {
+							Println("  remove(%d) failed", item.first);
+							flagSuccess = sl_false;
+							break;
+						}
+						reference.erase(item.first);
+					}
+					flagSuccess = flagSuccess && CheckItems(tree, reference);
+				}
+				tree.close();
+			}
+			Report(String::format("FileBTree(%d) random with reopening", order), flagSuccess, flagAll);
+		}
+		File::deleteFile(path);
+	}
+	Println(flagAll ? "All checks passed" : "Some checks failed");
+	return flagAll ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/crypto.h>
+
+using namespace slib;
+
+/*
+	Checks the multi-block (SIMD) path of ChaCha20 against the single-block output,
+	around the 2^32 block boundary of the counter
+*/
+
+#define BLOCKS_PER_CHECK 16
+
+static sl_bool CheckCounter(const sl_uint8* key, const sl_uint8* iv, sl_uint64 counter, sl_bool flagCounter32)
+{
+	ChaCha20 cipher;
+	cipher.setKey(key, 32);
+	sl_uint32 iv0 = MIO::readUint32LE(iv);
+	sl_uint32 iv1 = MIO::readUint32LE(iv + 4);
+	sl_uint32 iv2 = MIO::readUint32LE(iv + 8);
+	if (flagCounter32) {
+		cipher.start32(iv, (sl_uint32)counter);
+	} else {
+		cipher.start(iv, counter);
+	}
+	sl_uint8 stream[64 * BLOCKS_PER_CHECK] = {0};
+	cipher.encrypt(stream, stream, sizeof(stream));
+	for (sl_uint32 i = 0; i < BLOCKS_PER_CHECK; i++) {
+		sl_uint8 block[64] = {0};
+		if (flagCounter32) {
+			cipher.encryptBlock((sl_uint32)(counter + i), iv0, iv1, iv2, block, block);
+		} else {
+			sl_uint64 n = counter + i;
+			cipher.encryptBlock((sl_uint32)n, (sl_uint32)(n >> 32), iv0, iv1, block, block);
+		}
+		if (!(Base::equalsMemory(block, stream + (i << 6), 64))) {
+			Println("  block %d mismatch (counter=%d, 32-bit counter=%d)", i, counter, flagCounter32);
+			return sl_false;
+		}
+	}
+	return sl_true;
+}
+
+int main(int argc, const char * argv[])
+{
+	sl_uint8 key[32], iv[12];
+	for (sl_uint32 i = 0; i < 32; i++) {
+		key[i] = (sl_uint8)(i * 7 + 1);
+	}
+	for (sl_uint32 i = 0; i < 12; i++) {
+		iv[i] = (sl_uint8)(i * 13 + 5);
+	}
+	sl_bool flagAll = sl_true;
+	static const sl_uint64 bases[] = { 0, 0xfffffff0, 0x1fffffff0 };
+	for (sl_uint64 base : bases) {
+		for (sl_uint32 offset = 0; offset < 16; offset++) {
+			if (!(CheckCounter(key, iv, base + offset, sl_false))) {
+				flagAll = sl_false;
+			}
+			if (!(CheckCounter(key, iv, (sl_uint32)(base + offset), sl_true))) {
+				flagAll = sl_false;
+			}
+		}
+	}
+	Println(flagAll ? "All checks passed" : "Some checks failed");
+	return flagAll ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+/*
+	Checks the SIMD search kernels of `Base` against plain scalar loops,
+	over the lengths covering every tail (0 ~ 63 bytes) after the full SIMD blocks
+*/
+
+#define MAX_LENGTH 192
+#define PATTERN_LENGTH 4
+
+static const sl_uint8* FindReverse_Ref(const sl_uint8* m, sl_uint8 pattern, sl_size count)
+{
+	for (sl_size i = count; i > 0; i--) {
+		if (m[i - 1] == pattern) {
+			return m + i - 1;
+		}
+	}
+	return sl_null;
+}
+
+static sl_bool MatchAt(const sl_uint8* m, const sl_uint8* pattern, sl_size countPattern)
+{
+	for (sl_size k = 0; k < countPattern; k++) {
+		if (m[k] != pattern[k]) {
+			return sl_false;
+		}
+	}
+	return sl_true;
+}
+
+static const sl_uint8* FindPattern_Ref(const sl_uint8* m, sl_size count, const sl_uint8* pattern, sl_size countPattern)
+{
+	for (sl_size i = 0; i + countPattern <= count; i++) {
+		if (MatchAt(m + i, pattern, countPattern)) {
+			return m + i;
+		}
+	}
+	return sl_null;
+}
+
+static const sl_uint8* FindPatternReverse_Ref(const sl_uint8* m, sl_size count, const sl_uint8* pattern, sl_size countPattern)
+{
+	if (count < countPattern) {
+		return sl_null;
+	}
+	for (sl_size i = count - countPattern + 1; i > 0; i--) {
+		if (MatchAt(m + i - 1, pattern, countPattern)) {
+			return m + i - 1;
+		}
+	}
+	return sl_null;
+}
+
+static sl_uint8 ToUpper_Ref(sl_uint8 c)
+{
+	return (c >= 'a' && c <= 'z') ? (sl_uint8)(c - 'a' + 'A') : c;
+}
+
+static sl_bool CheckFindReverse(sl_uint8* m, sl_size count)
+{
+	const sl_uint8 pattern = 'z';
+	for (sl_size i = 0; i < count; i++) {
+		m[i] = (sl_uint8)('a' + i % 7);
+	}
+	if (Base::findMemoryReverse(m, pattern, count) != FindReverse_Ref(m, pattern, count)) {
+		Println("  findMemoryReverse: length=%d, no match", count);
+		return sl_false;
+	}
+	for (sl_size pos = 0; pos < count; pos++) {
+		m[pos] = pattern;
+		// a second occurrence before `pos` must not be reported
+		if (pos) {
+			m[pos >> 1] = pattern;
+		}
+		if (Base::findMemoryReverse(m, pattern, count) != FindReverse_Ref(m, pattern, count)) {
+			Println("  findMemoryReverse: length=%d, position=%d", count, pos);
+			return sl_false;
+		}
+		m[pos] = (sl_uint8)('a' + pos % 7);
+		m[pos >> 1] = (sl_uint8)('a' + (pos >> 1) % 7);
+	}
+	return sl_true;
+}
+
+static sl_bool CheckFindPattern(sl_uint8* m, sl_size count)
+{
+	static const sl_uint8 pattern[PATTERN_LENGTH] = { 'z', 'x', 'x', 'y' };
+	// every even position matches the first and the last bytes of the pattern, but not the middle
+	for (sl_size i = 0; i < count; i++) {
+		m[i] = (i & 1) ? 'y' : 'z';
+	}
+	for (sl_size pos = 0; pos <= count; pos++) {
+		sl_bool flagInserted = pos + PATTERN_LENGTH <= count;
+		if (flagInserted) {
+			Base::copyMemory(m + pos, pattern, PATTERN_LENGTH);
+		}
+		if (Base::findMemory(m, count, pattern, PATTERN_LENGTH) != FindPattern_Ref(m, count, pattern, PATTERN_LENGTH)) {
+			Println("  findMemory(pattern): length=%d, position=%d", count, pos);
+			return sl_false;
+		}
+		if (Base::findMemoryReverse(m, count, pattern, PATTERN_LENGTH) != FindPatternReverse_Ref(m, count, pattern, PATTERN_LENGTH)) {
+			Println("  findMemoryReverse(pattern): length=%d, position=%d", count, pos);
+			return sl_false;
+		}
+		if (flagInserted) {
+			for (sl_size i = pos; i < pos + PATTERN_LENGTH; i++) {
+				m[i] = (i & 1) ? 'y' : 'z';
+			}
+		}
+	}
+	return sl_true;
+}
+
+static sl_bool CheckIsZero(sl_uint8* m, sl_size count)
+{
+	Base::zeroMemory(m, count);
+	if (!(Base::equalsMemoryZero(m, count))) {
+		Println("  equalsMemoryZero: length=%d, all zero", count);
+		return sl_false;
+	}
+	for (sl_size pos = 0; pos < count; pos++) {
+		m[pos] = 0x80;
+		if (Base::equalsMemoryZero(m, count)) {
+			Println("  equalsMemoryZero: length=%d, position=%d", count, pos);
+			return sl_false;
+		}
+		m[pos] = 0;
+	}
+	return sl_true;
+}
+
+static sl_bool CheckIgnoreCase(sl_uint8* m1, sl_uint8* m2, sl_size count)
+{
+	static const char letters[] = "aBcDeFgHiJkLmNoPqRsTuVwXyZ@[`{09";
+	for (sl_size i = 0; i < count; i++) {
+		sl_uint8 c = (sl_uint8)(letters[i & 31]);
+		m1[i] = c;
+		m2[i] = (c >= 'a' && c <= 'z') ? ToUpper_Ref(c) : ((c >= 'A' && c <= 'Z') ? (sl_uint8)(c - 'A' + 'a') : c);
+	}
+	if (!(Base::equalsMemoryIgnoreCase(m1, m2, count)) || Base::compareMemoryIgnoreCase(m1, m2, count)) {
+		Println("  equalsMemoryIgnoreCase: length=%d, equal", count);
+		return sl_false;
+	}
+	for (sl_size pos = 0; pos < count; pos++) {
+		sl_uint8 old = m2[pos];
+		// '@' and '`' are next to 'A' and 'a': the case folding must not match them with any letter
+		m2[pos] = (m1[pos] == '@') ? '`' : '@';
+		sl_compare_result expected = ToUpper_Ref(m1[pos]) < ToUpper_Ref(m2[pos]) ? -1 : 1;
+		if (Base::equalsMemoryIgnoreCase(m1, m2, count) || Base::compareMemoryIgnoreCase(m1, m2, count) != expected) {
+			Println("  compareMemoryIgnoreCase: length=%d, position=%d", count, pos);
+			return sl_false;
+		}
+		m2[pos] = old;
+	}
+	return sl_true;
+}
+
+int main(int argc, const char * argv[])
+{
+	// one more byte for the unaligned start
+	sl_uint8 buf1[MAX_LENGTH + 1];
+	sl_uint8 buf2[MAX_LENGTH + 1];
+	sl_bool flagAll = sl_true;
+	for (sl_size offset = 0; offset < 2; offset++) {
+		for (sl_size base = 0; base < MAX_LENGTH; base += 64) {
+			for (sl_size tail = 0; tail < 64; tail++) {
+				sl_size count = base + tail;
+				sl_uint8* m1 = buf1 + offset;
+				sl_uint8* m2 = buf2 + offset;
+				if (!(CheckFindReverse(m1, count) && CheckFindPattern(m1, count) && CheckIsZero(m1, count) && CheckIgnoreCase(m1, m2, count))) {
+					flagAll = sl_false;
+				}
+			}
+		}
+	}
+	Println(flagAll ? "All checks passed" : "Some checks failed");
+	return flagAll ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+/*
+	Checks StringBuilder: growth from the inline storage to the heap buffer, releasing the content,
+	and the formatting (`addFormat`) against `String::format`.
+	Also checks that the XML nodes keep building into `StringBuffer`.
+*/
+
+#define CHECK(EXPR) \
+	if (!(EXPR)) { \
+		Println("  line %d: %s", __LINE__, #EXPR); \
+		return sl_false; \
+	}
+
+static sl_bool CheckGrowth()
+{
+	StringBuilder sb;
+	StringBuffer reference;
+	CHECK(sb.isEmpty())
+	CHECK(sb.getCapacity() == SLIB_STRING_BUILDER_INLINE_SIZE)
+	for (sl_uint32 i = 0; i < 3000; i++) {
+		String piece = String::format("[%d:", i);
+		sl_uint32 nRepeat = i % 37;
+		CHECK(sb.add(piece))
+		CHECK(sb.addChar('x', nRepeat))
+		CHECK(sb.addChar(']'))
+		reference.add(piece);
+		reference.add(String('x', nRepeat));
+		reference.addStatic("]");
+		CHECK(sb.getLength() == reference.getLength())
+		CHECK(sb.getCapacity() >= sb.getLength())
+	}
+	String result = sb.merge();
+	CHECK(result == reference.merge())
+	CHECK(Base::equalsMemory(sb.getData(), result.getData(), result.getLength()))
+
+	StringBuilder sbReserved(100000);
+	CHECK(sbReserved.getCapacity() >= 100000)
+	sl_char8* data = sbReserved.getData();
+	for (sl_uint32 i = 0; i < 10000; i++) {
+		sbReserved.addStatic("0123456789");
+	}
+	// no reallocation in the reserved capacity
+	CHECK(sbReserved.getData() == data)
+	CHECK(sbReserved.getLength() == 100000)
+
+	sb.setLength(4);
+	CHECK(sb.merge() == "[0:]")
+	sb.clear();
+	CHECK(sb.isEmpty())
+	CHECK(sb.merge().isEmpty())
+	return sl_true;
+}
+
+static sl_bool CheckRelease()
+{
+	{
+		// inline content
+		StringBuilder sb;
+		sb.addStatic("short");
+		String s = sb.releaseString();
+		CHECK(s == "short")
+		CHECK(sb.isEmpty())
+		sb.addStatic("again");
+		CHECK(sb.releaseString() == "again")
+	}
+	{
+		// heap content is handed off without copying
+		StringBuilder sb;
+		for (sl_uint32 i = 0; i < 1000; i++) {
+			sb.addUint32(i);
+		}
+		sl_char8* data = sb.getData();
+		sl_size len = sb.getLength();
+		String expected(data, len);
+		String s = sb.releaseString();
+		CHECK(s == expected)
+		CHECK(s.getData() == data)
+		CHECK(s.getData()[len] == 0)
+		CHECK(sb.isEmpty())
+		CHECK(sb.getCapacity() == SLIB_STRING_BUILDER_INLINE_SIZE)
+		sb.addStatic("reused");
+		CHECK(sb.merge() == "reused")
+	}
+	{
+		// mostly unused heap buffer is copied to a fitting string
+		StringBuilder sb(1 << 20);
+		sb.addStatic("small content");
+		String s = sb.releaseString();
+		CHECK(s == "small content")
+		CHECK(sb.isEmpty())
+	}
+	{
+		StringBuilder sb;
+		for (sl_uint32 i = 0; i < 1000; i++) {
+			sb.addStatic("memory ");
+		}
+		Memory mem = sb.releaseMemory();
+		CHECK(mem.getSize() == 7000)
+		CHECK(Base::equalsMemory(mem.getData(), "memory memory ", 14))
+		CHECK(sb.isEmpty())
+	}
+	{
+		StringBuilder sb;
+		CHECK(sb.releaseString().isEmpty())
+		CHECK(sb.releaseMemory().isNull())
+	}
+	{
+		StringBuilder sb1;
+		for (sl_uint32 i = 0; i < 100; i++) {
+			sb1.addStatic("moved ");
+		}
+		StringBuilder sb2(Move(sb1));
+		CHECK(sb1.isEmpty())
+		CHECK(sb2.getLength() == 600)
+		StringBuilder sb3;
+		sb3.addStatic("inline");
+		sb1 = Move(sb3);
+		CHECK(sb1.merge() == "inline")
+	}
+	return sl_true;
+}
+
+static sl_bool CheckFormat()
+{
+	StringBuilder sb;
+	sb.addFormat("%d, %s, %05d, %x, %X, %.3f, %%, %c", -123, "text", 42, 255, 0xABCDEFu, 3.5, 'Z');
+	CHECK(sb.merge() == "-123, text, 00042, ff, ABCDEF, 3.5, %, Z")
+	CHECK(sb.releaseString() == String::format("%d, %s, %05d, %x, %X, %.3f, %%, %c", -123, "text", 42, 255, 0xABCDEFu, 3.5, 'Z'))
+
+	// long formatted content crossing the inline storage
+	StringBuffer reference;
+	for (sl_uint32 i = 0; i < 500; i++) {
+		sb.addFormat("<%d|%s|%.2f>", i, String('a', i % 50), i * 0.5);
+		reference.add(String::format("<%d|%s|%.2f>", i, String('a', i % 50), i * 0.5));
+	}
+	CHECK(sb.releaseString() == reference.merge())
+
+	Variant params[] = { 7, "seven" };
+	sb.addFormatBy("%d=%s", params, 2);
+	CHECK(sb.releaseString() == "7=seven")
+
+	CHECK(sb.addInt32(-2147483647 - 1))
+	CHECK(sb.addChar(' '))
+	CHECK(sb.addUint64(18446744073709551615ULL, 16, 0, sl_true))
+	CHECK(sb.addChar(' '))
+	CHECK(sb.addInt64(-5, 10, 4))
+	CHECK(sb.addChar(' '))
+	CHECK(sb.addDouble(0.25))
+	CHECK(sb.releaseString() == String::format("%s %s %s %s", String::fromInt32(-2147483647 - 1), String::fromUint64(18446744073709551615ULL, 16, 0, sl_true), String::fromInt64(-5, 10, 4), String::fromDouble(0.25)))
+	return sl_true;
+}
+
+namespace {
+
+	// node written for `StringBuffer` only
+	class CustomNode : public XmlNode
+	{
+	public:
+		CustomNode(): XmlNode(XmlNodeType::Text) {}
+
+	public:
+		sl_bool buildText(StringBuffer& output) const override
+		{
+			return output.addStatic("custom");
+		}
+
+		sl_bool buildXml(StringBuffer& output) const override
+		{
+			return output.addStatic("<custom/>");
+		}
+	};
+
+}
+
+static sl_bool CheckXml()
+{
+	Ref<XmlElement> root = XmlElement::create("root");
+	root->setAttribute("a", "1 < 2");
+	Ref<XmlElement> child = XmlElement::create("child");
+	child->addChild(XmlText::create("text & more"));
+	root->addChild(child);
+	root->addChild(new CustomNode);
+	String xml = root->toString();
+	CHECK(xml == "<root a=\"1 &lt; 2\"><child>text &amp; more</child><custom/></root>")
+	StringBuffer buf;
+	CHECK(root->buildXml(buf))
+	CHECK(buf.merge() == xml)
+	StringBuffer bufText;
+	CHECK(root->buildText(bufText))
+	CHECK(bufText.merge() == "text & morecustom")
+	StringBuffer bufEntities;
+	CHECK(Xml::encodeTextToEntities("<a&b>", bufEntities))
+	CHECK(bufEntities.merge() == "&lt;a&amp;b&gt;")
+	return sl_true;
+}
+
+int main(int argc, const char * argv[])
+{
+	sl_bool flagAll = sl_true;
+	struct {
+		const char* name;
+		sl_bool (*check)();
+	} checks[] = {
+		{ "Growth", CheckGrowth },
+		{ "Release", CheckRelease },
+		{ "Format", CheckFormat },
+		{ "Xml", CheckXml }
+	};
+	for (auto& item : checks) {
+		sl_bool flagSuccess = item.check();
+		Println("%s: %s", item.name, flagSuccess ? "OK" : "FAILED");
+		if (!flagSuccess) {
+			flagAll = sl_false;
+		}
+	}
+	Println(flagAll ? "All checks passed" : "Some checks failed");
+	return flagAll ? 0 : 1;
+}
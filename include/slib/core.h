@@ -54,7 +54,10 @@
 #include "core/mutex.h"
 #include "core/string.h"
 #include "core/string_buffer.h"
+#include "core/string_builder.h"
 #include "core/memory.h"
+#include "core/slab_allocator.h"
+#include "core/arena.h"
 #include "core/time.h"
 #include "core/variant.h"
 
@@ -71,13 +74,18 @@
 #include "core/map.h"
 #include "core/hash_map.h"
 #include "core/hash_table.h"
+#include "core/flat_hash_map.h"
+#include "core/concurrent_hash_map.h"
+#include "core/cache.h"
 #include "core/linked_list.h"
 #include "core/queue.h"
 #include "core/queue_channel.h"
 #include "core/linked_object.h"
 #include "core/loop_queue.h"
+#include "core/lock_free_queue.h"
 #include "core/expire.h"
 #include "core/btree.h"
+#include "core/file_btree.h"
 
 #include "core/math.h"
 #include "core/interpolation.h"
@@ -89,6 +97,7 @@
 #include "core/process.h"
 #include "core/thread.h"
 #include "core/thread_pool.h"
+#include "core/parallel_sort.h"
 #include "core/rw_lock.h"
 #include "core/log.h"
 #include "core/asset.h"
@@ -0,0 +1,130 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_ARENA
+#define CHECKHEADER_SLIB_CORE_ARENA
+
+#include "definition.h"
+
+#include "string.h"
+#include "cpp.h"
+
+#include <new>
+#include <type_traits>
+
+#define SLIB_ARENA_DEFAULT_BLOCK_SIZE 4096
+#define SLIB_ARENA_DEFAULT_ALIGNMENT 16
+
+namespace slib
+{
+
+	/*
+		Bump allocator for request-scoped data.
+		The memory is released at once by `reset()` or by the destructor,
+		after calling the destructors of the objects created by `create()` in reverse order.
+		Arena is not thread-safe.
+	*/
+	class SLIB_EXPORT Arena
+	{
+	public:
+		Arena(sl_size blockSize = SLIB_ARENA_DEFAULT_BLOCK_SIZE) noexcept;
+
+		~Arena();
+
+	public:
+		Arena(const Arena& other) = delete;
+
+		Arena& operator=(const Arena& other) = delete;
+
+	public:
+		// `alignment` must be power of 2
+		void* allocate(sl_size size, sl_size alignment = SLIB_ARENA_DEFAULT_ALIGNMENT) noexcept;
+
+		template <class T, class... ARGS>
+		T* create(ARGS&&... args) noexcept
+		{
+			void* mem = allocate(sizeof(T), alignof(T) > SLIB_ARENA_DEFAULT_ALIGNMENT ? alignof(T) : SLIB_ARENA_DEFAULT_ALIGNMENT);
+			if (!mem) {
+				return sl_null;
+			}
+			if (!(std::is_trivially_destructible<T>::value)) {
+				if (!(_registerDestructor(mem, &_destroy<T>))) {
+					return sl_null;
+				}
+			}
+			return new (mem) T(Forward<ARGS>(args)...);
+		}
+
+		// returns null-terminated copy of the string
+		StringView copyString(const StringView& str) noexcept;
+
+		// releases all blocks except the first one, which is reused
+		void reset() noexcept;
+
+		// size of the memory allocated by the arena
+		sl_size getAllocatedSize() const noexcept;
+
+		// size of the memory requested to the arena
+		sl_size getUsedSize() const noexcept;
+
+	private:
+		struct Block
+		{
+			Block* next;
+			sl_size size;
+		};
+
+		struct Destructor
+		{
+			void (*destroy)(void*);
+			void* object;
+			Destructor* next;
+		};
+
+		template <class T>
+		static void _destroy(void* object) noexcept
+		{
+			((T*)object)->~T();
+		}
+
+		sl_bool _registerDestructor(void* object, void (*destroy)(void*)) noexcept;
+
+		void* _allocateBlock(sl_size size, sl_size alignment) noexcept;
+
+		void _runDestructors() noexcept;
+
+	private:
+		sl_size m_blockSize;
+		Block* m_blockFirst;
+		Block* m_blockCurrent;
+		sl_uint8* m_current;
+		sl_uint8* m_end;
+		Destructor* m_destructors;
+		sl_size m_sizeAllocated;
+		sl_size m_sizeUsed;
+
+	};
+
+}
+
+#endif
@@ -30,11 +30,42 @@ namespace slib
 	
 #ifdef SLIB_ARCH_IS_X64
 	sl_bool CanUseSse42();
+
+	sl_bool CanUseAvx2();
+
+	// AES-NI (with SSSE3)
+	sl_bool CanUseAesNi();
+
+	// PCLMULQDQ (with SSSE3)
+	sl_bool CanUsePclmul();
+
+	// SHA extensions (with SSE4.1)
+	sl_bool CanUseShaNi();
 #else
 	SLIB_INLINE static sl_bool CanUseSse42()
 	{
 		return sl_false;
 	}
+
+	SLIB_INLINE static sl_bool CanUseAvx2()
+	{
+		return sl_false;
+	}
+
+	SLIB_INLINE static sl_bool CanUseAesNi()
+	{
+		return sl_false;
+	}
+
+	SLIB_INLINE static sl_bool CanUsePclmul()
+	{
+		return sl_false;
+	}
+
+	SLIB_INLINE static sl_bool CanUseShaNi()
+	{
+		return sl_false;
+	}
 #endif
 	
 }
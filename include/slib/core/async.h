@@ -26,9 +26,11 @@
 #include "definition.h"
 
 #include "dispatch_loop.h"
+#include "timer_wheel.h"
 #include "file.h"
 #include "variant.h"
 #include "function.h"
+#include "lock_free_queue.h"
 
 namespace slib
 {
@@ -41,6 +43,29 @@ namespace slib
 		InOut = 3
 	};
 
+#if defined(SLIB_PLATFORM_IS_LINUX)
+	enum class AsyncIoOperationCode
+	{
+		Read = 0, // `offset`
+		Write = 1, // `offset`
+		Receive = 2,
+		Send = 3,
+		Accept = 4, // `address`, `addressLength` (in: buffer size, out: address size). `result` is the accepted handle
+		Connect = 5 // `address`, `addressLength`
+	};
+
+	// Completion-based operation submitted to an io_uring loop. The operation and the memory it points must be valid until its completion
+	struct SLIB_EXPORT AsyncIoOperation
+	{
+		AsyncIoOperationCode code;
+		void* data;
+		sl_uint32 size;
+		sl_uint64 offset;
+		void* address;
+		sl_uint32 addressLength;
+	};
+#endif
+
 	class AsyncIoLoop;
 	class AsyncIoInstance;
 	class AsyncIoObject;
@@ -62,7 +87,8 @@ namespace slib
 	
 		static void releaseDefault();
 
-		static Ref<AsyncIoLoop> create(sl_bool flagAutoStart = sl_true);
+		// `flagUseIoUring`: uses io_uring on Linux (5.19 or later), falling back to epoll when it is not available
+		static Ref<AsyncIoLoop> create(sl_bool flagAutoStart = sl_true, sl_bool flagUseIoUring = sl_false);
 	
 	public:
 		void release();
@@ -84,15 +110,28 @@ namespace slib
 		void requestOrder(AsyncIoInstance* instance);
 
 		sl_bool dispatch(const Function<void()>& callback, sl_uint64 delay_ms) override;
+		
+		// `task` runs on the loop thread after `delay_ms` milliseconds. The returned entry can be canceled in O(1)
+		Ref<TimerWheelEntry> setTimeout(const Function<void()>& task, sl_uint64 delay_ms);
+		
+		sl_bool isUsingIoUring();
+		
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		// io_uring loops only, called on the loop thread. The completion is delivered to `instance->onEvent()` with `pOperation` set to `op`
+		sl_bool submitOperation(AsyncIoInstance* instance, AsyncIoOperation* op);
+#endif
 
 	protected:
 		sl_bool m_flagInit;
 		sl_bool m_flagRunning;
 		void* m_handle;
+		sl_bool m_flagIoUring;
 
 		Ref<Thread> m_thread;
 
-		LinkedQueue< Function<void()> > m_queueTasks;
+		MpscQueue< Function<void()> > m_queueTasks;
+		sl_int32 m_flagWaking;
+		Ref<TimerWheel> m_timers;
 	
 		LinkedQueue< Ref<AsyncIoInstance> > m_queueInstancesOrder;
 		LinkedQueue< Ref<AsyncIoInstance> > m_queueInstancesClosing;
@@ -105,11 +144,62 @@ namespace slib
 		sl_bool _native_attachInstance(AsyncIoInstance* instance, AsyncIoMode mode);
 		void _native_detachInstance(AsyncIoInstance* instance);
 		void _native_wake();
+		
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		static void* _uring_createHandle();
+		static void _uring_closeHandle(void* handle);
+		void _uring_runLoop();
+		sl_bool _uring_attachInstance(AsyncIoInstance* instance, AsyncIoMode mode);
+		void _uring_detachInstance(AsyncIoInstance* instance);
+		void _uring_wake();
+#endif
 
 	protected:
 		void _stepBegin();
 		void _stepEnd();
+		
+		// milliseconds to wait for the events, capped at 5 seconds
+		sl_int32 _getTimeout();
+	
+	};
+	
 	
+	/*
+		Fixed set of AsyncIoLoops, each running on its own thread.
+		I/O objects are spread across the loops (see `getNextLoop`) so that socket I/O scales with the cores.
+	*/
+	class SLIB_EXPORT AsyncIoLoopGroup : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	private:
+		AsyncIoLoopGroup();
+		
+		~AsyncIoLoopGroup();
+		
+	public:
+		// `nLoops`: 0 means the processors count
+		static Ref<AsyncIoLoopGroup> create(sl_uint32 nLoops = 0, sl_bool flagAutoStart = sl_true, sl_bool flagUseIoUring = sl_false);
+		
+	public:
+		void release();
+		
+		void start();
+		
+		sl_bool isRunning();
+		
+		sl_uint32 getLoopsCount();
+		
+		Ref<AsyncIoLoop> getLoop(sl_uint32 index);
+		
+		// round-robin
+		Ref<AsyncIoLoop> getNextLoop();
+		
+	protected:
+		List< Ref<AsyncIoLoop> > m_loops;
+		sl_uint32 m_indexNext;
+		sl_bool m_flagRunning;
+		
 	};
 	
 	
@@ -167,6 +257,10 @@ namespace slib
 			sl_bool flagIn;
 			sl_bool flagOut;
 			sl_bool flagError;
+#endif
+#if defined(SLIB_PLATFORM_IS_LINUX)
+			AsyncIoOperation* pOperation; // completed operation on io_uring loops, `null` on readiness events
+			sl_int32 result; // result of `pOperation` (negative errno on failure)
 #endif
 		};
 		virtual void onEvent(EventDesc* pev) = 0;
@@ -241,6 +335,10 @@ namespace slib
 		Ref<Referable> userObject;
 		Function<void(AsyncStreamResult&)> callback;
 		sl_bool flagRead;
+		
+		// source of the zero-copy write (`data` is null). `SLIB_FILE_INVALID_HANDLE` for the other requests
+		sl_file file;
+		sl_uint64 fileOffset;
 
 	protected:
 		AsyncStreamRequest(const void* data, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback, sl_bool flagRead);
@@ -251,6 +349,8 @@ namespace slib
 		static Ref<AsyncStreamRequest> createRead(void* data, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback);
 
 		static Ref<AsyncStreamRequest> createWrite(const void* data, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback);
+		
+		static Ref<AsyncStreamRequest> createSendFile(sl_file file, sl_uint64 offset, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback);
 
 	public:
 		void runCallback(AsyncStream* stream, sl_uint32 resultSize, sl_bool flagError);
@@ -271,6 +371,11 @@ namespace slib
 		virtual sl_bool read(void* data, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject);
 
 		virtual sl_bool write(const void* data, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject);
+		
+		// returns `sl_false` when the instance can't write from the files directly
+		virtual sl_bool sendFile(sl_file file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject);
+		
+		virtual sl_bool isSupportingSendFile();
 
 		virtual sl_bool isSeekable();
 
@@ -328,6 +433,12 @@ namespace slib
 		virtual sl_bool seek(sl_uint64 pos);
 
 		virtual sl_uint64 getSize();
+		
+		// zero-copy write from the region of `file` (sendfile). Returns `sl_false` when the stream does not support it (ex: TLS streams)
+		virtual sl_bool sendFile(File* file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback);
+		
+		// returns `sl_true` when `sendFile` writes without moving the file position, so an opened file can be shared by the concurrent writes
+		virtual sl_bool isSupportingSendFile();
 
 		sl_bool readToMemory(const Memory& mem, const Function<void(AsyncStreamResult&)>& callback);
 	
@@ -360,6 +471,10 @@ namespace slib
 		sl_bool seek(sl_uint64 pos) override;
 
 		sl_uint64 getSize() override;
+		
+		sl_bool sendFile(File* file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback) override;
+		
+		sl_bool isSupportingSendFile() override;
 
 		sl_bool addTask(const Function<void()>& callback) override;
 
@@ -517,6 +632,11 @@ namespace slib
 
 		static Ref<AsyncStream> openIOCP(const StringParam& path, FileMode mode);
 #endif
+		
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		// reads and writes are submitted to the io_uring of `loop` (no thread-pool hop). Returns `null` when `loop` does not use io_uring
+		static Ref<AsyncStream> openIoUring(const StringParam& path, FileMode mode, const Ref<AsyncIoLoop>& loop);
+#endif
 	
 	public:
 		void close() override;
@@ -658,6 +778,8 @@ namespace slib
 
 		AsyncOutputBufferElement(AsyncStream* stream, sl_uint64 size);
 		
+		AsyncOutputBufferElement(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher);
+		
 		~AsyncOutputBufferElement();
 
 		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(AsyncOutputBufferElement)
@@ -671,17 +793,28 @@ namespace slib
 		sl_bool addHeader(const Memory& header);
 
 		void setBody(AsyncStream* stream, sl_uint64 size);
+		
+		void setBodyFile(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher);
 	
 		MemoryQueue& getHeader();
 	
 		Ref<AsyncStream> getBody();
 	
 		sl_uint64 getBodySize();
+		
+		Ref<File> getBodyFile();
+		
+		sl_uint64 getBodyFileOffset();
+		
+		Ref<Dispatcher> getBodyFileDispatcher();
 	
 	protected:
 		MemoryQueue m_header;
 		sl_uint64 m_sizeBody;
 		AtomicRef<AsyncStream> m_body;
+		AtomicRef<File> m_bodyFile;
+		sl_uint64 m_offsetBodyFile;
+		AtomicRef<Dispatcher> m_dispatcherBodyFile;
 
 	};
 	
@@ -706,6 +839,9 @@ namespace slib
 		sl_bool copyFromFile(const String& path);
 
 		sl_bool copyFromFile(const String& path, const Ref<Dispatcher>& dispatcher);
+		
+		// The region is sent by `sendfile` when the output stream supports it, otherwise it is read on `dispatcher` (null: on a new dispatch loop)
+		sl_bool sendFileRegion(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher);
 
 		sl_uint64 getOutputLength() const;
 	
@@ -759,6 +895,8 @@ namespace slib
 		void onAsyncCopyEnd(AsyncCopy* task, sl_bool flagError);
 		
 		void onWriteStream(AsyncStreamResult& result);
+		
+		void onSendFile(AsyncStreamResult& result);
 
 	protected:
 		void _onError();
@@ -766,6 +904,10 @@ namespace slib
 		void _onComplete();
 
 		void _write(sl_bool flagCompleted);
+		
+		void _copyBody(const Ref<AsyncStream>& body, sl_uint64 size);
+		
+		sl_bool _sendFile();
 
 	protected:
 		Ref<AsyncStream> m_streamOutput;
@@ -776,6 +918,9 @@ namespace slib
 
 		Ref<AsyncOutputBufferElement> m_elementWriting;
 		Ref<AsyncCopy> m_copy;
+		Ref<File> m_fileSending;
+		sl_uint64 m_offsetFileSending;
+		sl_uint64 m_sizeFileSending;
 		Memory m_bufWrite;
 		sl_bool m_flagWriting;
 		sl_bool m_flagClosed;
@@ -131,6 +131,13 @@ namespace slib
 		static sl_compare_result compareMemoryZero8(const sl_int64* mem, sl_size count) noexcept;
 
 
+		// ASCII case-insensitive
+		static sl_bool equalsMemoryIgnoreCase(const void* mem1, const void* mem2, sl_size count) noexcept;
+
+		// ASCII case-insensitive
+		static sl_compare_result compareMemoryIgnoreCase(const sl_uint8* mem1, const sl_uint8* mem2, sl_size count) noexcept;
+
+
 		static const sl_uint8* findMemory(const void* mem, sl_uint8 pattern, sl_size count) noexcept;
 	
 		static const sl_int8* findMemory(const sl_int8* mem, sl_int8 pattern, sl_size count) noexcept;
@@ -163,6 +170,13 @@ namespace slib
 		static const sl_int64* findMemoryReverse8(const sl_int64* mem, sl_int64 pattern, sl_size count) noexcept;
 	
 
+		// returns the first occurrence of `pattern`, `mem` is returned for empty pattern
+		static const sl_uint8* findMemory(const void* mem, sl_size count, const void* pattern, sl_size countPattern) noexcept;
+
+		// returns the last occurrence of `pattern`, `mem + count` is returned for empty pattern
+		static const sl_uint8* findMemoryReverse(const void* mem, sl_size count, const void* pattern, sl_size countPattern) noexcept;
+
+
 		static const sl_uint8* findMemoryUntilZero(const void* mem, sl_uint8 pattern, sl_size count) noexcept;
 
 
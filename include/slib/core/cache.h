@@ -0,0 +1,213 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_CACHE
+#define CHECKHEADER_SLIB_CORE_CACHE
+
+#include "definition.h"
+
+#include "flat_hash_map.h"
+#include "mutex.h"
+#include "event.h"
+#include "function.h"
+#include "system.h"
+
+/*
+	Cache is a thread-safe key-value cache with the per-entry lifetime and the bounded capacity.
+
+	The entries are distributed to the shards by the hash of the key, and every shard keeps
+	its own lock, hash table and LRU list. When the total weight of a shard exceeds its share
+	of the capacity, the least recently used entries of the shard are evicted. The expired
+	entries are removed when they are accessed, when they reach the tail of the LRU list, or
+	by `removeExpired()`.
+
+	`getOrLoad` calls the loader only once for concurrent misses of the same key; the other
+	callers wait for the result of the first loader (single-flight).
+*/
+
+namespace slib
+{
+
+	class SLIB_EXPORT CacheStatistics
+	{
+	public:
+		sl_uint64 hitsCount;
+		sl_uint64 missesCount;
+		sl_uint64 loadsCount;
+		sl_uint64 loadFailuresCount;
+		sl_uint64 evictionsCount;
+		sl_uint64 expirationsCount;
+
+	public:
+		CacheStatistics() noexcept;
+
+	public:
+		// hits / (hits + misses), 0 when there is no request
+		double getHitRate() const noexcept;
+
+	};
+
+	template < class KT, class VT, class HASH = Hash<KT>, class KEY_EQUALS = Equals<KT> >
+	class SLIB_EXPORT Cache
+	{
+	public:
+		typedef KT KEY_TYPE;
+		typedef VT VALUE_TYPE;
+
+	public:
+		/*
+			`capacity`: maximum total weight of the entries (0: unlimited). The weight of an entry is 1 unless `setWeigher` is called.
+			`defaultTTL`: lifetime of the entries in milliseconds (0: never expire)
+			`nShards`: rounded up to power of 2 (default: up to 16, keeping at least 64 weights per shard)
+		*/
+		Cache(sl_size capacity = 0, sl_uint32 defaultTTL = 0, sl_uint32 nShards = 0, const HASH& hash = HASH(), const KEY_EQUALS& key_equals = KEY_EQUALS()) noexcept;
+
+		Cache(const Cache& other) = delete;
+
+		~Cache() noexcept;
+
+	public:
+		Cache& operator=(const Cache& other) = delete;
+
+	public:
+		sl_size getCapacity() const noexcept;
+
+		sl_uint32 getShardsCount() const noexcept;
+
+		sl_uint32 getDefaultTTL() const noexcept;
+
+		void setDefaultTTL(sl_uint32 ttl) noexcept;
+
+		// `weigher`: sl_size(const KT& key, const VT& value). Should be set before the cache is shared
+		void setWeigher(const Function<sl_size(const KT& key, const VT& value)>& weigher) noexcept;
+
+		// includes the expired entries which are not removed yet
+		sl_size getCount() const noexcept;
+
+		sl_size getTotalWeight() const noexcept;
+
+		// does not update the LRU order and the statistics
+		sl_bool contains(const KT& key) const noexcept;
+
+		sl_bool get(const KT& key, VT* outValue = sl_null) noexcept;
+
+		VT getValue(const KT& key) noexcept;
+
+		VT getValue(const KT& key, const VT& def) noexcept;
+
+		// returns `sl_false` when the weight of the entry is larger than the capacity of the shard
+		template <class KEY, class VALUE>
+		sl_bool put(KEY&& key, VALUE&& value) noexcept;
+
+		// `ttl`: milliseconds (0: never expire)
+		template <class KEY, class VALUE>
+		sl_bool put(KEY&& key, VALUE&& value, sl_uint32 ttl) noexcept;
+
+		// `loader`: sl_bool(const KT& key, VT& outValue), called without locking the cache
+		template <class LOADER>
+		sl_bool getOrLoad(const KT& key, VT* outValue, const LOADER& loader) noexcept;
+
+		template <class LOADER>
+		sl_bool getOrLoad(const KT& key, VT* outValue, const LOADER& loader, sl_uint32 ttl) noexcept;
+
+		sl_bool remove(const KT& key, VT* outValue = sl_null) noexcept;
+
+		sl_size removeAll() noexcept;
+
+		// returns the number of removed entries
+		sl_size removeExpired() noexcept;
+
+		CacheStatistics getStatistics() const noexcept;
+
+		void resetStatistics() noexcept;
+
+	private:
+		struct Entry
+		{
+			KT key;
+			VT value;
+			sl_uint64 expireAt;
+			sl_size weight;
+			Entry* before;
+			Entry* after;
+
+			template <class KEY, class VALUE>
+			Entry(KEY&& _key, VALUE&& _value) noexcept : key(Forward<KEY>(_key)), value(Forward<VALUE>(_value)) {}
+		};
+
+		struct Loading : public Referable
+		{
+			Ref<Event> event;
+			VT value;
+			sl_bool flagSuccess;
+		};
+
+		struct Shard
+		{
+			Mutex lock;
+			FlatHashMap<KT, Entry*, HASH, KEY_EQUALS> table;
+			FlatHashMap<KT, Ref<Loading>, HASH, KEY_EQUALS> loadings;
+			Entry* front;
+			Entry* back;
+			sl_size weight;
+			CacheStatistics statistics;
+		};
+
+		Shard& _getShard(const KT& key) const noexcept;
+
+		sl_size _getWeight(const KT& key, const VT& value) const noexcept;
+
+		static sl_uint64 _getExpireAt(sl_uint32 ttl) noexcept;
+
+		template <class KEY, class VALUE>
+		sl_bool _put(KEY&& key, VALUE&& value, sl_uint32 ttl) noexcept;
+
+		template <class KEY, class VALUE>
+		sl_bool _putInShard(Shard& shard, KEY&& key, VALUE&& value, sl_size weight, sl_uint64 expireAt, Entry*& freed) noexcept;
+
+		void _unlink(Shard& shard, Entry* entry) noexcept;
+
+		void _linkFront(Shard& shard, Entry* entry) noexcept;
+
+		void _removeEntry(Shard& shard, Entry* entry, Entry*& freed) noexcept;
+
+		void _trim(Shard& shard, Entry*& freed) noexcept;
+
+		static void _freeEntries(Entry* freed) noexcept;
+
+	private:
+		Shard* m_shards;
+		sl_uint32 m_nShards;
+		sl_uint32 m_shiftShard;
+		sl_size m_capacity;
+		sl_size m_capacityPerShard;
+		sl_uint32 m_defaultTTL;
+		HASH m_hash;
+		Function<sl_size(const KT& key, const VT& value)> m_weigher;
+
+	};
+
+}
+
+#include "detail/cache.inc"
+
+#endif
@@ -225,6 +225,9 @@ namespace slib
 	class Charsets
 	{
 	public:
+		// strict validation: rejects overlong forms, surrogates and the code points over U+10FFFF
+		static sl_bool checkUtf8(const void* utf8, sl_size len) noexcept;
+
 		static sl_size utf8ToUtf16(const sl_char8* utf8, sl_reg lenUtf8, sl_char16* utf16, sl_reg lenUtf16Buffer) noexcept;
 
 		static sl_size encode8_UTF16BE(const sl_char8* utf8, sl_reg lenUtf8, void* utf16, sl_reg sizeUtf16Buffer) noexcept;
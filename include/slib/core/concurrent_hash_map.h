@@ -0,0 +1,137 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_CONCURRENT_HASH_MAP
+#define CHECKHEADER_SLIB_CORE_CONCURRENT_HASH_MAP
+
+#include "definition.h"
+
+#include "flat_hash_map.h"
+#include "rw_lock.h"
+#include "list.h"
+#include "pair.h"
+
+/*
+	ConcurrentHashMap is a thread-safe hash map for the tables shared by many threads.
+
+	The items are distributed to the shards by the hash of the key, and every shard
+	is a FlatHashMap guarded by its own ReadWriteLock. The readers of a shard never
+	block each other, and the writers only block the accesses to the same shard.
+
+	The callbacks (`computeIfAbsent`, `update`, `forEach`) are called while the shard
+	is locked, so they should not access the same map.
+*/
+
+namespace slib
+{
+
+	template < class KT, class VT, class HASH = Hash<KT>, class KEY_EQUALS = Equals<KT> >
+	class SLIB_EXPORT ConcurrentHashMap
+	{
+	public:
+		typedef KT KEY_TYPE;
+		typedef VT VALUE_TYPE;
+
+	public:
+		// `nShards` is rounded up to power of 2 (default: 64)
+		ConcurrentHashMap(sl_uint32 nShards = 0, const HASH& hash = HASH(), const KEY_EQUALS& key_equals = KEY_EQUALS()) noexcept;
+
+		ConcurrentHashMap(const ConcurrentHashMap& other) = delete;
+
+		~ConcurrentHashMap() noexcept;
+
+	public:
+		ConcurrentHashMap& operator=(const ConcurrentHashMap& other) = delete;
+
+	public:
+		sl_uint32 getShardsCount() const noexcept;
+
+		sl_size getCount() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		sl_bool contains(const KT& key) const noexcept;
+
+		sl_bool get(const KT& key, VT* outValue = sl_null) const noexcept;
+
+		VT getValue(const KT& key) const noexcept;
+
+		VT getValue(const KT& key, const VT& def) const noexcept;
+
+		template <class KEY, class VALUE>
+		sl_bool put(KEY&& key, VALUE&& value, sl_bool* isInsertion = sl_null) noexcept;
+
+		template <class KEY, class VALUE>
+		sl_bool replace(const KEY& key, VALUE&& value) noexcept;
+
+		// returns `sl_true` when new item is inserted
+		template <class KEY, class... VALUE_ARGS>
+		sl_bool emplace(KEY&& key, VALUE_ARGS&&... value_args) noexcept;
+
+		// `creator`: VT(const KT& key), called at most once per absent key
+		template <class CREATOR>
+		VT computeIfAbsent(const KT& key, const CREATOR& creator) noexcept;
+
+		// `updater`: void(VT& value), called when the key exists
+		template <class UPDATER>
+		sl_bool update(const KT& key, const UPDATER& updater) noexcept;
+
+		sl_bool remove(const KT& key, VT* outValue = sl_null) noexcept;
+
+		sl_size removeAll() noexcept;
+
+		// `callback`: void(const KT& key, const VT& value). The shards are visited one by one under the read lock
+		template <class CALLBACK>
+		void forEach(const CALLBACK& callback) const noexcept;
+
+		// snapshots (each shard is consistent, but the shards are copied at the different moments)
+		List<KT> getAllKeys() const noexcept;
+
+		List<VT> getAllValues() const noexcept;
+
+		List< Pair<KT, VT> > toList() const noexcept;
+
+	private:
+		struct Shard
+		{
+			ReadWriteLock lock;
+			FlatHashMap<KT, VT, HASH, KEY_EQUALS> table;
+		};
+
+		Shard& _getShard(const KT& key) const noexcept;
+
+	private:
+		Shard* m_shards;
+		sl_uint32 m_nShards;
+		sl_uint32 m_shiftShard;
+		HASH m_hash;
+
+	};
+
+}
+
+#include "detail/concurrent_hash_map.inc"
+
+#endif
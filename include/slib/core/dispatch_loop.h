@@ -29,6 +29,7 @@
 #include "thread.h"
 #include "time.h"
 #include "map.h"
+#include "timer_wheel.h"
 
 namespace slib
 {
@@ -57,6 +58,9 @@ namespace slib
 		sl_bool isRunning();
 
 		sl_bool dispatch(const Function<void()>& task, sl_uint64 delay_ms = 0) override;
+		
+		// `task` runs on the loop thread after `delay_ms` milliseconds. The returned entry can be canceled in O(1)
+		Ref<TimerWheelEntry> setTimeout(const Function<void()>& task, sl_uint64 delay_ms);
 
 		sl_bool addTimer(const Ref<Timer>& timer);
 		
@@ -73,30 +77,15 @@ namespace slib
 
 		LinkedQueue< Function<void()> > m_queueTasks;
 
-		struct TimeTask
-		{
-			sl_uint64 time;
-			Function<void()> task;
-		};
-		CMap<sl_uint64, TimeTask> m_timeTasks;
-		Mutex m_lockTimeTasks;
-
-		class TimerTask
-		{
-		public:
-			WeakRef<Timer> timer;
-
-		public:
-			sl_bool operator==(const TimerTask& other) const;
-		};
-		LinkedQueue<TimerTask> m_queueTimers;
-		Mutex m_lockTimer;
+		Ref<TimerWheel> m_timers;
 
 	protected:
 		void _wake();
 		sl_int32 _getTimeout();
-		sl_int32 _getTimeout_TimeTasks();
-		sl_int32 _getTimeout_Timer();
+		void _runTimer(const WeakRef<Timer>& timer);
+		// the next run is scheduled at `timeBase + interval`
+		sl_bool _scheduleTimer(Timer* timer, sl_uint64 timeBase);
+		Ref<TimerWheelEntry> _setTimeoutAt(const Function<void()>& task, sl_uint64 time);
 		void _runLoop();
 
 	};
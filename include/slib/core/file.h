@@ -107,6 +107,22 @@ namespace slib
 		};
 	
 	};
+
+	enum class FileMapMode
+	{
+		Read = 0,
+		ReadWrite = 1, // changes are written back to the file
+		CopyOnWrite = 2 // changes are private to the mapping
+	};
+
+	enum class FileMapAdvice
+	{
+		Normal = 0,
+		Sequential = 1,
+		Random = 2,
+		WillNeed = 3,
+		DontNeed = 4
+	};
 	
 	class SLIB_EXPORT File : public IO
 	{
@@ -188,6 +204,23 @@ namespace slib
 		sl_bool lock();
 
 		sl_bool unlock();
+
+		// flushes the written data to the storage device (fsync)
+		sl_bool sync();
+
+		// maps the region of the opened file. The returned memory keeps the mapping alive until it is released
+		Memory map(sl_uint64 offset = 0, sl_size size = SLIB_SIZE_MAX, FileMapMode mode = FileMapMode::Read);
+
+		static Memory map(const StringParam& filePath, sl_uint64 offset = 0, sl_size size = SLIB_SIZE_MAX, FileMapMode mode = FileMapMode::Read);
+
+		static sl_bool adviseMappedMemory(const void* data, sl_size size, FileMapAdvice advice);
+
+		static sl_bool adviseMappedMemory(const Memory& mem, FileMapAdvice advice);
+
+		// writes the modified pages of `FileMapMode::ReadWrite` mapping back to the file
+		static sl_bool syncMappedMemory(const void* data, sl_size size);
+
+		static sl_bool syncMappedMemory(const Memory& mem);
 	
 		sl_uint64 getDiskSize();
 
@@ -322,6 +355,28 @@ namespace slib
 
 	};
 	
+	// reads the file through a read-only mapping, without copying the contents into the heap
+	class SLIB_EXPORT MappedFileReader : public MemoryReader
+	{
+		SLIB_DECLARE_OBJECT
+
+	public:
+		MappedFileReader(const Memory& mem);
+
+		~MappedFileReader();
+
+	public:
+		static Ref<MappedFileReader> open(const StringParam& filePath, FileMapAdvice advice = FileMapAdvice::Sequential);
+
+		static Ref<MappedFileReader> open(const Ref<File>& file, FileMapAdvice advice = FileMapAdvice::Sequential);
+
+	public:
+		Memory getMemory();
+
+		sl_bool advise(FileMapAdvice advice);
+
+	};
+	
 	// FilePathSegments is not thread-safe
 	class SLIB_EXPORT FilePathSegments
 	{
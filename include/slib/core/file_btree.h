@@ -0,0 +1,177 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_FILE_BTREE
+#define CHECKHEADER_SLIB_CORE_FILE_BTREE
+
+#include "definition.h"
+
+#include "btree.h"
+#include "file.h"
+#include "hash_table.h"
+
+#define SLIB_FILE_BTREE_DEFAULT_PAGE_SIZE 4096
+#define SLIB_FILE_BTREE_DEFAULT_CACHE_PAGES 1024
+
+/*
+	FileBTree stores the nodes of BTree in the fixed-size pages of a file.
+
+	- Keys and values are stored as raw bytes, so KT and VT should be trivially copyable types (integers, fixed-size structs, ...).
+	- The recently used pages are kept in the page cache (LRU).
+	- Modifications are kept in the cache until `commit()`. The modified pages are written to
+	  the journal file ("<path>-journal") before they are written to the main file, and a
+	  complete journal is replayed when the file is opened after a crash.
+	  Uncommitted modifications are discarded by `rollback()`, and committed by `close()`.
+	- Not thread-safe.
+*/
+
+namespace slib
+{
+
+	template < class KT, class VT, class KEY_COMPARE = Compare<KT> >
+	class SLIB_EXPORT FileBTree : public BTree<KT, VT, KEY_COMPARE>
+	{
+	public:
+		typedef BTree<KT, VT, KEY_COMPARE> BASE;
+		typedef typename BASE::NodeData NodeData;
+
+	public:
+		// order = 0: the order fitting in SLIB_FILE_BTREE_DEFAULT_PAGE_SIZE
+		FileBTree(sl_uint32 order = 0);
+
+		FileBTree(const KEY_COMPARE& compare, sl_uint32 order = 0);
+
+		~FileBTree();
+
+	public:
+		// creates new file if not exists. The order of existing file should match
+		sl_bool open(const StringParam& filePath, sl_uint32 maxCachedPages = SLIB_FILE_BTREE_DEFAULT_CACHE_PAGES);
+
+		// commits the modifications and closes the file
+		void close();
+
+		sl_bool isOpened() const noexcept;
+
+		sl_bool commit();
+
+		void rollback();
+
+		// builds the tree from sorted items. The tree should be empty
+		sl_bool bulkLoad(const KT* keys, const VT* values, sl_size count);
+
+		sl_uint32 getPageSize() const noexcept;
+
+		sl_uint64 getPagesCount() const noexcept;
+
+		sl_size getCachedPagesCount() const noexcept;
+
+	protected:
+		BTreeNode getRootNode() const override;
+
+		sl_bool setRootNode(BTreeNode node) override;
+
+		BTreeNode createNode(NodeData* data) override;
+
+		sl_bool deleteNode(BTreeNode node) override;
+
+		NodeData* readNodeData(const BTreeNode& node) const override;
+
+		sl_bool writeNodeData(const BTreeNode& node, NodeData* data) override;
+
+		void releaseNodeData(NodeData* data) override;
+
+	protected:
+		struct Page : public NodeData
+		{
+			sl_uint64 position;
+			sl_uint32 refCount;
+			sl_bool flagDirty;
+			Page* before;
+			Page* after;
+		};
+
+		struct Header
+		{
+			sl_uint32 pageSize;
+			sl_uint32 order;
+			sl_uint32 keySize;
+			sl_uint32 valueSize;
+			sl_uint64 root;
+			sl_uint64 pagesCount;
+			sl_uint64 firstFreePage;
+		};
+
+		Page* _createPage(sl_uint64 position);
+
+		void _freePage(Page* page);
+
+		Page* _getPage(sl_uint64 position);
+
+		void _touchPage(Page* page);
+
+		void _removePage(Page* page);
+
+		void _evictPages();
+
+		void _clearPages();
+
+		sl_bool _readPage(sl_uint64 position, Page* page);
+
+		sl_bool _writePage(sl_uint64 position, Page* page);
+
+		void _encodePage(Page* page, sl_uint8* buf);
+
+		void _decodePage(const sl_uint8* buf, Page* page);
+
+		void _encodeHeader(sl_uint8* buf);
+
+		sl_bool _decodeHeader(const sl_uint8* buf);
+
+		sl_bool _writeRaw(sl_uint64 position, const void* buf);
+
+		sl_bool _recoverJournal();
+
+		sl_uint64 _allocatePage();
+
+		BTreeNode _bulkLoad(const KT* keys, const VT* values, sl_uint64 count, const BTreeNode& parent);
+
+	protected:
+		Ref<File> m_file;
+		String m_pathJournal;
+		Header m_header;
+		sl_bool m_flagHeaderDirty;
+		sl_uint64 m_nCommittedPages;
+		sl_uint32 m_pageSize;
+		Memory m_bufPage;
+		HashTable<sl_uint64, Page*> m_pages;
+		Page* m_pageFirst;
+		Page* m_pageLast;
+		sl_size m_maxCachedPages;
+
+	};
+
+}
+
+#include "detail/file_btree.inc"
+
+#endif
@@ -0,0 +1,185 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_FLAT_HASH_MAP
+#define CHECKHEADER_SLIB_CORE_FLAT_HASH_MAP
+
+#include "definition.h"
+
+#include "base.h"
+#include "map_common.h"
+#include "hash.h"
+#include "null_value.h"
+
+/*
+	FlatHashMap is an open-addressing hash table (Swiss-table style).
+
+	The key/value pairs are stored in place (no node allocation per item), and the
+	table keeps one control byte per slot which is probed 16 slots at once (SSE2/NEON).
+	Unlike HashTable/HashMap:
+		- it is not synchronized
+		- a key can have only one value
+		- node pointers and positions are invalidated by the insertions and `reserve()`
+*/
+
+namespace slib
+{
+
+	template <class KT, class VT>
+	class FlatHashMapNode
+	{
+	public:
+		KT key;
+		VT value;
+
+	public:
+		template <class KEY, class... VALUE_ARGS>
+		FlatHashMapNode(KEY&& _key, VALUE_ARGS&&... value_args) noexcept;
+
+	};
+
+	template <class KT, class VT>
+	class SLIB_EXPORT FlatHashMapPosition
+	{
+	public:
+		typedef FlatHashMapNode<KT, VT> NODE;
+
+	public:
+		FlatHashMapPosition(const sl_int8* ctrl, const sl_int8* ctrlEnd, NODE* node) noexcept;
+
+		FlatHashMapPosition(const FlatHashMapPosition& other) noexcept = default;
+
+	public:
+		FlatHashMapPosition& operator=(const FlatHashMapPosition& other) noexcept = default;
+
+		NODE& operator*() const noexcept;
+
+		sl_bool operator==(const FlatHashMapPosition& other) const noexcept;
+
+		sl_bool operator!=(const FlatHashMapPosition& other) const noexcept;
+
+		FlatHashMapPosition& operator++() noexcept;
+
+	public:
+		const sl_int8* ctrl;
+		const sl_int8* ctrlEnd;
+		NODE* node;
+
+	};
+
+	template < class KT, class VT, class HASH = Hash<KT>, class KEY_EQUALS = Equals<KT> >
+	class SLIB_EXPORT FlatHashMap
+	{
+	public:
+		typedef KT KEY_TYPE;
+		typedef VT VALUE_TYPE;
+		typedef FlatHashMapNode<KT, VT> NODE;
+
+	public:
+		FlatHashMap(sl_size capacity = 0, const HASH& hash = HASH(), const KEY_EQUALS& key_equals = KEY_EQUALS()) noexcept;
+
+		FlatHashMap(const FlatHashMap& other) = delete;
+
+		FlatHashMap(FlatHashMap&& other) noexcept;
+
+		~FlatHashMap() noexcept;
+
+	public:
+		FlatHashMap& operator=(const FlatHashMap& other) = delete;
+
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+
+	public:
+		sl_size getCount() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// count of the slots
+		sl_size getCapacity() const noexcept;
+
+		// prepares the slots for `count` items without rehashing
+		sl_bool reserve(sl_size count) noexcept;
+
+		NODE* find(const KT& key) const noexcept;
+
+		VT* getItemPointer(const KT& key) const noexcept;
+
+		sl_bool get(const KT& key, VT* outValue = sl_null) const noexcept;
+
+		VT getValue(const KT& key) const noexcept;
+
+		VT getValue(const KT& key, const VT& def) const noexcept;
+
+		template <class KEY, class VALUE>
+		NODE* put(KEY&& key, VALUE&& value, sl_bool* isInsertion = sl_null) noexcept;
+
+		template <class KEY, class VALUE>
+		NODE* replace(const KEY& key, VALUE&& value) noexcept;
+
+		template <class KEY, class... VALUE_ARGS>
+		MapEmplaceReturn<NODE> emplace(KEY&& key, VALUE_ARGS&&... value_args) noexcept;
+
+		sl_bool removeAt(const NODE* node) noexcept;
+
+		sl_bool remove(const KT& key, VT* outValue = sl_null) noexcept;
+
+		sl_size removeAll() noexcept;
+
+		sl_bool copyFrom(const FlatHashMap<KT, VT, HASH, KEY_EQUALS>& other) noexcept;
+
+		// range-based for loop
+		FlatHashMapPosition<KT, VT> begin() const noexcept;
+
+		FlatHashMapPosition<KT, VT> end() const noexcept;
+
+	private:
+		sl_size _hash(const KT& key) const noexcept;
+
+		NODE* _find(const KT& key, sl_size hash) const noexcept;
+
+		sl_size _findSlotForInsert(sl_size hash) const noexcept;
+
+		NODE* _prepareInsert(sl_size hash) noexcept;
+
+		sl_bool _rehash(sl_size capacity) noexcept;
+
+		void _free() noexcept;
+
+	private:
+		NODE* m_slots;
+		sl_int8* m_ctrl;
+		sl_size m_capacity;
+		sl_size m_count;
+		sl_size m_growthLeft;
+		HASH m_hash;
+		KEY_EQUALS m_equals;
+
+	};
+
+}
+
+#include "detail/flat_hash_map.inc"
+
+#endif
@@ -183,6 +183,9 @@ namespace slib
 		/* unsynchronized function */
 		void removeAt(Link<T>* item) noexcept;
 
+		// same as `removeAt()`, named for the code calling the other `_NoLock` functions under the list's lock
+		void removeAt_NoLock(Link<T>* item) noexcept;
+
 		sl_size removeAll_NoLock() noexcept;
 
 		sl_size removeAll() noexcept;
@@ -322,6 +325,8 @@ namespace slib
 		/* unsynchronized function */
 		void removeAt(Link<T>* item) const noexcept;
 
+		void removeAt_NoLock(Link<T>* item) const noexcept;
+
 		sl_size removeAll_NoLock() const noexcept;
 
 		sl_size removeAll() const noexcept;
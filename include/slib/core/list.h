@@ -37,6 +37,8 @@ namespace slib
 	
 	template <class T>
 	class List;
+
+	class ThreadPool;
 	
 	template <class T>
 	using AtomicList = Atomic< List<T> >;
@@ -363,6 +365,19 @@ namespace slib
 		
 		template < class COMPARE = Compare<T> >
 		void sortDesc(const COMPARE& compare = COMPARE()) const noexcept;
+
+		// defined in "parallel_sort.h"
+		template < class COMPARE = Compare<T> >
+		void sortParallel_NoLock(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
+
+		template < class COMPARE = Compare<T> >
+		void sortParallel(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
+
+		template < class COMPARE = Compare<T> >
+		void sortParallelDesc_NoLock(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
+
+		template < class COMPARE = Compare<T> >
+		void sortParallelDesc(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
 		
 		void reverse_NoLock() const noexcept;
 		
@@ -690,6 +705,19 @@ namespace slib
 		
 		template < class COMPARE = Compare<T> >
 		void sortDesc(const COMPARE& compare = COMPARE()) const noexcept;
+
+		// defined in "parallel_sort.h"
+		template < class COMPARE = Compare<T> >
+		void sortParallel_NoLock(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
+
+		template < class COMPARE = Compare<T> >
+		void sortParallel(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
+
+		template < class COMPARE = Compare<T> >
+		void sortParallelDesc_NoLock(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
+
+		template < class COMPARE = Compare<T> >
+		void sortParallelDesc(const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) const noexcept;
 		
 		void reverse_NoLock() const noexcept;
 		
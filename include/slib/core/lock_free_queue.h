@@ -0,0 +1,295 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_LOCK_FREE_QUEUE
+#define CHECKHEADER_SLIB_CORE_LOCK_FREE_QUEUE
+
+#include "definition.h"
+
+#include "event.h"
+#include "system.h"
+#include "cpp.h"
+
+#include <atomic>
+
+/*
+	Lock-free queues. The items are moved in and out, so `T` should be default-constructible and movable.
+
+	MpmcQueue: bounded array queue, any threads can push and pop (Dmitry Vyukov)
+	SpscQueue: bounded ring buffer, one producer thread and one consumer thread
+	MpscQueue: unbounded linked queue, any threads can push and one consumer thread pops
+	MpscIntrusiveQueue: MpscQueue linking the nodes allocated by the caller
+
+	BlockingQueue wraps any of them, and lets the idle threads wait on the events.
+*/
+
+#define SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE 64
+
+namespace slib
+{
+
+	template <class T>
+	class SLIB_EXPORT MpmcQueue
+	{
+	public:
+		typedef T ValueType;
+
+	public:
+		// `capacity` is rounded up to power of 2
+		MpmcQueue(sl_size capacity) noexcept;
+
+		~MpmcQueue() noexcept;
+
+	public:
+		MpmcQueue(const MpmcQueue& other) = delete;
+
+		MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+	public:
+		sl_size getCapacity() const noexcept;
+
+		// approximate while other threads are working on the queue
+		sl_size getCount() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// fails when the queue is full. `value` is not moved on failure
+		template <class VALUE>
+		sl_bool push(VALUE&& value) noexcept;
+
+		sl_bool pop(T* _out = sl_null) noexcept;
+
+	protected:
+		struct Cell
+		{
+			std::atomic<sl_size> sequence;
+			T value;
+		};
+
+		Cell* m_cells;
+		sl_size m_mask;
+		sl_uint8 m_padding0[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+		std::atomic<sl_size> m_posPush;
+		sl_uint8 m_padding1[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+		std::atomic<sl_size> m_posPop;
+		sl_uint8 m_padding2[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+
+	};
+
+	template <class T>
+	class SLIB_EXPORT SpscQueue
+	{
+	public:
+		typedef T ValueType;
+
+	public:
+		// `capacity` is rounded up to power of 2
+		SpscQueue(sl_size capacity) noexcept;
+
+		~SpscQueue() noexcept;
+
+	public:
+		SpscQueue(const SpscQueue& other) = delete;
+
+		SpscQueue& operator=(const SpscQueue& other) = delete;
+
+	public:
+		sl_size getCapacity() const noexcept;
+
+		sl_size getCount() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// producer thread only. `value` is not moved on failure
+		template <class VALUE>
+		sl_bool push(VALUE&& value) noexcept;
+
+		// consumer thread only
+		sl_bool pop(T* _out = sl_null) noexcept;
+
+	protected:
+		T* m_items;
+		sl_size m_mask;
+		sl_uint8 m_padding0[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+		// written by the producer
+		std::atomic<sl_size> m_posPush;
+		sl_size m_posPopCached;
+		sl_uint8 m_padding1[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+		// written by the consumer
+		std::atomic<sl_size> m_posPop;
+		sl_size m_posPushCached;
+		sl_uint8 m_padding2[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+
+	};
+
+	class SLIB_EXPORT MpscQueueNode
+	{
+	public:
+		std::atomic<MpscQueueNode*> mpscNext;
+
+	};
+
+	// `NODE` derives from `MpscQueueNode`. The queue does not own the nodes
+	template <class NODE>
+	class SLIB_EXPORT MpscIntrusiveQueue
+	{
+	public:
+		MpscIntrusiveQueue() noexcept;
+
+	public:
+		MpscIntrusiveQueue(const MpscIntrusiveQueue& other) = delete;
+
+		MpscIntrusiveQueue& operator=(const MpscIntrusiveQueue& other) = delete;
+
+	public:
+		// any thread. `true` while the push of another thread is in progress
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// any thread, wait-free
+		void push(NODE* node) noexcept;
+
+		// consumer thread only. Can return null while the push of another thread is in progress
+		NODE* pop() noexcept;
+
+		// consumer thread only. Pops the nodes pushed before the call
+		template <class CALLBACK>
+		sl_size popAll(const CALLBACK& callback) noexcept;
+
+	protected:
+		void _push(MpscQueueNode* node) noexcept;
+
+	protected:
+		sl_uint8 m_padding0[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+		std::atomic<MpscQueueNode*> m_tail;
+		sl_uint8 m_padding1[SLIB_LOCK_FREE_QUEUE_CACHE_LINE_SIZE];
+		MpscQueueNode* m_head;
+		MpscQueueNode m_stub;
+
+	};
+
+	template <class T>
+	class SLIB_EXPORT MpscQueue
+	{
+	public:
+		typedef T ValueType;
+
+	public:
+		MpscQueue() noexcept;
+
+		~MpscQueue() noexcept;
+
+	public:
+		MpscQueue(const MpscQueue& other) = delete;
+
+		MpscQueue& operator=(const MpscQueue& other) = delete;
+
+	public:
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// any thread. fails only when the node is not allocated
+		template <class VALUE>
+		sl_bool push(VALUE&& value) noexcept;
+
+		// consumer thread only
+		sl_bool pop(T* _out = sl_null) noexcept;
+
+		// consumer thread only. Pops the items pushed before the call, the items pushed by `callback` are left for the next call
+		template <class CALLBACK>
+		sl_size popAll(const CALLBACK& callback) noexcept;
+
+	protected:
+		struct Node : public MpscQueueNode
+		{
+			T value;
+		};
+
+		MpscIntrusiveQueue<Node> m_queue;
+
+	};
+
+	/*
+		`QUEUE`: MpmcQueue, SpscQueue or MpscQueue.
+		A waiting thread registers itself before it retries the queue, and sleeps on the event only when the retry fails.
+		`push` and `pop` do not touch the events while nobody is waiting.
+		`timeout`: milliseconds, negative means INFINITE, 0 means no wait
+	*/
+	template <class QUEUE>
+	class SLIB_EXPORT BlockingQueue
+	{
+	public:
+		typedef typename QUEUE::ValueType ValueType;
+
+	public:
+		template <class... ARGS>
+		BlockingQueue(ARGS&&... args) noexcept;
+
+	public:
+		QUEUE& getQueue() noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// waits while the queue is full
+		template <class VALUE>
+		sl_bool push(VALUE&& value, sl_int32 timeout = -1) noexcept;
+
+		// waits while the queue is empty
+		sl_bool pop(ValueType* _out, sl_int32 timeout = -1) noexcept;
+
+	protected:
+		void _notifyPush() noexcept;
+
+		void _notifyPop() noexcept;
+
+	protected:
+		QUEUE m_queue;
+		std::atomic<sl_int32> m_nWaitingPush;
+		std::atomic<sl_int32> m_nWaitingPop;
+		Ref<Event> m_eventNotFull;
+		Ref<Event> m_eventNotEmpty;
+
+	};
+
+	template <class T>
+	using BlockingMpmcQueue = BlockingQueue< MpmcQueue<T> >;
+
+	template <class T>
+	using BlockingSpscQueue = BlockingQueue< SpscQueue<T> >;
+
+	template <class T>
+	using BlockingMpscQueue = BlockingQueue< MpscQueue<T> >;
+
+}
+
+#include "detail/lock_free_queue.inc"
+
+#endif
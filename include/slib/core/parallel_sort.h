@@ -0,0 +1,74 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_PARALLEL_SORT
+#define CHECKHEADER_SLIB_CORE_PARALLEL_SORT
+
+#include "definition.h"
+
+#include "sort.h"
+#include "list.h"
+#include "function.h"
+#include "thread_pool.h"
+
+// the arrays smaller than this size are sorted by `IntroSort` on the calling thread
+#define SLIB_PARALLEL_SORT_MIN_SIZE 65536
+
+namespace slib
+{
+
+	/*
+		Parallel sample sort: the elements are distributed to the buckets split by
+		the sorted samples, then the buckets are sorted by `IntroSort` in parallel.
+		The elements equal to a splitter are collected into an equality bucket, which needs no sorting.
+		If `pool` is null, temporary threads are used. Not stable.
+	*/
+	class SLIB_EXPORT ParallelSort
+	{
+	public:
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortAsc(TYPE* list, sl_size size, const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) noexcept;
+
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortDesc(TYPE* list, sl_size size, const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) noexcept;
+
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sort(TYPE* list, sl_size size, const COMPARE& compare = COMPARE(), const Ref<ThreadPool>& pool = sl_null) noexcept
+		{
+			sortAsc(list, size, compare, pool);
+		}
+
+	public:
+		// runs `task(0)`...`task(nTasks - 1)` on the pool and the calling thread, and returns when all the tasks are finished
+		static void run(sl_uint32 nTasks, const Function<void(sl_uint32 index)>& task, const Ref<ThreadPool>& pool = sl_null) noexcept;
+
+		// number of threads (including the calling thread) used for the parallel work
+		static sl_uint32 getThreadsCount(const Ref<ThreadPool>& pool) noexcept;
+
+	};
+
+}
+
+#include "detail/parallel_sort.inc"
+
+#endif
@@ -68,6 +68,21 @@ namespace slib
 
 		virtual sl_bool isInstanceOf(sl_object_type type) const noexcept;
 
+	public:
+		// uses `SlabAllocator` when SLib is built with `SLIB_USE_SLAB_ALLOCATOR`
+		static void* operator new(sl_size_t size);
+
+		static void operator delete(void* ptr, sl_size_t size) noexcept;
+
+		SLIB_INLINE static void* operator new(sl_size_t, void* ptr) noexcept
+		{
+			return ptr;
+		}
+
+		SLIB_INLINE static void operator delete(void*, void*) noexcept
+		{
+		}
+
 	private:
 		void _clearWeak() noexcept;
 
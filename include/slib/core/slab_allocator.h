@@ -0,0 +1,83 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_SLAB_ALLOCATOR
+#define CHECKHEADER_SLIB_CORE_SLAB_ALLOCATOR
+
+#include "definition.h"
+
+/*
+	SlabAllocator serves small blocks (up to SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE bytes) from
+	size-class slabs cached per thread. A block freed by a thread other than the owner of
+	its slab is pushed to the owner's lock-free remote-free queue and reclaimed by the owner
+	on its next allocation of that size class.
+
+	Build SLib with `SLIB_USE_SLAB_ALLOCATOR` defined to route `Base::createMemory` and
+	the allocation of `Referable` objects through the slab allocator.
+*/
+
+#define SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE 1024
+#define SLIB_SLAB_ALLOCATOR_SIZE_CLASSES_COUNT 20
+
+namespace slib
+{
+
+	class SLIB_EXPORT SlabAllocatorStatistics
+	{
+	public:
+		sl_size blockSize;
+		sl_uint64 allocationsCount;
+		// includes `remoteFreesCount`
+		sl_uint64 freesCount;
+		// frees by the threads not owning the slab
+		sl_uint64 remoteFreesCount;
+		sl_uint64 slabsCount;
+
+	public:
+		SlabAllocatorStatistics() noexcept;
+
+	};
+
+	class SLIB_EXPORT SlabAllocator
+	{
+	public:
+		// blocks larger than SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE are allocated by `malloc`
+		static void* allocateMemory(sl_size size) noexcept;
+
+		// `size` must be the size passed to `allocateMemory()`
+		static void freeMemory(void* ptr, sl_size size) noexcept;
+
+		static sl_uint32 getSizeClassesCount() noexcept;
+
+		static sl_size getBlockSize(sl_uint32 sizeClass) noexcept;
+
+		static void getStatistics(sl_uint32 sizeClass, SlabAllocatorStatistics& _out) noexcept;
+
+		// returns `sl_true` when SLib was built with `SLIB_USE_SLAB_ALLOCATOR`
+		static sl_bool isUsedByBase() noexcept;
+
+	};
+
+}
+
+#endif
@@ -27,6 +27,9 @@
 
 #include "cpp.h"
 #include "compare.h"
+#include "base.h"
+
+#include <new>
 
 namespace slib
 {
@@ -70,6 +73,58 @@ namespace slib
 
 	};
 
+	/*
+		Pattern-defeating quicksort: median-of-3 (ninther for large ranges) pivots,
+		partitioning out the runs of equal elements, and falling back to heap sort
+		when the partitions keep being unbalanced, so the worst case is O(n log n).
+		Not stable.
+	*/
+	class SLIB_EXPORT IntroSort
+	{
+	public:
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortAsc(TYPE* list, sl_size size, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortDesc(TYPE* list, sl_size size, const COMPARE& compare = COMPARE()) noexcept;
+
+	};
+
+	// Stable bottom-up merge sort using a temporary buffer of `size` elements
+	class SLIB_EXPORT MergeSort
+	{
+	public:
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortAsc(TYPE* list, sl_size size, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortDesc(TYPE* list, sl_size size, const COMPARE& compare = COMPARE()) noexcept;
+
+	};
+
+	/*
+		Stable LSD radix sort on integer or floating-point keys (8 bits per pass).
+		The passes in which all the keys share the same digit are skipped.
+		Returns `sl_false` when the temporary buffer could not be allocated.
+	*/
+	class SLIB_EXPORT RadixSort
+	{
+	public:
+		template <class TYPE>
+		static sl_bool sortAsc(TYPE* list, sl_size size) noexcept;
+
+		template <class TYPE>
+		static sl_bool sortDesc(TYPE* list, sl_size size) noexcept;
+
+		// `getKey(element)` returns integer or floating-point key
+		template <class TYPE, class GET_KEY>
+		static sl_bool sortAscByKey(TYPE* list, sl_size size, const GET_KEY& getKey) noexcept;
+
+		template <class TYPE, class GET_KEY>
+		static sl_bool sortDescByKey(TYPE* list, sl_size size, const GET_KEY& getKey) noexcept;
+
+	};
+
 }
 
 #include "detail/sort.inc"
@@ -0,0 +1,227 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_STRING_BUILDER
+#define CHECKHEADER_SLIB_CORE_STRING_BUILDER
+
+#include "string.h"
+#include "variant.h"
+
+#define SLIB_STRING_BUILDER_INLINE_SIZE 120
+
+/**
+ * @addtogroup core
+ *  @{
+ */
+namespace slib
+{
+
+	/** @class StringBuilder
+	 * @brief Contiguous buffer for building a string piece by piece. StringBuilder is not thread-safe.
+	 *
+	 * Short contents are kept in the inline storage. Longer contents are kept in a heap buffer which grows geometrically,
+	 * and the buffer is handed off to `String` or `Memory` without copying by `releaseString()` and `releaseMemory()`.
+	 */
+	class SLIB_EXPORT StringBuilder
+	{
+	public:
+		StringBuilder() noexcept;
+
+		StringBuilder(sl_size capacity) noexcept;
+
+		StringBuilder(const StringBuilder& other) = delete;
+
+		StringBuilder(StringBuilder&& other) noexcept;
+
+		~StringBuilder() noexcept;
+
+	public:
+		StringBuilder& operator=(const StringBuilder& other) = delete;
+
+		StringBuilder& operator=(StringBuilder&& other) noexcept;
+
+	public:
+		/**
+		 * Returns the written characters. The content is not null-terminated.
+		 */
+		SLIB_INLINE sl_char8* getData() const noexcept
+		{
+			return m_data;
+		}
+
+		SLIB_INLINE sl_size getLength() const noexcept
+		{
+			return m_length;
+		}
+
+		SLIB_INLINE sl_size getCapacity() const noexcept
+		{
+			return m_capacity;
+		}
+
+		SLIB_INLINE sl_bool isEmpty() const noexcept
+		{
+			return !m_length;
+		}
+
+		SLIB_INLINE sl_bool isNotEmpty() const noexcept
+		{
+			return m_length != 0;
+		}
+
+		/**
+		 * Ensures the buffer can hold `capacity` characters without reallocation.
+		 */
+		sl_bool reserve(sl_size capacity) noexcept;
+
+		/**
+		 * Truncates the content. `length` should not be larger than current length.
+		 */
+		void setLength(sl_size length) noexcept;
+
+		/**
+		 * Clears the content. The buffer is kept for reuse.
+		 */
+		void clear() noexcept;
+
+		/**
+		 * Appends `length` uninitialized characters and returns the pointer to them (null on failure).
+		 */
+		SLIB_INLINE sl_char8* addUninitialized(sl_size length) noexcept
+		{
+			sl_size n = m_length + length;
+			if (n > m_capacity) {
+				if (!(_grow(n))) {
+					return sl_null;
+				}
+			}
+			sl_char8* p = m_data + m_length;
+			m_length = n;
+			return p;
+		}
+
+		sl_bool add(const sl_char8* buf, sl_size length) noexcept;
+
+		sl_bool add(const String& str) noexcept;
+
+		sl_bool add(const StringView& str) noexcept;
+
+		sl_bool add(const StringStorage& str) noexcept;
+
+		/**
+		 * Same as `add()`. Provided for the code written for `StringBuffer`.
+		 */
+		SLIB_INLINE sl_bool addStatic(const sl_char8* buf, sl_size length) noexcept
+		{
+			return add(buf, length);
+		}
+
+		template <sl_size N>
+		SLIB_INLINE sl_bool addStatic(const sl_char8 (&s)[N]) noexcept
+		{
+			return add(s, N - 1);
+		}
+
+		SLIB_INLINE sl_bool addChar(sl_char8 ch) noexcept
+		{
+			if (m_length < m_capacity) {
+				m_data[m_length++] = ch;
+				return sl_true;
+			}
+			sl_char8* p = addUninitialized(1);
+			if (p) {
+				*p = ch;
+				return sl_true;
+			}
+			return sl_false;
+		}
+
+		sl_bool addChar(sl_char8 ch, sl_size nRepeatCount) noexcept;
+
+		sl_bool addInt32(sl_int32 value, sl_uint32 radix = 10, sl_uint32 minWidth = 0, sl_bool flagUpperCase = sl_false) noexcept;
+
+		sl_bool addUint32(sl_uint32 value, sl_uint32 radix = 10, sl_uint32 minWidth = 0, sl_bool flagUpperCase = sl_false) noexcept;
+
+		sl_bool addInt64(sl_int64 value, sl_uint32 radix = 10, sl_uint32 minWidth = 0, sl_bool flagUpperCase = sl_false) noexcept;
+
+		sl_bool addUint64(sl_uint64 value, sl_uint32 radix = 10, sl_uint32 minWidth = 0, sl_bool flagUpperCase = sl_false) noexcept;
+
+		sl_bool addFloat(float value, sl_int32 precision = -1, sl_bool flagZeroPadding = sl_false, sl_uint32 minWidthIntegral = 1) noexcept;
+
+		sl_bool addDouble(double value, sl_int32 precision = -1, sl_bool flagZeroPadding = sl_false, sl_uint32 minWidthIntegral = 1) noexcept;
+
+		/**
+		 * Appends the string formatted by the rules of `String::format()`.
+		 */
+		template <class... ARGS>
+		SLIB_INLINE void addFormat(const StringParam& strFormat, ARGS&&... args) noexcept
+		{
+			Variant params[] = {Forward<ARGS>(args)...};
+			addFormatBy(strFormat, params, sizeof...(args));
+		}
+
+		void addFormatBy(const StringParam& strFormat, const Variant* params, sl_size nParams) noexcept;
+
+		void addFormatBy(const StringParam& strFormat, const ListParam<Variant>& params) noexcept;
+
+		/**
+		 * Returns a copy of the content.
+		 */
+		String merge() const noexcept;
+
+		/**
+		 * Returns a copy of the content as memory.
+		 */
+		Memory mergeToMemory() const noexcept;
+
+		/**
+		 * Returns the content and clears the builder. The heap buffer is handed off without copying.
+		 */
+		String releaseString() noexcept;
+
+		/**
+		 * Returns the content as memory and clears the builder. The heap buffer is handed off without copying.
+		 */
+		Memory releaseMemory() noexcept;
+
+	private:
+		sl_bool _grow(sl_size size) noexcept;
+
+		sl_bool _reallocate(sl_size capacity) noexcept;
+
+		void _reset() noexcept;
+
+		void _moveFrom(StringBuilder& other) noexcept;
+
+	private:
+		sl_char8* m_data;
+		sl_size m_length;
+		sl_size m_capacity;
+		Memory m_memory;
+		sl_char8 m_inline[SLIB_STRING_BUILDER_INLINE_SIZE];
+
+	};
+
+}
+/// @}
+
+#endif
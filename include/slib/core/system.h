@@ -68,6 +68,8 @@ namespace slib
 		static void yield();
 
 		static void yield(sl_uint32 elapsed);
+		
+		static sl_uint32 getProcessorsCount();
 	
 		
 		static sl_uint32 getLastError();
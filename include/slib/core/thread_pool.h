@@ -26,23 +26,41 @@
 #include "definition.h"
 
 #include "queue.h"
+#include "lock_free_queue.h"
 #include "thread.h"
 #include "dispatch.h"
+#include "timer_wheel.h"
 
 namespace slib
 {
 	
+	namespace priv
+	{
+		namespace thread_pool
+		{
+			class WorkStealingContext;
+		}
+	}
+	
 	class SLIB_EXPORT ThreadPool : public Dispatcher
 	{
 		SLIB_DECLARE_OBJECT
 
 	private:
-		ThreadPool();
+		ThreadPool(sl_uint32 sizeTaskQueue);
 
 		~ThreadPool();
 
 	public:
-		static Ref<ThreadPool> create(sl_uint32 minThreads = 0, sl_uint32 maxThreads = 30);
+		// `sizeTaskQueue`: preallocated capacity of the lock-free task queue, the tasks beyond it go through the locked overflow queue
+		static Ref<ThreadPool> create(sl_uint32 minThreads = 0, sl_uint32 maxThreads = 30, sl_uint32 sizeTaskQueue = 256);
+		
+		/*
+			Work-stealing pool: `nThreads` fixed workers (0: processors count), each owning a lock-free deque.
+			Tasks dispatched from a worker are pushed onto its own deque, other tasks go through the bounded injection queue.
+			Idle workers steal from the other deques before they sleep.
+		*/
+		static Ref<ThreadPool> createWorkStealing(sl_uint32 nThreads = 0, sl_uint32 sizeInjectionQueue = 65536);
 	
 	public:
 		void release();
@@ -50,10 +68,15 @@ namespace slib
 		sl_bool isRunning();
 
 		sl_uint32 getThreadsCount();
+		
+		sl_bool isWorkStealing();
 	
 		sl_bool addTask(const Function<void()>& task);
 
 		sl_bool dispatch(const Function<void()>& callback, sl_uint64 delay_ms = 0) override;
+		
+		// `task` is added to the pool after `delay_ms` milliseconds. The returned entry can be canceled in O(1)
+		Ref<TimerWheelEntry> setTimeout(const Function<void()>& task, sl_uint64 delay_ms);
 	
 	public:
 		SLIB_PROPERTY(sl_uint32, MinimumThreadsCount)
@@ -62,13 +85,29 @@ namespace slib
 	
 	protected:
 		void onRunWorker();
+
+		sl_bool _hasTasks();
+		
+		void _runStealingWorker(sl_uint32 index);
+		
+		sl_bool _addStealingTask(const Function<void()>& task);
+		
+		void _runTimer();
 	
 	protected:
 		CList< Ref<Thread> > m_threadWorkers;
 		LinkedQueue< Ref<Thread> > m_threadSleeping;
-		LinkedQueue< Function<void()> > m_tasks;
+		MpmcQueue< Function<void()> > m_tasks;
+		// used when `m_tasks` is full
+		LinkedQueue< Function<void()> > m_tasksOverflow;
+		std::atomic<sl_int32> m_nSleeping;
 
 		sl_bool m_flagRunning;
+		
+		Ref<priv::thread_pool::WorkStealingContext> m_stealing;
+		
+		Ref<TimerWheel> m_timers;
+		Ref<Thread> m_threadTimer;
 
 	};
 
@@ -33,6 +33,7 @@ namespace slib
 	
 	class DispatchLoop;
 	class Dispatcher;
+	class TimerWheelEntry;
 	
 	class SLIB_EXPORT Timer : public Object
 	{
@@ -87,8 +88,11 @@ namespace slib
 
 		Ref<Dispatcher> m_dispatcher;
 		WeakRef<DispatchLoop> m_loop;
+		Ref<TimerWheelEntry> m_entry;
 
 		sl_bool m_flagDispatched;
+		
+		friend class DispatchLoop;
 
 	};
 
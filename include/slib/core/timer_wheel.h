@@ -0,0 +1,129 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_TIMER_WHEEL
+#define CHECKHEADER_SLIB_CORE_TIMER_WHEEL
+
+#include "definition.h"
+
+#include "object.h"
+#include "function.h"
+#include "list.h"
+
+#define SLIB_TIMER_WHEEL_LEVELS 4
+#define SLIB_TIMER_WHEEL_SLOT_BITS 8
+#define SLIB_TIMER_WHEEL_SLOTS (1 << SLIB_TIMER_WHEEL_SLOT_BITS)
+
+namespace slib
+{
+	
+	class TimerWheel;
+	
+	class SLIB_EXPORT TimerWheelEntry : public Referable
+	{
+		SLIB_DECLARE_OBJECT
+		
+	public:
+		TimerWheelEntry();
+		
+		~TimerWheelEntry();
+		
+	public:
+		// expiration time (milliseconds)
+		sl_uint64 getTime();
+		
+		sl_bool isPending();
+		
+		// O(1), safe to call from any thread
+		sl_bool cancel();
+		
+	protected:
+		Function<void()> m_task;
+		sl_uint64 m_time;
+		WeakRef<TimerWheel> m_wheel;
+		
+		TimerWheelEntry* m_prev;
+		TimerWheelEntry* m_next;
+		TimerWheelEntry** m_slot;
+		
+		friend class TimerWheel;
+		
+	};
+	
+	/*
+		Hierarchical timing wheel with 1 millisecond ticks.
+		Adding and removing entries are O(1), and `advance` visits the slots one by one skipping empty ranges.
+		The wheel is not bound to a thread: the owner (loop or pool) drives it by calling `advance` and waits for `getTimeout` milliseconds.
+	*/
+	class SLIB_EXPORT TimerWheel : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		TimerWheel();
+		
+		~TimerWheel();
+		
+	public:
+		static Ref<TimerWheel> create(sl_uint64 timeStart = 0);
+		
+	public:
+		// `time`: absolute expiration time (milliseconds). `pFlagEarliest` receives whether the owner should wake up to recalculate its timeout.
+		Ref<TimerWheelEntry> add(const Function<void()>& task, sl_uint64 time, sl_bool* pFlagEarliest = sl_null);
+		
+		sl_bool remove(TimerWheelEntry* entry);
+		
+		void removeAll();
+		
+		sl_size getCount();
+		
+		// collects the tasks expired until `time`
+		void advance(sl_uint64 time, List< Function<void()> >& tasks);
+		
+		// milliseconds to wait from `time` before calling `advance` again. negative means no entry is pending
+		sl_int32 getTimeout(sl_uint64 time);
+		
+	protected:
+		void _insert(TimerWheelEntry* entry);
+		
+		void _unlink(TimerWheelEntry* entry);
+		
+		void _cascade(sl_uint32 level, sl_uint32 index);
+		
+		sl_int32 _findNextSlot(sl_uint32 level, sl_uint32 index);
+		
+		sl_int32 _findNextSlotCyclic(sl_uint32 level, sl_uint32 index);
+		
+	protected:
+		TimerWheelEntry* m_slots[SLIB_TIMER_WHEEL_LEVELS][SLIB_TIMER_WHEEL_SLOTS];
+		sl_uint64 m_bitmaps[SLIB_TIMER_WHEEL_LEVELS][SLIB_TIMER_WHEEL_SLOTS / 64];
+		sl_uint64 m_timeCurrent;
+		sl_uint64 m_timeExpected;
+		sl_size m_count;
+		
+		friend class TimerWheelEntry;
+		
+	};
+	
+}
+
+#endif
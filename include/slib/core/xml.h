@@ -52,6 +52,7 @@ namespace slib
 	class XmlComment;
 	class XmlParseControl;
 	class StringBuffer;
+	class StringBuilder;
 
 	enum class XmlNodeType
 	{
@@ -79,6 +80,11 @@ namespace slib
 
 		virtual sl_bool buildXml(StringBuffer& output) const = 0;
 
+		// writes into the contiguous buffer. By default, forwards to the `StringBuffer` version. The nodes of SLib override both
+		virtual sl_bool buildText(StringBuilder& output) const;
+
+		virtual sl_bool buildXml(StringBuilder& output) const;
+
 		virtual String getText() const;
 
 		String toString() const;
@@ -160,8 +166,12 @@ namespace slib
 	public:
 		sl_bool buildText(StringBuffer& output) const override;
 
+		sl_bool buildText(StringBuilder& output) const override;
+
 		sl_bool buildInnerXml(StringBuffer& output) const;
 
+		sl_bool buildInnerXml(StringBuilder& output) const;
+
 		String getInnerXml() const;
 	
 		sl_size getChildrenCount() const;
@@ -256,6 +266,8 @@ namespace slib
 		static Ref<XmlElement> create(const StringParam& name, const StringParam& uri, const StringParam& localName);
 
 		sl_bool buildXml(StringBuffer& output) const override;
+
+		sl_bool buildXml(StringBuilder& output) const override;
 	
 		String getName() const;
 
@@ -336,6 +348,8 @@ namespace slib
 		static Ref<XmlDocument> create();
 
 		sl_bool buildXml(StringBuffer& output) const override;
+
+		sl_bool buildXml(StringBuilder& output) const override;
 	
 		Ref<XmlElement> getElementById(const StringParam& _id) const;
 
@@ -366,7 +380,11 @@ namespace slib
 
 		sl_bool buildText(StringBuffer& output) const override;
 
+		sl_bool buildText(StringBuilder& output) const override;
+
 		sl_bool buildXml(StringBuffer& output) const override;
+
+		sl_bool buildXml(StringBuilder& output) const override;
 	
 		String getText() const override;
 
@@ -396,8 +414,12 @@ namespace slib
 
 		sl_bool buildText(StringBuffer& output) const override;
 
+		sl_bool buildText(StringBuilder& output) const override;
+
 		sl_bool buildXml(StringBuffer& output) const override;
 
+		sl_bool buildXml(StringBuilder& output) const override;
+
 		String getTarget() const;
 
 		sl_bool setTarget(const StringParam& target);
@@ -426,8 +448,12 @@ namespace slib
 
 		sl_bool buildText(StringBuffer& output) const override;
 
+		sl_bool buildText(StringBuilder& output) const override;
+
 		sl_bool buildXml(StringBuffer& output) const override;
 
+		sl_bool buildXml(StringBuilder& output) const override;
+
 		String getComment() const;
 
 		void setComment(const StringParam& comment);
@@ -451,8 +477,12 @@ namespace slib
 
 		sl_bool buildText(StringBuffer& output) const override;
 
+		sl_bool buildText(StringBuilder& output) const override;
+
 		sl_bool buildXml(StringBuffer& output) const override;
 
+		sl_bool buildXml(StringBuilder& output) const override;
+
 		String getContent() const;
 
 		void setContent(const StringParam& comment);
@@ -673,6 +703,8 @@ namespace slib
 		 * @return `true` on success
 		 */
 		static sl_bool encodeTextToEntities(const String& text, StringBuffer& output);
+
+		static sl_bool encodeTextToEntities(const String& text, StringBuilder& output);
 		
 		/**
 		 * Decodes XML entities (&amp;lt; &amp;gt; &amp;amp; ...) contained in `text`.
@@ -66,6 +66,16 @@ namespace slib
 		// 128 bits (16 bytes) block
 		void decryptBlock(const void* src, void* dst) const;
 
+		// Below functions process `size / 16` blocks, and use AES-NI (x64) or ARMv8 Cryptography Extensions when available
+
+		void encryptBlocks(const void* src, void* dst, sl_size size) const;
+
+		void decryptBlocks(const void* src, void* dst, sl_size size) const;
+
+		void encryptBlocks_CTR(void* counter /* 16 bytes, inout */, const void* src, void* dst, sl_size size) const;
+
+		void decryptBlocks_CBC(void* iv /* 16 bytes, inout */, const void* src, void* dst, sl_size size) const;
+
 	private:
 		sl_uint32 m_roundKeyEnc[64];
 		sl_uint32 m_roundKeyDec[64];
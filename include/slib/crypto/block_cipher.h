@@ -146,6 +146,45 @@ namespace slib
 			}
 		}
 		
+		// `counter` is a big-endian integer, and is increased by the count of the processed blocks
+		void encryptBlocks_CTR(void* _counter, const void* _src, void* _dst, sl_size size) const
+		{
+			sl_uint8* counter = (sl_uint8*)_counter;
+			const sl_uint8* src = (const sl_uint8*)_src;
+			sl_uint8* dst = (sl_uint8*)_dst;
+			sl_uint8 mask[CLASS::BlockSize];
+			sl_size nBlocks = size / CLASS::BlockSize;
+			for (sl_size i = 0; i < nBlocks; i++) {
+				((CLASS*)this)->encryptBlock(counter, mask);
+				for (sl_uint32 k = 0; k < CLASS::BlockSize; k++) {
+					dst[k] = src[k] ^ mask[k];
+				}
+				MIO::increaseBE(counter, CLASS::BlockSize);
+				src += CLASS::BlockSize;
+				dst += CLASS::BlockSize;
+			}
+		}
+		
+		// `iv` is updated to the last ciphertext block
+		void decryptBlocks_CBC(void* _iv, const void* _src, void* _dst, sl_size size) const
+		{
+			sl_uint8* iv = (sl_uint8*)_iv;
+			const sl_uint8* src = (const sl_uint8*)_src;
+			sl_uint8* dst = (sl_uint8*)_dst;
+			sl_uint8 cipher[CLASS::BlockSize];
+			sl_size nBlocks = size / CLASS::BlockSize;
+			for (sl_size i = 0; i < nBlocks; i++) {
+				Base::copyMemory(cipher, src, CLASS::BlockSize);
+				((CLASS*)this)->decryptBlock(cipher, dst);
+				for (sl_uint32 k = 0; k < CLASS::BlockSize; k++) {
+					dst[k] ^= iv[k];
+				}
+				Base::copyMemory(iv, cipher, CLASS::BlockSize);
+				src += CLASS::BlockSize;
+				dst += CLASS::BlockSize;
+			}
+		}
+		
 		sl_size encrypt_ECB_PKCS7Padding(const void* src, sl_size size, void* dst) const
 		{
 			return BlockCipher_ECB<CLASS, BlockCipherPadding_PKCS7>::encrypt((CLASS*)this, src, size, dst);
@@ -163,6 +163,11 @@ namespace slib
 
 		static sl_bool verify_SHA256(const EllipticCurve& curve, const ECPublicKey& key, const void* data, sl_size size, const ECDSA_Signature& signature);
 
+		// returns true only when all of the `n` signatures are valid
+		static sl_bool verifyBatch(const EllipticCurve& curve, const ECPublicKey* keys, const BigInt* z, const ECDSA_Signature* signatures, sl_size n);
+
+		static sl_bool verifyBatch(const EllipticCurve& curve, const ECPublicKey* keys, const void* const* hashes, const sl_size* sizeHashes, const ECDSA_Signature* signatures, sl_size n);
+
 	};
 	
 	// Elliptic Curve Diffie–Hellman
@@ -46,6 +46,7 @@ namespace slib
 	{
 	public:
 		Uint128 M[16]; // Shoup's, 4-bit table
+		sl_uint8 HP[4][16]; // H, H^2, H^3, H^4 (byte-reversed), used by PCLMULQDQ (x64) or PMULL (ARMv8)
 	
 	public:
 		void generateTable(const void* H /* 16 bytes */);
@@ -73,6 +74,9 @@ namespace slib
 	public:
 		void increaseCIV();
 
+		// Increases CIV, and reserves at most `nBlocks` counter blocks starting from the increased CIV without wrapping the 32-bit counter. Returns the count of the reserved blocks.
+		sl_size reserveCounterBlocks(sl_size nBlocks, void* counter /* out, 16 bytes */);
+
 		void putBlock(const void* src, sl_uint32 n = 16 /* n <= 16 */);
 
 		void put(const void* src, sl_size len);
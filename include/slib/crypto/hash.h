@@ -84,6 +84,30 @@ namespace slib
 			return Memory::create(v, CLASS::HashSize);
 		}
 		
+		// hashes `n` independent messages, `outputs` receives `n * HashSize` bytes
+		static void hashBatch(const void* const* inputs, const sl_size* sizes, sl_size n, void* outputs)
+		{
+			sl_uint8* output = (sl_uint8*)outputs;
+			for (sl_size i = 0; i < n; i++) {
+				hash(inputs[i], sizes[i], output);
+				output += CLASS::HashSize;
+			}
+		}
+		
+		// same as above, but every message is preceded by `prefix`
+		static void hashBatch(const void* prefix, sl_size sizePrefix, const void* const* inputs, const sl_size* sizes, sl_size n, void* outputs)
+		{
+			sl_uint8* output = (sl_uint8*)outputs;
+			CLASS h;
+			for (sl_size i = 0; i < n; i++) {
+				h.start();
+				h.update(prefix, sizePrefix);
+				h.update(inputs[i], sizes[i]);
+				h.finish(output);
+				output += CLASS::HashSize;
+			}
+		}
+		
 		void applyMask_MGF1(const void* seed, sl_uint32 sizeSeed, void* target, sl_uint32 sizeTarget);
 
 	};
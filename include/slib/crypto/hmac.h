@@ -36,46 +36,68 @@ namespace slib
 	class SLIB_EXPORT HMAC
 	{
 	public:
-		static void execute(const void* _key, sl_size lenKey, const void* message, sl_size lenMessage, void* output)
+		static void execute(const void* key, sl_size lenKey, const void* message, sl_size lenMessage, void* output)
 		{
-			sl_size i;
-			const sl_uint8* key = (const sl_uint8*)_key;
-			sl_uint8 keyLocal[HASH::BlockSize];
-			if (lenKey > HASH::BlockSize) {
-				HASH::hash(key, lenKey, keyLocal);
-				for (i = HASH::HashSize; i < HASH::BlockSize; i++) {
-					keyLocal[i] = 0;
-				}
-				key = keyLocal;
-			} else if (lenKey < HASH::BlockSize) {
-				for (i = 0; i < lenKey; i++) {
-					keyLocal[i] = key[i];
-				}
-				for (; i < HASH::BlockSize; i++) {
-					keyLocal[i] = 0;
-				}
-				key = keyLocal;
-			}
 			// hash(o_key_pad | hash(i_key_pad | message)), i_key_pad = key xor [0x36 * BlockSize], o_key_pad = key xor [0x5c * BlockSize]
+			sl_uint8 i_key_pad[HASH::BlockSize];
+			sl_uint8 o_key_pad[HASH::BlockSize];
+			_getKeyPads(key, lenKey, i_key_pad, o_key_pad);
 			HASH hash;
 			hash.start();
-			sl_uint8 key_pad[HASH::BlockSize];
-			for (i = 0; i < HASH::BlockSize; i++) {
-				key_pad[i] = key[i] ^ 0x36;
-			}
-			hash.update(key_pad, HASH::BlockSize);
+			hash.update(i_key_pad, HASH::BlockSize);
 			hash.update(message, lenMessage);
 			hash.finish(output);
 			
 			hash.start();
-			for (i = 0; i < HASH::BlockSize; i++) {
-				key_pad[i] = key[i] ^ 0x5c;
-			}
-			hash.update(key_pad, HASH::BlockSize);
+			hash.update(o_key_pad, HASH::BlockSize);
 			hash.update(output, HASH::HashSize);
 			hash.finish(output);
 		}
 		
+		// authenticates `n` messages with the same key, `outputs` receives `n * HashSize` bytes
+		static void executeBatch(const void* key, sl_size lenKey, const void* const* messages, const sl_size* sizes, sl_size n, void* outputs)
+		{
+			sl_uint8 i_key_pad[HASH::BlockSize];
+			sl_uint8 o_key_pad[HASH::BlockSize];
+			_getKeyPads(key, lenKey, i_key_pad, o_key_pad);
+			HASH::hashBatch(i_key_pad, HASH::BlockSize, messages, sizes, n, outputs);
+			
+			sl_uint8* output = (sl_uint8*)outputs;
+			const void* inners[32];
+			sl_size sizesInner[32];
+			while (n) {
+				sl_size m = n < 32 ? n : 32;
+				for (sl_size i = 0; i < m; i++) {
+					inners[i] = output + i * HASH::HashSize;
+					sizesInner[i] = HASH::HashSize;
+				}
+				HASH::hashBatch(o_key_pad, HASH::BlockSize, inners, sizesInner, m, output);
+				output += m * HASH::HashSize;
+				n -= m;
+			}
+		}
+		
+	private:
+		static void _getKeyPads(const void* _key, sl_size lenKey, sl_uint8* i_key_pad, sl_uint8* o_key_pad)
+		{
+			sl_size i;
+			const sl_uint8* key = (const sl_uint8*)_key;
+			sl_uint8 keyLocal[HASH::HashSize];
+			if (lenKey > HASH::BlockSize) {
+				HASH::hash(key, lenKey, keyLocal);
+				key = keyLocal;
+				lenKey = HASH::HashSize;
+			}
+			for (i = 0; i < lenKey; i++) {
+				i_key_pad[i] = key[i] ^ 0x36;
+				o_key_pad[i] = key[i] ^ 0x5c;
+			}
+			for (; i < HASH::BlockSize; i++) {
+				i_key_pad[i] = 0x36;
+				o_key_pad[i] = 0x5c;
+			}
+		}
+		
 	};
 
 }
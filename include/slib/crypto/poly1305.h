@@ -62,8 +62,15 @@ namespace slib
 		void updateBlocks(const void* input, sl_size nBlocks);
 		
 	private:
+#if defined(SLIB_ARCH_IS_64BIT)
+		// 44-bit limbs
+		sl_uint64 m_r[4][3]; // r, r^2, r^3, r^4
+		sl_uint64 m_h[3];
+#else
+		// 26-bit limbs
 		sl_uint32 m_r[5];
 		sl_uint32 m_h[5];
+#endif
 		sl_uint32 m_pad[4];
 		sl_uint32 m_leftOver;
 		sl_uint8 m_buffer[16];
@@ -138,6 +138,12 @@ namespace slib
 	public:
 		static sl_uint32 make32bitChecksum(const void* input, sl_size n);
 
+		// hashes `n` independent messages at once, `outputs` receives `n * HashSize` bytes
+		static void hashBatch(const void* const* inputs, const sl_size* sizes, sl_size n, void* outputs);
+
+		// same as above, but every message is preceded by `prefix`
+		static void hashBatch(const void* prefix, sl_size sizePrefix, const void* const* inputs, const sl_size* sizes, sl_size n, void* outputs);
+
 	};
 	
 	class SLIB_EXPORT SHA384 : public priv::sha2::SHA512Base, public CryptoHash<SHA384>
@@ -83,11 +83,14 @@ namespace slib
 				<0: Error
 				=0: Finished
 				>0: Success
+
+			flagSyncFlush: flushes all the pending output aligned on a byte boundary, so that the receiver can decompress all the input passed so far.
+				When `sizeOutputAvailable` is used up, call again with the same flag.
 		*/
 		sl_int32 compress(
 			const void* input, sl_uint32 sizeInputAvailable, sl_uint32& sizeInputPassed,
 			void* output, sl_uint32 sizeOutputAvailable, sl_uint32& sizeOutputUsed,
-			sl_bool flagFinish);
+			sl_bool flagFinish, sl_bool flagSyncFlush = sl_false);
 	
 		Memory compress(const void* data, sl_size size, sl_bool flagFinish);
 	
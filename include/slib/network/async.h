@@ -93,7 +93,7 @@ namespace slib
 		void _onError();
 		
 	private:
-		static Ref<AsyncTcpSocketInstance> _createInstance(const Ref<Socket>& socket);
+		static Ref<AsyncTcpSocketInstance> _createInstance(const Ref<Socket>& socket, sl_bool flagIoUring);
 		
 	protected:
 		Function<void(AsyncTcpSocket*, sl_bool flagError)> m_onConnect;
@@ -117,6 +117,7 @@ namespace slib
 		sl_bool flagIPv6; // default: false
 		sl_bool flagAutoStart; // default: true
 		sl_bool flagLogError; // default: true
+		sl_bool flagReusePort; // default: false, lets several listeners share `bindAddress` (one per loop)
 		Ref<AsyncIoLoop> ioLoop;
 		
 		Function<void(AsyncTcpServer*, Socket*, const SocketAddress&)> onAccept;
@@ -160,7 +161,7 @@ namespace slib
 		void _onError();
 		
 	protected:
-		static Ref<AsyncTcpServerInstance> _createInstance(const Ref<Socket>& socket);
+		static Ref<AsyncTcpServerInstance> _createInstance(const Ref<Socket>& socket, sl_bool flagIoUring);
 		
 	protected:
 		Function<void(AsyncTcpServer*, Socket*, const SocketAddress&)> m_onAccept;
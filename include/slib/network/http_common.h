@@ -177,6 +177,7 @@ namespace slib
 		static const String& Cookie;
 		static const String& Range;
 		static const String& IfModifiedSince;
+		static const String& IfNoneMatch;
 		
 		// Response Headers
 		static const String& TransferEncoding;
@@ -185,7 +186,9 @@ namespace slib
 		static const String& AcceptRanges;
 		static const String& ContentRange;
 		static const String& LastModified;
+		static const String& ETag;
 		static const String& Location;
+		static const String& Vary;
 		
 	};
 
@@ -423,6 +426,10 @@ namespace slib
 		
 		void setRequestRangeSuffix(sl_uint64 length);
 		
+		String getRequestAcceptEncoding() const;
+		
+		void setRequestAcceptEncoding(const String& encodings);
+		
 		String getRequestOrigin() const;
 		
 		void setRequestOrigin(const String& origin);
@@ -431,6 +438,11 @@ namespace slib
 		
 		void setRequestIfModifiedSince(const Time& time);
 		
+		// entity tags are listed without quotes
+		String getRequestIfNoneMatch() const;
+		
+		void setRequestIfNoneMatch(const String& etag);
+		
 		HttpCacheControlRequest getRequestCacheControl() const;
 		
 		void setRequestCacheControl(const HttpCacheControlRequest&);
@@ -633,6 +645,12 @@ namespace slib
 		
 		void setResponseLastModified(const Time& time);
 		
+		// returns the entity tag without quotes
+		String getResponseETag() const;
+		
+		// `etag` should not contain quotes
+		void setResponseETag(const String& etag);
+		
 		HttpCacheControlResponse getResponseCacheControl() const;
 		
 		void setResponseCacheControl(const HttpCacheControlResponse&);
@@ -57,6 +57,11 @@ namespace slib
 		
 		void copyFromFile(const String& path, const Ref<Dispatcher>& dispatcher);
 		
+		// zero-copy (sendfile) on plain sockets. Other streams (ex: TLS) read the region on `dispatcher`
+		void sendFileRegion(const Ref<File>& file, sl_uint64 offset, sl_uint64 size);
+		
+		void sendFileRegion(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher);
+		
 		sl_uint64 getOutputLength() const;
 		
 	protected:
@@ -139,6 +144,45 @@ namespace slib
 		HttpContentReaderOnComplete m_onComplete;
 
 	};
+	
+	// Encodes (gzip, deflate) the data written to the filter, and writes to the source stream
+	class SLIB_EXPORT HttpContentEncoder : public AsyncStreamFilter
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		HttpContentEncoder();
+		
+		~HttpContentEncoder();
+		
+	public:
+		// `encoding`: "gzip" or "deflate". `flagChunked`: writes as the chunked transfer coding. `level` is clamped to 0 ~ 9
+		static Ref<HttpContentEncoder> create(const Ref<AsyncStream>& io, const String& encoding, sl_bool flagChunked, sl_int32 level = 6);
+		
+		// returns 0 when `encoding` is not accepted by `Accept-Encoding`, otherwise 1~1000 (q-value * 1000)
+		static sl_uint32 getAcceptedQuality(const String& acceptEncoding, const String& encoding);
+		
+		// returns the supported encoding preferred by `Accept-Encoding`, or null
+		static String selectEncoding(const String& acceptEncoding);
+		
+	public:
+		const String& getEncoding();
+		
+		// writes the remaining encoded data (and the last chunk)
+		sl_bool finish(const Function<void(AsyncStreamResult&)>& callback);
+		
+	protected:
+		Memory filterWrite(const void* data, sl_uint32 size, Referable* userObject) override;
+		
+		Memory encodeData(const void* data, sl_uint32 size, sl_bool flagFinish);
+		
+	protected:
+		String m_encoding;
+		sl_bool m_flagChunked;
+		ZlibCompress m_zlib;
+		Memory m_bufEncode;
+		
+	};
 
 }
 
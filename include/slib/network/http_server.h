@@ -27,9 +27,11 @@
 
 #include "http_common.h"
 #include "http_io.h"
+#include "http_static_cache.h"
 #include "socket_address.h"
 
 #include "../core/thread_pool.h"
+#include "../core/concurrent_hash_map.h"
 #include "../crypto/tls.h"
 
 namespace slib
@@ -37,6 +39,10 @@ namespace slib
 
 	class HttpServer;
 	class HttpServerConnection;
+	class HttpServerContext;
+	
+	// called on the I/O thread for each piece of the request body (decoded from the chunked transfer coding)
+	typedef Function<void(HttpServerContext* context, const void* data, sl_size size)> HttpServerRequestBodyHandler;
 	
 	class SLIB_EXPORT HttpServerContext : public Object, public HttpRequest, public HttpResponse, public HttpOutputBuffer
 	{
@@ -91,6 +97,27 @@ namespace slib
 		
 		void setKeepAlive(sl_bool flag = sl_true);
 		
+		// the response body can be compressed while sending (`HttpServerParam::flagUseCompression`). default: true
+		sl_bool isCompressionEnabled() const;
+		
+		void setCompressionEnabled(sl_bool flag = sl_true);
+		
+		
+		sl_bool isStreamingRequestBody() const;
+		
+		HttpServerRequestBodyHandler getRequestBodyHandler() const;
+		
+		// Receives the request body by `handler` instead of buffering it. Should be set before the body is received (`HttpServer::preprocessRequest`, `HttpServerRoute::onRequestBodyData`).
+		// The request is processed as usual after the whole body is passed, but `getRequestBody()` returns null.
+		void setRequestBodyHandler(const HttpServerRequestBodyHandler& handler);
+		
+		// stops reading the connection (backpressure) until `resumeRequestBody()` is called
+		void pauseRequestBody();
+		
+		void resumeRequestBody();
+		
+		sl_bool isRequestBodyPaused() const;
+		
 	protected:
 		HttpHeaderReader m_requestHeaderReader;
 		AtomicMemory m_requestHeader;
@@ -98,17 +125,31 @@ namespace slib
 		MemoryQueue m_requestBodyBuffer;
 		AtomicMemory m_requestBody;
 		
+		sl_uint64 m_sizeRequestBodyReceived;
+		sl_bool m_flagRequestBodyChunked;
+		sl_uint32 m_stateRequestBodyChunk;
+		sl_uint64 m_sizeRequestBodyChunk;
+		sl_bool m_flagRequestBodyChunkSize;
+		sl_bool m_flagRequestBodyCompleted;
+		sl_bool m_flagRequestBodyPaused;
+		HttpServerRequestBodyHandler m_requestBodyHandler;
+		
 		sl_bool m_flagProcessed;
 		sl_bool m_flagClosingConnection;
 		sl_bool m_flagProcessingByThread;
 		sl_bool m_flagKeepAlive;
+		sl_bool m_flagCompressionEnabled;
 
 		sl_bool m_flagBeganProcessing;
 		
+		// content coding applied to the body while sending. created before the response header is made
+		Ref<HttpContentEncoder> m_encoderOutput;
+		
 	private:
 		WeakRef<HttpServerConnection> m_connection;
 		
 		friend class HttpServerConnection;
+		friend class HttpServer;
 		
 	};
 	
@@ -166,13 +207,22 @@ namespace slib
 		Memory m_bufRead;
 		sl_bool m_flagReading;
 		sl_bool m_flagKeepAlive;
-		List<char> m_bufReadUnprocessed;
+		Memory m_bufReadUnprocessed;
 		
 	protected:
 		void _read();
 		
 		void _processInput(const void* data, sl_uint32 size);
 		
+		sl_bool _beginRequestBody(HttpServerContext* context, sl_uint64 maxRequestBodySize);
+		
+		// returns the consumed size, or negative value on error
+		sl_reg _processRequestBody(HttpServerContext* context, const char* data, sl_size size, sl_uint64 maxRequestBodySize);
+		
+		sl_bool _receiveRequestBody(HttpServerContext* context, const char* data, sl_size size, sl_uint64 maxRequestBodySize);
+		
+		void _resumeInput();
+		
 		void _processContext(const Ref<HttpServerContext>& context);
 		
 	public:
@@ -183,6 +233,18 @@ namespace slib
 
 		void onAsyncOutputEnd(AsyncOutput* output, sl_bool flagError);
 		
+		void onEncodingOutputEnd(AsyncOutput* output, sl_bool flagError);
+		
+		void onEncodingFinish(AsyncStreamResult& result);
+		
+	protected:
+		void _writeEncodedBody(HttpServerContext* context);
+		
+	protected:
+		AtomicRef<HttpServerContext> m_contextEncoding;
+		AtomicRef<HttpContentEncoder> m_encoder;
+		AtomicRef<AsyncOutput> m_outputEncoding;
+		
 		friend class HttpServerContext;
 		
 	};
@@ -214,6 +276,8 @@ namespace slib
 	{
 	public:
 		Function<Variant(HttpServerContext*)> onRequest;
+		// optional: receives the request body as a stream before `onRequest` is called
+		HttpServerRequestBodyHandler onRequestBodyData;
 		HashMap<String, HttpServerRoute> routes;
 		Ptr<HttpServerRoute> defaultRoute;
 		Ptr<HttpServerRoute> ellipsisRoute;
@@ -235,6 +299,8 @@ namespace slib
 		
 		Variant processRequest(const String& path, HttpServerContext* context);
 		
+		HttpServerRequestBodyHandler getRequestBodyHandler(const String& path);
+		
 	};
 	
 	class SLIB_EXPORT HttpServerRouter
@@ -255,6 +321,8 @@ namespace slib
 		Variant preProcessRequest(const String& path, HttpServerContext* context);
 
 		Variant postProcessRequest(const String& path, HttpServerContext* context);
+		
+		HttpServerRequestBodyHandler getRequestBodyHandler(const String& path, HttpServerContext* context);
 
 		void add(HttpMethod method, const String& path, const HttpServerRoute& route);
 		
@@ -301,6 +369,11 @@ namespace slib
 		sl_uint32 maxThreadsCount;
 		sl_bool flagProcessByThreads;
 		
+		// number of I/O loops (threads) serving the connections. default: 1, 0 means the processors count
+		sl_uint32 ioThreadsCount;
+		// uses io_uring for the I/O loops on Linux, falling back to epoll when it is not available. default: false
+		sl_bool flagUseIoUring;
+		
 		sl_bool flagUseWebRoot;
 		String webRootPath;
 
@@ -319,6 +392,23 @@ namespace slib
 		sl_bool flagCacheControlNoCache;
 		sl_uint32 cacheControlMaxAge;
 		
+		// caches the attributes, the opened handles and the small contents of the static files. default: false
+		sl_bool flagUseStaticCache;
+		HttpStaticCacheParam staticCache;
+		
+		// compresses the response bodies while sending, by the encoding (gzip, deflate) negotiated with `Accept-Encoding`. default: false
+		// Static files (`processFile`) are not compressed at request time. Use `flagUsePrecompressedFiles` for them.
+		sl_bool flagUseCompression;
+		// 1 ~ 9. default: 6
+		sl_uint32 compressionLevel;
+		// smaller bodies are sent as is. default: 1024
+		sl_uint32 compressionMinimumSize;
+		// content types (without parameters) to be compressed
+		List<String> compressionContentTypes;
+		
+		// serves `<path>.gz` instead of `<path>` to the clients accepting gzip. default: false
+		sl_bool flagUsePrecompressedFiles;
+		
 		sl_bool flagLogDebug;
 		
 		HttpServerRouter router;
@@ -362,14 +452,22 @@ namespace slib
 		
 		Ref<AsyncIoLoop> getAsyncIoLoop();
 		
+		Ref<AsyncIoLoopGroup> getAsyncIoLoopGroup();
+		
 		Ref<ThreadPool> getThreadPool();
 		
+		// returns null when `flagUseStaticCache` is not set
+		Ref<HttpStaticCache> getStaticCache();
+		
 		const HttpServerParam& getParam();
 		
 	public:
 		// called before processing body, returns true if the server is trying to process the connection itself.
 		virtual sl_bool preprocessRequest(HttpServerContext* context);
 		
+		// returns the `onRequestBodyData` of the route matching the request (called after `preprocessRequest`)
+		HttpServerRequestBodyHandler getRequestBodyHandler(HttpServerContext* context);
+		
 		// called after inputing body
 		void processRequest(HttpServerContext* context, HttpServerConnection* connection);
 		
@@ -418,13 +516,23 @@ namespace slib
 		
 		void _processCacheControl(HttpServerContext* context);
 		
+		void _processContentType(HttpServerContext* context, const String& path);
+		
+		sl_bool _processFile(HttpServerContext* context, const String& path);
+		
+		sl_bool _processCachedFile(HttpServerContext* context, const String& path, HttpStaticCacheEntry* entry);
+		
+		sl_bool _processCompression(HttpServerContext* context);
+		
 	protected:
 		AtomicRef<AsyncIoLoop> m_ioLoop;
+		AtomicRef<AsyncIoLoopGroup> m_ioLoopGroup;
 		AtomicRef<ThreadPool> m_threadPool;
+		Ref<HttpStaticCache> m_staticCache;
 		sl_bool m_flagReleased;
 		sl_bool m_flagRunning;
 		
-		CHashMap< HttpServerConnection*, Ref<HttpServerConnection> > m_connections;
+		ConcurrentHashMap< HttpServerConnection*, Ref<HttpServerConnection> > m_connections;
 		
 		CList< Ref<HttpServerConnectionProvider> > m_connectionProviders;
 		
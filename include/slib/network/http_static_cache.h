@@ -0,0 +1,152 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_NETWORK_HTTP_STATIC_CACHE
+#define CHECKHEADER_SLIB_NETWORK_HTTP_STATIC_CACHE
+
+#include "definition.h"
+
+#include "../core/object.h"
+#include "../core/file.h"
+#include "../core/memory.h"
+#include "../core/hash_map.h"
+#include "../core/linked_list.h"
+#include "../core/time.h"
+
+namespace slib
+{
+	
+	class SLIB_EXPORT HttpStaticCacheParam
+	{
+	public:
+		// maximum number of the cached paths (opened files and loaded contents)
+		sl_uint32 maxEntriesCount;
+		// maximum total size of the contents loaded into the memory
+		sl_uint64 maxContentsSize;
+		// files not larger than this size are loaded into the memory. Larger files are kept opened
+		sl_uint32 maxContentSize;
+		// the attributes of the cached files are checked again after this interval (milliseconds)
+		sl_uint32 revalidateInterval;
+		
+	public:
+		HttpStaticCacheParam();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(HttpStaticCacheParam)
+		
+	};
+	
+	class SLIB_EXPORT HttpStaticCacheEntry : public Referable
+	{
+	public:
+		String path;
+		sl_uint64 size;
+		Time modifiedTime;
+		
+		// precomputed `Last-Modified` value
+		String lastModified;
+		// precomputed entity tag (without quotes)
+		String etag;
+		
+		// loaded contents of the small file
+		Memory content;
+		// opened file (null when `content` is loaded)
+		Ref<File> file;
+		
+	public:
+		HttpStaticCacheEntry();
+		
+		~HttpStaticCacheEntry();
+		
+	public:
+		sl_bool isContentLoaded();
+		
+		// `ifNoneMatch`: `If-None-Match` header without quotes
+		sl_bool matchETag(const String& ifNoneMatch);
+		
+		sl_bool isNotModifiedSince(const Time& ifModifiedSince);
+		
+	protected:
+		sl_uint64 m_tickCheck;
+		Link<HttpStaticCacheEntry*>* m_link;
+		
+		friend class HttpStaticCache;
+		
+	};
+	
+	class SLIB_EXPORT HttpStaticCache : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		HttpStaticCache();
+		
+		~HttpStaticCache();
+		
+	public:
+		static Ref<HttpStaticCache> create(const HttpStaticCacheParam& param);
+		
+		static Ref<HttpStaticCache> create();
+		
+	public:
+		// returns null when the path does not exist or is a directory
+		Ref<HttpStaticCacheEntry> get(const String& path);
+		
+		void remove(const String& path);
+		
+		void clear();
+		
+		const HttpStaticCacheParam& getParam();
+		
+		sl_size getEntriesCount();
+		
+		sl_uint64 getContentsSize();
+		
+		sl_uint64 getHitsCount();
+		
+		sl_uint64 getMissesCount();
+		
+		void resetCounters();
+		
+	protected:
+		Ref<HttpStaticCacheEntry> _load(const String& path);
+		
+		void _put(const String& path, const Ref<HttpStaticCacheEntry>& entry);
+		
+		void _remove(HttpStaticCacheEntry* entry);
+		
+	protected:
+		HttpStaticCacheParam m_param;
+		
+		CHashMap< String, Ref<HttpStaticCacheEntry> > m_map;
+		// least recently used entry is in front
+		CLinkedList<HttpStaticCacheEntry*> m_listLRU;
+		sl_uint64 m_sizeContents;
+		
+		sl_int64 m_nHits;
+		sl_int64 m_nMisses;
+		
+	};
+
+}
+
+#endif
@@ -171,6 +171,9 @@ namespace slib
 		
 		static Ref<Socket> openPacketDatagram(NetworkLinkProtocol linkProtocol = NetworkLinkProtocol::All);
 		
+		// takes the ownership of `handle` (ex: a socket accepted by io_uring)
+		static Ref<Socket> create(SocketType type, sl_socket handle);
+		
 	public:
 		void close();
 		
@@ -28,7 +28,8 @@
 #include "constants.h"
 #include "ip_address.h"
 
-#include "../core/expire.h"
+#include "../core/cache.h"
+#include "../core/dispatch_loop.h"
 
 /********************************************************************
 					IPv4 Header from RFC 791
@@ -607,7 +608,7 @@ public:
 		static List<Memory> makeFragments(const IPv4Packet* packet, sl_uint16 mtu = 1500);
 		
 	protected:
-		ExpiringMap< IPv4PacketIdentifier, Ref<IPv4FragmentedPacket> > m_packets;
+		Cache< IPv4PacketIdentifier, Ref<IPv4FragmentedPacket> > m_packets;
 		
 	};
 	
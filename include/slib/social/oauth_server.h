@@ -27,6 +27,7 @@
 
 #include "oauth.h"
 
+#include "../core/cache.h"
 #include "../network/http_server.h"
 #include "../crypto/jwt.h"
 
@@ -111,7 +112,8 @@ namespace slib
 		SLIB_DECLARE_OBJECT
 		
 	public:
-		OAuthTokenMemoryRepository();
+		// `expirySeconds`: lifetime of the tokens (0: never expire), `maxTokensCount`: 0 means unlimited
+		OAuthTokenMemoryRepository(sl_uint32 expirySeconds = 0, sl_size maxTokensCount = 0);
 		
 		~OAuthTokenMemoryRepository();
 		
@@ -125,7 +127,7 @@ namespace slib
 		Json getTokenData(const String& token) override;
 		
 	protected:
-		HashMap<String, Json> m_repo;
+		Cache<String, Json> m_repo;
 		
 	};
 
@@ -0,0 +1,175 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include "slib/core/arena.h"
+
+#include "slib/core/base.h"
+
+#define BLOCK_HEADER_SIZE 16
+
+namespace slib
+{
+
+	Arena::Arena(sl_size blockSize) noexcept
+	{
+		if (blockSize < 256) {
+			blockSize = 256;
+		}
+		m_blockSize = blockSize;
+		m_blockFirst = sl_null;
+		m_blockCurrent = sl_null;
+		m_current = sl_null;
+		m_end = sl_null;
+		m_destructors = sl_null;
+		m_sizeAllocated = 0;
+		m_sizeUsed = 0;
+	}
+
+	Arena::~Arena()
+	{
+		_runDestructors();
+		Block* block = m_blockCurrent;
+		while (block) {
+			Block* next = block->next;
+			Base::freeMemory(block);
+			block = next;
+		}
+	}
+
+	void* Arena::allocate(sl_size size, sl_size alignment) noexcept
+	{
+		if (!alignment) {
+			alignment = 1;
+		}
+		sl_uint8* p = (sl_uint8*)((((sl_size)m_current) + alignment - 1) & ~(alignment - 1));
+		if (m_current && p <= m_end && size <= (sl_size)(m_end - p)) {
+			m_current = p + size;
+			m_sizeUsed += size;
+			return p;
+		}
+		return _allocateBlock(size, alignment);
+	}
+
+	StringView Arena::copyString(const StringView& str) noexcept
+	{
+		sl_size len = str.getLength();
+		sl_char8* data = (sl_char8*)(allocate(len + 1, 1));
+		if (!data) {
+			return sl_null;
+		}
+		if (len) {
+			Base::copyMemory(data, str.getData(), len);
+		}
+		data[len] = 0;
+		return StringView(data, len);
+	}
+
+	void Arena::reset() noexcept
+	{
+		_runDestructors();
+		// dedicated blocks may be linked after the first block
+		Block* block = m_blockCurrent;
+		while (block) {
+			Block* next = block->next;
+			if (block != m_blockFirst) {
+				m_sizeAllocated -= block->size;
+				Base::freeMemory(block);
+			}
+			block = next;
+		}
+		m_blockCurrent = m_blockFirst;
+		if (m_blockFirst) {
+			m_blockFirst->next = sl_null;
+			m_current = (sl_uint8*)m_blockFirst + BLOCK_HEADER_SIZE;
+			m_end = (sl_uint8*)m_blockFirst + m_blockFirst->size;
+		}
+		m_sizeUsed = 0;
+	}
+
+	sl_size Arena::getAllocatedSize() const noexcept
+	{
+		return m_sizeAllocated;
+	}
+
+	sl_size Arena::getUsedSize() const noexcept
+	{
+		return m_sizeUsed;
+	}
+
+	sl_bool Arena::_registerDestructor(void* object, void (*destroy)(void*)) noexcept
+	{
+		Destructor* item = (Destructor*)(allocate(sizeof(Destructor), sizeof(void*)));
+		if (!item) {
+			return sl_false;
+		}
+		item->destroy = destroy;
+		item->object = object;
+		item->next = m_destructors;
+		m_destructors = item;
+		return sl_true;
+	}
+
+	void* Arena::_allocateBlock(sl_size size, sl_size alignment) noexcept
+	{
+		sl_size sizeRequired = BLOCK_HEADER_SIZE + size + alignment;
+		if (sizeRequired < size) {
+			return sl_null;
+		}
+		sl_bool flagDedicated = sizeRequired > m_blockSize;
+		sl_size sizeBlock = flagDedicated ? sizeRequired : m_blockSize;
+		Block* block = (Block*)(Base::createMemory(sizeBlock));
+		if (!block) {
+			return sl_null;
+		}
+		block->size = sizeBlock;
+		m_sizeAllocated += sizeBlock;
+		sl_uint8* start = (sl_uint8*)block + BLOCK_HEADER_SIZE;
+		sl_uint8* p = (sl_uint8*)((((sl_size)start) + alignment - 1) & ~(alignment - 1));
+		if (flagDedicated && m_blockCurrent) {
+			// keeps using the remaining space of the current block
+			block->next = m_blockCurrent->next;
+			m_blockCurrent->next = block;
+		} else {
+			block->next = m_blockCurrent;
+			m_blockCurrent = block;
+			if (!m_blockFirst) {
+				m_blockFirst = block;
+			}
+			m_current = p + size;
+			m_end = (sl_uint8*)block + sizeBlock;
+		}
+		m_sizeUsed += size;
+		return p;
+	}
+
+	void Arena::_runDestructors() noexcept
+	{
+		Destructor* item = m_destructors;
+		m_destructors = sl_null;
+		while (item) {
+			item->destroy(item->object);
+			item = item->next;
+		}
+	}
+
+}
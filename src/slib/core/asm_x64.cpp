@@ -50,6 +50,97 @@ namespace slib
 #endif
 			}
 
+			static sl_bool CanUseAvx2()
+			{
+#if defined(SLIB_COMPILER_IS_VC)
+				int cpu_info[4];
+				__cpuid(cpu_info, 0);
+				if (cpu_info[0] < 7) {
+					return sl_false;
+				}
+				__cpuid(cpu_info, 1);
+				// AVX and OSXSAVE
+				if ((cpu_info[2] & 0x18000000) != 0x18000000) {
+					return sl_false;
+				}
+				// YMM state must be enabled by OS
+				if ((_xgetbv(0) & 6) != 6) {
+					return sl_false;
+				}
+				__cpuidex(cpu_info, 7, 0);
+				return (cpu_info[1] & (1 << 5)) != 0;
+#else
+				unsigned int eax, ebx, ecx, edx;
+				if (__get_cpuid_max(0, sl_null) < 7) {
+					return sl_false;
+				}
+				if (!(__get_cpuid(1, &eax, &ebx, &ecx, &edx))) {
+					return sl_false;
+				}
+				// AVX and OSXSAVE
+				if ((ecx & 0x18000000) != 0x18000000) {
+					return sl_false;
+				}
+				// YMM state must be enabled by OS
+				unsigned int xcr0, xcr0High;
+				__asm__ __volatile__ ("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+				if ((xcr0 & 6) != 6) {
+					return sl_false;
+				}
+				__cpuid_count(7, 0, eax, ebx, ecx, edx);
+				return (ebx & (1 << 5)) != 0;
+#endif
+			}
+
+			static sl_bool HasCpuFeatures_Ecx1(sl_uint32 mask)
+			{
+#if defined(SLIB_COMPILER_IS_VC)
+				int cpu_info[4];
+				__cpuid(cpu_info, 1);
+				return (((sl_uint32)(cpu_info[2])) & mask) == mask;
+#else
+				unsigned int eax, ebx, ecx, edx;
+				return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && ((ecx & mask) == mask);
+#endif
+			}
+
+			static sl_bool CanUseAesNi()
+			{
+				// AES (bit 25), SSSE3 (bit 9)
+				return HasCpuFeatures_Ecx1((1 << 25) | (1 << 9));
+			}
+
+			static sl_bool CanUsePclmul()
+			{
+				// PCLMULQDQ (bit 1), SSSE3 (bit 9)
+				return HasCpuFeatures_Ecx1((1 << 1) | (1 << 9));
+			}
+
+			static sl_bool CanUseShaNi()
+			{
+				// SSSE3 (bit 9), SSE4.1 (bit 19)
+				if (!(HasCpuFeatures_Ecx1((1 << 9) | (1 << 19)))) {
+					return sl_false;
+				}
+				// SHA (leaf 7, ebx bit 29)
+#if defined(SLIB_COMPILER_IS_VC)
+				int cpu_info[4];
+				__cpuid(cpu_info, 0);
+				if (cpu_info[0] < 7) {
+					return sl_false;
+				}
+				__cpuidex(cpu_info, 7, 0);
+				return (cpu_info[1] & (1 << 29)) != 0;
+#else
+				unsigned int eax, ebx, ecx, edx;
+				if (__get_cpuid_max(0, sl_null) < 7) {
+					return sl_false;
+				}
+				__cpuid_count(7, 0, eax, ebx, ecx, edx);
+				return (ebx & (1 << 29)) != 0;
+#endif
+			}
+
 		}
 	}
 	
@@ -58,6 +149,30 @@ namespace slib
 		static sl_bool f = priv::asm_x64::CanUseSse42();
 		return f;
 	}
+
+	sl_bool CanUseAvx2()
+	{
+		static sl_bool f = priv::asm_x64::CanUseAvx2();
+		return f;
+	}
+
+	sl_bool CanUseAesNi()
+	{
+		static sl_bool f = priv::asm_x64::CanUseAesNi();
+		return f;
+	}
+
+	sl_bool CanUsePclmul()
+	{
+		static sl_bool f = priv::asm_x64::CanUsePclmul();
+		return f;
+	}
+
+	sl_bool CanUseShaNi()
+	{
+		static sl_bool f = priv::asm_x64::CanUseShaNi();
+		return f;
+	}
 	
 }
 
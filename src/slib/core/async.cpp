@@ -23,6 +23,9 @@
 #include "slib/core/async.h"
 
 #include "slib/core/safe_static.h"
+#include "slib/core/system.h"
+
+#define ASYNC_MAX_WAIT_TIMEOUT 5000
 
 namespace slib
 {
@@ -38,6 +41,9 @@ namespace slib
 		m_flagInit = sl_false;
 		m_flagRunning = sl_false;
 		m_handle = sl_null;
+		m_flagIoUring = sl_false;
+		m_flagWaking = 0;
+		m_timers = TimerWheel::create(System::getTickCount64());
 	}
 
 	AsyncIoLoop::~AsyncIoLoop()
@@ -62,14 +68,34 @@ namespace slib
 		}
 	}
 
-	Ref<AsyncIoLoop> AsyncIoLoop::create(sl_bool flagAutoStart)
+	Ref<AsyncIoLoop> AsyncIoLoop::create(sl_bool flagAutoStart, sl_bool flagUseIoUring)
 	{
-		void* handle = _native_createHandle();
+		void* handle = sl_null;
+		sl_bool flagIoUring = sl_false;
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		if (flagUseIoUring) {
+			handle = _uring_createHandle();
+			if (handle) {
+				flagIoUring = sl_true;
+			}
+		}
+#endif
+		if (!handle) {
+			handle = _native_createHandle();
+		}
 		if (handle) {
 			Ref<AsyncIoLoop> ret = new AsyncIoLoop;
 			if (ret.isNotNull()) {
 				ret->m_handle = handle;
-				ret->m_thread = Thread::create(SLIB_FUNCTION_MEMBER(AsyncIoLoop, _native_runLoop, ret.get()));
+				ret->m_flagIoUring = flagIoUring;
+#if defined(SLIB_PLATFORM_IS_LINUX)
+				if (flagIoUring) {
+					ret->m_thread = Thread::create(SLIB_FUNCTION_MEMBER(AsyncIoLoop, _uring_runLoop, ret.get()));
+				} else
+#endif
+				{
+					ret->m_thread = Thread::create(SLIB_FUNCTION_MEMBER(AsyncIoLoop, _native_runLoop, ret.get()));
+				}
 				if (ret->m_thread.isNotNull()) {
 					ret->m_flagInit = sl_true;
 					if (flagAutoStart) {
@@ -78,6 +104,12 @@ namespace slib
 					return ret;
 				}
 			}
+#if defined(SLIB_PLATFORM_IS_LINUX)
+			if (flagIoUring) {
+				_uring_closeHandle(handle);
+				return sl_null;
+			}
+#endif
 			_native_closeHandle(handle);
 		}
 		return sl_null;
@@ -99,12 +131,23 @@ namespace slib
 			m_thread->finishAndWait();
 		}
 		
-		_native_closeHandle(m_handle);
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		if (m_flagIoUring) {
+			_uring_closeHandle(m_handle);
+		} else
+#endif
+		{
+			_native_closeHandle(m_handle);
+		}
 		
 		m_queueInstancesOrder.removeAll();
 		m_queueInstancesClosing.removeAll();
 		m_queueInstancesClosed.removeAll();
 		
+		if (m_timers.isNotNull()) {
+			m_timers->removeAll();
+		}
+		
 	}
 
 	void AsyncIoLoop::start()
@@ -127,13 +170,21 @@ namespace slib
 		return m_flagRunning;
 	}
 
+	sl_bool AsyncIoLoop::isUsingIoUring()
+	{
+		return m_flagIoUring;
+	}
+
 	sl_bool AsyncIoLoop::addTask(const Function<void()>& task)
 	{
 		if (task.isNull()) {
 			return sl_false;
 		}
 		if (m_queueTasks.push(task)) {
-			wake();
+			// the loop thread runs the queued tasks before it waits for the events
+			if (!(m_thread->isCurrentThread())) {
+				wake();
+			}
 			return sl_true;
 		}
 		return sl_false;
@@ -141,11 +192,34 @@ namespace slib
 
 	sl_bool AsyncIoLoop::dispatch(const Function<void()>& callback, sl_uint64 delay_ms)
 	{
+		if (delay_ms) {
+			return setTimeout(callback, delay_ms).isNotNull();
+		}
 		return addTask(callback);
 	}
 
+	Ref<TimerWheelEntry> AsyncIoLoop::setTimeout(const Function<void()>& task, sl_uint64 delay_ms)
+	{
+		if (task.isNull() || m_timers.isNull()) {
+			return sl_null;
+		}
+		sl_bool flagEarliest = sl_false;
+		Ref<TimerWheelEntry> entry = m_timers->add(task, System::getTickCount64() + delay_ms, &flagEarliest);
+		if (entry.isNotNull() && flagEarliest) {
+			// the loop thread computes its timeout after running the step
+			if (!(m_thread->isCurrentThread())) {
+				wake();
+			}
+		}
+		return entry;
+	}
+
 	void AsyncIoLoop::wake()
 	{
+		// one wake-up covers all the requests queued until the loop is going to wait again
+		if (!(Base::interlockedCompareExchange32(&m_flagWaking, 1, 0))) {
+			return;
+		}
 		ObjectLocker lock(this);
 		if (!m_flagRunning) {
 			return;
@@ -189,13 +263,18 @@ namespace slib
 
 	void AsyncIoLoop::_stepBegin()
 	{
-		// Async Tasks
-		{
-			LinkedQueue< Function<void()> > tasks;
-			tasks.merge(&m_queueTasks);
-			Function<void()> task;
-			while (tasks.pop(&task)) {
-				task();
+		// Async Tasks: the tasks added while running are left for the next step
+		m_queueTasks.popAll([](Function<void()>& task) {
+			task();
+		});
+		
+		// Timers
+		if (m_timers.isNotNull()) {
+			List< Function<void()> > tasks;
+			m_timers->advance(System::getTickCount64(), tasks);
+			ListElements< Function<void()> > items(tasks);
+			for (sl_size i = 0; i < items.count; i++) {
+				items[i]();
 			}
 		}
 		
@@ -224,6 +303,115 @@ namespace slib
 		}
 	}
 
+	sl_int32 AsyncIoLoop::_getTimeout()
+	{
+		// allows the next request to wake the loop. requests made before are found by the checks below
+		Base::interlockedCompareExchange32(&m_flagWaking, 0, 1);
+		if (m_queueTasks.isNotEmpty() || m_queueInstancesOrder.isNotEmpty() || m_queueInstancesClosing.isNotEmpty()) {
+			return 0;
+		}
+		if (m_timers.isNotNull()) {
+			sl_int32 timeout = m_timers->getTimeout(System::getTickCount64());
+			if (timeout >= 0 && timeout < ASYNC_MAX_WAIT_TIMEOUT) {
+				return timeout;
+			}
+		}
+		return ASYNC_MAX_WAIT_TIMEOUT;
+	}
+
+/*************************************
+		AsyncIoLoopGroup
+**************************************/
+
+	SLIB_DEFINE_OBJECT(AsyncIoLoopGroup, Object)
+
+	AsyncIoLoopGroup::AsyncIoLoopGroup()
+	{
+		m_indexNext = 0;
+		m_flagRunning = sl_false;
+	}
+
+	AsyncIoLoopGroup::~AsyncIoLoopGroup()
+	{
+		release();
+	}
+
+	Ref<AsyncIoLoopGroup> AsyncIoLoopGroup::create(sl_uint32 nLoops, sl_bool flagAutoStart, sl_bool flagUseIoUring)
+	{
+		if (!nLoops) {
+			nLoops = System::getProcessorsCount();
+			if (!nLoops) {
+				nLoops = 1;
+			}
+		}
+		Ref<AsyncIoLoopGroup> ret = new AsyncIoLoopGroup;
+		if (ret.isNull()) {
+			return sl_null;
+		}
+		for (sl_uint32 i = 0; i < nLoops; i++) {
+			Ref<AsyncIoLoop> loop = AsyncIoLoop::create(sl_false, flagUseIoUring);
+			if (loop.isNull()) {
+				return sl_null;
+			}
+			if (!(ret->m_loops.add_NoLock(loop))) {
+				return sl_null;
+			}
+		}
+		if (flagAutoStart) {
+			ret->start();
+		}
+		return ret;
+	}
+
+	void AsyncIoLoopGroup::release()
+	{
+		ObjectLocker lock(this);
+		m_flagRunning = sl_false;
+		ListElements< Ref<AsyncIoLoop> > loops(m_loops);
+		for (sl_size i = 0; i < loops.count; i++) {
+			loops[i]->release();
+		}
+	}
+
+	void AsyncIoLoopGroup::start()
+	{
+		ObjectLocker lock(this);
+		if (m_flagRunning) {
+			return;
+		}
+		m_flagRunning = sl_true;
+		ListElements< Ref<AsyncIoLoop> > loops(m_loops);
+		for (sl_size i = 0; i < loops.count; i++) {
+			loops[i]->start();
+		}
+	}
+
+	sl_bool AsyncIoLoopGroup::isRunning()
+	{
+		return m_flagRunning;
+	}
+
+	sl_uint32 AsyncIoLoopGroup::getLoopsCount()
+	{
+		return (sl_uint32)(m_loops.getCount());
+	}
+
+	Ref<AsyncIoLoop> AsyncIoLoopGroup::getLoop(sl_uint32 index)
+	{
+		// the list is not modified after creation
+		return m_loops.getValueAt_NoLock(index);
+	}
+
+	Ref<AsyncIoLoop> AsyncIoLoopGroup::getNextLoop()
+	{
+		sl_uint32 n = (sl_uint32)(m_loops.getCount());
+		if (!n) {
+			return sl_null;
+		}
+		sl_uint32 index = (sl_uint32)(Base::interlockedIncrement32((sl_int32*)&m_indexNext));
+		return m_loops.getValueAt_NoLock(index % n);
+	}
+
 /*************************************
 		AsyncIoInstance
 **************************************/
@@ -396,7 +584,7 @@ namespace slib
 		Referable* _userObject,
 		const Function<void(AsyncStreamResult&)>& _callback,
 		sl_bool _flagRead)
-	 : data((void*)_data), size(_size), userObject(_userObject), callback(_callback), flagRead(_flagRead)
+	 : data((void*)_data), size(_size), userObject(_userObject), callback(_callback), flagRead(_flagRead), file(SLIB_FILE_INVALID_HANDLE), fileOffset(0)
 	{
 	}
 	
@@ -428,6 +616,24 @@ namespace slib
 		return new AsyncStreamRequest(data, size, userObject, callback, sl_false);
 	}
 
+	Ref<AsyncStreamRequest> AsyncStreamRequest::createSendFile(
+		sl_file file,
+		sl_uint64 offset,
+		sl_uint32 size,
+		Referable* userObject,
+		const Function<void(AsyncStreamResult&)>& callback)
+	{
+		if (!size || file == SLIB_FILE_INVALID_HANDLE) {
+			return sl_null;
+		}
+		Ref<AsyncStreamRequest> ret = new AsyncStreamRequest(sl_null, size, userObject, callback, sl_false);
+		if (ret.isNotNull()) {
+			ret->file = file;
+			ret->fileOffset = offset;
+		}
+		return ret;
+	}
+
 	void AsyncStreamRequest::runCallback(AsyncStream* stream, sl_uint32 resultSize, sl_bool flagError)
 	{
 		if (callback.isNotNull()) {
@@ -473,6 +679,16 @@ namespace slib
 		return sl_false;
 	}
 
+	sl_bool AsyncStreamInstance::sendFile(sl_file file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		return sl_false;
+	}
+
+	sl_bool AsyncStreamInstance::isSupportingSendFile()
+	{
+		return sl_false;
+	}
+
 	sl_bool AsyncStreamInstance::isSeekable()
 	{
 		return sl_false;
@@ -582,6 +798,16 @@ namespace slib
 		return 0;
 	}
 
+	sl_bool AsyncStream::sendFile(File* file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback)
+	{
+		return sl_false;
+	}
+
+	sl_bool AsyncStream::isSupportingSendFile()
+	{
+		return sl_false;
+	}
+
 	sl_bool AsyncStream::readToMemory(const Memory& mem, const Function<void(AsyncStreamResult&)>& callback)
 	{
 		sl_size size = mem.getSize();
@@ -682,6 +908,34 @@ namespace slib
 		return sl_false;
 	}
 
+	sl_bool AsyncStreamBase::sendFile(File* file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback)
+	{
+		if (!file) {
+			return sl_false;
+		}
+		Ref<AsyncIoLoop> loop = getIoLoop();
+		if (loop.isNull()) {
+			return sl_false;
+		}
+		Ref<AsyncStreamInstance> instance = getIoInstance();
+		if (instance.isNotNull()) {
+			if (instance->sendFile(file->getHandle(), offset, size, callback, file)) {
+				loop->requestOrder(instance.get());
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+
+	sl_bool AsyncStreamBase::isSupportingSendFile()
+	{
+		Ref<AsyncStreamInstance> instance = getIoInstance();
+		if (instance.isNotNull()) {
+			return instance->isSupportingSendFile();
+		}
+		return sl_false;
+	}
+
 	sl_bool AsyncStreamBase::isSeekable()
 	{
 		Ref<AsyncStreamInstance> instance = getIoInstance();
@@ -1461,18 +1715,29 @@ namespace slib
 	AsyncOutputBufferElement::AsyncOutputBufferElement()
 	{
 		m_sizeBody = 0;
+		m_offsetBodyFile = 0;
 	}
 
 	AsyncOutputBufferElement::AsyncOutputBufferElement(const Memory& header)
 	{
 		m_header.add(header);
 		m_sizeBody = 0;
+		m_offsetBodyFile = 0;
 	}
 
 	AsyncOutputBufferElement::AsyncOutputBufferElement(AsyncStream* stream, sl_uint64 size)
 	{
 		m_body = stream;
 		m_sizeBody = size;
+		m_offsetBodyFile = 0;
+	}
+
+	AsyncOutputBufferElement::AsyncOutputBufferElement(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher)
+	{
+		m_sizeBody = size;
+		m_bodyFile = file;
+		m_offsetBodyFile = offset;
+		m_dispatcherBodyFile = dispatcher;
 	}
 	
 	AsyncOutputBufferElement::~AsyncOutputBufferElement()
@@ -1481,7 +1746,7 @@ namespace slib
 
 	sl_bool AsyncOutputBufferElement::isEmpty() const
 	{
-		if (m_header.getSize() == 0 && (m_sizeBody == 0 || m_body.isNull())) {
+		if (m_header.getSize() == 0 && isEmptyBody()) {
 			return sl_true;
 		}
 		return sl_false;
@@ -1489,7 +1754,7 @@ namespace slib
 
 	sl_bool AsyncOutputBufferElement::isEmptyBody() const
 	{
-		if (m_sizeBody == 0 || m_body.isNull()) {
+		if (m_sizeBody == 0 || (m_body.isNull() && m_bodyFile.isNull())) {
 			return sl_true;
 		}
 		return sl_false;
@@ -1506,6 +1771,14 @@ namespace slib
 		m_sizeBody = size;
 	}
 
+	void AsyncOutputBufferElement::setBodyFile(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher)
+	{
+		m_bodyFile = file;
+		m_offsetBodyFile = offset;
+		m_dispatcherBodyFile = dispatcher;
+		m_sizeBody = size;
+	}
+
 	MemoryQueue& AsyncOutputBufferElement::getHeader()
 	{
 		return m_header;
@@ -1521,6 +1794,21 @@ namespace slib
 		return m_sizeBody;
 	}
 
+	Ref<File> AsyncOutputBufferElement::getBodyFile()
+	{
+		return m_bodyFile;
+	}
+
+	sl_uint64 AsyncOutputBufferElement::getBodyFileOffset()
+	{
+		return m_offsetBodyFile;
+	}
+
+	Ref<Dispatcher> AsyncOutputBufferElement::getBodyFileDispatcher()
+	{
+		return m_dispatcherBodyFile;
+	}
+
 
 /**********************************************
 		AsyncOutputBuffer
@@ -1636,6 +1924,34 @@ namespace slib
 		return sl_true;
 	}
 
+	sl_bool AsyncOutputBuffer::sendFileRegion(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher)
+	{
+		if (size == 0) {
+			return sl_true;
+		}
+		if (file.isNull()) {
+			return sl_false;
+		}
+		ObjectLocker lock(this);
+		Link< Ref<AsyncOutputBufferElement> >* link = m_queueOutput.getBack();
+		if (link && link->value->isEmptyBody()) {
+			link->value->setBodyFile(file, offset, size, dispatcher);
+			m_lengthOutput += size;
+		} else {
+			Ref<AsyncOutputBufferElement> data = new AsyncOutputBufferElement(file, offset, size, dispatcher);
+			if (data.isNotNull()) {
+				if (m_queueOutput.push(data)) {
+					m_lengthOutput += size;
+				} else {
+					return sl_false;
+				}
+			} else {
+				return sl_false;
+			}
+		}
+		return sl_true;
+	}
+
 	sl_uint64 AsyncOutputBuffer::getOutputLength() const
 	{
 		return m_lengthOutput;
@@ -1659,6 +1975,8 @@ namespace slib
 	{
 		m_flagClosed = sl_false;
 		m_flagWriting = sl_false;
+		m_offsetFileSending = 0;
+		m_sizeFileSending = 0;
 
 		m_bufferCount = 1;
 		m_bufferSize = 0x10000;
@@ -1681,6 +1999,7 @@ namespace slib
 			copy->close();
 		}
 		m_copy.setNull();
+		m_fileSending.setNull();
 		m_streamOutput.setNull();
 	}
 
@@ -1754,25 +2073,61 @@ namespace slib
 		} else {
 			sl_uint64 sizeBody = m_elementWriting->getBodySize();
 			Ref<AsyncStream> body = m_elementWriting->getBody();
-			if (sizeBody != 0 && body.isNotNull()) {
+			Ref<File> file = m_elementWriting->getBodyFile();
+			if (sizeBody != 0 && file.isNotNull()) {
+				sl_uint64 offset = m_elementWriting->getBodyFileOffset();
+				Ref<Dispatcher> dispatcher = m_elementWriting->getBodyFileDispatcher();
 				m_flagWriting = sl_true;
 				m_elementWriting.setNull();
-				AsyncCopyParam param;
-				param.source = body;
-				param.target = m_streamOutput;
-				param.size = sizeBody;
-				param.bufferSize = m_bufferSize;
-				param.bufferCount = m_bufferCount;
-				param.onEnd = SLIB_FUNCTION_WEAKREF(AsyncOutput, onAsyncCopyEnd, this);
-				Ref<AsyncCopy> copy = AsyncCopy::create(param);
-				if (copy.isNotNull()) {
-					m_copy = copy;
-				} else {
+				m_fileSending = file;
+				m_offsetFileSending = offset;
+				m_sizeFileSending = sizeBody;
+				if (_sendFile()) {
+					return;
+				}
+				// the output stream does not support `sendFile`
+				m_fileSending.setNull();
+				body = AsyncFile::create(file, dispatcher);
+				if (body.isNull() || !(body->seek(offset))) {
 					m_flagWriting = sl_false;
 					_onError();
+					return;
 				}
 			}
+			if (sizeBody != 0 && body.isNotNull()) {
+				m_flagWriting = sl_true;
+				m_elementWriting.setNull();
+				_copyBody(body, sizeBody);
+			}
+		}
+	}
+
+	void AsyncOutput::_copyBody(const Ref<AsyncStream>& body, sl_uint64 size)
+	{
+		AsyncCopyParam param;
+		param.source = body;
+		param.target = m_streamOutput;
+		param.size = size;
+		param.bufferSize = m_bufferSize;
+		param.bufferCount = m_bufferCount;
+		param.onEnd = SLIB_FUNCTION_WEAKREF(AsyncOutput, onAsyncCopyEnd, this);
+		Ref<AsyncCopy> copy = AsyncCopy::create(param);
+		if (copy.isNotNull()) {
+			m_copy = copy;
+		} else {
+			m_flagWriting = sl_false;
+			_onError();
+		}
+	}
+
+	sl_bool AsyncOutput::_sendFile()
+	{
+		sl_uint64 size = m_sizeFileSending;
+		// keeps each request in the 32-bit size of `AsyncStreamRequest`
+		if (size > 0x40000000) {
+			size = 0x40000000;
 		}
+		return m_streamOutput->sendFile(m_fileSending.get(), m_offsetFileSending, (sl_uint32)size, SLIB_FUNCTION_WEAKREF(AsyncOutput, onSendFile, this));
 	}
 
 	void AsyncOutput::onAsyncCopyEnd(AsyncCopy* task, sl_bool flagError)
@@ -1795,6 +2150,37 @@ namespace slib
 		_write(sl_true);
 	}
 
+	void AsyncOutput::onSendFile(AsyncStreamResult& result)
+	{
+		ObjectLocker lock(this);
+		if (m_flagClosed) {
+			return;
+		}
+		if (result.flagError || result.size != result.requestSize) {
+			m_flagWriting = sl_false;
+			m_fileSending.setNull();
+			lock.unlock();
+			_onError();
+			return;
+		}
+		m_offsetFileSending += result.size;
+		m_sizeFileSending -= result.size;
+		if (m_sizeFileSending) {
+			if (_sendFile()) {
+				return;
+			}
+			m_flagWriting = sl_false;
+			m_fileSending.setNull();
+			lock.unlock();
+			_onError();
+			return;
+		}
+		m_flagWriting = sl_false;
+		m_fileSending.setNull();
+		lock.unlock();
+		_write(sl_true);
+	}
+
 	void AsyncOutput::_onError()
 	{
 		m_onEnd(this, sl_true);
@@ -31,6 +31,11 @@
 #define ASYNC_USE_KQUEUE
 #elif defined(SLIB_PLATFORM_IS_LINUX)
 #define ASYNC_USE_EPOLL
+#if defined(SLIB_PLATFORM_IS_DESKTOP) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ASYNC_USE_IO_URING
+#endif
+#endif
 #elif defined(SLIB_PLATFORM_IS_FREEBSD)
 #define ASYNC_USE_KEVENT
 #endif
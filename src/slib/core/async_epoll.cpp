@@ -25,10 +25,10 @@
 #if defined(ASYNC_USE_EPOLL)
 
 #include "slib/core/async.h"
-#include "slib/core/pipe.h"
 
 #include <unistd.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/errno.h>
 
 #if defined(SLIB_PLATFORM_IS_ANDROID)
@@ -45,7 +45,7 @@ namespace slib
 			struct AsyncIoLoopHandle
 			{
 				int fdEpoll;
-				Ref<PipeEvent> eventWake;
+				int fdWake; // eventfd
 			};
 		}
 	}
@@ -54,32 +54,33 @@ namespace slib
 
 	void* AsyncIoLoop::_native_createHandle()
 	{
-		Ref<PipeEvent> pipe = PipeEvent::create();
-		if (pipe.isNull()) {
+		int fdWake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (fdWake < 0) {
 			return 0;
 		}
 		int fdEpoll;
 #if defined(EPOLL_LOW)
 		fdEpoll = ::epoll_create(1024);
 #else
-		fdEpoll = ::epoll_create1(0);
+		fdEpoll = ::epoll_create1(EPOLL_CLOEXEC);
 #endif
 		if (fdEpoll >= 0) {
 			AsyncIoLoopHandle* handle = new AsyncIoLoopHandle;
 			if (handle) {
 				handle->fdEpoll = fdEpoll;
-				handle->eventWake = pipe;
+				handle->fdWake = fdWake;
 				// register wake event
 				epoll_event ev;
 				ev.data.ptr = sl_null;
-				ev.events = EPOLLIN | EPOLLPRI | EPOLLET;
-				if (0 == epoll_ctl(fdEpoll, EPOLL_CTL_ADD, (int)(pipe->getReadPipeHandle()), &ev)) {
+				ev.events = EPOLLIN | EPOLLET;
+				if (0 == epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fdWake, &ev)) {
 					return handle;
 				}
 				delete handle;
 			}
 			::close(fdEpoll);
 		}
+		::close(fdWake);
 		return 0;
 	}
 
@@ -87,6 +88,7 @@ namespace slib
 	{
 		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)_handle;
 		::close(handle->fdEpoll);
+		::close(handle->fdWake);
 		delete handle;
 	}
 
@@ -100,7 +102,7 @@ namespace slib
 
 			_stepBegin();
 
-			int nEvents = ::epoll_wait(handle->fdEpoll, waitEvents, ASYNC_MAX_WAIT_EVENT, 5000);
+			int nEvents = ::epoll_wait(handle->fdEpoll, waitEvents, ASYNC_MAX_WAIT_EVENT, _getTimeout());
 			if (m_queueInstancesClosed.isNotEmpty()) {
 				m_queueInstancesClosed.removeAll();
 			}
@@ -117,6 +119,8 @@ namespace slib
 				if (instance) {
 					if (!(instance->isClosing())) {
 						AsyncIoInstance::EventDesc desc;
+						desc.pOperation = sl_null;
+						desc.result = 0;
 						desc.flagIn = sl_false;
 						desc.flagOut = sl_false;
 						desc.flagError = sl_false;
@@ -137,7 +141,9 @@ namespace slib
 						instance->onEvent(&desc);
 					}
 				} else {
-					handle->eventWake->reset();
+					sl_uint64 n;
+					ssize_t nRead = ::read(handle->fdWake, &n, sizeof(n));
+					SLIB_UNUSED(nRead);
 				}
 			}
 
@@ -150,12 +156,21 @@ namespace slib
 
 	void AsyncIoLoop::_native_wake()
 	{
+		if (m_flagIoUring) {
+			_uring_wake();
+			return;
+		}
 		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
-		handle->eventWake->set();
+		sl_uint64 n = 1;
+		ssize_t nWritten = ::write(handle->fdWake, &n, sizeof(n));
+		SLIB_UNUSED(nWritten);
 	}
 
 	sl_bool AsyncIoLoop::_native_attachInstance(AsyncIoInstance* instance, AsyncIoMode mode)
 	{
+		if (m_flagIoUring) {
+			return _uring_attachInstance(instance, mode);
+		}
 		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
 		int hObject = (int)(instance->getHandle());
 		epoll_event ev;
@@ -190,6 +205,10 @@ namespace slib
 
 	void AsyncIoLoop::_native_detachInstance(AsyncIoInstance* instance)
 	{
+		if (m_flagIoUring) {
+			_uring_detachInstance(instance);
+			return;
+		}
 		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
 		int hObject = (int)(instance->getHandle());
 		epoll_event ev;
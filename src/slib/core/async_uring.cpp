@@ -0,0 +1,771 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#include "async_config.h"
+
+#if defined(ASYNC_USE_EPOLL)
+
+#include "slib/core/async.h"
+
+#if defined(ASYNC_USE_IO_URING)
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+// needs the kernel headers of Linux 5.19 or later (`IORING_ASYNC_CANCEL_ANY`), otherwise only epoll is used
+#if !defined(IORING_ASYNC_CANCEL_ANY) || !defined(__NR_io_uring_enter)
+#undef ASYNC_USE_IO_URING
+#endif
+#endif
+
+#if defined(ASYNC_USE_IO_URING)
+
+#include "slib/core/queue.h"
+
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <endian.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+
+#define URING_ENTRIES 256
+#define URING_USER_DATA_WAKE 0
+#define URING_USER_DATA_IGNORE 1
+
+namespace slib
+{
+
+	namespace priv
+	{
+		namespace async_uring
+		{
+
+			struct Operation
+			{
+				Ref<AsyncIoInstance> instance;
+				AsyncIoOperation* op; // `null` for the readiness polls of the generic instances
+				sl_uint32 pollMask;
+			};
+
+			class AsyncIoLoopHandle
+			{
+			public:
+				int fdRing;
+				int fdWake; // eventfd
+				sl_uint64 valueWake;
+
+				sl_uint32* sqHead;
+				sl_uint32* sqTail;
+				sl_uint32 sqMask;
+				sl_uint32 sqEntries;
+				io_uring_sqe* sqes;
+				sl_uint32 sqTailLocal;
+				sl_size nOperations; // operations owned by the kernel
+
+				sl_uint32* cqHead;
+				sl_uint32* cqTail;
+				sl_uint32 cqMask;
+				io_uring_cqe* cqes;
+
+				void* mapRing;
+				sl_size sizeMapRing;
+				void* mapCq;
+				sl_size sizeMapCq;
+				void* mapSqes;
+				sl_size sizeMapSqes;
+
+				// polls attached from any thread, armed on the loop thread
+				LinkedQueue<Operation*> queueAttach;
+
+			public:
+				AsyncIoLoopHandle()
+				{
+					fdRing = -1;
+					fdWake = -1;
+					valueWake = 0;
+					sqTailLocal = 0;
+					nOperations = 0;
+					mapRing = MAP_FAILED;
+					mapCq = MAP_FAILED;
+					mapSqes = MAP_FAILED;
+				}
+
+				~AsyncIoLoopHandle()
+				{
+					Operation* op;
+					while (queueAttach.pop(&op)) {
+						delete op;
+					}
+					if (mapSqes != MAP_FAILED) {
+						::munmap(mapSqes, sizeMapSqes);
+					}
+					if (mapCq != MAP_FAILED) {
+						::munmap(mapCq, sizeMapCq);
+					}
+					if (mapRing != MAP_FAILED) {
+						::munmap(mapRing, sizeMapRing);
+					}
+					if (fdRing >= 0) {
+						::close(fdRing);
+					}
+					if (fdWake >= 0) {
+						::close(fdWake);
+					}
+				}
+
+			public:
+				sl_bool initialize()
+				{
+					fdWake = ::eventfd(0, EFD_CLOEXEC);
+					if (fdWake < 0) {
+						return sl_false;
+					}
+					io_uring_params params;
+					Base::zeroMemory(&params, sizeof(params));
+					params.flags = IORING_SETUP_CLAMP;
+					fdRing = (int)(::syscall(__NR_io_uring_setup, URING_ENTRIES, &params));
+					if (fdRing < 0) {
+						return sl_false;
+					}
+					// waiting with timeout needs `IORING_ENTER_EXT_ARG` (5.11)
+					if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP)) {
+						return sl_false;
+					}
+					sizeMapRing = params.sq_off.array + params.sq_entries * sizeof(sl_uint32);
+					sizeMapCq = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+					if (params.features & IORING_FEAT_SINGLE_MMAP) {
+						if (sizeMapCq > sizeMapRing) {
+							sizeMapRing = sizeMapCq;
+						}
+					}
+					mapRing = ::mmap(sl_null, sizeMapRing, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fdRing, IORING_OFF_SQ_RING);
+					if (mapRing == MAP_FAILED) {
+						return sl_false;
+					}
+					char* ringCq;
+					if (params.features & IORING_FEAT_SINGLE_MMAP) {
+						ringCq = (char*)mapRing;
+					} else {
+						mapCq = ::mmap(sl_null, sizeMapCq, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fdRing, IORING_OFF_CQ_RING);
+						if (mapCq == MAP_FAILED) {
+							return sl_false;
+						}
+						ringCq = (char*)mapCq;
+					}
+					sizeMapSqes = params.sq_entries * sizeof(io_uring_sqe);
+					mapSqes = ::mmap(sl_null, sizeMapSqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fdRing, IORING_OFF_SQES);
+					if (mapSqes == MAP_FAILED) {
+						return sl_false;
+					}
+					char* ringSq = (char*)mapRing;
+					sqHead = (sl_uint32*)(ringSq + params.sq_off.head);
+					sqTail = (sl_uint32*)(ringSq + params.sq_off.tail);
+					sqMask = *((sl_uint32*)(ringSq + params.sq_off.ring_mask));
+					sqEntries = *((sl_uint32*)(ringSq + params.sq_off.ring_entries));
+					sl_uint32* sqArray = (sl_uint32*)(ringSq + params.sq_off.array);
+					for (sl_uint32 i = 0; i < sqEntries; i++) {
+						sqArray[i] = i;
+					}
+					sqes = (io_uring_sqe*)mapSqes;
+					sqTailLocal = *sqTail;
+					cqHead = (sl_uint32*)(ringCq + params.cq_off.head);
+					cqTail = (sl_uint32*)(ringCq + params.cq_off.tail);
+					cqMask = *((sl_uint32*)(ringCq + params.cq_off.ring_mask));
+					cqes = (io_uring_cqe*)(ringCq + params.cq_off.cqes);
+
+					// canceling by file descriptor (5.19) is used to detach the instances. Probes it with the wake handle
+					io_uring_sqe* sqe = getSqe();
+					sqe->opcode = IORING_OP_ASYNC_CANCEL;
+					sqe->fd = fdWake;
+					sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+					sqe->user_data = URING_USER_DATA_IGNORE;
+					if (enter(1, IORING_ENTER_GETEVENTS, sl_null) < 0) {
+						return sl_false;
+					}
+					sl_uint32 head = *cqHead;
+					if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+						return sl_false;
+					}
+					sl_int32 res = cqes[head & cqMask].res;
+					__atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+					if (res == -EINVAL) {
+						return sl_false;
+					}
+					prepareWake();
+					return sl_true;
+				}
+
+				io_uring_sqe* getSqe()
+				{
+					if (sqTailLocal - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+						// the submission queue is full
+						submit();
+						if (sqTailLocal - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+							return sl_null;
+						}
+					}
+					io_uring_sqe* sqe = sqes + (sqTailLocal & sqMask);
+					Base::zeroMemory(sqe, sizeof(io_uring_sqe));
+					sqTailLocal++;
+					return sqe;
+				}
+
+				int enter(sl_uint32 minComplete, sl_uint32 flags, io_uring_getevents_arg* arg)
+				{
+					__atomic_store_n(sqTail, sqTailLocal, __ATOMIC_RELEASE);
+					sl_uint32 nSubmit = sqTailLocal - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+					if (arg) {
+						flags |= IORING_ENTER_EXT_ARG;
+					}
+					int ret = (int)(::syscall(__NR_io_uring_enter, fdRing, nSubmit, minComplete, flags, arg, arg ? sizeof(io_uring_getevents_arg) : _NSIG / 8));
+					if (ret < 0) {
+						return -errno;
+					}
+					return ret;
+				}
+
+				void submit()
+				{
+					if (sqTailLocal != __atomic_load_n(sqHead, __ATOMIC_ACQUIRE)) {
+						enter(0, 0, sl_null);
+					}
+				}
+
+				// submits the prepared operations and waits for the completions within `timeout` milliseconds
+				void submitAndWait(sl_int32 timeout)
+				{
+					if (timeout > 0 && *cqHead == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+						__kernel_timespec ts;
+						ts.tv_sec = timeout / 1000;
+						ts.tv_nsec = (timeout % 1000) * 1000000;
+						io_uring_getevents_arg arg;
+						Base::zeroMemory(&arg, sizeof(arg));
+						arg.sigmask_sz = _NSIG / 8;
+						arg.ts = (sl_uint64)(sl_size)&ts;
+						enter(1, IORING_ENTER_GETEVENTS, &arg);
+					} else {
+						submit();
+					}
+				}
+
+				void prepareWake()
+				{
+					io_uring_sqe* sqe = getSqe();
+					if (sqe) {
+						sqe->opcode = IORING_OP_READ;
+						sqe->fd = fdWake;
+						sqe->addr = (sl_uint64)(sl_size)&valueWake;
+						sqe->len = sizeof(valueWake);
+						sqe->user_data = URING_USER_DATA_WAKE;
+					}
+				}
+
+				sl_bool preparePoll(Operation* op)
+				{
+					io_uring_sqe* sqe = getSqe();
+					if (sqe) {
+						sqe->opcode = IORING_OP_POLL_ADD;
+						sqe->fd = (int)(op->instance->getHandle());
+						sqe->len = IORING_POLL_ADD_MULTI;
+#if __BYTE_ORDER == __BIG_ENDIAN
+						sqe->poll32_events = (op->pollMask << 16) | (op->pollMask >> 16);
+#else
+						sqe->poll32_events = op->pollMask;
+#endif
+						sqe->user_data = (sl_uint64)(sl_size)op;
+						nOperations++;
+						return sl_true;
+					}
+					return sl_false;
+				}
+
+				sl_bool prepareOperation(Operation* op)
+				{
+					io_uring_sqe* sqe = getSqe();
+					if (!sqe) {
+						return sl_false;
+					}
+					AsyncIoOperation* desc = op->op;
+					sqe->fd = (int)(op->instance->getHandle());
+					sqe->addr = (sl_uint64)(sl_size)(desc->data);
+					sqe->len = desc->size;
+					switch (desc->code) {
+						case AsyncIoOperationCode::Read:
+							sqe->opcode = IORING_OP_READ;
+							sqe->off = desc->offset;
+							break;
+						case AsyncIoOperationCode::Write:
+							sqe->opcode = IORING_OP_WRITE;
+							sqe->off = desc->offset;
+							break;
+						case AsyncIoOperationCode::Receive:
+							sqe->opcode = IORING_OP_RECV;
+							break;
+						case AsyncIoOperationCode::Send:
+							sqe->opcode = IORING_OP_SEND;
+							sqe->msg_flags = MSG_NOSIGNAL;
+							break;
+						case AsyncIoOperationCode::Accept:
+							sqe->opcode = IORING_OP_ACCEPT;
+							sqe->addr = (sl_uint64)(sl_size)(desc->address);
+							sqe->addr2 = (sl_uint64)(sl_size)&(desc->addressLength);
+							sqe->len = 0;
+							sqe->accept_flags = SOCK_CLOEXEC;
+							break;
+						case AsyncIoOperationCode::Connect:
+							sqe->opcode = IORING_OP_CONNECT;
+							sqe->addr = (sl_uint64)(sl_size)(desc->address);
+							sqe->off = desc->addressLength;
+							sqe->len = 0;
+							break;
+						default:
+							// returns the unused entry as no-op
+							sqe->opcode = IORING_OP_NOP;
+							sqe->user_data = URING_USER_DATA_IGNORE;
+							return sl_false;
+					}
+					sqe->user_data = (sl_uint64)(sl_size)op;
+					nOperations++;
+					return sl_true;
+				}
+
+				void prepareCancel(int fd)
+				{
+					io_uring_sqe* sqe = getSqe();
+					if (sqe) {
+						sqe->opcode = IORING_OP_ASYNC_CANCEL;
+						sqe->fd = fd;
+						sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+						sqe->user_data = URING_USER_DATA_IGNORE;
+					}
+				}
+
+				// called when the loop is stopped: cancels all the operations and releases their instances.
+				// Waits until every operation is completed, because the kernel may still write to their buffers
+				void cancelAll()
+				{
+					Operation* op;
+					while (queueAttach.pop(&op)) {
+						delete op;
+					}
+					// the canceled operations complete soon, but the disk I/O can not be interrupted
+					sl_uint32 nWaits = 0;
+					while (nOperations) {
+						// repeats canceling every second, in case the submission queue was full
+						if (!(nWaits % 10)) {
+							io_uring_sqe* sqe = getSqe();
+							if (sqe) {
+								sqe->opcode = IORING_OP_ASYNC_CANCEL;
+								sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+								sqe->user_data = URING_USER_DATA_IGNORE;
+							}
+						}
+						nWaits++;
+						submitAndWait(100);
+						sl_uint32 head = *cqHead;
+						sl_uint32 tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+						while (head != tail) {
+							io_uring_cqe& cqe = cqes[head & cqMask];
+							if (cqe.user_data != URING_USER_DATA_WAKE && cqe.user_data != URING_USER_DATA_IGNORE) {
+								if (!(cqe.flags & IORING_CQE_F_MORE)) {
+									delete (Operation*)(sl_size)(cqe.user_data);
+									nOperations--;
+								}
+							}
+							head++;
+						}
+						__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+					}
+				}
+
+			};
+
+			class FileStreamInstance : public AsyncStreamInstance
+			{
+			public:
+				Ref<File> m_file;
+				sl_uint64 m_offset;
+				Ref<AsyncStreamRequest> m_requestOperating;
+				AsyncIoOperation m_operation;
+
+			public:
+				FileStreamInstance()
+				{
+					m_offset = 0;
+					Base::zeroMemory(&m_operation, sizeof(m_operation));
+				}
+
+				~FileStreamInstance()
+				{
+					close();
+				}
+
+			public:
+				static Ref<FileStreamInstance> open(const StringParam& path, FileMode mode)
+				{
+					Ref<File> file = File::open(path, mode);
+					if (file.isNotNull()) {
+						Ref<FileStreamInstance> ret = new FileStreamInstance;
+						if (ret.isNotNull()) {
+							ret->m_file = file;
+							ret->setHandle(file->getHandle());
+							if (mode & FileMode::SeekToEnd) {
+								ret->m_offset = file->getSize();
+							}
+							return ret;
+						}
+					}
+					return sl_null;
+				}
+
+				void close() override
+				{
+					setHandle(SLIB_FILE_INVALID_HANDLE);
+					m_file.setNull();
+				}
+
+				void onOrder() override
+				{
+					if (m_file.isNull() || m_requestOperating.isNotNull()) {
+						return;
+					}
+					Ref<AsyncIoLoop> loop = getLoop();
+					if (loop.isNull()) {
+						return;
+					}
+					Ref<AsyncStreamRequest> req;
+					if (popReadRequest(req)) {
+						if (req.isNotNull()) {
+							if (req->data && req->size) {
+								m_operation.code = AsyncIoOperationCode::Read;
+								process(loop.get(), req);
+							} else {
+								processResult(req.get(), req->size, sl_false);
+							}
+						}
+						return;
+					}
+					if (popWriteRequest(req)) {
+						if (req.isNotNull()) {
+							if (req->data && req->size) {
+								m_operation.code = AsyncIoOperationCode::Write;
+								process(loop.get(), req);
+							} else {
+								processResult(req.get(), req->size, sl_false);
+							}
+						}
+					}
+				}
+
+				void onEvent(EventDesc* pev) override
+				{
+					if (pev->pOperation != &m_operation) {
+						return;
+					}
+					Ref<AsyncStreamRequest> req = m_requestOperating;
+					m_requestOperating.setNull();
+					sl_int32 n = pev->result;
+					if (req.isNotNull()) {
+						if (n > 0) {
+							m_offset += n;
+							processResult(req.get(), n, sl_false);
+						} else {
+							processResult(req.get(), 0, sl_true);
+						}
+					}
+					requestOrder();
+				}
+
+				void process(AsyncIoLoop* loop, const Ref<AsyncStreamRequest>& req)
+				{
+					m_operation.data = req->data;
+					m_operation.size = req->size;
+					m_operation.offset = m_offset;
+					m_requestOperating = req;
+					if (!(loop->submitOperation(this, &m_operation))) {
+						m_requestOperating.setNull();
+						processResult(req.get(), 0, sl_true);
+					}
+				}
+
+				void processResult(AsyncStreamRequest* req, sl_uint32 size, sl_bool flagError)
+				{
+					Ref<AsyncIoObject> object = getObject();
+					if (object.isNotNull()) {
+						req->runCallback(static_cast<AsyncStream*>(object.get()), size, flagError);
+					}
+				}
+
+				sl_bool isSeekable() override
+				{
+					return sl_true;
+				}
+
+				sl_bool seek(sl_uint64 pos) override
+				{
+					m_offset = pos;
+					return sl_true;
+				}
+
+				sl_uint64 getSize() override
+				{
+					Ref<File> file = m_file;
+					if (file.isNotNull()) {
+						return file->getSize();
+					}
+					return 0;
+				}
+
+			};
+
+		}
+	}
+
+	using namespace priv::async_uring;
+
+	void* AsyncIoLoop::_uring_createHandle()
+	{
+		AsyncIoLoopHandle* handle = new AsyncIoLoopHandle;
+		if (handle) {
+			if (handle->initialize()) {
+				return handle;
+			}
+			delete handle;
+		}
+		return sl_null;
+	}
+
+	void AsyncIoLoop::_uring_closeHandle(void* handle)
+	{
+		delete (AsyncIoLoopHandle*)handle;
+	}
+
+	void AsyncIoLoop::_uring_runLoop()
+	{
+		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
+
+		while (m_flagRunning) {
+
+			_stepBegin();
+
+			{
+				Operation* op;
+				while (handle->queueAttach.pop(&op)) {
+					if (op->instance->isClosing() || !(handle->preparePoll(op))) {
+						delete op;
+					}
+				}
+			}
+
+			handle->submitAndWait(_getTimeout());
+
+			if (m_queueInstancesClosed.isNotEmpty()) {
+				m_queueInstancesClosed.removeAll();
+			}
+
+			sl_uint32 head = *(handle->cqHead);
+			sl_uint32 tail = __atomic_load_n(handle->cqTail, __ATOMIC_ACQUIRE);
+			while (head != tail) {
+				io_uring_cqe& cqe = handle->cqes[head & handle->cqMask];
+				sl_uint64 userData = cqe.user_data;
+				sl_int32 res = cqe.res;
+				sl_uint32 flags = cqe.flags;
+				head++;
+				// releases the entry before the callbacks, which may submit new operations
+				__atomic_store_n(handle->cqHead, head, __ATOMIC_RELEASE);
+				if (userData == URING_USER_DATA_WAKE) {
+					handle->prepareWake();
+				} else if (userData != URING_USER_DATA_IGNORE) {
+					Operation* op = (Operation*)(sl_size)userData;
+					AsyncIoInstance* instance = op->instance.get();
+					if (m_flagRunning && !(instance->isClosing())) {
+						AsyncIoInstance::EventDesc desc;
+						desc.pOperation = op->op;
+						desc.result = res;
+						if (op->op) {
+							desc.flagIn = sl_false;
+							desc.flagOut = sl_false;
+							desc.flagError = sl_false;
+						} else {
+							desc.flagIn = res > 0 && (res & (POLLIN | POLLPRI));
+							desc.flagOut = res > 0 && (res & POLLOUT);
+							desc.flagError = res < 0 || (res & (POLLERR | POLLHUP | POLLRDHUP));
+						}
+						instance->onEvent(&desc);
+					}
+					if (!(flags & IORING_CQE_F_MORE)) {
+						// the multishot poll can be terminated by the kernel (ex: overflow), so re-arms it
+						handle->nOperations--;
+						if (!(op->op) && m_flagRunning && res != -ECANCELED && !(instance->isClosing()) && handle->preparePoll(op)) {
+							// re-armed
+						} else {
+							delete op;
+						}
+					}
+				}
+				if (!m_flagRunning) {
+					break;
+				}
+				if (head == tail) {
+					tail = __atomic_load_n(handle->cqTail, __ATOMIC_ACQUIRE);
+				}
+			}
+
+			if (m_flagRunning) {
+				_stepEnd();
+			}
+		}
+
+		handle->cancelAll();
+	}
+
+	void AsyncIoLoop::_uring_wake()
+	{
+		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
+		sl_uint64 n = 1;
+		ssize_t nWritten = ::write(handle->fdWake, &n, sizeof(n));
+		SLIB_UNUSED(nWritten);
+	}
+
+	sl_bool AsyncIoLoop::_uring_attachInstance(AsyncIoInstance* instance, AsyncIoMode mode)
+	{
+		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
+		sl_uint32 mask;
+		switch (mode) {
+			case AsyncIoMode::In:
+				mask = POLLIN | POLLPRI | POLLRDHUP;
+				break;
+			case AsyncIoMode::Out:
+				mask = POLLOUT | POLLRDHUP;
+				break;
+			case AsyncIoMode::InOut:
+				mask = POLLIN | POLLPRI | POLLOUT | POLLRDHUP;
+				break;
+			default:
+				// completion-based instance (see `submitOperation()`)
+				return sl_true;
+		}
+		Operation* op = new Operation;
+		if (op) {
+			op->instance = instance;
+			op->op = sl_null;
+			op->pollMask = mask;
+			if (handle->queueAttach.push(op)) {
+				wake();
+				return sl_true;
+			}
+			delete op;
+		}
+		return sl_false;
+	}
+
+	void AsyncIoLoop::_uring_detachInstance(AsyncIoInstance* instance)
+	{
+		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
+		// cancels the pending operations before the handle is closed by the instance
+		handle->prepareCancel((int)(instance->getHandle()));
+		handle->submit();
+	}
+
+	sl_bool AsyncIoLoop::submitOperation(AsyncIoInstance* instance, AsyncIoOperation* _op)
+	{
+		if (!m_flagIoUring || !m_flagRunning) {
+			return sl_false;
+		}
+		if (!instance || !_op || instance->isClosing() || !(instance->isOpened())) {
+			return sl_false;
+		}
+		AsyncIoLoopHandle* handle = (AsyncIoLoopHandle*)m_handle;
+		Operation* op = new Operation;
+		if (op) {
+			op->instance = instance;
+			op->op = _op;
+			op->pollMask = 0;
+			if (handle->prepareOperation(op)) {
+				return sl_true;
+			}
+			delete op;
+		}
+		return sl_false;
+	}
+
+	Ref<AsyncStream> AsyncFile::openIoUring(const StringParam& path, FileMode mode, const Ref<AsyncIoLoop>& loop)
+	{
+		if (loop.isNull() || !(loop->isUsingIoUring())) {
+			return sl_null;
+		}
+		Ref<FileStreamInstance> instance = FileStreamInstance::open(path, mode);
+		if (instance.isNotNull()) {
+			return AsyncStream::create(instance.get(), AsyncIoMode::None, loop);
+		}
+		return sl_null;
+	}
+
+}
+
+#else
+
+namespace slib
+{
+
+	void* AsyncIoLoop::_uring_createHandle()
+	{
+		return sl_null;
+	}
+
+	void AsyncIoLoop::_uring_closeHandle(void* handle)
+	{
+	}
+
+	void AsyncIoLoop::_uring_runLoop()
+	{
+	}
+
+	sl_bool AsyncIoLoop::_uring_attachInstance(AsyncIoInstance* instance, AsyncIoMode mode)
+	{
+		return sl_false;
+	}
+
+	void AsyncIoLoop::_uring_detachInstance(AsyncIoInstance* instance)
+	{
+	}
+
+	void AsyncIoLoop::_uring_wake()
+	{
+	}
+
+	sl_bool AsyncIoLoop::submitOperation(AsyncIoInstance* instance, AsyncIoOperation* op)
+	{
+		return sl_false;
+	}
+
+	Ref<AsyncStream> AsyncFile::openIoUring(const StringParam& path, FileMode mode, const Ref<AsyncIoLoop>& loop)
+	{
+		return sl_null;
+	}
+
+}
+
+#endif
+
+#endif
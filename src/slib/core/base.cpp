@@ -24,6 +24,10 @@
 
 #include "slib/core/system.h"
 
+#if defined(SLIB_USE_SLAB_ALLOCATOR)
+#	include "slib/core/slab_allocator.h"
+#endif
+
 #if !defined(SLIB_PLATFORM_IS_APPLE)
 #	include <malloc.h>
 #endif
@@ -42,6 +46,25 @@
 #	define NOT_SUPPORT_ATOMIC_64BIT
 #endif
 
+#if defined(SLIB_ARCH_IS_X64)
+#	define SLIB_BASE_USE_SSE2
+#	define SLIB_BASE_USE_AVX2
+#	include "slib/core/asm.h"
+#	include <immintrin.h>
+#	if defined(SLIB_COMPILER_IS_GCC)
+#		define SLIB_BASE_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define SLIB_BASE_TARGET_AVX2
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64)
+#	define SLIB_BASE_USE_NEON
+#	include <arm_neon.h>
+#endif
+
+#if defined(SLIB_COMPILER_IS_VC)
+#	include <intrin.h>
+#endif
+
 namespace slib
 {
 	
@@ -56,6 +79,623 @@ namespace slib
 	typedef char32_t sl_base_char32;
 #endif
 
+	namespace priv
+	{
+		namespace base
+		{
+
+			SLIB_INLINE static sl_uint8 ToUpper(sl_uint8 c) noexcept
+			{
+				return (sl_uint8)(c - ((sl_uint8)(c - 'a') < 26 ? 0x20 : 0));
+			}
+
+			static sl_size GetEqualLengthIgnoreCase_Scalar(const sl_uint8* m1, const sl_uint8* m2, sl_size count) noexcept
+			{
+				for (sl_size i = 0; i < count; i++) {
+					if (ToUpper(m1[i]) != ToUpper(m2[i])) {
+						return i;
+					}
+				}
+				return count;
+			}
+
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+			SLIB_INLINE static sl_uint32 GetLowestBit(sl_uint32 n) noexcept
+			{
+#	if defined(SLIB_COMPILER_IS_VC)
+				unsigned long index;
+				_BitScanForward(&index, n);
+				return (sl_uint32)index;
+#	else
+				return (sl_uint32)(__builtin_ctz(n));
+#	endif
+			}
+
+			SLIB_INLINE static sl_uint32 GetHighestBit(sl_uint32 n) noexcept
+			{
+#	if defined(SLIB_COMPILER_IS_VC)
+				unsigned long index;
+				_BitScanReverse(&index, n);
+				return (sl_uint32)index;
+#	else
+				return (sl_uint32)(31 - __builtin_clz(n));
+#	endif
+			}
+
+			// `count` >= `countPattern` >= 2
+			SLIB_INLINE static sl_bool MatchPattern(const sl_uint8* m, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				return !(memcmp(m + 1, pattern + 1, countPattern - 2));
+			}
+#endif
+
+			/*
+				Vector kernels. They are called only for the blocks of 16 bytes or more
+				(the count of candidate positions for the pattern search),
+				the shorter inputs are processed by the scalar code in `Base`.
+				`n`: count of the candidate positions for the pattern search
+			*/
+
+#if defined(SLIB_BASE_USE_SSE2)
+			SLIB_INLINE static __m128i ToUpper_SSE2(__m128i v) noexcept
+			{
+				// 'a' -> -128, 'z' -> -103 (signed)
+				__m128i t = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'a')));
+				__m128i lower = _mm_cmplt_epi8(t, _mm_set1_epi8((char)(-128 + 26)));
+				return _mm_sub_epi8(v, _mm_and_si128(lower, _mm_set1_epi8(0x20)));
+			}
+
+			static sl_bool IsZero_SSE2(const sl_uint8* m, sl_size count) noexcept
+			{
+				__m128i zero = _mm_setzero_si128();
+				sl_size i = 0;
+				for (; i + 64 <= count; i += 64) {
+					__m128i v = _mm_or_si128(_mm_or_si128(_mm_loadu_si128((__m128i*)(m + i)), _mm_loadu_si128((__m128i*)(m + i + 16))), _mm_or_si128(_mm_loadu_si128((__m128i*)(m + i + 32)), _mm_loadu_si128((__m128i*)(m + i + 48))));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF) {
+						return sl_false;
+					}
+				}
+				for (; i + 16 <= count; i += 16) {
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i*)(m + i)), zero)) != 0xFFFF) {
+						return sl_false;
+					}
+				}
+				if (i < count) {
+					// overlapped last block
+					if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i*)(m + count - 16)), zero)) != 0xFFFF) {
+						return sl_false;
+					}
+				}
+				return sl_true;
+			}
+
+			static const sl_uint8* FindReverse_SSE2(const sl_uint8* m, sl_uint8 pattern, sl_size count) noexcept
+			{
+				__m128i p = _mm_set1_epi8((char)pattern);
+				sl_size i = count;
+				while (i >= 16) {
+					i -= 16;
+					sl_uint32 mask = (sl_uint32)(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i*)(m + i)), p)));
+					if (mask) {
+						return m + i + GetHighestBit(mask);
+					}
+				}
+				if (i) {
+					sl_uint32 mask = (sl_uint32)(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i*)m), p))) & ((1u << i) - 1);
+					if (mask) {
+						return m + GetHighestBit(mask);
+					}
+				}
+				return sl_null;
+			}
+
+			// filters the candidate positions by the first and the last bytes of the pattern
+			SLIB_INLINE static sl_uint32 GetPatternCandidates_SSE2(const sl_uint8* m, sl_size countPattern, __m128i first, __m128i last) noexcept
+			{
+				__m128i f = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i*)m), first);
+				__m128i l = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i*)(m + countPattern - 1)), last);
+				return (sl_uint32)(_mm_movemask_epi8(_mm_and_si128(f, l)));
+			}
+
+			static const sl_uint8* FindPattern_SSE2(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				__m128i first = _mm_set1_epi8((char)(pattern[0]));
+				__m128i last = _mm_set1_epi8((char)(pattern[countPattern - 1]));
+				sl_size i = 0;
+				for (;;) {
+					sl_uint32 mask;
+					if (i + 16 <= n) {
+						mask = GetPatternCandidates_SSE2(m + i, countPattern, first, last);
+					} else if (i < n) {
+						sl_uint32 skip = (sl_uint32)(i - (n - 16));
+						i = n - 16;
+						mask = GetPatternCandidates_SSE2(m + i, countPattern, first, last) & ~((1u << skip) - 1);
+					} else {
+						return sl_null;
+					}
+					while (mask) {
+						const sl_uint8* p = m + i + GetLowestBit(mask);
+						if (MatchPattern(p, pattern, countPattern)) {
+							return p;
+						}
+						mask &= mask - 1;
+					}
+					i += 16;
+				}
+			}
+
+			static const sl_uint8* FindPatternReverse_SSE2(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				__m128i first = _mm_set1_epi8((char)(pattern[0]));
+				__m128i last = _mm_set1_epi8((char)(pattern[countPattern - 1]));
+				sl_size i = n;
+				while (i) {
+					sl_uint32 mask;
+					if (i >= 16) {
+						i -= 16;
+						mask = GetPatternCandidates_SSE2(m + i, countPattern, first, last);
+					} else {
+						mask = GetPatternCandidates_SSE2(m, countPattern, first, last) & ((1u << i) - 1);
+						i = 0;
+					}
+					while (mask) {
+						sl_uint32 k = GetHighestBit(mask);
+						const sl_uint8* p = m + i + k;
+						if (MatchPattern(p, pattern, countPattern)) {
+							return p;
+						}
+						mask &= ~(1u << k);
+					}
+				}
+				return sl_null;
+			}
+
+			static sl_size GetEqualLengthIgnoreCase_SSE2(const sl_uint8* m1, const sl_uint8* m2, sl_size count) noexcept
+			{
+				sl_size i = 0;
+				for (;;) {
+					if (i + 16 > count) {
+						if (i < count) {
+							i = count - 16;
+						} else {
+							return count;
+						}
+					}
+					__m128i v1 = ToUpper_SSE2(_mm_loadu_si128((__m128i*)(m1 + i)));
+					__m128i v2 = ToUpper_SSE2(_mm_loadu_si128((__m128i*)(m2 + i)));
+					sl_uint32 mask = (sl_uint32)(_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2))) ^ 0xFFFF;
+					if (mask) {
+						return i + GetLowestBit(mask);
+					}
+					i += 16;
+				}
+			}
+#endif
+
+#if defined(SLIB_BASE_USE_AVX2)
+			SLIB_BASE_TARGET_AVX2 SLIB_INLINE static __m256i ToUpper_AVX2(__m256i v) noexcept
+			{
+				__m256i t = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'a')));
+				__m256i lower = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + 26)), t);
+				return _mm256_sub_epi8(v, _mm256_and_si256(lower, _mm256_set1_epi8(0x20)));
+			}
+
+			SLIB_BASE_TARGET_AVX2 static sl_bool IsZero_AVX2(const sl_uint8* m, sl_size count) noexcept
+			{
+				if (count < 32) {
+					return IsZero_SSE2(m, count);
+				}
+				sl_size i = 0;
+				for (; i + 128 <= count; i += 128) {
+					__m256i v = _mm256_or_si256(_mm256_or_si256(_mm256_loadu_si256((__m256i*)(m + i)), _mm256_loadu_si256((__m256i*)(m + i + 32))), _mm256_or_si256(_mm256_loadu_si256((__m256i*)(m + i + 64)), _mm256_loadu_si256((__m256i*)(m + i + 96))));
+					if (!(_mm256_testz_si256(v, v))) {
+						return sl_false;
+					}
+				}
+				for (; i + 32 <= count; i += 32) {
+					__m256i v = _mm256_loadu_si256((__m256i*)(m + i));
+					if (!(_mm256_testz_si256(v, v))) {
+						return sl_false;
+					}
+				}
+				if (i < count) {
+					__m256i v = _mm256_loadu_si256((__m256i*)(m + count - 32));
+					if (!(_mm256_testz_si256(v, v))) {
+						return sl_false;
+					}
+				}
+				return sl_true;
+			}
+
+			SLIB_BASE_TARGET_AVX2 static const sl_uint8* FindReverse_AVX2(const sl_uint8* m, sl_uint8 pattern, sl_size count) noexcept
+			{
+				if (count < 32) {
+					return FindReverse_SSE2(m, pattern, count);
+				}
+				__m256i p = _mm256_set1_epi8((char)pattern);
+				sl_size i = count;
+				while (i >= 32) {
+					i -= 32;
+					sl_uint32 mask = (sl_uint32)(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(m + i)), p)));
+					if (mask) {
+						return m + i + GetHighestBit(mask);
+					}
+				}
+				if (i) {
+					sl_uint32 mask = (sl_uint32)(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)m), p))) & ((1u << i) - 1);
+					if (mask) {
+						return m + GetHighestBit(mask);
+					}
+				}
+				return sl_null;
+			}
+
+			SLIB_BASE_TARGET_AVX2 SLIB_INLINE static sl_uint32 GetPatternCandidates_AVX2(const sl_uint8* m, sl_size countPattern, __m256i first, __m256i last) noexcept
+			{
+				__m256i f = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)m), first);
+				__m256i l = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(m + countPattern - 1)), last);
+				return (sl_uint32)(_mm256_movemask_epi8(_mm256_and_si256(f, l)));
+			}
+
+			SLIB_BASE_TARGET_AVX2 static const sl_uint8* FindPattern_AVX2(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				if (n < 32) {
+					return FindPattern_SSE2(m, n, pattern, countPattern);
+				}
+				__m256i first = _mm256_set1_epi8((char)(pattern[0]));
+				__m256i last = _mm256_set1_epi8((char)(pattern[countPattern - 1]));
+				sl_size i = 0;
+				for (;;) {
+					// skips the blocks without candidates, 64 bytes per step
+					while (i + 64 <= n) {
+						__m256i f0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(m + i)), first);
+						__m256i l0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(m + i + countPattern - 1)), last);
+						__m256i f1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(m + i + 32)), first);
+						__m256i l1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i*)(m + i + countPattern + 31)), last);
+						__m256i c = _mm256_or_si256(_mm256_and_si256(f0, l0), _mm256_and_si256(f1, l1));
+						if (!(_mm256_testz_si256(c, c))) {
+							break;
+						}
+						i += 64;
+					}
+					sl_uint32 mask;
+					if (i + 32 <= n) {
+						mask = GetPatternCandidates_AVX2(m + i, countPattern, first, last);
+					} else if (i < n) {
+						sl_uint32 skip = (sl_uint32)(i - (n - 32));
+						i = n - 32;
+						mask = GetPatternCandidates_AVX2(m + i, countPattern, first, last) & ~((1u << skip) - 1);
+					} else {
+						return sl_null;
+					}
+					while (mask) {
+						const sl_uint8* p = m + i + GetLowestBit(mask);
+						if (MatchPattern(p, pattern, countPattern)) {
+							return p;
+						}
+						mask &= mask - 1;
+					}
+					i += 32;
+				}
+			}
+
+			SLIB_BASE_TARGET_AVX2 static const sl_uint8* FindPatternReverse_AVX2(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				if (n < 32) {
+					return FindPatternReverse_SSE2(m, n, pattern, countPattern);
+				}
+				__m256i first = _mm256_set1_epi8((char)(pattern[0]));
+				__m256i last = _mm256_set1_epi8((char)(pattern[countPattern - 1]));
+				sl_size i = n;
+				while (i) {
+					sl_uint32 mask;
+					if (i >= 32) {
+						i -= 32;
+						mask = GetPatternCandidates_AVX2(m + i, countPattern, first, last);
+					} else {
+						mask = GetPatternCandidates_AVX2(m, countPattern, first, last) & ((1u << i) - 1);
+						i = 0;
+					}
+					while (mask) {
+						sl_uint32 k = GetHighestBit(mask);
+						const sl_uint8* p = m + i + k;
+						if (MatchPattern(p, pattern, countPattern)) {
+							return p;
+						}
+						mask &= ~(1u << k);
+					}
+				}
+				return sl_null;
+			}
+
+			SLIB_BASE_TARGET_AVX2 static sl_size GetEqualLengthIgnoreCase_AVX2(const sl_uint8* m1, const sl_uint8* m2, sl_size count) noexcept
+			{
+				if (count < 32) {
+					return GetEqualLengthIgnoreCase_SSE2(m1, m2, count);
+				}
+				sl_size i = 0;
+				for (;;) {
+					if (i + 32 > count) {
+						if (i < count) {
+							i = count - 32;
+						} else {
+							return count;
+						}
+					}
+					__m256i v1 = ToUpper_AVX2(_mm256_loadu_si256((__m256i*)(m1 + i)));
+					__m256i v2 = ToUpper_AVX2(_mm256_loadu_si256((__m256i*)(m2 + i)));
+					sl_uint32 mask = ~(sl_uint32)(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2)));
+					if (mask) {
+						return i + GetLowestBit(mask);
+					}
+					i += 32;
+				}
+			}
+#endif
+
+#if defined(SLIB_BASE_USE_NEON)
+			SLIB_INLINE static sl_uint32 ToMask_NEON(uint8x16_t m) noexcept
+			{
+				static const sl_uint8 bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+				uint8x16_t v = vandq_u8(m, vld1q_u8(bits));
+				return (sl_uint32)(vaddv_u8(vget_low_u8(v))) | ((sl_uint32)(vaddv_u8(vget_high_u8(v))) << 8);
+			}
+
+			SLIB_INLINE static uint8x16_t ToUpper_NEON(uint8x16_t v) noexcept
+			{
+				uint8x16_t lower = vcltq_u8(vsubq_u8(v, vdupq_n_u8('a')), vdupq_n_u8(26));
+				return vsubq_u8(v, vandq_u8(lower, vdupq_n_u8(0x20)));
+			}
+
+			static sl_bool IsZero_NEON(const sl_uint8* m, sl_size count) noexcept
+			{
+				sl_size i = 0;
+				for (; i + 64 <= count; i += 64) {
+					uint8x16_t v = vorrq_u8(vorrq_u8(vld1q_u8(m + i), vld1q_u8(m + i + 16)), vorrq_u8(vld1q_u8(m + i + 32), vld1q_u8(m + i + 48)));
+					if (vmaxvq_u8(v)) {
+						return sl_false;
+					}
+				}
+				for (; i + 16 <= count; i += 16) {
+					if (vmaxvq_u8(vld1q_u8(m + i))) {
+						return sl_false;
+					}
+				}
+				if (i < count) {
+					if (vmaxvq_u8(vld1q_u8(m + count - 16))) {
+						return sl_false;
+					}
+				}
+				return sl_true;
+			}
+
+			static const sl_uint8* FindReverse_NEON(const sl_uint8* m, sl_uint8 pattern, sl_size count) noexcept
+			{
+				uint8x16_t p = vdupq_n_u8(pattern);
+				sl_size i = count;
+				while (i >= 16) {
+					i -= 16;
+					uint8x16_t e = vceqq_u8(vld1q_u8(m + i), p);
+					if (vmaxvq_u8(e)) {
+						return m + i + GetHighestBit(ToMask_NEON(e));
+					}
+				}
+				if (i) {
+					sl_uint32 mask = ToMask_NEON(vceqq_u8(vld1q_u8(m), p)) & ((1u << i) - 1);
+					if (mask) {
+						return m + GetHighestBit(mask);
+					}
+				}
+				return sl_null;
+			}
+
+			SLIB_INLINE static sl_uint32 GetPatternCandidates_NEON(const sl_uint8* m, sl_size countPattern, uint8x16_t first, uint8x16_t last) noexcept
+			{
+				uint8x16_t f = vceqq_u8(vld1q_u8(m), first);
+				uint8x16_t l = vceqq_u8(vld1q_u8(m + countPattern - 1), last);
+				uint8x16_t c = vandq_u8(f, l);
+				if (vmaxvq_u8(c)) {
+					return ToMask_NEON(c);
+				}
+				return 0;
+			}
+
+			static const sl_uint8* FindPattern_NEON(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				uint8x16_t first = vdupq_n_u8(pattern[0]);
+				uint8x16_t last = vdupq_n_u8(pattern[countPattern - 1]);
+				sl_size i = 0;
+				for (;;) {
+					sl_uint32 mask;
+					if (i + 16 <= n) {
+						mask = GetPatternCandidates_NEON(m + i, countPattern, first, last);
+					} else if (i < n) {
+						sl_uint32 skip = (sl_uint32)(i - (n - 16));
+						i = n - 16;
+						mask = GetPatternCandidates_NEON(m + i, countPattern, first, last) & ~((1u << skip) - 1);
+					} else {
+						return sl_null;
+					}
+					while (mask) {
+						const sl_uint8* p = m + i + GetLowestBit(mask);
+						if (MatchPattern(p, pattern, countPattern)) {
+							return p;
+						}
+						mask &= mask - 1;
+					}
+					i += 16;
+				}
+			}
+
+			static const sl_uint8* FindPatternReverse_NEON(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept
+			{
+				uint8x16_t first = vdupq_n_u8(pattern[0]);
+				uint8x16_t last = vdupq_n_u8(pattern[countPattern - 1]);
+				sl_size i = n;
+				while (i) {
+					sl_uint32 mask;
+					if (i >= 16) {
+						i -= 16;
+						mask = GetPatternCandidates_NEON(m + i, countPattern, first, last);
+					} else {
+						mask = GetPatternCandidates_NEON(m, countPattern, first, last) & ((1u << i) - 1);
+						i = 0;
+					}
+					while (mask) {
+						sl_uint32 k = GetHighestBit(mask);
+						const sl_uint8* p = m + i + k;
+						if (MatchPattern(p, pattern, countPattern)) {
+							return p;
+						}
+						mask &= ~(1u << k);
+					}
+				}
+				return sl_null;
+			}
+
+			static sl_size GetEqualLengthIgnoreCase_NEON(const sl_uint8* m1, const sl_uint8* m2, sl_size count) noexcept
+			{
+				sl_size i = 0;
+				for (;;) {
+					if (i + 16 > count) {
+						if (i < count) {
+							i = count - 16;
+						} else {
+							return count;
+						}
+					}
+					uint8x16_t ne = vmvnq_u8(vceqq_u8(ToUpper_NEON(vld1q_u8(m1 + i)), ToUpper_NEON(vld1q_u8(m2 + i))));
+					if (vmaxvq_u8(ne)) {
+						return i + GetLowestBit(ToMask_NEON(ne));
+					}
+					i += 16;
+				}
+			}
+#endif
+
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+			struct Kernels
+			{
+				sl_bool (*isZero)(const sl_uint8* m, sl_size count) noexcept;
+				const sl_uint8* (*findReverse)(const sl_uint8* m, sl_uint8 pattern, sl_size count) noexcept;
+				const sl_uint8* (*findPattern)(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept;
+				const sl_uint8* (*findPatternReverse)(const sl_uint8* m, sl_size n, const sl_uint8* pattern, sl_size countPattern) noexcept;
+				sl_size (*getEqualLengthIgnoreCase)(const sl_uint8* m1, const sl_uint8* m2, sl_size count) noexcept;
+			};
+
+			static Kernels SelectKernels() noexcept
+			{
+				Kernels k;
+#	if defined(SLIB_BASE_USE_SSE2)
+#		if defined(SLIB_BASE_USE_AVX2)
+				if (CanUseAvx2()) {
+					k.isZero = IsZero_AVX2;
+					k.findReverse = FindReverse_AVX2;
+					k.findPattern = FindPattern_AVX2;
+					k.findPatternReverse = FindPatternReverse_AVX2;
+					k.getEqualLengthIgnoreCase = GetEqualLengthIgnoreCase_AVX2;
+					return k;
+				}
+#		endif
+				k.isZero = IsZero_SSE2;
+				k.findReverse = FindReverse_SSE2;
+				k.findPattern = FindPattern_SSE2;
+				k.findPatternReverse = FindPatternReverse_SSE2;
+				k.getEqualLengthIgnoreCase = GetEqualLengthIgnoreCase_SSE2;
+#	else
+				k.isZero = IsZero_NEON;
+				k.findReverse = FindReverse_NEON;
+				k.findPattern = FindPattern_NEON;
+				k.findPatternReverse = FindPatternReverse_NEON;
+				k.getEqualLengthIgnoreCase = GetEqualLengthIgnoreCase_NEON;
+#	endif
+				return k;
+			}
+
+			// selected once by the CPU features
+			static const Kernels& GetKernels() noexcept
+			{
+				static Kernels kernels = SelectKernels();
+				return kernels;
+			}
+#endif
+
+		}
+	}
+
+#if defined(SLIB_USE_SLAB_ALLOCATOR)
+	namespace priv
+	{
+		namespace base
+		{
+			// the requested size is stored in front of the block, because `freeMemory()` is not sized
+			static const sl_size g_sizeBlockPrefix = 16;
+
+			SLIB_INLINE static sl_size GetBlockSize(void* ptr) noexcept
+			{
+				return *((sl_size*)((sl_uint8*)ptr - g_sizeBlockPrefix));
+			}
+		}
+	}
+
+	void* Base::createMemory(sl_size size) noexcept
+	{
+		sl_size n = size + priv::base::g_sizeBlockPrefix;
+		if (n < size) {
+			return sl_null;
+		}
+		sl_uint8* block = (sl_uint8*)(SlabAllocator::allocateMemory(n));
+		if (block) {
+			*((sl_size*)block) = size;
+			return block + priv::base::g_sizeBlockPrefix;
+		}
+		return sl_null;
+	}
+
+	void Base::freeMemory(void* ptr) noexcept
+	{
+		if (ptr) {
+			sl_size size = priv::base::GetBlockSize(ptr);
+			SlabAllocator::freeMemory((sl_uint8*)ptr - priv::base::g_sizeBlockPrefix, size + priv::base::g_sizeBlockPrefix);
+		}
+	}
+
+	void* Base::reallocMemory(void* ptr, sl_size sizeNew) noexcept
+	{
+		if (!ptr) {
+			return createMemory(sizeNew);
+		}
+		sl_size sizeOld = priv::base::GetBlockSize(ptr);
+		if (sizeOld + priv::base::g_sizeBlockPrefix > SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE && sizeNew + priv::base::g_sizeBlockPrefix > SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE) {
+			// both are allocated by `malloc`
+			sl_size n = sizeNew + priv::base::g_sizeBlockPrefix;
+			if (n < sizeNew) {
+				return sl_null;
+			}
+			sl_uint8* block = (sl_uint8*)(realloc((sl_uint8*)ptr - priv::base::g_sizeBlockPrefix, n));
+			if (block) {
+				*((sl_size*)block) = sizeNew;
+				return block + priv::base::g_sizeBlockPrefix;
+			}
+			return sl_null;
+		}
+		void* ptrNew = createMemory(sizeNew);
+		if (ptrNew) {
+			memcpy(ptrNew, ptr, sizeOld < sizeNew ? sizeOld : sizeNew);
+			freeMemory(ptr);
+		}
+		return ptrNew;
+	}
+
+	void* Base::createZeroMemory(sl_size size) noexcept
+	{
+		void* ptr = createMemory(size);
+		if (ptr) {
+			memset(ptr, 0, size);
+		}
+		return ptr;
+	}
+#else
 	void* Base::createMemory(sl_size size) noexcept
 	{
 		return malloc(size);
@@ -84,6 +724,7 @@ namespace slib
 		}
 		return ptr;
 	}
+#endif
 
 	void Base::copyMemory(void* dst, const void* src, sl_size count) noexcept
 	{
@@ -213,6 +854,11 @@ namespace slib
 	sl_bool Base::equalsMemoryZero(const void* _m, sl_size count) noexcept
 	{
 		sl_uint8* m = (sl_uint8*)_m;
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+		if (count >= 16) {
+			return priv::base::GetKernels().isZero(m, count);
+		}
+#endif
 		for (sl_size i = 0; i < count; i++) {
 			if (m[i]) {
 				return sl_false;
@@ -381,6 +1027,35 @@ namespace slib
 		return 0;
 	}
 
+	sl_bool Base::equalsMemoryIgnoreCase(const void* mem1, const void* mem2, sl_size count) noexcept
+	{
+		const sl_uint8* m1 = (const sl_uint8*)mem1;
+		const sl_uint8* m2 = (const sl_uint8*)mem2;
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+		if (count >= 16) {
+			return priv::base::GetKernels().getEqualLengthIgnoreCase(m1, m2, count) == count;
+		}
+#endif
+		return priv::base::GetEqualLengthIgnoreCase_Scalar(m1, m2, count) == count;
+	}
+
+	sl_compare_result Base::compareMemoryIgnoreCase(const sl_uint8* m1, const sl_uint8* m2, sl_size count) noexcept
+	{
+		sl_size n;
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+		if (count >= 16) {
+			n = priv::base::GetKernels().getEqualLengthIgnoreCase(m1, m2, count);
+		} else
+#endif
+		{
+			n = priv::base::GetEqualLengthIgnoreCase_Scalar(m1, m2, count);
+		}
+		if (n < count) {
+			return priv::base::ToUpper(m1[n]) < priv::base::ToUpper(m2[n]) ? -1 : 1;
+		}
+		return 0;
+	}
+
 	const sl_uint8* Base::findMemory(const void* mem, sl_uint8 pattern, sl_size count) noexcept
 	{		
 		return (const sl_uint8*)(memchr(mem, pattern, count));
@@ -424,6 +1099,11 @@ namespace slib
 	const sl_uint8* Base::findMemoryReverse(const void* mem, sl_uint8 pattern, sl_size count) noexcept
 	{
 		sl_uint8* m = (sl_uint8*)mem;
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+		if (count >= 16) {
+			return priv::base::GetKernels().findReverse(m, pattern, count);
+		}
+#endif
 		for (sl_reg i = count - 1; i >= 0; i--) {
 			if (m[i] == pattern) {
 				return m + i;
@@ -494,6 +1174,71 @@ namespace slib
 		return sl_null;
 	}
 
+	const sl_uint8* Base::findMemory(const void* _mem, sl_size count, const void* _pattern, sl_size countPattern) noexcept
+	{
+		const sl_uint8* mem = (const sl_uint8*)_mem;
+		const sl_uint8* pattern = (const sl_uint8*)_pattern;
+		if (!countPattern) {
+			return mem;
+		}
+		if (count < countPattern) {
+			return sl_null;
+		}
+		if (countPattern == 1) {
+			return findMemory(mem, pattern[0], count);
+		}
+		sl_size n = count - countPattern + 1;
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+		if (n >= 16) {
+			return priv::base::GetKernels().findPattern(mem, n, pattern, countPattern);
+		}
+#endif
+		sl_size i = 0;
+		while (i < n) {
+			const sl_uint8* p = findMemory(mem + i, pattern[0], n - i);
+			if (!p) {
+				break;
+			}
+			if (!(memcmp(p + 1, pattern + 1, countPattern - 1))) {
+				return p;
+			}
+			i = p - mem + 1;
+		}
+		return sl_null;
+	}
+
+	const sl_uint8* Base::findMemoryReverse(const void* _mem, sl_size count, const void* _pattern, sl_size countPattern) noexcept
+	{
+		const sl_uint8* mem = (const sl_uint8*)_mem;
+		const sl_uint8* pattern = (const sl_uint8*)_pattern;
+		if (!countPattern) {
+			return mem + count;
+		}
+		if (count < countPattern) {
+			return sl_null;
+		}
+		if (countPattern == 1) {
+			return findMemoryReverse(mem, pattern[0], count);
+		}
+		sl_size n = count - countPattern + 1;
+#if defined(SLIB_BASE_USE_SSE2) || defined(SLIB_BASE_USE_NEON)
+		if (n >= 16) {
+			return priv::base::GetKernels().findPatternReverse(mem, n, pattern, countPattern);
+		}
+#endif
+		while (n) {
+			const sl_uint8* p = findMemoryReverse(mem, pattern[0], n);
+			if (!p) {
+				break;
+			}
+			if (!(memcmp(p + 1, pattern + 1, countPattern - 1))) {
+				return p;
+			}
+			n = p - mem;
+		}
+		return sl_null;
+	}
+
 	const sl_uint8* Base::findMemoryUntilZero(const void* mem, sl_uint8 pattern, sl_size count) noexcept
 	{
 		sl_uint8* m = (sl_uint8*)mem;
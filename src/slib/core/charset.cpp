@@ -25,6 +25,18 @@
 #include "slib/core/endian.h"
 #include "slib/core/macro.h"
 
+#if defined(SLIB_ARCH_IS_X64) || (defined(SLIB_ARCH_IS_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define SLIB_CHARSET_USE_SSE2
+#	include <emmintrin.h>
+#elif defined(SLIB_ARCH_IS_ARM64)
+#	define SLIB_CHARSET_USE_NEON
+#	include <arm_neon.h>
+#endif
+
+#if defined(SLIB_COMPILER_IS_VC)
+#	include <intrin.h>
+#endif
+
 namespace slib
 {
 	
@@ -87,6 +99,125 @@ namespace slib
 				}
 			}
 			
+			// count of the leading ASCII characters
+			static sl_size GetAsciiLength(const sl_uint8* s, sl_size n) noexcept
+			{
+				sl_size i = 0;
+#if defined(SLIB_CHARSET_USE_SSE2)
+				for (; i + 16 <= n; i += 16) {
+					sl_uint32 mask = (sl_uint32)(_mm_movemask_epi8(_mm_loadu_si128((__m128i*)(s + i))));
+					if (mask) {
+#	if defined(SLIB_COMPILER_IS_VC)
+						unsigned long index;
+						_BitScanForward(&index, mask);
+						return i + index;
+#	else
+						return i + __builtin_ctz(mask);
+#	endif
+					}
+				}
+#elif defined(SLIB_CHARSET_USE_NEON)
+				for (; i + 16 <= n; i += 16) {
+					if (vmaxvq_u8(vld1q_u8(s + i)) >= 0x80) {
+						break;
+					}
+				}
+#endif
+				for (; i < n; i++) {
+					if (s[i] >= 0x80) {
+						break;
+					}
+				}
+				return i;
+			}
+
+			template <EndianType endian>
+			static void WidenAscii(const sl_uint8* s, sl_size n, void* dst, sl_size pos) noexcept
+			{
+				sl_size i = 0;
+#if defined(SLIB_CHARSET_USE_SSE2)
+				sl_uint8* d = ((sl_uint8*)dst) + (pos << 1);
+				__m128i zero = _mm_setzero_si128();
+				for (; i + 16 <= n; i += 16) {
+					__m128i v = _mm_loadu_si128((__m128i*)(s + i));
+					if (endian == EndianType::Little) {
+						_mm_storeu_si128((__m128i*)(d + (i << 1)), _mm_unpacklo_epi8(v, zero));
+						_mm_storeu_si128((__m128i*)(d + (i << 1) + 16), _mm_unpackhi_epi8(v, zero));
+					} else {
+						_mm_storeu_si128((__m128i*)(d + (i << 1)), _mm_unpacklo_epi8(zero, v));
+						_mm_storeu_si128((__m128i*)(d + (i << 1) + 16), _mm_unpackhi_epi8(zero, v));
+					}
+				}
+#elif defined(SLIB_CHARSET_USE_NEON)
+				sl_uint8* d = ((sl_uint8*)dst) + (pos << 1);
+				uint8x16_t zero = vdupq_n_u8(0);
+				for (; i + 16 <= n; i += 16) {
+					uint8x16x2_t w;
+					if (endian == EndianType::Little) {
+						w.val[0] = vld1q_u8(s + i);
+						w.val[1] = zero;
+					} else {
+						w.val[0] = zero;
+						w.val[1] = vld1q_u8(s + i);
+					}
+					vst2q_u8(d + (i << 1), w);
+				}
+#endif
+				for (; i < n; i++) {
+					Write16<endian>(dst, pos + i, (sl_char16)(s[i]));
+				}
+			}
+
+			// copies the leading ASCII characters (`dst` can be null), and returns the count of copied characters
+			template <EndianType endian>
+			static sl_size NarrowAscii(const void* src, sl_size pos, sl_size n, sl_char8* dst) noexcept
+			{
+				sl_size i = 0;
+#if defined(SLIB_CHARSET_USE_SSE2)
+				const sl_uint8* s = ((const sl_uint8*)src) + (pos << 1);
+				__m128i zero = _mm_setzero_si128();
+				__m128i maskNonAscii = _mm_set1_epi16((short)0xFF80);
+				for (; i + 8 <= n; i += 8) {
+					__m128i v = _mm_loadu_si128((__m128i*)(s + (i << 1)));
+					if (endian != EndianType::Little) {
+						v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+					}
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, maskNonAscii), zero)) != 0xFFFF) {
+						break;
+					}
+					if (dst) {
+						_mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(v, v));
+					}
+				}
+#elif defined(SLIB_CHARSET_USE_NEON)
+				const sl_uint8* s = ((const sl_uint8*)src) + (pos << 1);
+				for (; i + 8 <= n; i += 8) {
+					uint16x8_t v;
+					if (endian == EndianType::Little) {
+						v = vreinterpretq_u16_u8(vld1q_u8(s + (i << 1)));
+					} else {
+						v = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(s + (i << 1))));
+					}
+					if (vmaxvq_u16(v) >= 0x80) {
+						break;
+					}
+					if (dst) {
+						vst1_u8((sl_uint8*)(dst + i), vmovn_u16(v));
+					}
+				}
+#endif
+				for (; i < n; i++) {
+					sl_char16 ch = Read16<endian>(src, pos + i);
+					if ((sl_uint16)ch >= 0x80) {
+						break;
+					}
+					if (dst) {
+						dst[i] = (sl_char8)ch;
+					}
+				}
+				return i;
+			}
+
 			template <EndianType endian>
 			static sl_size ConvertUtf8ToUtf16(const sl_char8* utf8, sl_reg lenUtf8, void* utf16, sl_reg lenUtf16Buffer) noexcept
 			{
@@ -118,6 +249,21 @@ namespace slib
 						}
 					}
 					if (ch < 0x80) {
+						if (!flagSz) {
+							sl_size m = (sl_size)(lenUtf8 - i);
+							if (lenUtf16Buffer >= 0 && (sl_size)(lenUtf16Buffer - n) < m) {
+								m = (sl_size)(lenUtf16Buffer - n);
+							}
+							if (m >= 16) {
+								sl_size k = GetAsciiLength((const sl_uint8*)(utf8 + i), m);
+								if (utf16) {
+									WidenAscii<endian>((const sl_uint8*)(utf8 + i), k, utf16, n);
+								}
+								n += k;
+								i += k;
+								continue;
+							}
+						}
 						if (utf16) {
 							Write16<endian>(utf16, n++, (sl_char16)ch);
 						} else {
@@ -357,6 +503,18 @@ namespace slib
 						}
 					}
 					if (ch < 0x80) {
+						if (!flagSz) {
+							sl_size m = (sl_size)(lenUtf16 - i);
+							if (lenUtf8Buffer >= 0 && (sl_size)(lenUtf8Buffer - n) < m) {
+								m = (sl_size)(lenUtf8Buffer - n);
+							}
+							if (m >= 16) {
+								sl_size k = NarrowAscii<endian>(utf16, i, m, utf8 ? utf8 + n : sl_null);
+								n += k;
+								i += k;
+								continue;
+							}
+						}
 						if (utf8) {
 							utf8[n++] = (sl_char8)(ch);
 						} else {
@@ -617,6 +775,64 @@ namespace slib
 	
 	using namespace priv::charset;
 	
+	sl_bool Charsets::checkUtf8(const void* _utf8, sl_size len) noexcept
+	{
+		const sl_uint8* utf8 = (const sl_uint8*)_utf8;
+		sl_size i = 0;
+		while (i < len) {
+			sl_uint32 ch = utf8[i];
+			if (ch < 0x80) {
+				if (len - i >= 16) {
+					i += GetAsciiLength(utf8 + i, len - i);
+				} else {
+					i++;
+				}
+				continue;
+			}
+			sl_size k;
+			if ((ch & 0xE0) == 0xC0) {
+				if (ch < 0xC2) {
+					// overlong
+					return sl_false;
+				}
+				k = 1;
+			} else if ((ch & 0xF0) == 0xE0) {
+				k = 2;
+			} else if ((ch & 0xF8) == 0xF0) {
+				if (ch > 0xF4) {
+					// over U+10FFFF
+					return sl_false;
+				}
+				k = 3;
+			} else {
+				return sl_false;
+			}
+			if (len - i <= k) {
+				return sl_false;
+			}
+			ch &= 0x3F >> k;
+			for (sl_size j = 1; j <= k; j++) {
+				sl_uint32 ch1 = utf8[i + j];
+				if ((ch1 & 0xC0) != 0x80) {
+					return sl_false;
+				}
+				ch = (ch << 6) | (ch1 & 0x3F);
+			}
+			if (k == 2) {
+				if (ch < 0x800 || (ch >= 0xD800 && ch < 0xE000)) {
+					// overlong or surrogate
+					return sl_false;
+				}
+			} else if (k == 3) {
+				if (ch < 0x10000 || ch > 0x10FFFF) {
+					return sl_false;
+				}
+			}
+			i += k + 1;
+		}
+		return sl_true;
+	}
+
 	sl_size Charsets::utf8ToUtf16(const sl_char8* utf8, sl_reg lenUtf8, sl_char16* utf16, sl_reg lenUtf16Buffer) noexcept
 	{
 		if (Endian::isBE()) {
@@ -86,6 +86,7 @@ namespace slib
 	{
 		m_flagInit = sl_false;
 		m_flagRunning = sl_false;
+		m_timers = TimerWheel::create(0);
 	}
 
 	DispatchLoop::~DispatchLoop()
@@ -142,8 +143,9 @@ namespace slib
 
 		m_queueTasks.removeAll();
 		
-		MutexLocker lockTime(&m_lockTimeTasks);
-		m_timeTasks.removeAll();
+		if (m_timers.isNotNull()) {
+			m_timers->removeAll();
+		}
 	}
 
 	void DispatchLoop::start()
@@ -178,20 +180,22 @@ namespace slib
 	sl_int32 DispatchLoop::_getTimeout()
 	{
 		m_timeCounter.update();
-		sl_int32 t1 = _getTimeout_TimeTasks();
-		sl_int32 t2 = _getTimeout_Timer();
+		sl_int32 timeout = -1;
+		if (m_timers.isNotNull()) {
+			sl_uint64 now = getElapsedMilliseconds();
+			List< Function<void()> > tasks;
+			m_timers->advance(now, tasks);
+			ListElements< Function<void()> > items(tasks);
+			for (sl_size i = 0; i < items.count; i++) {
+				items[i]();
+			}
+			// the tasks may take time: the timeout is measured after running them
+			timeout = m_timers->getTimeout(getElapsedMilliseconds());
+		}
 		if (m_queueTasks.isNotEmpty()) {
 			return 0;
 		}
-		if (t1 < 0) {
-			return t2;
-		} else {
-			if (t2 < 0) {
-				return t1;
-			} else {
-				return SLIB_MIN(t1, t2);
-			}
-		}
+		return timeout;
 	}
 
 	sl_bool DispatchLoop::dispatch(const Function<void()>& task, sl_uint64 delay_ms)
@@ -205,116 +209,89 @@ namespace slib
 				return sl_true;
 			}
 		} else {
-			MutexLocker lock(&m_lockTimeTasks);
-			TimeTask tt;
-			tt.time = getElapsedMilliseconds() + delay_ms;
-			tt.task = task;
-			if (m_timeTasks.add(tt.time, tt)) {
-				_wake();
-				return sl_true;
-			}
+			return setTimeout(task, delay_ms).isNotNull();
 		}
 		return sl_false;
 	}
 
-	sl_int32 DispatchLoop::_getTimeout_TimeTasks()
+	Ref<TimerWheelEntry> DispatchLoop::setTimeout(const Function<void()>& task, sl_uint64 delay_ms)
 	{
-		MutexLocker lock(&m_lockTimeTasks);
-		sl_uint64 rel = getElapsedMilliseconds();
-		if (m_timeTasks.getCount() == 0) {
-			return -1;
+		return _setTimeoutAt(task, getElapsedMilliseconds() + delay_ms);
+	}
+
+	Ref<TimerWheelEntry> DispatchLoop::_setTimeoutAt(const Function<void()>& task, sl_uint64 time)
+	{
+		if (task.isNull() || m_timers.isNull()) {
+			return sl_null;
 		}
-		sl_int32 timeout = -1;
-		LinkedQueue< Function<void()> > tasks;
-		while (MapNode<sl_uint64, TimeTask>* node = m_timeTasks.getFirstNode()) {
-			if (rel >= node->key) {
-				tasks.push(node->value.task);
-				m_timeTasks.removeAt(node);
-			} else {
-				timeout = (sl_int32)(node->key - rel);
-				break;
+		sl_bool flagEarliest = sl_false;
+		Ref<TimerWheelEntry> entry = m_timers->add(task, time, &flagEarliest);
+		if (entry.isNotNull() && flagEarliest) {
+			// the loop thread recalculates its timeout after running the expired tasks
+			if (!(m_thread->isCurrentThread())) {
+				_wake();
 			}
 		}
-		lock.unlock();
+		return entry;
+	}
 
-		Function<void()> task;
-		while (tasks.pop(&task)) {
-			task();
+	sl_bool DispatchLoop::addTimer(const Ref<Timer>& timer)
+	{
+		if (timer.isNull()) {
+			return sl_false;
 		}
-		return timeout;
+		ObjectLocker lock(timer.get());
+		Ref<TimerWheelEntry>& entry = timer->m_entry;
+		if (entry.isNotNull() && entry->isPending()) {
+			return sl_true;
+		}
+		return _scheduleTimer(timer.get(), getElapsedMilliseconds());
 	}
 
-	sl_int32 DispatchLoop::_getTimeout_Timer()
+	void DispatchLoop::removeTimer(const Ref<Timer>& timer)
 	{
-		MutexLocker lock(&m_lockTimer);
-
-		sl_int32 timeout = -1;
-		LinkedQueue< Ref<Timer> > tasks;
-
-		sl_uint64 rel = getElapsedMilliseconds();
-		Link<TimerTask>* link = m_queueTimers.getFront();
-		while (link) {
-			Ref<Timer> timer(link->value.timer);
-			if (timer.isNotNull()) {
-				if (timer->isStarted()) {
-					sl_uint64 t = rel - timer->getLastRunTime();
-					if (t >= timer->getInterval()) {
-						tasks.push(timer);
-						timer->setLastRunTime(rel);
-						t = timer->getInterval();
-					} else {
-						t = timer->getInterval() - t;
-					}
-					if (timeout < 0 || t < (sl_uint64)timeout) {
-						timeout = (sl_uint32)t;
-					}
-				}
-				link = link->next;
-			} else {
-				Link<TimerTask>* linkRemove = link;
-				link = link->next;
-				m_queueTimers.removeAt(linkRemove);
-			}
+		if (timer.isNull()) {
+			return;
 		}
-
+		ObjectLocker lock(timer.get());
+		Ref<TimerWheelEntry> entry = timer->m_entry;
+		timer->m_entry.setNull();
 		lock.unlock();
-
-		Ref<Timer> task;
-		while (tasks.pop(&task)) {
-			if (task.isNotNull()) {
-				task->run();
-			}
+		// only the wheel is locked, so the timer can be stopped while the loop is running its tasks
+		if (entry.isNotNull()) {
+			entry->cancel();
 		}
-		return timeout;
 	}
 
-	sl_bool DispatchLoop::TimerTask::operator==(const DispatchLoop::TimerTask& other) const
+	sl_bool DispatchLoop::_scheduleTimer(Timer* timer, sl_uint64 timeBase)
 	{
-		return timer == other.timer;
+		// called under the lock of `timer`
+		Ref<TimerWheelEntry> entry = _setTimeoutAt(SLIB_BIND_MEMBER(void(), DispatchLoop, _runTimer, this, WeakRef<Timer>(timer)), timeBase + timer->getInterval());
+		timer->m_entry = entry;
+		return entry.isNotNull();
 	}
 
-	sl_bool DispatchLoop::addTimer(const Ref<Timer>& timer)
+	void DispatchLoop::_runTimer(const WeakRef<Timer>& _timer)
 	{
+		Ref<Timer> timer(_timer);
 		if (timer.isNull()) {
-			return sl_false;
+			return;
 		}
-		TimerTask t;
-		t.timer = timer;
-		MutexLocker lock(&m_lockTimer);
-		if (m_queueTimers.push(t)) {
-			_wake();
-			return sl_true;
-		} else {
-			return sl_false;
+		if (!(timer->isStarted())) {
+			return;
+		}
+		// the period is measured from the start of the run, so the running time of the task does not delay the next run
+		sl_uint64 timeRun = getElapsedMilliseconds();
+		timer->setLastRunTime(timeRun);
+		timer->run();
+		ObjectLocker lock(timer.get());
+		if (timer->isStarted()) {
+			// the entry is replaced if the timer has been restarted while running
+			Ref<TimerWheelEntry>& entry = timer->m_entry;
+			if (entry.isNull() || !(entry->isPending())) {
+				_scheduleTimer(timer.get(), timeRun);
+			}
 		}
-	}
-
-	void DispatchLoop::removeTimer(const Ref<Timer>& timer)
-	{
-		MutexLocker lock(&m_lockTimer);
-		TimerTask t;
-		t.timer = timer;
-		m_queueTimers.remove(t);
 	}
 
 	sl_uint64 DispatchLoop::getElapsedMilliseconds()
@@ -616,6 +616,79 @@ namespace slib
 		return sl_null;
 	}
 
+	Memory File::map(const StringParam& filePath, sl_uint64 offset, sl_size size, FileMapMode mode)
+	{
+		Ref<File> file;
+		if (mode == FileMapMode::ReadWrite) {
+			file = File::open(filePath, FileMode::ReadWrite | FileMode::NotCreate | FileMode::NotTruncate);
+		} else {
+			file = File::openForRead(filePath);
+		}
+		if (file.isNotNull()) {
+			// the mapping stays valid after the file is closed
+			return file->map(offset, size, mode);
+		}
+		return sl_null;
+	}
+
+	sl_bool File::adviseMappedMemory(const Memory& mem, FileMapAdvice advice)
+	{
+		return adviseMappedMemory(mem.getData(), mem.getSize(), advice);
+	}
+
+	sl_bool File::syncMappedMemory(const Memory& mem)
+	{
+		return syncMappedMemory(mem.getData(), mem.getSize());
+	}
+
+
+	SLIB_DEFINE_OBJECT(MappedFileReader, MemoryReader)
+
+	MappedFileReader::MappedFileReader(const Memory& mem): MemoryReader(mem)
+	{
+	}
+
+	MappedFileReader::~MappedFileReader()
+	{
+	}
+
+	Ref<MappedFileReader> MappedFileReader::open(const StringParam& filePath, FileMapAdvice advice)
+	{
+		Ref<File> file = File::openForRead(filePath);
+		if (file.isNotNull()) {
+			return open(file, advice);
+		}
+		return sl_null;
+	}
+
+	Ref<MappedFileReader> MappedFileReader::open(const Ref<File>& file, FileMapAdvice advice)
+	{
+		if (file.isNull()) {
+			return sl_null;
+		}
+		Memory mem;
+		if (file->getSize()) {
+			mem = file->map();
+			if (mem.isNull()) {
+				return sl_null;
+			}
+			if (advice != FileMapAdvice::Normal) {
+				File::adviseMappedMemory(mem, advice);
+			}
+		}
+		return new MappedFileReader(mem);
+	}
+
+	Memory MappedFileReader::getMemory()
+	{
+		return m_mem;
+	}
+
+	sl_bool MappedFileReader::advise(FileMapAdvice advice)
+	{
+		return File::adviseMappedMemory(m_mem, advice);
+	}
+
 
 	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(FilePathSegments)
 	
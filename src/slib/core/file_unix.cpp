@@ -31,6 +31,7 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/mman.h>
 #if defined(SLIB_PLATFORM_IS_DESKTOP)
 #	include <sys/ioctl.h>
 #	if defined(SLIB_PLATFORM_IS_MACOS)
@@ -264,6 +265,143 @@ namespace slib
 		return 0;
 	}
 	
+	sl_bool File::sync()
+	{
+		if (isOpened()) {
+			int fd = (int)m_file;
+			return 0 == fsync(fd);
+		}
+		return sl_false;
+	}
+
+	namespace priv
+	{
+		namespace file
+		{
+
+			class MappedView : public Referable
+			{
+			public:
+				void* address;
+				sl_size size;
+
+			public:
+				MappedView(void* _address, sl_size _size): address(_address), size(_size)
+				{
+				}
+
+				~MappedView()
+				{
+					::munmap(address, size);
+				}
+
+			};
+
+			static sl_size GetPageSize()
+			{
+				static sl_size size = 0;
+				if (!size) {
+					long n = sysconf(_SC_PAGESIZE);
+					size = n > 0 ? (sl_size)n : 4096;
+				}
+				return size;
+			}
+
+			static sl_bool AlignToPages(const void* data, sl_size size, void*& outAddress, sl_size& outSize)
+			{
+				if (!data || !size) {
+					return sl_false;
+				}
+				sl_size pageSize = GetPageSize();
+				sl_size start = ((sl_size)data) & ~(pageSize - 1);
+				outAddress = (void*)start;
+				outSize = size + (((sl_size)data) - start);
+				return sl_true;
+			}
+
+		}
+	}
+
+	Memory File::map(sl_uint64 offset, sl_size size, FileMapMode mode)
+	{
+		if (!(isOpened())) {
+			return sl_null;
+		}
+		int fd = (int)m_file;
+		sl_uint64 sizeFile = getSize(m_file);
+		if (offset >= sizeFile) {
+			return sl_null;
+		}
+		sl_uint64 sizeRemain = sizeFile - offset;
+		if ((sl_uint64)size > sizeRemain) {
+			size = (sl_size)sizeRemain;
+		}
+		sl_size pageSize = priv::file::GetPageSize();
+		sl_size delta = (sl_size)(offset % pageSize);
+		sl_size sizeMap = size + delta;
+		if (sizeMap < size) {
+			return sl_null;
+		}
+		int prot;
+		int flags;
+		if (mode == FileMapMode::ReadWrite) {
+			prot = PROT_READ | PROT_WRITE;
+			flags = MAP_SHARED;
+		} else if (mode == FileMapMode::CopyOnWrite) {
+			prot = PROT_READ | PROT_WRITE;
+			flags = MAP_PRIVATE;
+		} else {
+			prot = PROT_READ;
+			flags = MAP_SHARED;
+		}
+		void* address = ::mmap(sl_null, sizeMap, prot, flags, fd, (off_t)(offset - delta));
+		if (address == MAP_FAILED) {
+			return sl_null;
+		}
+		Ref<priv::file::MappedView> view = new priv::file::MappedView(address, sizeMap);
+		if (view.isNull()) {
+			::munmap(address, sizeMap);
+			return sl_null;
+		}
+		return Memory::createStatic((sl_uint8*)address + delta, size, view.get());
+	}
+
+	sl_bool File::adviseMappedMemory(const void* data, sl_size size, FileMapAdvice advice)
+	{
+		void* address;
+		if (!(priv::file::AlignToPages(data, size, address, size))) {
+			return sl_false;
+		}
+		int n;
+		switch (advice) {
+			case FileMapAdvice::Sequential:
+				n = MADV_SEQUENTIAL;
+				break;
+			case FileMapAdvice::Random:
+				n = MADV_RANDOM;
+				break;
+			case FileMapAdvice::WillNeed:
+				n = MADV_WILLNEED;
+				break;
+			case FileMapAdvice::DontNeed:
+				n = MADV_DONTNEED;
+				break;
+			default:
+				n = MADV_NORMAL;
+				break;
+		}
+		return 0 == ::madvise(address, size, n);
+	}
+
+	sl_bool File::syncMappedMemory(const void* data, sl_size size)
+	{
+		void* address;
+		if (!(priv::file::AlignToPages(data, size, address, size))) {
+			return sl_false;
+		}
+		return 0 == ::msync(address, size, MS_SYNC);
+	}
+
 	sl_bool File::lock()
 	{
 		if (isOpened()) {
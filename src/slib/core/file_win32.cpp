@@ -236,6 +236,118 @@ namespace slib
 		return 0;
 	}
 
+	sl_bool File::sync()
+	{
+		HANDLE handle = (HANDLE)m_file;
+		if (handle != INVALID_HANDLE_VALUE) {
+			if (FlushFileBuffers(handle)) {
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+
+	namespace priv
+	{
+		namespace file
+		{
+
+			class MappedView : public Referable
+			{
+			public:
+				void* address;
+
+			public:
+				MappedView(void* _address): address(_address)
+				{
+				}
+
+				~MappedView()
+				{
+					UnmapViewOfFile(address);
+				}
+
+			};
+
+			static sl_size GetAllocationGranularity()
+			{
+				static sl_size size = 0;
+				if (!size) {
+					SYSTEM_INFO si;
+					GetSystemInfo(&si);
+					size = si.dwAllocationGranularity ? (sl_size)(si.dwAllocationGranularity) : 65536;
+				}
+				return size;
+			}
+
+		}
+	}
+
+	Memory File::map(sl_uint64 offset, sl_size size, FileMapMode mode)
+	{
+		HANDLE handle = (HANDLE)m_file;
+		if (handle == INVALID_HANDLE_VALUE) {
+			return sl_null;
+		}
+		sl_uint64 sizeFile = getSize(m_file);
+		if (offset >= sizeFile) {
+			return sl_null;
+		}
+		sl_uint64 sizeRemain = sizeFile - offset;
+		if ((sl_uint64)size > sizeRemain) {
+			size = (sl_size)sizeRemain;
+		}
+		sl_size granularity = priv::file::GetAllocationGranularity();
+		sl_size delta = (sl_size)(offset % granularity);
+		sl_size sizeMap = size + delta;
+		if (sizeMap < size) {
+			return sl_null;
+		}
+		DWORD dwProtect;
+		DWORD dwAccess;
+		if (mode == FileMapMode::ReadWrite) {
+			dwProtect = PAGE_READWRITE;
+			dwAccess = FILE_MAP_WRITE;
+		} else if (mode == FileMapMode::CopyOnWrite) {
+			dwProtect = PAGE_WRITECOPY;
+			dwAccess = FILE_MAP_COPY;
+		} else {
+			dwProtect = PAGE_READONLY;
+			dwAccess = FILE_MAP_READ;
+		}
+		HANDLE hMapping = CreateFileMappingW(handle, NULL, dwProtect, 0, 0, NULL);
+		if (!hMapping) {
+			return sl_null;
+		}
+		sl_uint64 offsetMap = offset - delta;
+		void* address = MapViewOfFile(hMapping, dwAccess, (DWORD)(offsetMap >> 32), (DWORD)offsetMap, sizeMap);
+		// the view keeps the mapping object alive
+		CloseHandle(hMapping);
+		if (!address) {
+			return sl_null;
+		}
+		Ref<priv::file::MappedView> view = new priv::file::MappedView(address);
+		if (view.isNull()) {
+			UnmapViewOfFile(address);
+			return sl_null;
+		}
+		return Memory::createStatic((sl_uint8*)address + delta, size, view.get());
+	}
+
+	sl_bool File::adviseMappedMemory(const void* data, sl_size size, FileMapAdvice advice)
+	{
+		// access pattern hints are not available for mapped views on Win32
+		return data && size;
+	}
+
+	sl_bool File::syncMappedMemory(const void* data, sl_size size)
+	{
+		if (data && size) {
+			return FlushViewOfFile(data, size) != 0;
+		}
+		return sl_false;
+	}
+
 	sl_bool File::lock()
 	{
 		HANDLE handle = (HANDLE)m_file;
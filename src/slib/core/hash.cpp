@@ -24,41 +24,148 @@
 #include "slib/core/hash_table.h"
 
 #include "slib/core/math.h"
+#include "slib/core/mio.h"
 
 namespace slib
 {
 
-	/****************************************************
-	 
-		Fowler–Noll–Vo hash function / FNV-1a hash
-	 
-	 https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
-	 http://www.isthe.com/chongo/tech/comp/fnv/index.html
-	 
-	****************************************************/
-	
+	namespace priv
+	{
+		namespace hash
+		{
+
+			/****************************************************
+			 
+				MurmurHash3 (x86_32)
+			 
+			 https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+			 (MurmurHash3 was written by Austin Appleby, and is placed in the public domain)
+			 
+			****************************************************/
+
+			SLIB_INLINE static sl_uint32 Rotl32(sl_uint32 x, sl_uint32 r) noexcept
+			{
+				return (x << r) | (x >> (32 - r));
+			}
+
+			SLIB_INLINE static sl_uint32 Fmix32(sl_uint32 h) noexcept
+			{
+				h ^= h >> 16;
+				h *= 0x85ebca6b;
+				h ^= h >> 13;
+				h *= 0xc2b2ae35;
+				h ^= h >> 16;
+				return h;
+			}
+
+			/****************************************************
+			 
+				wyhash (final version 4)
+			 
+			 https://github.com/wangyi-fudan/wyhash
+			 (wyhash was written by Wang Yi, and is released into the public domain)
+			 
+			****************************************************/
+
+			const sl_uint64 g_wyp0 = SLIB_UINT64(0xa0761d6478bd642f);
+			const sl_uint64 g_wyp1 = SLIB_UINT64(0xe7037ed1a0b428db);
+			const sl_uint64 g_wyp2 = SLIB_UINT64(0x8ebc6af09c88c6e3);
+			const sl_uint64 g_wyp3 = SLIB_UINT64(0x589965cc75374cc3);
+
+			SLIB_INLINE static sl_uint64 WyMix(sl_uint64 a, sl_uint64 b) noexcept
+			{
+				sl_uint64 high, low;
+				Math::mul64(a, b, high, low);
+				return high ^ low;
+			}
+
+			SLIB_INLINE static sl_uint64 WyRead3(const sl_uint8* p, sl_size n) noexcept
+			{
+				return (((sl_uint64)(p[0])) << 16) | (((sl_uint64)(p[n >> 1])) << 8) | p[n - 1];
+			}
+
+		}
+	}
+
 	sl_uint32 HashBytes32(const void* _buf, sl_size n) noexcept
 	{
-		sl_uint8* buf = (sl_uint8*)_buf;
-		sl_uint32 hash = 0x811c9dc5;
-		sl_uint32 prime = 16777619;
-		for (sl_size i = 0; i < n; i++) {
-			hash ^= buf[i];
-			hash *= prime;
+		const sl_uint8* buf = (const sl_uint8*)_buf;
+		const sl_uint32 c1 = 0xcc9e2d51;
+		const sl_uint32 c2 = 0x1b873593;
+		sl_uint32 h = 0x811c9dc5;
+		sl_size nBlocks = n >> 2;
+		for (sl_size i = 0; i < nBlocks; i++) {
+			sl_uint32 k = MIO::readUint32LE(buf);
+			k *= c1;
+			k = priv::hash::Rotl32(k, 15);
+			k *= c2;
+			h ^= k;
+			h = priv::hash::Rotl32(h, 13);
+			h = h * 5 + 0xe6546b64;
+			buf += 4;
+		}
+		sl_uint32 k = 0;
+		switch (n & 3) {
+			case 3:
+				k ^= ((sl_uint32)(buf[2])) << 16;
+				// fall through
+			case 2:
+				k ^= ((sl_uint32)(buf[1])) << 8;
+				// fall through
+			case 1:
+				k ^= buf[0];
+				k *= c1;
+				k = priv::hash::Rotl32(k, 15);
+				k *= c2;
+				h ^= k;
 		}
-		return hash;
+		h ^= (sl_uint32)n;
+		return priv::hash::Fmix32(h);
 	}
 	
 	sl_uint64 HashBytes64(const void* _buf, sl_size n) noexcept
 	{
-		sl_uint8* buf = (sl_uint8*)_buf;
-		sl_uint64 hash = SLIB_UINT64(0xcbf29ce484222325);
-		sl_uint64 prime = SLIB_UINT64(1099511628211);
-		for (sl_size i = 0; i < n; i++) {
-			hash ^= buf[i];
-			hash *= prime;
+		using namespace priv::hash;
+		const sl_uint8* p = (const sl_uint8*)_buf;
+		sl_uint64 seed = g_wyp0;
+		sl_uint64 a, b;
+		if (n <= 16) {
+			if (n >= 4) {
+				sl_size m = (n >> 3) << 2;
+				a = (((sl_uint64)(MIO::readUint32LE(p))) << 32) | MIO::readUint32LE(p + m);
+				b = (((sl_uint64)(MIO::readUint32LE(p + n - 4))) << 32) | MIO::readUint32LE(p + n - 4 - m);
+			} else if (n) {
+				a = WyRead3(p, n);
+				b = 0;
+			} else {
+				a = b = 0;
+			}
+		} else {
+			sl_size i = n;
+			if (i > 48) {
+				sl_uint64 seed1 = seed;
+				sl_uint64 seed2 = seed;
+				do {
+					seed = WyMix(MIO::readUint64LE(p) ^ g_wyp1, MIO::readUint64LE(p + 8) ^ seed);
+					seed1 = WyMix(MIO::readUint64LE(p + 16) ^ g_wyp2, MIO::readUint64LE(p + 24) ^ seed1);
+					seed2 = WyMix(MIO::readUint64LE(p + 32) ^ g_wyp3, MIO::readUint64LE(p + 40) ^ seed2);
+					p += 48;
+					i -= 48;
+				} while (i > 48);
+				seed ^= seed1 ^ seed2;
+			}
+			while (i > 16) {
+				seed = WyMix(MIO::readUint64LE(p) ^ g_wyp1, MIO::readUint64LE(p + 8) ^ seed);
+				i -= 16;
+				p += 16;
+			}
+			a = MIO::readUint64LE(p + i - 16);
+			b = MIO::readUint64LE(p + i - 8);
 		}
-		return hash;
+		a ^= g_wyp1;
+		b ^= seed;
+		Math::mul64(a, b, b, a);
+		return WyMix(a ^ g_wyp0 ^ n, b ^ g_wyp1);
 	}
 	
 	sl_size HashBytes(const void* buf, sl_size n) noexcept
@@ -975,6 +975,9 @@ namespace slib
 			sl_uint32 n32 = (sl_uint32)n;
 			sl_int32 m = write32(buf + nWrite, n32);
 			if (m <= 0) {
+				if (m < 0 && !nWrite) {
+					return m;
+				}
 				break;
 			}
 			nWrite += m;
@@ -0,0 +1,133 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include "slib/core/parallel_sort.h"
+
+#include "slib/core/event.h"
+#include "slib/core/system.h"
+
+namespace slib
+{
+
+	namespace priv
+	{
+		namespace parallel_sort
+		{
+
+			class TaskContext : public Referable
+			{
+			public:
+				Function<void(sl_uint32)> task;
+				sl_reg nTasks;
+				sl_reg indexNext;
+				sl_reg nRemaining;
+				Ref<Event> eventFinish;
+
+			public:
+				void runWorker()
+				{
+					for (;;) {
+						sl_reg index = Base::interlockedIncrement(&indexNext) - 1;
+						if (index >= nTasks) {
+							return;
+						}
+						task((sl_uint32)index);
+						if (!(Base::interlockedDecrement(&nRemaining))) {
+							eventFinish->set();
+						}
+					}
+				}
+
+			};
+
+		}
+	}
+
+	void ParallelSort::run(sl_uint32 nTasks, const Function<void(sl_uint32 index)>& task, const Ref<ThreadPool>& pool) noexcept
+	{
+		if (!nTasks) {
+			return;
+		}
+		sl_uint32 nThreads = getThreadsCount(pool);
+		Ref<priv::parallel_sort::TaskContext> context;
+		if (nTasks > 1 && nThreads > 1) {
+			context = new priv::parallel_sort::TaskContext;
+			if (context.isNotNull()) {
+				context->eventFinish = Event::create();
+				if (context->eventFinish.isNull()) {
+					context.setNull();
+				}
+			}
+		}
+		if (context.isNull()) {
+			for (sl_uint32 i = 0; i < nTasks; i++) {
+				task(i);
+			}
+			return;
+		}
+		context->task = task;
+		context->nTasks = nTasks;
+		context->indexNext = 0;
+		context->nRemaining = nTasks;
+		// the calling thread also runs the tasks, so this never blocks even if the pool is busy
+		sl_uint32 nHelpers = (nTasks < nThreads ? nTasks : nThreads) - 1;
+		Ref<Thread> threads[64];
+		if (nHelpers > 64) {
+			nHelpers = 64;
+		}
+		for (sl_uint32 i = 0; i < nHelpers; i++) {
+			auto worker = [context]() {
+				context->runWorker();
+			};
+			if (pool.isNotNull()) {
+				pool->addTask(worker);
+			} else {
+				threads[i] = Thread::start(worker);
+			}
+		}
+		context->runWorker();
+		while (Base::interlockedAdd(&(context->nRemaining), 0)) {
+			context->eventFinish->wait();
+		}
+	}
+
+	sl_uint32 ParallelSort::getThreadsCount(const Ref<ThreadPool>& pool) noexcept
+	{
+		sl_uint32 n = System::getProcessorsCount();
+		if (pool.isNotNull()) {
+			sl_uint32 nWorkers = pool->getThreadsCount();
+			sl_uint32 nMax = pool->getMaximumThreadsCount();
+			if (nMax > nWorkers) {
+				nWorkers = nMax;
+			}
+			if (n > nWorkers + 1) {
+				n = nWorkers + 1;
+			}
+		}
+		if (!n) {
+			n = 1;
+		}
+		return n;
+	}
+
+}
@@ -22,6 +22,12 @@
 
 #include "slib/core/ref.h"
 
+#if defined(SLIB_USE_SLAB_ALLOCATOR)
+#	include "slib/core/slab_allocator.h"
+#endif
+
+#include <new>
+
 #define PRIV_SIGNATURE 0x15181289
 
 namespace slib
@@ -151,6 +157,28 @@ namespace slib
 		delete this;
 	}
 	
+	void* Referable::operator new(sl_size_t size)
+	{
+#if defined(SLIB_USE_SLAB_ALLOCATOR)
+		void* ptr = SlabAllocator::allocateMemory(size);
+		if (ptr) {
+			return ptr;
+		}
+		throw std::bad_alloc();
+#else
+		return ::operator new(size);
+#endif
+	}
+
+	void Referable::operator delete(void* ptr, sl_size_t size) noexcept
+	{
+#if defined(SLIB_USE_SLAB_ALLOCATOR)
+		SlabAllocator::freeMemory(ptr, size);
+#else
+		::operator delete(ptr);
+#endif
+	}
+
 	Referable& Referable::operator=(const Referable& other)
 	{
 		return *this;
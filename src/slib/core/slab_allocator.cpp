@@ -0,0 +1,399 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include "slib/core/slab_allocator.h"
+
+#include "slib/core/spin_lock.h"
+#include "slib/core/base.h"
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#if defined(SLIB_PLATFORM_IS_WINDOWS)
+#	include <malloc.h>
+#endif
+
+#define SLAB_SIZE 0x10000
+#define SLAB_HEADER_SIZE 64
+#define SIZE_CLASSES_COUNT SLIB_SLAB_ALLOCATOR_SIZE_CLASSES_COUNT
+
+namespace slib
+{
+
+	namespace priv
+	{
+		namespace slab_allocator
+		{
+
+			static const sl_uint32 g_blockSizes[SIZE_CLASSES_COUNT] = {
+				16, 32, 48, 64, 80, 96, 112, 128,
+				160, 192, 224, 256,
+				320, 384, 448, 512,
+				640, 768, 896, 1024
+			};
+
+			SLIB_INLINE static sl_uint32 GetSizeClass(sl_size size) noexcept
+			{
+				if (size <= 128) {
+					if (!size) {
+						return 0;
+					}
+					return (sl_uint32)((size - 1) >> 4);
+				} else if (size <= 256) {
+					return 8 + (sl_uint32)((size - 129) >> 5);
+				} else if (size <= 512) {
+					return 12 + (sl_uint32)((size - 257) >> 6);
+				} else {
+					return 16 + (sl_uint32)((size - 513) >> 7);
+				}
+			}
+
+			struct FreeBlock
+			{
+				FreeBlock* next;
+			};
+
+			class Counter
+			{
+			public:
+				Counter(): m_value(0) {}
+
+			public:
+				// written only by the owner of the counter (or under the lock of the shared cache)
+				SLIB_INLINE void increase() noexcept
+				{
+					m_value.store(m_value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+
+				SLIB_INLINE sl_size get() const noexcept
+				{
+					return m_value.load(std::memory_order_relaxed);
+				}
+
+			private:
+				std::atomic<sl_size> m_value;
+
+			};
+
+			class ThreadCache;
+
+			struct SlabHeader
+			{
+				ThreadCache* owner;
+				sl_uint32 sizeClass;
+			};
+
+			struct SizeClassCache
+			{
+				FreeBlock* freeList;
+				sl_uint8* current;
+				sl_uint8* end;
+				std::atomic<FreeBlock*> remoteFrees;
+				Counter allocationsCount;
+				Counter freesCount;
+				Counter remoteFreesCount;
+				Counter slabsCount;
+			};
+
+			class ThreadCache
+			{
+			public:
+				SizeClassCache classes[SIZE_CLASSES_COUNT];
+				ThreadCache* nextAll;
+				ThreadCache* nextAbandoned;
+
+			public:
+				ThreadCache() noexcept
+				{
+					for (sl_uint32 i = 0; i < SIZE_CLASSES_COUNT; i++) {
+						SizeClassCache& c = classes[i];
+						c.freeList = sl_null;
+						c.current = sl_null;
+						c.end = sl_null;
+						c.remoteFrees.store(sl_null, std::memory_order_relaxed);
+					}
+					nextAll = sl_null;
+					nextAbandoned = sl_null;
+				}
+
+			public:
+				void* allocate(sl_uint32 sizeClass) noexcept
+				{
+					SizeClassCache& c = classes[sizeClass];
+					FreeBlock* block = c.freeList;
+					if (!block) {
+						block = c.remoteFrees.exchange(sl_null, std::memory_order_acquire);
+						if (!block) {
+							return _allocateFromSlab(c, sizeClass);
+						}
+					}
+					c.freeList = block->next;
+					c.allocationsCount.increase();
+					return block;
+				}
+
+				SLIB_INLINE void freeLocal(sl_uint32 sizeClass, void* ptr) noexcept
+				{
+					SizeClassCache& c = classes[sizeClass];
+					FreeBlock* block = (FreeBlock*)ptr;
+					block->next = c.freeList;
+					c.freeList = block;
+					c.freesCount.increase();
+				}
+
+				SLIB_INLINE void freeRemote(sl_uint32 sizeClass, void* ptr) noexcept
+				{
+					std::atomic<FreeBlock*>& head = classes[sizeClass].remoteFrees;
+					FreeBlock* block = (FreeBlock*)ptr;
+					FreeBlock* next = head.load(std::memory_order_relaxed);
+					do {
+						block->next = next;
+					} while (!(head.compare_exchange_weak(next, block, std::memory_order_release, std::memory_order_relaxed)));
+				}
+
+			private:
+				void* _allocateFromSlab(SizeClassCache& c, sl_uint32 sizeClass) noexcept
+				{
+					sl_size blockSize = g_blockSizes[sizeClass];
+					sl_uint8* current = c.current;
+					if (current + blockSize > c.end || !current) {
+						sl_uint8* slab = _createSlab();
+						if (!slab) {
+							return sl_null;
+						}
+						SlabHeader* header = (SlabHeader*)slab;
+						header->owner = this;
+						header->sizeClass = sizeClass;
+						current = slab + SLAB_HEADER_SIZE;
+						c.end = slab + SLAB_SIZE;
+						c.slabsCount.increase();
+					}
+					c.current = current + blockSize;
+					c.allocationsCount.increase();
+					return current;
+				}
+
+				static sl_uint8* _createSlab() noexcept
+				{
+#if defined(SLIB_PLATFORM_IS_WINDOWS)
+					return (sl_uint8*)(_aligned_malloc(SLAB_SIZE, SLAB_SIZE));
+#else
+					void* p = sl_null;
+					if (posix_memalign(&p, SLAB_SIZE, SLAB_SIZE)) {
+						return sl_null;
+					}
+					return (sl_uint8*)p;
+#endif
+				}
+
+			};
+
+			SLIB_INLINE static ThreadCache* GetOwner(void* ptr) noexcept
+			{
+				return ((SlabHeader*)(((sl_size)ptr) & ~((sl_size)(SLAB_SIZE - 1))))->owner;
+			}
+
+			// the caches are never destroyed: the cache of an exited thread is adopted by a new thread
+			static SpinLock g_lockCaches;
+			static ThreadCache* g_cacheAllFirst = sl_null;
+			static ThreadCache* g_cacheAbandonedFirst = sl_null;
+
+			// serves the threads whose cache is already released (destructors of thread-local objects)
+			static SpinLock g_lockShared;
+			static ThreadCache* g_cacheShared = sl_null;
+
+			static SLIB_THREAD ThreadCache* g_cacheCurrent = sl_null;
+			static SLIB_THREAD sl_bool g_flagThreadExited = sl_false;
+
+			static ThreadCache* CreateCache() noexcept
+			{
+				void* mem = malloc(sizeof(ThreadCache));
+				if (!mem) {
+					return sl_null;
+				}
+				ThreadCache* cache = new (mem) ThreadCache;
+				SpinLocker lock(&g_lockCaches);
+				cache->nextAll = g_cacheAllFirst;
+				g_cacheAllFirst = cache;
+				return cache;
+			}
+
+			class ThreadCacheReleaser
+			{
+			public:
+				~ThreadCacheReleaser()
+				{
+					ThreadCache* cache = g_cacheCurrent;
+					g_cacheCurrent = sl_null;
+					g_flagThreadExited = sl_true;
+					if (cache) {
+						SpinLocker lock(&g_lockCaches);
+						cache->nextAbandoned = g_cacheAbandonedFirst;
+						g_cacheAbandonedFirst = cache;
+					}
+				}
+
+			};
+
+			static ThreadCache* CreateCurrentCache() noexcept
+			{
+				static SLIB_THREAD ThreadCacheReleaser releaser;
+				ThreadCache* cache = sl_null;
+				{
+					SpinLocker lock(&g_lockCaches);
+					cache = g_cacheAbandonedFirst;
+					if (cache) {
+						g_cacheAbandonedFirst = cache->nextAbandoned;
+						cache->nextAbandoned = sl_null;
+					}
+				}
+				if (!cache) {
+					cache = CreateCache();
+					if (!cache) {
+						return sl_null;
+					}
+				}
+				(void)(&releaser);
+				g_cacheCurrent = cache;
+				return cache;
+			}
+
+			static ThreadCache* GetSharedCache() noexcept
+			{
+				ThreadCache* cache = g_cacheShared;
+				if (!cache) {
+					cache = CreateCache();
+					g_cacheShared = cache;
+				}
+				return cache;
+			}
+
+			static void* AllocateFromShared(sl_uint32 sizeClass) noexcept
+			{
+				SpinLocker lock(&g_lockShared);
+				ThreadCache* cache = GetSharedCache();
+				if (cache) {
+					return cache->allocate(sizeClass);
+				}
+				return sl_null;
+			}
+
+		}
+	}
+
+	using namespace priv::slab_allocator;
+
+	SlabAllocatorStatistics::SlabAllocatorStatistics() noexcept: blockSize(0), allocationsCount(0), freesCount(0), remoteFreesCount(0), slabsCount(0)
+	{
+	}
+
+	void* SlabAllocator::allocateMemory(sl_size size) noexcept
+	{
+		if (size > SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE) {
+			return malloc(size);
+		}
+		sl_uint32 sizeClass = GetSizeClass(size);
+		ThreadCache* cache = g_cacheCurrent;
+		if (cache) {
+			return cache->allocate(sizeClass);
+		}
+		if (!g_flagThreadExited) {
+			cache = CreateCurrentCache();
+			if (cache) {
+				return cache->allocate(sizeClass);
+			}
+		}
+		return AllocateFromShared(sizeClass);
+	}
+
+	void SlabAllocator::freeMemory(void* ptr, sl_size size) noexcept
+	{
+		if (!ptr) {
+			return;
+		}
+		if (size > SLIB_SLAB_ALLOCATOR_MAX_BLOCK_SIZE) {
+			free(ptr);
+			return;
+		}
+		sl_uint32 sizeClass = GetSizeClass(size);
+		ThreadCache* owner = GetOwner(ptr);
+		ThreadCache* cache = g_cacheCurrent;
+		if (owner == cache) {
+			cache->freeLocal(sizeClass, ptr);
+			return;
+		}
+		owner->freeRemote(sizeClass, ptr);
+		if (cache) {
+			cache->classes[sizeClass].remoteFreesCount.increase();
+		} else {
+			SpinLocker lock(&g_lockShared);
+			ThreadCache* shared = GetSharedCache();
+			if (shared) {
+				shared->classes[sizeClass].remoteFreesCount.increase();
+			}
+		}
+	}
+
+	sl_uint32 SlabAllocator::getSizeClassesCount() noexcept
+	{
+		return SIZE_CLASSES_COUNT;
+	}
+
+	sl_size SlabAllocator::getBlockSize(sl_uint32 sizeClass) noexcept
+	{
+		if (sizeClass < SIZE_CLASSES_COUNT) {
+			return g_blockSizes[sizeClass];
+		}
+		return 0;
+	}
+
+	void SlabAllocator::getStatistics(sl_uint32 sizeClass, SlabAllocatorStatistics& _out) noexcept
+	{
+		_out = SlabAllocatorStatistics();
+		if (sizeClass >= SIZE_CLASSES_COUNT) {
+			return;
+		}
+		_out.blockSize = g_blockSizes[sizeClass];
+		SpinLocker lock(&g_lockCaches);
+		ThreadCache* cache = g_cacheAllFirst;
+		while (cache) {
+			SizeClassCache& c = cache->classes[sizeClass];
+			_out.allocationsCount += c.allocationsCount.get();
+			sl_uint64 nRemote = c.remoteFreesCount.get();
+			_out.freesCount += c.freesCount.get() + nRemote;
+			_out.remoteFreesCount += nRemote;
+			_out.slabsCount += c.slabsCount.get();
+			cache = cache->nextAll;
+		}
+	}
+
+	sl_bool SlabAllocator::isUsedByBase() noexcept
+	{
+#if defined(SLIB_USE_SLAB_ALLOCATOR)
+		return sl_true;
+#else
+		return sl_false;
+#endif
+	}
+
+}
@@ -0,0 +1,225 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#include "slib/core/string_builder.h"
+
+namespace slib
+{
+
+	StringBuilder::StringBuilder() noexcept
+	{
+		m_data = m_inline;
+		m_length = 0;
+		m_capacity = SLIB_STRING_BUILDER_INLINE_SIZE;
+	}
+
+	StringBuilder::StringBuilder(sl_size capacity) noexcept
+	{
+		m_data = m_inline;
+		m_length = 0;
+		m_capacity = SLIB_STRING_BUILDER_INLINE_SIZE;
+		reserve(capacity);
+	}
+
+	StringBuilder::StringBuilder(StringBuilder&& other) noexcept
+	{
+		_moveFrom(other);
+	}
+
+	StringBuilder::~StringBuilder() noexcept
+	{
+	}
+
+	StringBuilder& StringBuilder::operator=(StringBuilder&& other) noexcept
+	{
+		if (this != &other) {
+			_moveFrom(other);
+		}
+		return *this;
+	}
+
+	sl_bool StringBuilder::reserve(sl_size capacity) noexcept
+	{
+		if (capacity <= m_capacity) {
+			return sl_true;
+		}
+		return _reallocate(capacity);
+	}
+
+	void StringBuilder::setLength(sl_size length) noexcept
+	{
+		if (length < m_length) {
+			m_length = length;
+		}
+	}
+
+	void StringBuilder::clear() noexcept
+	{
+		m_length = 0;
+	}
+
+	sl_bool StringBuilder::add(const sl_char8* buf, sl_size length) noexcept
+	{
+		if (!length) {
+			return sl_true;
+		}
+		sl_char8* p = addUninitialized(length);
+		if (p) {
+			Base::copyMemory(p, buf, length);
+			return sl_true;
+		}
+		return sl_false;
+	}
+
+	sl_bool StringBuilder::add(const String& str) noexcept
+	{
+		return add(str.getData(), str.getLength());
+	}
+
+	sl_bool StringBuilder::add(const StringView& str) noexcept
+	{
+		return add(str.getData(), str.getLength());
+	}
+
+	sl_bool StringBuilder::add(const StringStorage& str) noexcept
+	{
+		return add(str.data8, str.length);
+	}
+
+	sl_bool StringBuilder::addChar(sl_char8 ch, sl_size nRepeatCount) noexcept
+	{
+		if (!nRepeatCount) {
+			return sl_true;
+		}
+		sl_char8* p = addUninitialized(nRepeatCount);
+		if (p) {
+			Base::resetMemory(p, ch, nRepeatCount);
+			return sl_true;
+		}
+		return sl_false;
+	}
+
+	String StringBuilder::merge() const noexcept
+	{
+		if (!m_length) {
+			return String::getEmpty();
+		}
+		return String(m_data, m_length);
+	}
+
+	Memory StringBuilder::mergeToMemory() const noexcept
+	{
+		if (!m_length) {
+			return sl_null;
+		}
+		return Memory::create(m_data, m_length);
+	}
+
+	String StringBuilder::releaseString() noexcept
+	{
+		if (!m_length) {
+			return String::getEmpty();
+		}
+		// the heap buffer is handed off unless more than half of it is unused
+		if (m_memory.isNotNull() && m_length >= (m_capacity >> 1)) {
+			m_data[m_length] = 0;
+			String ret = String::fromRef(m_memory.ref, m_data, m_length);
+			if (ret.isNotNull()) {
+				_reset();
+				return ret;
+			}
+		}
+		String ret(m_data, m_length);
+		m_length = 0;
+		return ret;
+	}
+
+	Memory StringBuilder::releaseMemory() noexcept
+	{
+		if (!m_length) {
+			return sl_null;
+		}
+		if (m_memory.isNotNull() && m_length >= (m_capacity >> 1)) {
+			Memory ret = m_memory.sub(0, m_length);
+			if (ret.isNotNull()) {
+				_reset();
+				return ret;
+			}
+		}
+		Memory ret = Memory::create(m_data, m_length);
+		m_length = 0;
+		return ret;
+	}
+
+	sl_bool StringBuilder::_grow(sl_size size) noexcept
+	{
+		sl_size capacity = m_capacity << 1;
+		if (capacity < m_capacity || capacity < size) {
+			capacity = size;
+		}
+		return _reallocate(capacity);
+	}
+
+	sl_bool StringBuilder::_reallocate(sl_size capacity) noexcept
+	{
+		// one more byte for the null-terminator of `releaseString()`
+		Memory mem = Memory::create(capacity + 1);
+		if (mem.isNull()) {
+			return sl_false;
+		}
+		sl_char8* data = (sl_char8*)(mem.getData());
+		if (m_length) {
+			Base::copyMemory(data, m_data, m_length);
+		}
+		m_memory = Move(mem);
+		m_data = data;
+		m_capacity = capacity;
+		return sl_true;
+	}
+
+	void StringBuilder::_reset() noexcept
+	{
+		m_memory.setNull();
+		m_data = m_inline;
+		m_length = 0;
+		m_capacity = SLIB_STRING_BUILDER_INLINE_SIZE;
+	}
+
+	void StringBuilder::_moveFrom(StringBuilder& other) noexcept
+	{
+		if (other.m_memory.isNotNull()) {
+			m_memory = Move(other.m_memory);
+			m_data = other.m_data;
+			m_capacity = other.m_capacity;
+		} else {
+			m_memory.setNull();
+			m_data = m_inline;
+			m_capacity = SLIB_STRING_BUILDER_INLINE_SIZE;
+			if (other.m_length) {
+				Base::copyMemory(m_inline, other.m_inline, other.m_length);
+			}
+		}
+		m_length = other.m_length;
+		other._reset();
+	}
+
+}
@@ -25,6 +25,7 @@
 #include "slib/core/string.h"
 
 #include "slib/core/string_buffer.h"
+#include "slib/core/string_builder.h"
 #include "slib/core/parse.h"
 #include "slib/core/math.h"
 #include "slib/core/time.h"
@@ -69,6 +70,54 @@ namespace slib
 			{
 				return Base::compareMemory2((sl_uint16*)mem1, (sl_uint16*)mem2, count);
 			}
+
+			// `count` >= `countPattern` >= 2
+			SLIB_INLINE static const sl_char8* FindPattern(const sl_char8* mem, sl_size count, const sl_char8* pattern, sl_size countPattern) noexcept
+			{
+				return (const sl_char8*)(Base::findMemory(mem, count, pattern, countPattern));
+			}
+
+			template <class CT>
+			static const CT* FindPattern(const CT* mem, sl_size count, const CT* pattern, sl_size countPattern) noexcept
+			{
+				sl_size start = 0;
+				while (start <= count - countPattern) {
+					const CT* pt = (const CT*)(FindMemory(mem + start, pattern[0], count - start - countPattern + 1));
+					if (pt == sl_null) {
+						return sl_null;
+					}
+					if (CompareMemory(pt + 1, pattern + 1, countPattern - 1) == 0) {
+						return pt;
+					} else {
+						start = (sl_size)(pt - mem + 1);
+					}
+				}
+				return sl_null;
+			}
+
+			// `count` >= `countPattern` >= 2
+			SLIB_INLINE static const sl_char8* FindPatternReverse(const sl_char8* mem, sl_size count, const sl_char8* pattern, sl_size countPattern) noexcept
+			{
+				return (const sl_char8*)(Base::findMemoryReverse(mem, count, pattern, countPattern));
+			}
+
+			template <class CT>
+			static const CT* FindPatternReverse(const CT* mem, sl_size count, const CT* pattern, sl_size countPattern) noexcept
+			{
+				sl_size s = count - countPattern + 1;
+				while (s > 0) {
+					const CT* pt = (const CT*)(FindMemoryReverse(mem, pattern[0], s));
+					if (pt == sl_null) {
+						return sl_null;
+					}
+					if (CompareMemory(pt + 1, pattern + 1, countPattern - 1) == 0) {
+						return pt;
+					} else {
+						s = (sl_size)(pt - mem);
+					}
+				}
+				return sl_null;
+			}
 			
 		
 			template <class CT>
@@ -880,6 +929,17 @@ namespace slib
 				}
 				return sl_true;
 			}
+
+			SLIB_INLINE static sl_bool EqualsIgnoreCase(const sl_uint8* s1, sl_size l1, const sl_uint8* s2, sl_size l2) noexcept
+			{
+				if (s1 == s2) {
+					return sl_true;
+				}
+				if (l1 != l2) {
+					return sl_false;
+				}
+				return Base::equalsMemoryIgnoreCase(s1, s2, l1);
+			}
 		}
 	}
 
@@ -962,6 +1022,38 @@ namespace slib
 				}
 				return 0;
 			}
+
+			SLIB_INLINE static sl_compare_result CompareIgnoreCase(const sl_uint8* s1, sl_size len1, const sl_uint8* s2, sl_size len2) noexcept
+			{
+				if (s1 == s2) {
+					return 0;
+				}
+				sl_size len = SLIB_MIN(len1, len2);
+				// comparison stops at the null character
+				const sl_uint8* z = Base::findMemory(s1, 0, len);
+				if (z) {
+					return Base::compareMemoryIgnoreCase(s1, s2, z - s1 + 1);
+				}
+				sl_compare_result result = Base::compareMemoryIgnoreCase(s1, s2, len);
+				if (result) {
+					return result;
+				}
+				if (len1 < len2) {
+					if (s2[len1] == 0) {
+						return 0;
+					} else {
+						return -1;
+					}
+				}
+				if (len1 > len2) {
+					if (s1[len2] == 0) {
+						return 0;
+					} else {
+						return 1;
+					}
+				}
+				return 0;
+			}
 		}
 	}
 
@@ -1267,16 +1359,9 @@ namespace slib
 						return -1;
 					}
 				}
-				while (start <= count - countPat) {
-					const CT* pt = (const CT*)(FindMemory(buf + start, bufPat[0], count - start - countPat + 1));
-					if (pt == sl_null) {
-						return -1;
-					}
-					if (CompareMemory(pt + 1, bufPat + 1, countPat - 1) == 0) {
-						return (sl_reg)(pt - buf);
-					} else {
-						start = (sl_size)(pt - buf + 1);
-					}
+				const CT* pt = FindPattern(buf + start, count - start, bufPat, countPat);
+				if (pt) {
+					return (sl_reg)(pt - buf);
 				}
 				return -1;
 			}
@@ -1408,16 +1493,12 @@ namespace slib
 						s = n;
 					}
 				}
-				while (s > 0) {
-					const CT* pt = (const CT*)(FindMemoryReverse(buf, bufPat[0], s));
-					if (pt == sl_null) {
-						return -1;
-					}
-					if (CompareMemory(pt + 1, bufPat + 1, countPat - 1) == 0) {
-						return (sl_reg)(pt - buf);
-					} else {
-						s = (sl_size)(pt - buf);
-					}
+				if (!s) {
+					return -1;
+				}
+				const CT* pt = FindPatternReverse(buf, s + countPat - 1, bufPat, countPat);
+				if (pt) {
+					return (sl_reg)(pt - buf);
 				}
 				return -1;
 			}
@@ -3019,17 +3100,11 @@ namespace slib
 				return i;
 			}
 
-			template <class IT, class UT, class ST, class CT>
-			SLIB_INLINE static ST FromInt(IT _value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase, CT chGroup = sl_false, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false, sl_bool flagEncloseNagtive = sl_false) noexcept
+			template <class IT, class UT, class CT>
+			SLIB_INLINE static sl_uint32 WriteInt(CT* buf, IT _value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase, CT chGroup = sl_false, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false, sl_bool flagEncloseNagtive = sl_false) noexcept
 			{
-				if (radix < 2 || radix > 64) {
-					return sl_null;
-				}
-				
 				const char* pattern = flagUpperCase && radix <= 36 ? g_conv_radix_pattern_upper : g_conv_radix_pattern_lower;
 				
-				CT buf[MAX_NUMBER_STR_LEN];
-				
 				sl_uint32 pos = MAX_NUMBER_STR_LEN;
 				
 				if (minWidth < 1) {
@@ -3101,19 +3176,24 @@ namespace slib
 						}
 					}
 				}
-				return ST(buf + pos, MAX_NUMBER_STR_LEN - pos);
+				return pos;
 			}
 			
-			template <class IT, class ST, class CT>
-			SLIB_INLINE static ST FromUint(IT value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase, CT chGroup = 0, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false) noexcept
+			template <class IT, class UT, class ST, class CT>
+			SLIB_INLINE static ST FromInt(IT value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase, CT chGroup = sl_false, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false, sl_bool flagEncloseNagtive = sl_false) noexcept
 			{
 				if (radix < 2 || radix > 64) {
 					return sl_null;
 				}
-				
-				const char* pattern = flagUpperCase && radix <= 36 ? g_conv_radix_pattern_upper : g_conv_radix_pattern_lower;
-				
 				CT buf[MAX_NUMBER_STR_LEN];
+				sl_uint32 pos = WriteInt<IT, UT, CT>(buf, value, radix, minWidth, flagUpperCase, chGroup, flagSignPositive, flagLeadingSpacePositive, flagEncloseNagtive);
+				return ST(buf + pos, MAX_NUMBER_STR_LEN - pos);
+			}
+			
+			template <class IT, class CT>
+			SLIB_INLINE static sl_uint32 WriteUint(CT* buf, IT value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase, CT chGroup = 0, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false) noexcept
+			{
+				const char* pattern = flagUpperCase && radix <= 36 ? g_conv_radix_pattern_upper : g_conv_radix_pattern_lower;
 				
 				sl_uint32 pos = MAX_NUMBER_STR_LEN;
 				
@@ -3161,22 +3241,36 @@ namespace slib
 					}
 				}
 				
-				return ST(buf + pos, MAX_NUMBER_STR_LEN - pos);
+				return pos;
 			}
 
-			template <class FT, class ST, class CT>
-			SLIB_INLINE static ST FromFloat(FT value, sl_int32 precision, sl_bool flagZeroPadding, sl_int32 minWidthIntegral, CT chConv = 'g', CT chGroup = 0, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false, sl_bool flagEncloseNagtive = sl_false) noexcept
+			template <class IT, class ST, class CT>
+			SLIB_INLINE static ST FromUint(IT value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase, CT chGroup = 0, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false) noexcept
 			{
-				
+				if (radix < 2 || radix > 64) {
+					return sl_null;
+				}
 				CT buf[MAX_NUMBER_STR_LEN];
-				
+				sl_uint32 pos = WriteUint<IT, CT>(buf, value, radix, minWidth, flagUpperCase, chGroup, flagSignPositive, flagLeadingSpacePositive);
+				return ST(buf + pos, MAX_NUMBER_STR_LEN - pos);
+			}
+			
+			template <class FT, class CT>
+			SLIB_INLINE static sl_size WriteFloat(CT* buf, FT value, sl_int32 precision, sl_bool flagZeroPadding, sl_int32 minWidthIntegral, CT chConv = 'g', CT chGroup = 0, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false, sl_bool flagEncloseNagtive = sl_false) noexcept
+			{
 				if (Math::isNaN(value)) {
-					static CT s[] = {'N', 'a', 'N', 0};
-					return ST::fromStatic(s);
+					static const CT s[] = {'N', 'a', 'N'};
+					for (sl_uint32 i = 0; i < 3; i++) {
+						buf[i] = s[i];
+					}
+					return 3;
 				}
 				if (Math::isInfinite(value)) {
-					static CT s[] = {'I', 'n', 'f', 'i', 'n', 'i', 't', 'y', 0};
-					return ST::fromStatic(s);
+					static const CT s[] = {'I', 'n', 'f', 'i', 'n', 'i', 't', 'y'};
+					for (sl_uint32 i = 0; i < 8; i++) {
+						buf[i] = s[i];
+					}
+					return 8;
 				}
 				
 				if (minWidthIntegral > MAX_PRECISION) {
@@ -3217,7 +3311,7 @@ namespace slib
 							buf[pos++] = '0';
 						}
 					}
-					return ST(buf, pos);
+					return pos;
 				}
 				
 				CT* str = buf;
@@ -3357,7 +3451,15 @@ namespace slib
 					}
 				}
 				
-				return ST(buf, str - buf);
+				return str - buf;
+			}
+
+			template <class FT, class ST, class CT>
+			SLIB_INLINE static ST FromFloat(FT value, sl_int32 precision, sl_bool flagZeroPadding, sl_int32 minWidthIntegral, CT chConv = 'g', CT chGroup = 0, sl_bool flagSignPositive = sl_false, sl_bool flagLeadingSpacePositive = sl_false, sl_bool flagEncloseNagtive = sl_false) noexcept
+			{
+				CT buf[MAX_NUMBER_STR_LEN];
+				sl_size len = WriteFloat<FT, CT>(buf, value, precision, flagZeroPadding, minWidthIntegral, chConv, chGroup, flagSignPositive, flagLeadingSpacePositive, flagEncloseNagtive);
+				return ST(buf, len);
 			}
 
 			template <class ST, class CT>
@@ -4573,6 +4675,50 @@ namespace slib
 #endif
 	}
 
+	sl_bool StringBuilder::addInt32(sl_int32 value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase) noexcept
+	{
+		return addInt64(value, radix, minWidth, flagUpperCase);
+	}
+
+	sl_bool StringBuilder::addUint32(sl_uint32 value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase) noexcept
+	{
+		return addUint64(value, radix, minWidth, flagUpperCase);
+	}
+
+	sl_bool StringBuilder::addInt64(sl_int64 value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase) noexcept
+	{
+		if (radix < 2 || radix > 64) {
+			return sl_false;
+		}
+		sl_char8 buf[MAX_NUMBER_STR_LEN];
+		sl_uint32 pos = priv::string::WriteInt<sl_int64, sl_uint64, sl_char8>(buf, value, radix, minWidth, flagUpperCase);
+		return add(buf + pos, MAX_NUMBER_STR_LEN - pos);
+	}
+
+	sl_bool StringBuilder::addUint64(sl_uint64 value, sl_uint32 radix, sl_uint32 minWidth, sl_bool flagUpperCase) noexcept
+	{
+		if (radix < 2 || radix > 64) {
+			return sl_false;
+		}
+		sl_char8 buf[MAX_NUMBER_STR_LEN];
+		sl_uint32 pos = priv::string::WriteUint<sl_uint64, sl_char8>(buf, value, radix, minWidth, flagUpperCase);
+		return add(buf + pos, MAX_NUMBER_STR_LEN - pos);
+	}
+
+	sl_bool StringBuilder::addFloat(float value, sl_int32 precision, sl_bool flagZeroPadding, sl_uint32 minWidthIntegral) noexcept
+	{
+		sl_char8 buf[MAX_NUMBER_STR_LEN];
+		sl_size len = priv::string::WriteFloat<float, sl_char8>(buf, value, precision, flagZeroPadding, minWidthIntegral);
+		return add(buf, len);
+	}
+
+	sl_bool StringBuilder::addDouble(double value, sl_int32 precision, sl_bool flagZeroPadding, sl_uint32 minWidthIntegral) noexcept
+	{
+		sl_char8 buf[MAX_NUMBER_STR_LEN];
+		sl_size len = priv::string::WriteFloat<double, sl_char8>(buf, value, precision, flagZeroPadding, minWidthIntegral);
+		return add(buf, len);
+	}
+
 	String String::fromDouble(double value, sl_int32 precision, sl_bool flagZeroPadding, sl_uint32 minWidthIntegral) noexcept
 	{
 		return priv::string::FromFloat<double, String, sl_char8>(value, precision, flagZeroPadding, minWidthIntegral);
@@ -4832,16 +4978,13 @@ https://docs.oracle.com/javase/7/docs/api/java/util/Formatter.html
 		{
 			
 			template <class ST, class CT, class BT>
-			static ST Format(const Locale& locale, const CT* format, sl_size len, const Variant* params, sl_size _nParams) noexcept
+			static void FormatTo(BT& sb, const Locale& locale, const CT* format, sl_size len, const Variant* params, sl_size _nParams) noexcept
 			{
-				if (len == 0) {
-					return ST::getEmpty();
-				}
 				sl_uint32 nParams = (sl_uint32)_nParams;
 				if (nParams == 0) {
-					return ST(format, len);
+					sb.addStatic(format, len);
+					return;
 				}
-				BT sb;
 				sl_size pos = 0;
 				sl_size posText = 0;
 				sl_uint32 indexArgLast = 0;
@@ -5317,6 +5460,19 @@ https://docs.oracle.com/javase/7/docs/api/java/util/Formatter.html
 						pos++;
 					}
 				}
+			}
+
+			template <class ST, class CT, class BT>
+			static ST Format(const Locale& locale, const CT* format, sl_size len, const Variant* params, sl_size nParams) noexcept
+			{
+				if (len == 0) {
+					return ST::getEmpty();
+				}
+				if (nParams == 0) {
+					return ST(format, len);
+				}
+				BT sb;
+				FormatTo<ST, CT, BT>(sb, locale, format, len, params, nParams);
 				return sb.merge();
 			}
 
@@ -5375,6 +5531,19 @@ https://docs.oracle.com/javase/7/docs/api/java/util/Formatter.html
 		return priv::string::Format<String16, sl_char16, StringBuffer16>(locale, format.getData(), format.getLength(), params.data, params.count);
 	}
 	
+	void StringBuilder::addFormatBy(const StringParam& _format, const Variant* params, sl_size nParams) noexcept
+	{
+		StringData format(_format);
+		priv::string::FormatTo<String, sl_char8, StringBuilder>(*this, Locale::Unknown, format.getData(), format.getLength(), params, nParams);
+	}
+
+	void StringBuilder::addFormatBy(const StringParam& _format, const ListParam<Variant>& _params) noexcept
+	{
+		StringData format(_format);
+		ListLocker<Variant> params(_params);
+		priv::string::FormatTo<String, sl_char8, StringBuilder>(*this, Locale::Unknown, format.getData(), format.getLength(), params.data, params.count);
+	}
+
 	String String::format(const StringParam& strFormat) noexcept
 	{
 		return strFormat.toString();
@@ -167,6 +167,15 @@ namespace slib
 		sched_yield();
 	}
 	
+	sl_uint32 System::getProcessorsCount()
+	{
+		long n = sysconf(_SC_NPROCESSORS_ONLN);
+		if (n > 0) {
+			return (sl_uint32)n;
+		}
+		return 1;
+	}
+	
 	sl_uint32 System::getLastError()
 	{
 		return errno;
@@ -190,6 +190,20 @@ namespace slib
 #endif
 	}
 
+	sl_uint32 System::getProcessorsCount()
+	{
+		SYSTEM_INFO info;
+#if defined(SLIB_PLATFORM_IS_WIN32)
+		GetSystemInfo(&info);
+#else
+		GetNativeSystemInfo(&info);
+#endif
+		if (info.dwNumberOfProcessors > 0) {
+			return (sl_uint32)(info.dwNumberOfProcessors);
+		}
+		return 1;
+	}
+
 	sl_uint32 System::getLastError()
 	{
 		return (sl_uint32)(GetLastError());
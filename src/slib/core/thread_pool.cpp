@@ -22,15 +22,285 @@
 
 #include "slib/core/thread_pool.h"
 
+#include "slib/core/system.h"
+
+#include <atomic>
+
+#define WORK_STEALING_DEQUE_INITIAL_CAPACITY 1024
+#define WORK_STEALING_SPIN_COUNT 32
+
 namespace slib
 {
 
+	namespace priv
+	{
+		namespace thread_pool
+		{
+
+			typedef Callable<void()> Task;
+
+			SLIB_INLINE static Task* RetainTask(const Function<void()>& task)
+			{
+				Task* ret = task.ref.get();
+				ret->increaseReference();
+				return ret;
+			}
+
+			SLIB_INLINE static void RunTask(Task* task)
+			{
+				Ref<Task> ref(task);
+				task->decreaseReference();
+				task->invoke();
+			}
+
+			// Chase-Lev deque: the owner pushes and pops at the bottom, thieves take from the top
+			class WorkStealingDeque
+			{
+			private:
+				struct Buffer
+				{
+					sl_int64 capacity;
+					sl_int64 mask;
+					std::atomic<Task*>* items;
+					Buffer* retired;
+
+					Task* get(sl_int64 index)
+					{
+						return items[index & mask].load(std::memory_order_relaxed);
+					}
+
+					void put(sl_int64 index, Task* task)
+					{
+						items[index & mask].store(task, std::memory_order_relaxed);
+					}
+				};
+
+			public:
+				WorkStealingDeque(): m_top(0), m_bottom(0)
+				{
+					m_buffer.store(createBuffer(WORK_STEALING_DEQUE_INITIAL_CAPACITY), std::memory_order_relaxed);
+				}
+
+				~WorkStealingDeque()
+				{
+					Task* task;
+					while ((task = pop())) {
+						task->decreaseReference();
+					}
+					Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+					while (buffer) {
+						Buffer* retired = buffer->retired;
+						delete[] buffer->items;
+						delete buffer;
+						buffer = retired;
+					}
+				}
+
+			public:
+				// owner only
+				void push(Task* task)
+				{
+					sl_int64 b = m_bottom.load(std::memory_order_relaxed);
+					sl_int64 t = m_top.load(std::memory_order_acquire);
+					Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+					if (b - t > buffer->capacity - 1) {
+						buffer = grow(buffer, b, t);
+					}
+					buffer->put(b, task);
+					std::atomic_thread_fence(std::memory_order_release);
+					m_bottom.store(b + 1, std::memory_order_relaxed);
+				}
+
+				// owner only
+				Task* pop()
+				{
+					sl_int64 b = m_bottom.load(std::memory_order_relaxed) - 1;
+					Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+					m_bottom.store(b, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					sl_int64 t = m_top.load(std::memory_order_relaxed);
+					if (t <= b) {
+						Task* task = buffer->get(b);
+						if (t == b) {
+							// last item: race against thieves
+							if (!(m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))) {
+								task = sl_null;
+							}
+							m_bottom.store(b + 1, std::memory_order_relaxed);
+						}
+						return task;
+					} else {
+						m_bottom.store(b + 1, std::memory_order_relaxed);
+						return sl_null;
+					}
+				}
+
+				// any thread
+				Task* steal()
+				{
+					sl_int64 t = m_top.load(std::memory_order_acquire);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					sl_int64 b = m_bottom.load(std::memory_order_acquire);
+					if (t < b) {
+						Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+						Task* task = buffer->get(t);
+						if (m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+							return task;
+						}
+					}
+					return sl_null;
+				}
+
+				sl_bool isEmpty()
+				{
+					sl_int64 t = m_top.load(std::memory_order_acquire);
+					sl_int64 b = m_bottom.load(std::memory_order_acquire);
+					return t >= b;
+				}
+
+			private:
+				static Buffer* createBuffer(sl_int64 capacity)
+				{
+					Buffer* buffer = new Buffer;
+					buffer->capacity = capacity;
+					buffer->mask = capacity - 1;
+					buffer->items = new std::atomic<Task*>[(sl_size)capacity];
+					buffer->retired = sl_null;
+					return buffer;
+				}
+
+				Buffer* grow(Buffer* old, sl_int64 b, sl_int64 t)
+				{
+					Buffer* buffer = createBuffer(old->capacity << 1);
+					for (sl_int64 i = t; i < b; i++) {
+						buffer->put(i, old->get(i));
+					}
+					// thieves may still read the old buffer, so it is released with the deque
+					buffer->retired = old;
+					m_buffer.store(buffer, std::memory_order_release);
+					return buffer;
+				}
+
+			private:
+				std::atomic<sl_int64> m_top;
+				std::atomic<sl_int64> m_bottom;
+				std::atomic<Buffer*> m_buffer;
+
+			};
+
+			class WorkStealingContext : public Referable
+			{
+			public:
+				sl_uint32 nWorkers;
+				WorkStealingDeque* deques;
+				std::atomic<sl_bool>* flagsSleeping;
+				Ref<Thread>* threads;
+
+				MpmcQueue<Task*> injection;
+				// used when the injection queue is full
+				LinkedQueue< Function<void()> > overflow;
+
+				std::atomic<sl_int32> nSleeping;
+				std::atomic<sl_uint32> indexWake;
+
+			public:
+				WorkStealingContext(sl_uint32 _nWorkers, sl_uint32 sizeInjectionQueue): injection(sizeInjectionQueue), nSleeping(0), indexWake(0)
+				{
+					nWorkers = _nWorkers;
+					deques = new WorkStealingDeque[nWorkers];
+					flagsSleeping = new std::atomic<sl_bool>[nWorkers];
+					for (sl_uint32 i = 0; i < nWorkers; i++) {
+						flagsSleeping[i].store(sl_false, std::memory_order_relaxed);
+					}
+					threads = new Ref<Thread>[nWorkers];
+				}
+
+				~WorkStealingContext()
+				{
+					Task* task;
+					while (injection.pop(&task)) {
+						task->decreaseReference();
+					}
+					delete[] threads;
+					delete[] flagsSleeping;
+					delete[] deques;
+				}
+
+			public:
+				Task* popTask(sl_uint32 index)
+				{
+					Task* task = deques[index].pop();
+					if (task) {
+						return task;
+					}
+					if (injection.pop(&task)) {
+						return task;
+					}
+					if (overflow.isNotEmpty()) {
+						Function<void()> f;
+						if (overflow.pop(&f)) {
+							return RetainTask(f);
+						}
+					}
+					for (sl_uint32 k = 1; k < nWorkers; k++) {
+						task = deques[(index + k) % nWorkers].steal();
+						if (task) {
+							return task;
+						}
+					}
+					return sl_null;
+				}
+
+				sl_bool hasTasks()
+				{
+					if (injection.isNotEmpty() || overflow.isNotEmpty()) {
+						return sl_true;
+					}
+					for (sl_uint32 i = 0; i < nWorkers; i++) {
+						if (!(deques[i].isEmpty())) {
+							return sl_true;
+						}
+					}
+					return sl_false;
+				}
+
+				void wakeWorker()
+				{
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (nSleeping.load(std::memory_order_relaxed) <= 0) {
+						return;
+					}
+					sl_uint32 start = indexWake.fetch_add(1, std::memory_order_relaxed);
+					for (sl_uint32 k = 0; k < nWorkers; k++) {
+						sl_uint32 i = (start + k) % nWorkers;
+						if (flagsSleeping[i].exchange(sl_false)) {
+							nSleeping.fetch_sub(1);
+							Ref<Thread>& thread = threads[i];
+							if (thread.isNotNull()) {
+								thread->wakeSelfEvent();
+							}
+							return;
+						}
+					}
+				}
+
+			};
+
+			static SLIB_THREAD WorkStealingContext* g_currentContext = sl_null;
+			static SLIB_THREAD sl_uint32 g_currentIndex = 0;
+
+		}
+	}
+
+	using namespace priv::thread_pool;
+
 	SLIB_DEFINE_OBJECT(ThreadPool, Dispatcher)
 
-	ThreadPool::ThreadPool()
+	ThreadPool::ThreadPool(sl_uint32 sizeTaskQueue): m_tasks(sizeTaskQueue), m_nSleeping(0)
 	{
 		setThreadStackSize(SLIB_THREAD_DEFAULT_STACK_SIZE);
 		m_flagRunning = sl_true;
+		m_timers = TimerWheel::create(System::getTickCount64());
 	}
 
 	ThreadPool::~ThreadPool()
@@ -38,9 +308,9 @@ namespace slib
 		release();
 	}
 
-	Ref<ThreadPool> ThreadPool::create(sl_uint32 minThreads, sl_uint32 maxThreads)
+	Ref<ThreadPool> ThreadPool::create(sl_uint32 minThreads, sl_uint32 maxThreads, sl_uint32 sizeTaskQueue)
 	{
-		Ref<ThreadPool> ret = new ThreadPool();
+		Ref<ThreadPool> ret = new ThreadPool(sizeTaskQueue);
 		if (ret.isNotNull()) {
 			ret->setMinimumThreadsCount(minThreads);
 			ret->setMaximumThreadsCount(maxThreads);
@@ -48,6 +318,39 @@ namespace slib
 		return ret;
 	}
 
+	Ref<ThreadPool> ThreadPool::createWorkStealing(sl_uint32 nThreads, sl_uint32 sizeInjectionQueue)
+	{
+		if (!nThreads) {
+			nThreads = System::getProcessorsCount();
+		}
+		// the tasks go through the injection queue and the deques, so the shared task queue is kept at the minimum size
+		Ref<ThreadPool> ret = new ThreadPool(0);
+		if (ret.isNull()) {
+			return sl_null;
+		}
+		ret->setMinimumThreadsCount(nThreads);
+		ret->setMaximumThreadsCount(nThreads);
+		Ref<WorkStealingContext> context = new WorkStealingContext(nThreads, sizeInjectionQueue);
+		if (context.isNull()) {
+			return sl_null;
+		}
+		ret->m_stealing = context;
+		for (sl_uint32 i = 0; i < nThreads; i++) {
+			Ref<Thread> worker = Thread::create(SLIB_BIND_MEMBER(void(), ThreadPool, _runStealingWorker, ret.get(), i));
+			if (worker.isNull()) {
+				return sl_null;
+			}
+			context->threads[i] = worker;
+			ret->m_threadWorkers.add_NoLock(worker);
+		}
+		for (sl_uint32 i = 0; i < nThreads; i++) {
+			if (!(context->threads[i]->start(ret->getThreadStackSize()))) {
+				return sl_null;
+			}
+		}
+		return ret;
+	}
+
 	void ThreadPool::release()
 	{
 		ObjectLocker lock(this);
@@ -56,6 +359,17 @@ namespace slib
 		}
 		m_flagRunning = sl_false;
 		
+		Ref<Thread> threadTimer = m_threadTimer;
+		if (threadTimer.isNotNull()) {
+			// the timer thread adds tasks under the object lock
+			lock.unlock();
+			threadTimer->finishAndWait();
+			lock.lock(this);
+		}
+		if (m_timers.isNotNull()) {
+			m_timers->removeAll();
+		}
+		
 		ListElements< Ref<Thread> > threads(m_threadWorkers);
 		sl_size i;
 		for (i = 0; i < threads.count; i++) {
@@ -76,24 +390,49 @@ namespace slib
 		return (sl_uint32)(m_threadWorkers.getCount());
 	}
 
+	sl_bool ThreadPool::isWorkStealing()
+	{
+		return m_stealing.isNotNull();
+	}
+
 	sl_bool ThreadPool::addTask(const Function<void()>& task)
 	{
 		if (task.isNull()) {
 			return sl_false;
 		}
-		ObjectLocker lock(this);
+		if (m_stealing.isNotNull()) {
+			return _addStealingTask(task);
+		}
 		if (!m_flagRunning) {
 			return sl_false;
 		}
 		// add task
 		if (!(m_tasks.push(task))) {
-			return sl_false;
+			if (!(m_tasksOverflow.push(task))) {
+				return sl_false;
+			}
+		}
+
+		// pairs with the fence of `onRunWorker()`: either the sleeping worker sees the task, or this sees the worker
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_nSleeping.load(std::memory_order_relaxed) <= 0) {
+			sl_size nThreads = m_threadWorkers.getCount();
+			if (nThreads && nThreads >= getMaximumThreadsCount()) {
+				// all the workers are busy, no lock is needed
+				return sl_true;
+			}
+		}
+
+		ObjectLocker lock(this);
+		if (!m_flagRunning) {
+			return sl_true;
 		}
 
 		// wake a sleeping worker
 		{
 			Ref<Thread> thread;
 			if (m_threadSleeping.pop_NoLock(&thread)) {
+				m_nSleeping.fetch_sub(1, std::memory_order_relaxed);
 				thread->wakeSelfEvent();
 				return sl_true;
 			}
@@ -114,9 +453,63 @@ namespace slib
 
 	sl_bool ThreadPool::dispatch(const Function<void()>& callback, sl_uint64 delay_ms)
 	{
+		if (delay_ms) {
+			return setTimeout(callback, delay_ms).isNotNull();
+		}
 		return addTask(callback);
 	}
 
+	Ref<TimerWheelEntry> ThreadPool::setTimeout(const Function<void()>& task, sl_uint64 delay_ms)
+	{
+		if (task.isNull() || m_timers.isNull()) {
+			return sl_null;
+		}
+		if (m_threadTimer.isNull()) {
+			ObjectLocker lock(this);
+			if (!m_flagRunning) {
+				return sl_null;
+			}
+			if (m_threadTimer.isNull()) {
+				Ref<Thread> thread = Thread::start(SLIB_FUNCTION_MEMBER(ThreadPool, _runTimer, this));
+				if (thread.isNull()) {
+					return sl_null;
+				}
+				m_threadTimer = thread;
+			}
+		}
+		if (!m_flagRunning) {
+			return sl_null;
+		}
+		sl_bool flagEarliest = sl_false;
+		Ref<TimerWheelEntry> entry = m_timers->add(task, System::getTickCount64() + delay_ms, &flagEarliest);
+		if (entry.isNotNull() && flagEarliest) {
+			Ref<Thread> thread = m_threadTimer;
+			if (thread.isNotNull()) {
+				thread->wakeSelfEvent();
+			}
+		}
+		return entry;
+	}
+
+	void ThreadPool::_runTimer()
+	{
+		Ref<Thread> thread = Thread::getCurrent();
+		if (thread.isNull()) {
+			return;
+		}
+		List< Function<void()> > tasks;
+		while (m_flagRunning && thread->isNotStopping()) {
+			sl_uint64 now = System::getTickCount64();
+			m_timers->advance(now, tasks);
+			ListElements< Function<void()> > items(tasks);
+			for (sl_size i = 0; i < items.count; i++) {
+				addTask(items[i]);
+			}
+			tasks.setNull();
+			thread->wait(m_timers->getTimeout(now));
+		}
+	}
+
 	void ThreadPool::onRunWorker()
 	{
 		Ref<Thread> thread = Thread::getCurrent();
@@ -125,21 +518,102 @@ namespace slib
 		}
 		while (m_flagRunning && thread->isNotStopping()) {
 			Function<void()> task;
-			if (m_tasks.pop(&task)) {
+			if (m_tasks.pop(&task) || (m_tasksOverflow.isNotEmpty() && m_tasksOverflow.pop(&task))) {
 				task();
 			} else {
 				ObjectLocker lock(this);
 				sl_size nThreads = m_threadWorkers.getCount();
 				if (nThreads > getMinimumThreadsCount()) {
 					m_threadWorkers.remove_NoLock(thread);
-					return;
-				} else {
-					m_threadSleeping.push_NoLock(thread);
-					lock.unlock();
-					thread->wait();
+					// pairs with the fence of `addTask()`, which counts the workers without the lock
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (!(_hasTasks())) {
+						return;
+					}
+					m_threadWorkers.add_NoLock(thread);
+					continue;
 				}
+				m_threadSleeping.push_NoLock(thread);
+				m_nSleeping.fetch_add(1, std::memory_order_relaxed);
+				lock.unlock();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (_hasTasks()) {
+					// a task was added before `addTask()` could see this worker
+					lock.lock(this);
+					if (m_threadSleeping.remove_NoLock(thread)) {
+						m_nSleeping.fetch_sub(1, std::memory_order_relaxed);
+					}
+					// otherwise the worker is already woken, and the next wait returns immediately
+					continue;
+				}
+				thread->wait();
+			}
+		}
+	}
+
+	sl_bool ThreadPool::_hasTasks()
+	{
+		return m_tasks.isNotEmpty() || m_tasksOverflow.isNotEmpty();
+	}
+
+	sl_bool ThreadPool::_addStealingTask(const Function<void()>& task)
+	{
+		if (!m_flagRunning) {
+			return sl_false;
+		}
+		WorkStealingContext* context = m_stealing.get();
+		Task* t = RetainTask(task);
+		if (g_currentContext == context) {
+			context->deques[g_currentIndex].push(t);
+		} else if (!(context->injection.push(t))) {
+			t->decreaseReference();
+			if (!(context->overflow.push(task))) {
+				return sl_false;
+			}
+		}
+		context->wakeWorker();
+		return sl_true;
+	}
+
+	void ThreadPool::_runStealingWorker(sl_uint32 index)
+	{
+		Ref<Thread> thread = Thread::getCurrent();
+		if (thread.isNull()) {
+			return;
+		}
+		Ref<WorkStealingContext> context = m_stealing;
+		if (context.isNull()) {
+			return;
+		}
+		g_currentContext = context.get();
+		g_currentIndex = index;
+		std::atomic<sl_bool>& flagSleeping = context->flagsSleeping[index];
+		sl_uint32 nSpin = 0;
+		while (m_flagRunning && thread->isNotStopping()) {
+			Task* task = context->popTask(index);
+			if (task) {
+				RunTask(task);
+				nSpin = 0;
+				continue;
+			}
+			if (nSpin < WORK_STEALING_SPIN_COUNT) {
+				System::yield(nSpin);
+				nSpin++;
+				continue;
+			}
+			nSpin = 0;
+			// announce sleeping before the last check, so that a submitter either sees us or we see its task
+			flagSleeping.store(sl_true);
+			context->nSleeping.fetch_add(1);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!(context->hasTasks()) && m_flagRunning) {
+				thread->wait();
+			}
+			if (flagSleeping.exchange(sl_false)) {
+				context->nSleeping.fetch_sub(1);
 			}
 		}
+		g_currentContext = sl_null;
 	}
 
 }
@@ -44,6 +44,9 @@ namespace slib
 
 	Timer::~Timer()
 	{
+		if (m_entry.isNotNull()) {
+			m_entry->cancel();
+		}
 	}
 	
 	Ref<Timer> Timer::create(const Function<void(Timer*)>& task, sl_uint64 interval_ms)
@@ -142,12 +145,12 @@ namespace slib
 		ObjectLocker lock(this);
 		if (m_flagStarted) {
 			m_flagStarted = sl_false;
-			if (m_dispatcher.isNull()) {
-				Ref<DispatchLoop> loop = m_loop;
-				if (loop.isNotNull()) {
-					lock.unlock();
-					loop->removeTimer(this);
-				}
+			if (m_entry.isNotNull()) {
+				// canceling the entry locks the timer wheel only, not the loop
+				Ref<TimerWheelEntry> entry = m_entry;
+				m_entry.setNull();
+				lock.unlock();
+				entry->cancel();
 			}
 		}
 	}
@@ -0,0 +1,362 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#include "slib/core/timer_wheel.h"
+
+#include "slib/core/math.h"
+
+#define LEVEL_SHIFT(LEVEL) ((LEVEL) * SLIB_TIMER_WHEEL_SLOT_BITS)
+#define SLOT_MASK (SLIB_TIMER_WHEEL_SLOTS - 1)
+#define MAX_DELAY ((((sl_uint64)1) << LEVEL_SHIFT(SLIB_TIMER_WHEEL_LEVELS)) - 1)
+#define MAX_TIMEOUT 0x7fffffff
+
+namespace slib
+{
+	
+	SLIB_DEFINE_OBJECT(TimerWheelEntry, Referable)
+	
+	TimerWheelEntry::TimerWheelEntry()
+	{
+		m_time = 0;
+		m_prev = sl_null;
+		m_next = sl_null;
+		m_slot = sl_null;
+	}
+	
+	TimerWheelEntry::~TimerWheelEntry()
+	{
+	}
+	
+	sl_uint64 TimerWheelEntry::getTime()
+	{
+		return m_time;
+	}
+	
+	sl_bool TimerWheelEntry::isPending()
+	{
+		return m_slot != sl_null;
+	}
+	
+	sl_bool TimerWheelEntry::cancel()
+	{
+		Ref<TimerWheel> wheel(m_wheel);
+		if (wheel.isNotNull()) {
+			return wheel->remove(this);
+		}
+		return sl_false;
+	}
+	
+	
+	SLIB_DEFINE_OBJECT(TimerWheel, Object)
+	
+	TimerWheel::TimerWheel()
+	{
+		Base::zeroMemory(m_slots, sizeof(m_slots));
+		Base::zeroMemory(m_bitmaps, sizeof(m_bitmaps));
+		m_timeCurrent = 0;
+		m_timeExpected = 0;
+		m_count = 0;
+	}
+	
+	TimerWheel::~TimerWheel()
+	{
+		removeAll();
+	}
+	
+	Ref<TimerWheel> TimerWheel::create(sl_uint64 timeStart)
+	{
+		Ref<TimerWheel> ret = new TimerWheel;
+		if (ret.isNotNull()) {
+			ret->m_timeCurrent = timeStart;
+			ret->m_timeExpected = timeStart;
+		}
+		return ret;
+	}
+	
+	Ref<TimerWheelEntry> TimerWheel::add(const Function<void()>& task, sl_uint64 time, sl_bool* pFlagEarliest)
+	{
+		if (task.isNull()) {
+			return sl_null;
+		}
+		Ref<TimerWheelEntry> entry = new TimerWheelEntry;
+		if (entry.isNull()) {
+			return sl_null;
+		}
+		entry->m_task = task;
+		entry->m_time = time;
+		entry->m_wheel = this;
+		ObjectLocker lock(this);
+		// the wheel holds a reference while the entry is pending
+		entry->increaseReference();
+		_insert(entry.get());
+		m_count++;
+		if (pFlagEarliest) {
+			*pFlagEarliest = time < m_timeExpected;
+		}
+		if (time < m_timeExpected) {
+			m_timeExpected = time;
+		}
+		return entry;
+	}
+	
+	sl_bool TimerWheel::remove(TimerWheelEntry* entry)
+	{
+		if (!entry) {
+			return sl_false;
+		}
+		ObjectLocker lock(this);
+		if (!(entry->m_slot)) {
+			return sl_false;
+		}
+		_unlink(entry);
+		m_count--;
+		lock.unlock();
+		entry->decreaseReference();
+		return sl_true;
+	}
+	
+	void TimerWheel::removeAll()
+	{
+		List< Ref<TimerWheelEntry> > entries;
+		ObjectLocker lock(this);
+		for (sl_uint32 level = 0; level < SLIB_TIMER_WHEEL_LEVELS; level++) {
+			for (sl_uint32 i = 0; i < SLIB_TIMER_WHEEL_SLOTS; i++) {
+				TimerWheelEntry* entry = m_slots[level][i];
+				while (entry) {
+					TimerWheelEntry* next = entry->m_next;
+					entry->m_prev = sl_null;
+					entry->m_next = sl_null;
+					entry->m_slot = sl_null;
+					entries.add_NoLock(entry);
+					entry->decreaseReference();
+					entry = next;
+				}
+				m_slots[level][i] = sl_null;
+			}
+		}
+		Base::zeroMemory(m_bitmaps, sizeof(m_bitmaps));
+		m_count = 0;
+		lock.unlock();
+		// entries are released out of the lock
+	}
+	
+	sl_size TimerWheel::getCount()
+	{
+		return m_count;
+	}
+	
+	void TimerWheel::advance(sl_uint64 time, List< Function<void()> >& tasks)
+	{
+		ObjectLocker lock(this);
+		while (m_timeCurrent <= time) {
+			if (!m_count) {
+				m_timeCurrent = time + 1;
+				break;
+			}
+			sl_uint32 index = (sl_uint32)(m_timeCurrent & SLOT_MASK);
+			if (!index) {
+				for (sl_uint32 level = 1; level < SLIB_TIMER_WHEEL_LEVELS; level++) {
+					sl_uint32 k = (sl_uint32)((m_timeCurrent >> LEVEL_SHIFT(level)) & SLOT_MASK);
+					_cascade(level, k);
+					if (k) {
+						break;
+					}
+				}
+			}
+			TimerWheelEntry* entry = m_slots[0][index];
+			if (!entry) {
+				// skip to the next occupied slot or the next round
+				sl_int32 next = _findNextSlot(0, index);
+				sl_uint64 n = (next < 0 ? SLIB_TIMER_WHEEL_SLOTS : (sl_uint32)next) - index;
+				if (n > time + 1 - m_timeCurrent) {
+					n = time + 1 - m_timeCurrent;
+				}
+				m_timeCurrent += n;
+				continue;
+			}
+			m_slots[0][index] = sl_null;
+			m_bitmaps[0][index >> 6] &= ~(((sl_uint64)1) << (index & 63));
+			while (entry) {
+				TimerWheelEntry* next = entry->m_next;
+				entry->m_prev = sl_null;
+				entry->m_next = sl_null;
+				entry->m_slot = sl_null;
+				if (entry->m_time > m_timeCurrent) {
+					// clamped to the top level when added
+					_insert(entry);
+				} else {
+					m_count--;
+					tasks.add_NoLock(Move(entry->m_task));
+					entry->decreaseReference();
+				}
+				entry = next;
+			}
+			m_timeCurrent++;
+		}
+	}
+	
+	sl_int32 TimerWheel::getTimeout(sl_uint64 time)
+	{
+		ObjectLocker lock(this);
+		if (!m_count) {
+			m_timeExpected = (sl_uint64)-1;
+			return -1;
+		}
+		// level 0 holds the entries of the next 256 ticks, and an upper level slot is cascaded when the lower levels wrap around
+		sl_uint64 expected = (sl_uint64)-1;
+		for (sl_uint32 level = 0; level < SLIB_TIMER_WHEEL_LEVELS; level++) {
+			sl_uint64 base = m_timeCurrent >> LEVEL_SHIFT(level);
+			sl_uint32 index = (sl_uint32)(base & SLOT_MASK);
+			sl_int32 next;
+			if (level) {
+				next = _findNextSlotCyclic(level, index + 1);
+			} else {
+				next = _findNextSlotCyclic(0, index);
+			}
+			if (next >= 0) {
+				sl_uint64 distance = ((sl_uint32)next - index) & SLOT_MASK;
+				if (level && !distance) {
+					distance = SLIB_TIMER_WHEEL_SLOTS;
+				}
+				sl_uint64 t;
+				if (level) {
+					t = (base + distance) << LEVEL_SHIFT(level);
+				} else {
+					t = m_timeCurrent + distance;
+				}
+				if (t < expected) {
+					expected = t;
+				}
+			}
+		}
+		m_timeExpected = expected;
+		if (expected <= time) {
+			return 0;
+		}
+		sl_uint64 t = expected - time;
+		if (t > MAX_TIMEOUT) {
+			return MAX_TIMEOUT;
+		}
+		return (sl_int32)t;
+	}
+	
+	void TimerWheel::_insert(TimerWheelEntry* entry)
+	{
+		sl_uint64 time = entry->m_time;
+		if (time < m_timeCurrent) {
+			time = m_timeCurrent;
+		}
+		sl_uint64 delay = time - m_timeCurrent;
+		sl_uint32 level;
+		if (delay > MAX_DELAY) {
+			time = m_timeCurrent + MAX_DELAY;
+			level = SLIB_TIMER_WHEEL_LEVELS - 1;
+		} else {
+			level = 0;
+			while (level < SLIB_TIMER_WHEEL_LEVELS - 1 && (delay >> LEVEL_SHIFT(level + 1))) {
+				level++;
+			}
+		}
+		sl_uint32 index = (sl_uint32)((time >> LEVEL_SHIFT(level)) & SLOT_MASK);
+		TimerWheelEntry** slot = &(m_slots[level][index]);
+		TimerWheelEntry* head = *slot;
+		entry->m_prev = sl_null;
+		entry->m_next = head;
+		if (head) {
+			head->m_prev = entry;
+		}
+		*slot = entry;
+		entry->m_slot = slot;
+		m_bitmaps[level][index >> 6] |= ((sl_uint64)1) << (index & 63);
+	}
+	
+	void TimerWheel::_unlink(TimerWheelEntry* entry)
+	{
+		TimerWheelEntry** slot = entry->m_slot;
+		if (entry->m_prev) {
+			entry->m_prev->m_next = entry->m_next;
+		} else {
+			*slot = entry->m_next;
+			if (!(entry->m_next)) {
+				sl_size index = slot - m_slots[0];
+				m_bitmaps[index >> SLIB_TIMER_WHEEL_SLOT_BITS][(index & SLOT_MASK) >> 6] &= ~(((sl_uint64)1) << (index & 63));
+			}
+		}
+		if (entry->m_next) {
+			entry->m_next->m_prev = entry->m_prev;
+		}
+		entry->m_prev = sl_null;
+		entry->m_next = sl_null;
+		entry->m_slot = sl_null;
+	}
+	
+	void TimerWheel::_cascade(sl_uint32 level, sl_uint32 index)
+	{
+		TimerWheelEntry* entry = m_slots[level][index];
+		if (!entry) {
+			return;
+		}
+		m_slots[level][index] = sl_null;
+		m_bitmaps[level][index >> 6] &= ~(((sl_uint64)1) << (index & 63));
+		while (entry) {
+			TimerWheelEntry* next = entry->m_next;
+			_insert(entry);
+			entry = next;
+		}
+	}
+	
+	sl_int32 TimerWheel::_findNextSlot(sl_uint32 level, sl_uint32 index)
+	{
+		// first occupied slot after `index`
+		index++;
+		while (index < SLIB_TIMER_WHEEL_SLOTS) {
+			sl_uint64 bits = m_bitmaps[level][index >> 6] >> (index & 63);
+			if (bits) {
+				return (sl_int32)(index + Math::getLeastSignificantBits(bits));
+			}
+			index = (index | 63) + 1;
+		}
+		return -1;
+	}
+	
+	sl_int32 TimerWheel::_findNextSlotCyclic(sl_uint32 level, sl_uint32 index)
+	{
+		// first occupied slot from `index`, wrapping around
+		index &= SLOT_MASK;
+		if (m_slots[level][index]) {
+			return (sl_int32)index;
+		}
+		sl_int32 next = _findNextSlot(level, index);
+		if (next >= 0) {
+			return next;
+		}
+		if (m_slots[level][0]) {
+			return 0;
+		}
+		next = _findNextSlot(level, 0);
+		if (next >= 0 && (sl_uint32)next < index) {
+			return next;
+		}
+		return -1;
+	}
+	
+}
@@ -24,7 +24,7 @@
 
 #include "slib/core/variant.h"
 
-#include "slib/core/string_buffer.h"
+#include "slib/core/string_builder.h"
 #include "slib/core/math.h"
 
 #define PTR_VAR(TYPE, x) ((TYPE*)((void*)(&(x))))
@@ -2109,13 +2109,13 @@ namespace slib
 	{
 		namespace variant
 		{
-			static sl_bool getVariantListJsonString(StringBuffer& ret, const List<Variant>& list) noexcept;
-			static sl_bool getVariantMapJsonString(StringBuffer& ret, const Map<String, Variant>& map) noexcept;
-			static sl_bool getVariantHashMapJsonString(StringBuffer& ret, const HashMap<String, Variant>& map) noexcept;
-			static sl_bool getVariantMapListJsonString(StringBuffer& ret, const List< Map<String, Variant> >& list) noexcept;
-			static sl_bool getVariantHashMapListJsonString(StringBuffer& ret, const List< HashMap<String, Variant> >& list) noexcept;
+			static sl_bool getVariantListJsonString(StringBuilder& ret, const List<Variant>& list) noexcept;
+			static sl_bool getVariantMapJsonString(StringBuilder& ret, const Map<String, Variant>& map) noexcept;
+			static sl_bool getVariantHashMapJsonString(StringBuilder& ret, const HashMap<String, Variant>& map) noexcept;
+			static sl_bool getVariantMapListJsonString(StringBuilder& ret, const List< Map<String, Variant> >& list) noexcept;
+			static sl_bool getVariantHashMapListJsonString(StringBuilder& ret, const List< HashMap<String, Variant> >& list) noexcept;
 			
-			static sl_bool getVariantJsonString(StringBuffer& ret, const Variant& v) noexcept
+			static sl_bool getVariantJsonString(StringBuilder& ret, const Variant& v) noexcept
 			{
 				if (v.isObject()) {
 					Ref<Referable> obj(v.getObject());
@@ -2148,6 +2148,30 @@ namespace slib
 						}
 					}
 				}
+				switch (v._type) {
+					case VariantType::Null:
+						return ret.addStatic("null");
+					case VariantType::Int32:
+						return ret.addInt32(REF_VAR(sl_int32 const, v._value));
+					case VariantType::Uint32:
+						return ret.addUint32(REF_VAR(sl_uint32 const, v._value));
+					case VariantType::Int64:
+						return ret.addInt64(REF_VAR(sl_int64 const, v._value));
+					case VariantType::Uint64:
+						return ret.addUint64(REF_VAR(sl_uint64 const, v._value));
+					case VariantType::Float:
+						return ret.addFloat(REF_VAR(float const, v._value));
+					case VariantType::Double:
+						return ret.addDouble(REF_VAR(double const, v._value));
+					case VariantType::Boolean:
+						if (REF_VAR(sl_bool const, v._value)) {
+							return ret.addStatic("true");
+						} else {
+							return ret.addStatic("false");
+						}
+					default:
+						break;
+				}
 				String valueText = v.toJsonString();
 				if (!(ret.add(valueText))) {
 					return sl_false;
@@ -2155,7 +2179,7 @@ namespace slib
 				return sl_true;
 			}
 			
-			static sl_bool getVariantListJsonString(StringBuffer& ret, const List<Variant>& list) noexcept
+			static sl_bool getVariantListJsonString(StringBuilder& ret, const List<Variant>& list) noexcept
 			{
 				ListLocker<Variant> l(list);
 				sl_size n = l.count;
@@ -2181,7 +2205,7 @@ namespace slib
 				return sl_true;
 			}
 			
-			static sl_bool getVariantMapJsonString(StringBuffer& ret, const Map<String, Variant>& map) noexcept
+			static sl_bool getVariantMapJsonString(StringBuilder& ret, const Map<String, Variant>& map) noexcept
 			{
 				MutexLocker lock(map.getLocker());
 				if (!(ret.addStatic("{"))) {
@@ -2214,7 +2238,7 @@ namespace slib
 				return sl_true;
 			}
 			
-			static sl_bool getVariantHashMapJsonString(StringBuffer& ret, const HashMap<String, Variant>& map) noexcept
+			static sl_bool getVariantHashMapJsonString(StringBuilder& ret, const HashMap<String, Variant>& map) noexcept
 			{
 				MutexLocker lock(map.getLocker());
 				if (!(ret.addStatic("{"))) {
@@ -2247,7 +2271,7 @@ namespace slib
 				return sl_true;
 			}
 			
-			static sl_bool getVariantMapListJsonString(StringBuffer& ret, const List< Map<String, Variant> >& list) noexcept
+			static sl_bool getVariantMapListJsonString(StringBuilder& ret, const List< Map<String, Variant> >& list) noexcept
 			{
 				ListLocker< Map<String, Variant> > l(list);
 				sl_size n = l.count;
@@ -2273,7 +2297,7 @@ namespace slib
 				return sl_true;
 			}
 			
-			static sl_bool getVariantHashMapListJsonString(StringBuffer& ret, const List< HashMap<String, Variant> >& list) noexcept
+			static sl_bool getVariantHashMapListJsonString(StringBuilder& ret, const List< HashMap<String, Variant> >& list) noexcept
 			{
 				ListLocker< HashMap<String, Variant> > l(list);
 				sl_size n = l.count;
@@ -2327,35 +2351,35 @@ namespace slib
 					Ref<Referable> obj(getObject());
 					if (obj.isNotNull()) {
 						if (CList<Variant>* p1 = CastInstance< CList<Variant> >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantListJsonString(ret, p1)) {
 								return "<json-error>";
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CMap<String, Variant>* p2 = CastInstance< CMap<String, Variant> >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantMapJsonString(ret, p2)) {
 								return "<json-error>";
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CHashMap<String, Variant>* p3 = CastInstance< CHashMap<String, Variant> >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantHashMapJsonString(ret, p3)) {
 								return "<json-error>";
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CList< Map<String, Variant> >* p4 = CastInstance< CList< Map<String, Variant> > >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantMapListJsonString(ret, p4)) {
 								return "<json-error>";
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CList< HashMap<String, Variant> >* p5 = CastInstance< CList< HashMap<String, Variant> > >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantHashMapListJsonString(ret, p5)) {
 								return "<json-error>";
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else {
 							return String::format("<object:%s>", obj->getObjectType());
 						}
@@ -2395,35 +2419,35 @@ namespace slib
 					Ref<Referable> obj(getObject());
 					if (obj.isNotNull()) {
 						if (CList<Variant>* p1 = CastInstance< CList<Variant> >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantListJsonString(ret, p1)) {
 								return strNull;
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CMap<String, Variant>* p2 = CastInstance< CMap<String, Variant> >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantMapJsonString(ret, p2)) {
 								return strNull;
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CHashMap<String, Variant>* p3 = CastInstance< CHashMap<String, Variant> >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantHashMapJsonString(ret, p3)) {
 								return strNull;
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CList< Map<String, Variant> >* p4 = CastInstance< CList< Map<String, Variant> > >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantMapListJsonString(ret, p4)) {
 								return strNull;
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else if (CList< HashMap<String, Variant> >* p5 = CastInstance< CList< HashMap<String, Variant> > >(obj._ptr)) {
-							StringBuffer ret;
+							StringBuilder ret;
 							if (!priv::variant::getVariantHashMapListJsonString(ret, p5)) {
 								return strNull;
 							}
-							return ret.merge();
+							return ret.releaseString();
 						} else {
 							return strNull;
 						}
@@ -25,6 +25,7 @@
 #include "slib/core/file.h"
 #include "slib/core/log.h"
 #include "slib/core/string_buffer.h"
+#include "slib/core/string_builder.h"
 
 namespace slib
 {
@@ -44,20 +45,38 @@ namespace slib
 		return m_type;
 	}
 
-	String XmlNode::getText() const
+	sl_bool XmlNode::buildText(StringBuilder& output) const
 	{
 		StringBuffer buf;
 		if (buildText(buf)) {
-			return buf.merge();
+			return output.add(buf.merge());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlNode::buildXml(StringBuilder& output) const
+	{
+		StringBuffer buf;
+		if (buildXml(buf)) {
+			return output.add(buf.merge());
+		}
+		return sl_false;
+	}
+
+	String XmlNode::getText() const
+	{
+		StringBuilder buf;
+		if (buildText(buf)) {
+			return buf.releaseString();
 		}
 		return sl_null;
 	}
 
 	String XmlNode::toString() const
 	{
-		StringBuffer buf;
+		StringBuilder buf;
 		if (buildXml(buf)) {
-			return buf.merge();
+			return buf.releaseString();
 		}
 		return sl_null;
 	}
@@ -241,6 +260,15 @@ namespace slib
 	}
 
 	sl_bool XmlNodeGroup::buildText(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildText(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlNodeGroup::buildText(StringBuilder& output) const
 	{
 		ListLocker< Ref<XmlNode> > children(m_children);
 		for (sl_size i = 0; i < children.count; i++) {
@@ -254,6 +282,15 @@ namespace slib
 	}
 
 	sl_bool XmlNodeGroup::buildInnerXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildInnerXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlNodeGroup::buildInnerXml(StringBuilder& output) const
 	{
 		ListLocker< Ref<XmlNode> > children(m_children);
 		for (sl_size i = 0; i < children.count; i++) {
@@ -268,9 +305,9 @@ namespace slib
 
 	String XmlNodeGroup::getInnerXml() const
 	{
-		StringBuffer buf;
+		StringBuilder buf;
 		if (buildInnerXml(buf)) {
-			return buf.merge();
+			return buf.releaseString();
 		}
 		return sl_null;
 	}
@@ -658,6 +695,15 @@ namespace slib
 	}
 
 	sl_bool XmlElement::buildXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlElement::buildXml(StringBuilder& output) const
 	{
 		String name = m_name;
 		if (name.isEmpty()) {
@@ -1002,6 +1048,15 @@ namespace slib
 	}
 
 	sl_bool XmlDocument::buildXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlDocument::buildXml(StringBuilder& output) const
 	{
 		return buildInnerXml(output);
 	}
@@ -1084,11 +1139,29 @@ namespace slib
 	}
 
 	sl_bool XmlText::buildText(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildText(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlText::buildText(StringBuilder& output) const
 	{
 		return output.add(m_text);
 	}
 
 	sl_bool XmlText::buildXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlText::buildXml(StringBuilder& output) const
 	{
 		String text = m_text;
 		if (text.isEmpty()) {
@@ -1181,11 +1254,29 @@ namespace slib
 	}
 
 	sl_bool XmlProcessingInstruction::buildText(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildText(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlProcessingInstruction::buildText(StringBuilder& output) const
 	{
 		return sl_true;
 	}
 
 	sl_bool XmlProcessingInstruction::buildXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlProcessingInstruction::buildXml(StringBuilder& output) const
 	{
 		String target = m_target;
 		if (target.isEmpty()) {
@@ -1281,11 +1372,29 @@ namespace slib
 	}
 
 	sl_bool XmlComment::buildText(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildText(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlComment::buildText(StringBuilder& output) const
 	{
 		return sl_true;
 	}
 
 	sl_bool XmlComment::buildXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlComment::buildXml(StringBuilder& output) const
 	{
 		String comment = m_comment;
 		if (comment.isEmpty()) {
@@ -1359,11 +1468,29 @@ namespace slib
 	}
 
 	sl_bool XmlWhiteSpace::buildText(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildText(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlWhiteSpace::buildText(StringBuilder& output) const
 	{
 		return sl_true;
 	}
 
 	sl_bool XmlWhiteSpace::buildXml(StringBuffer& output) const
+	{
+		StringBuilder builder;
+		if (buildXml(builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool XmlWhiteSpace::buildXml(StringBuilder& output) const
 	{
 		if (!(output.add(m_content))) {
 			return sl_false;
@@ -2506,14 +2633,23 @@ namespace slib
 	
 	String Xml::encodeTextToEntities(const String& text)
 	{
-		StringBuffer buf;
+		StringBuilder buf;
 		if (encodeTextToEntities(text, buf)) {
-			return buf.merge();
+			return buf.releaseString();
 		}
 		return sl_null;
 	}
 
 	sl_bool Xml::encodeTextToEntities(const String& text, StringBuffer& output)
+	{
+		StringBuilder builder;
+		if (encodeTextToEntities(text, builder)) {
+			return output.add(builder.releaseString());
+		}
+		return sl_false;
+	}
+
+	sl_bool Xml::encodeTextToEntities(const String& text, StringBuilder& output)
 	{
 		StringStorage data;
 		StringStorage dataEscape;
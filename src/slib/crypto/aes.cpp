@@ -25,6 +25,23 @@
 #include "slib/crypto/sha2.h"
 #include "slib/core/mio.h"
 
+#if defined(SLIB_ARCH_IS_X64)
+#	define SLIB_AES_SUPPORT_HW
+#	define SLIB_AES_USE_AESNI
+#	include "slib/core/asm.h"
+#	include <immintrin.h>
+#	if defined(SLIB_COMPILER_IS_GCC)
+#		define SLIB_AES_TARGET_HW __attribute__((target("aes,ssse3")))
+#	else
+#		define SLIB_AES_TARGET_HW
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#	define SLIB_AES_SUPPORT_HW
+#	define SLIB_AES_USE_ARMV8
+#	include <arm_neon.h>
+#	define SLIB_AES_TARGET_HW
+#endif
+
 /*
 	AES - Advanced Encryption Standard
 
@@ -401,7 +418,302 @@ namespace slib
 				d2 = S1[2];
 				d3 = S1[3];
 			}
-			
+
+#if defined(SLIB_AES_SUPPORT_HW)
+#	if defined(SLIB_AES_USE_AESNI)
+			typedef __m128i HwBlock;
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static HwBlock LoadBlock(const void* p) noexcept
+			{
+				return _mm_loadu_si128((const __m128i*)p);
+			}
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static void StoreBlock(void* p, HwBlock b) noexcept
+			{
+				_mm_storeu_si128((__m128i*)p, b);
+			}
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static HwBlock XorBlock(HwBlock a, HwBlock b) noexcept
+			{
+				return _mm_xor_si128(a, b);
+			}
+
+			// round keys are stored as big-endian words
+			SLIB_AES_TARGET_HW SLIB_INLINE static HwBlock LoadRoundKey(const sl_uint32* W) noexcept
+			{
+				return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)W), _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3));
+			}
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static HwBlock MakeCounterBlock(sl_uint64 high, sl_uint64 low) noexcept
+			{
+				return _mm_shuffle_epi8(_mm_set_epi64x((sl_int64)high, (sl_int64)low), _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			}
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static HwBlock Encipher_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock b) noexcept
+			{
+				b = _mm_xor_si128(b, K[0]);
+				for (sl_uint32 i = 1; i < nRounds; i++) {
+					b = _mm_aesenc_si128(b, K[i]);
+				}
+				return _mm_aesenclast_si128(b, K[nRounds]);
+			}
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static HwBlock Decipher_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock b) noexcept
+			{
+				b = _mm_xor_si128(b, K[0]);
+				for (sl_uint32 i = 1; i < nRounds; i++) {
+					b = _mm_aesdec_si128(b, K[i]);
+				}
+				return _mm_aesdeclast_si128(b, K[nRounds]);
+			}
+
+#define AES_HW_ROUND8(FUNC, K) \
+	b[0] = FUNC(b[0], K); b[1] = FUNC(b[1], K); b[2] = FUNC(b[2], K); b[3] = FUNC(b[3], K); \
+	b[4] = FUNC(b[4], K); b[5] = FUNC(b[5], K); b[6] = FUNC(b[6], K); b[7] = FUNC(b[7], K);
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static void Encipher8_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock* b) noexcept
+			{
+				AES_HW_ROUND8(_mm_xor_si128, K[0])
+				for (sl_uint32 i = 1; i < nRounds; i++) {
+					AES_HW_ROUND8(_mm_aesenc_si128, K[i])
+				}
+				AES_HW_ROUND8(_mm_aesenclast_si128, K[nRounds])
+			}
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static void Decipher8_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock* b) noexcept
+			{
+				AES_HW_ROUND8(_mm_xor_si128, K[0])
+				for (sl_uint32 i = 1; i < nRounds; i++) {
+					AES_HW_ROUND8(_mm_aesdec_si128, K[i])
+				}
+				AES_HW_ROUND8(_mm_aesdeclast_si128, K[nRounds])
+			}
+
+			static sl_bool IsHardwareEnabled()
+			{
+				static sl_bool flag = CanUseAesNi();
+				return flag;
+			}
+#	elif defined(SLIB_AES_USE_ARMV8)
+			typedef uint8x16_t HwBlock;
+
+			SLIB_INLINE static HwBlock LoadBlock(const void* p) noexcept
+			{
+				return vld1q_u8((const uint8_t*)p);
+			}
+
+			SLIB_INLINE static void StoreBlock(void* p, HwBlock b) noexcept
+			{
+				vst1q_u8((uint8_t*)p, b);
+			}
+
+			SLIB_INLINE static HwBlock XorBlock(HwBlock a, HwBlock b) noexcept
+			{
+				return veorq_u8(a, b);
+			}
+
+			// round keys are stored as big-endian words
+			SLIB_INLINE static HwBlock LoadRoundKey(const sl_uint32* W) noexcept
+			{
+				return vrev32q_u8(vld1q_u8((const uint8_t*)W));
+			}
+
+			SLIB_INLINE static HwBlock MakeCounterBlock(sl_uint64 high, sl_uint64 low) noexcept
+			{
+				return vcombine_u8(vrev64_u8(vcreate_u8(high)), vrev64_u8(vcreate_u8(low)));
+			}
+
+			// AESE performs AddRoundKey before SubBytes and ShiftRows, so the last round key is added separately
+			SLIB_INLINE static HwBlock Encipher_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock b) noexcept
+			{
+				for (sl_uint32 i = 0; i + 1 < nRounds; i++) {
+					b = vaesmcq_u8(vaeseq_u8(b, K[i]));
+				}
+				return veorq_u8(vaeseq_u8(b, K[nRounds - 1]), K[nRounds]);
+			}
+
+			SLIB_INLINE static HwBlock Decipher_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock b) noexcept
+			{
+				for (sl_uint32 i = 0; i + 1 < nRounds; i++) {
+					b = vaesimcq_u8(vaesdq_u8(b, K[i]));
+				}
+				return veorq_u8(vaesdq_u8(b, K[nRounds - 1]), K[nRounds]);
+			}
+
+#define AES_HW_ROUND8(FUNC, K) \
+	b[0] = FUNC(b[0], K); b[1] = FUNC(b[1], K); b[2] = FUNC(b[2], K); b[3] = FUNC(b[3], K); \
+	b[4] = FUNC(b[4], K); b[5] = FUNC(b[5], K); b[6] = FUNC(b[6], K); b[7] = FUNC(b[7], K);
+
+#define AES_HW_ENC_ROUND(b, K) vaesmcq_u8(vaeseq_u8(b, K))
+#define AES_HW_DEC_ROUND(b, K) vaesimcq_u8(vaesdq_u8(b, K))
+
+			SLIB_INLINE static void Encipher8_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock* b) noexcept
+			{
+				for (sl_uint32 i = 0; i + 1 < nRounds; i++) {
+					AES_HW_ROUND8(AES_HW_ENC_ROUND, K[i])
+				}
+				AES_HW_ROUND8(vaeseq_u8, K[nRounds - 1])
+				AES_HW_ROUND8(veorq_u8, K[nRounds])
+			}
+
+			SLIB_INLINE static void Decipher8_HW(const HwBlock* K, sl_uint32 nRounds, HwBlock* b) noexcept
+			{
+				for (sl_uint32 i = 0; i + 1 < nRounds; i++) {
+					AES_HW_ROUND8(AES_HW_DEC_ROUND, K[i])
+				}
+				AES_HW_ROUND8(vaesdq_u8, K[nRounds - 1])
+				AES_HW_ROUND8(veorq_u8, K[nRounds])
+			}
+
+			static sl_bool IsHardwareEnabled()
+			{
+				return sl_true;
+			}
+#	endif
+
+			SLIB_AES_TARGET_HW SLIB_INLINE static void LoadRoundKeys(const sl_uint32* W, sl_uint32 nRounds, HwBlock* K) noexcept
+			{
+				for (sl_uint32 i = 0; i <= nRounds; i++) {
+					K[i] = LoadRoundKey(W + (i << 2));
+				}
+			}
+
+			SLIB_AES_TARGET_HW static void EncryptBlock_HW(const sl_uint32* W, sl_uint32 nRounds, const void* src, void* dst) noexcept
+			{
+				HwBlock K[15];
+				LoadRoundKeys(W, nRounds, K);
+				StoreBlock(dst, Encipher_HW(K, nRounds, LoadBlock(src)));
+			}
+
+			SLIB_AES_TARGET_HW static void DecryptBlock_HW(const sl_uint32* W, sl_uint32 nRounds, const void* src, void* dst) noexcept
+			{
+				HwBlock K[15];
+				LoadRoundKeys(W, nRounds, K);
+				StoreBlock(dst, Decipher_HW(K, nRounds, LoadBlock(src)));
+			}
+
+			SLIB_AES_TARGET_HW static void EncryptBlocks_HW(const sl_uint32* W, sl_uint32 nRounds, const sl_uint8* src, sl_uint8* dst, sl_size nBlocks) noexcept
+			{
+				HwBlock K[15];
+				LoadRoundKeys(W, nRounds, K);
+				HwBlock b[8];
+				while (nBlocks >= 8) {
+					for (sl_uint32 k = 0; k < 8; k++) {
+						b[k] = LoadBlock(src + (k << 4));
+					}
+					Encipher8_HW(K, nRounds, b);
+					for (sl_uint32 k = 0; k < 8; k++) {
+						StoreBlock(dst + (k << 4), b[k]);
+					}
+					src += 128;
+					dst += 128;
+					nBlocks -= 8;
+				}
+				while (nBlocks) {
+					StoreBlock(dst, Encipher_HW(K, nRounds, LoadBlock(src)));
+					src += 16;
+					dst += 16;
+					nBlocks--;
+				}
+			}
+
+			SLIB_AES_TARGET_HW static void DecryptBlocks_HW(const sl_uint32* W, sl_uint32 nRounds, const sl_uint8* src, sl_uint8* dst, sl_size nBlocks) noexcept
+			{
+				HwBlock K[15];
+				LoadRoundKeys(W, nRounds, K);
+				HwBlock b[8];
+				while (nBlocks >= 8) {
+					for (sl_uint32 k = 0; k < 8; k++) {
+						b[k] = LoadBlock(src + (k << 4));
+					}
+					Decipher8_HW(K, nRounds, b);
+					for (sl_uint32 k = 0; k < 8; k++) {
+						StoreBlock(dst + (k << 4), b[k]);
+					}
+					src += 128;
+					dst += 128;
+					nBlocks -= 8;
+				}
+				while (nBlocks) {
+					StoreBlock(dst, Decipher_HW(K, nRounds, LoadBlock(src)));
+					src += 16;
+					dst += 16;
+					nBlocks--;
+				}
+			}
+
+			// ciphertext blocks are loaded before the output is written, so `src` may equal to `dst`
+			SLIB_AES_TARGET_HW static void DecryptBlocks_CBC_HW(const sl_uint32* W, sl_uint32 nRounds, sl_uint8* _iv, const sl_uint8* src, sl_uint8* dst, sl_size nBlocks) noexcept
+			{
+				HwBlock K[15];
+				LoadRoundKeys(W, nRounds, K);
+				HwBlock iv = LoadBlock(_iv);
+				HwBlock b[8], c[8];
+				while (nBlocks >= 8) {
+					for (sl_uint32 k = 0; k < 8; k++) {
+						c[k] = LoadBlock(src + (k << 4));
+						b[k] = c[k];
+					}
+					Decipher8_HW(K, nRounds, b);
+					StoreBlock(dst, XorBlock(b[0], iv));
+					for (sl_uint32 k = 1; k < 8; k++) {
+						StoreBlock(dst + (k << 4), XorBlock(b[k], c[k - 1]));
+					}
+					iv = c[7];
+					src += 128;
+					dst += 128;
+					nBlocks -= 8;
+				}
+				while (nBlocks) {
+					HwBlock t = LoadBlock(src);
+					StoreBlock(dst, XorBlock(Decipher_HW(K, nRounds, t), iv));
+					iv = t;
+					src += 16;
+					dst += 16;
+					nBlocks--;
+				}
+				StoreBlock(_iv, iv);
+			}
+
+			SLIB_AES_TARGET_HW static void EncryptBlocks_CTR_HW(const sl_uint32* W, sl_uint32 nRounds, sl_uint8* counter, const sl_uint8* src, sl_uint8* dst, sl_size nBlocks) noexcept
+			{
+				HwBlock K[15];
+				LoadRoundKeys(W, nRounds, K);
+				sl_uint64 high = MIO::readUint64BE(counter);
+				sl_uint64 low = MIO::readUint64BE(counter + 8);
+				HwBlock b[8];
+				while (nBlocks >= 8) {
+					for (sl_uint32 k = 0; k < 8; k++) {
+						b[k] = MakeCounterBlock(high, low);
+						low++;
+						if (!low) {
+							high++;
+						}
+					}
+					Encipher8_HW(K, nRounds, b);
+					for (sl_uint32 k = 0; k < 8; k++) {
+						StoreBlock(dst + (k << 4), XorBlock(b[k], LoadBlock(src + (k << 4))));
+					}
+					src += 128;
+					dst += 128;
+					nBlocks -= 8;
+				}
+				while (nBlocks) {
+					HwBlock t = Encipher_HW(K, nRounds, MakeCounterBlock(high, low));
+					StoreBlock(dst, XorBlock(t, LoadBlock(src)));
+					low++;
+					if (!low) {
+						high++;
+					}
+					src += 16;
+					dst += 16;
+					nBlocks--;
+				}
+				MIO::writeUint64BE(counter, high);
+				MIO::writeUint64BE(counter + 8, low);
+			}
+#endif
+
 
 		}
 	}
@@ -525,6 +837,12 @@ namespace slib
 	
 	void AES::encryptBlock(const void* _src, void *_dst) const
 	{
+#if defined(SLIB_AES_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			EncryptBlock_HW(m_roundKeyEnc, m_nCountRounds, _src, _dst);
+			return;
+		}
+#endif
 		const sl_uint8* IN = (const sl_uint8*)_src;
 		sl_uint8* OUT = (sl_uint8*)_dst;
 
@@ -548,6 +866,12 @@ namespace slib
 	
 	void AES::decryptBlock(const void* _src, void *_dst) const
 	{
+#if defined(SLIB_AES_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			DecryptBlock_HW(m_roundKeyDec, m_nCountRounds, _src, _dst);
+			return;
+		}
+#endif
 		const sl_uint8* IN = (const sl_uint8*)_src;
 		sl_uint8* OUT = (sl_uint8*)_dst;
 		
@@ -564,6 +888,50 @@ namespace slib
 		MIO::writeUint32BE(OUT + 12, d3);
 	}
 
+	void AES::encryptBlocks(const void* src, void* dst, sl_size size) const
+	{
+#if defined(SLIB_AES_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			EncryptBlocks_HW(m_roundKeyEnc, m_nCountRounds, (const sl_uint8*)src, (sl_uint8*)dst, size >> 4);
+			return;
+		}
+#endif
+		BlockCipher<AES>::encryptBlocks(src, dst, size);
+	}
+
+	void AES::decryptBlocks(const void* src, void* dst, sl_size size) const
+	{
+#if defined(SLIB_AES_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			DecryptBlocks_HW(m_roundKeyDec, m_nCountRounds, (const sl_uint8*)src, (sl_uint8*)dst, size >> 4);
+			return;
+		}
+#endif
+		BlockCipher<AES>::decryptBlocks(src, dst, size);
+	}
+
+	void AES::encryptBlocks_CTR(void* counter, const void* src, void* dst, sl_size size) const
+	{
+#if defined(SLIB_AES_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			EncryptBlocks_CTR_HW(m_roundKeyEnc, m_nCountRounds, (sl_uint8*)counter, (const sl_uint8*)src, (sl_uint8*)dst, size >> 4);
+			return;
+		}
+#endif
+		BlockCipher<AES>::encryptBlocks_CTR(counter, src, dst, size);
+	}
+
+	void AES::decryptBlocks_CBC(void* iv, const void* src, void* dst, sl_size size) const
+	{
+#if defined(SLIB_AES_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			DecryptBlocks_CBC_HW(m_roundKeyDec, m_nCountRounds, (sl_uint8*)iv, (const sl_uint8*)src, (sl_uint8*)dst, size >> 4);
+			return;
+		}
+#endif
+		BlockCipher<AES>::decryptBlocks_CBC(iv, src, dst, size);
+	}
+
 	void AES::setKey_SHA256(const String& key)
 	{
 		char sig[32];
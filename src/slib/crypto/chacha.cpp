@@ -32,6 +32,21 @@
 
 #include "slib/core/mio.h"
 
+#if defined(SLIB_ARCH_IS_X64)
+#	define SLIB_CHACHA_USE_SSE2
+#	define SLIB_CHACHA_USE_AVX2
+#	include "slib/core/asm.h"
+#	include <immintrin.h>
+#	if defined(SLIB_COMPILER_IS_GCC)
+#		define SLIB_CHACHA_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define SLIB_CHACHA_TARGET_AVX2
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64)
+#	define SLIB_CHACHA_USE_NEON
+#	include <arm_neon.h>
+#endif
+
 namespace slib
 {
 	
@@ -45,6 +60,8 @@ namespace slib
 	x[a] += x[b]; x[d] = ROTATE(x[d]^x[a], 8); \
 	x[c] += x[d]; x[b] = ROTATE(x[b]^x[c], 7);
 	
+#define CHACHA20_POLY1305_CHUNK_SIZE 4096
+
 #define U8TO32_LITTLE(A,B,C,D) ((((sl_uint32)(sl_uint8)(A))) | (((sl_uint32)(sl_uint8)(B))<<8) | (((sl_uint32)(sl_uint8)(C))<<16) | (((sl_uint32)(sl_uint8)(D))<<24))
 
 	namespace priv
@@ -53,6 +70,7 @@ namespace slib
 		namespace chacha
 		{
 			
+#if !defined(SLIB_CHACHA_USE_SSE2) && !defined(SLIB_CHACHA_USE_NEON)
 			static void salsa20_wordtobyte(sl_uint8 output[64], const sl_uint32 input[12], sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3)
 			{
 				sl_uint32 x[16];
@@ -118,6 +136,350 @@ namespace slib
 					u += 4;
 				}
 			}
+#endif
+
+			SLIB_INLINE static void IncreaseNonce(sl_uint32* nonce, sl_bool flagCounter32)
+			{
+				nonce[0]++;
+				if (!flagCounter32) {
+					if (!nonce[0]) {
+						nonce[1]++;
+					}
+				}
+			}
+
+			// the lanes of a batch never cross the 2^32 boundary, but the counter after the batch can wrap
+			SLIB_INLINE static void IncreaseNonce(sl_uint32* nonce, sl_uint32 n, sl_bool flagCounter32)
+			{
+				sl_uint32 old = nonce[0];
+				nonce[0] += n;
+				if (!flagCounter32) {
+					if (nonce[0] < old) {
+						nonce[1]++;
+					}
+				}
+			}
+
+/*
+	SIMD kernels: each lane of the vectors processes the same state word of the different blocks.
+	The counter word (nonce0) of the blocks must not wrap inside of a batch.
+*/
+
+#if defined(SLIB_CHACHA_USE_SSE2)
+#define CHACHA_SSE2_ROTATE(v, c) _mm_or_si128(_mm_slli_epi32(v, c), _mm_srli_epi32(v, 32 - (c)))
+#define CHACHA_SSE2_QUARTERROUND(a,b,c,d) \
+	x[a] = _mm_add_epi32(x[a], x[b]); x[d] = CHACHA_SSE2_ROTATE(_mm_xor_si128(x[d], x[a]), 16); \
+	x[c] = _mm_add_epi32(x[c], x[d]); x[b] = CHACHA_SSE2_ROTATE(_mm_xor_si128(x[b], x[c]), 12); \
+	x[a] = _mm_add_epi32(x[a], x[b]); x[d] = CHACHA_SSE2_ROTATE(_mm_xor_si128(x[d], x[a]), 8); \
+	x[c] = _mm_add_epi32(x[c], x[d]); x[b] = CHACHA_SSE2_ROTATE(_mm_xor_si128(x[b], x[c]), 7);
+
+#define CHACHA_SSE2_ROTATE16(v) _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1)
+#define CHACHA_SSE2_ROUND(a, b, c, d) \
+	a = _mm_add_epi32(a, b); d = CHACHA_SSE2_ROTATE16(_mm_xor_si128(d, a)); \
+	c = _mm_add_epi32(c, d); b = CHACHA_SSE2_ROTATE(_mm_xor_si128(b, c), 12); \
+	a = _mm_add_epi32(a, b); d = CHACHA_SSE2_ROTATE(_mm_xor_si128(d, a), 8); \
+	c = _mm_add_epi32(c, d); b = CHACHA_SSE2_ROTATE(_mm_xor_si128(b, c), 7);
+
+			// 1 block: each vector holds a row of the state. `data` can be null to output the key stream
+			static void EncryptBlock_SSE2(const sl_uint8* data, sl_uint8* output, const sl_uint32* input, sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3) noexcept
+			{
+				__m128i s0 = _mm_loadu_si128((const __m128i*)input);
+				__m128i s1 = _mm_loadu_si128((const __m128i*)(input + 4));
+				__m128i s2 = _mm_loadu_si128((const __m128i*)(input + 8));
+				__m128i s3 = _mm_set_epi32((int)nonce3, (int)nonce2, (int)nonce1, (int)nonce0);
+				__m128i a = s0, b = s1, c = s2, d = s3;
+				for (sl_uint32 i = ROUNDS; i > 0; i -= 2) {
+					// column round
+					CHACHA_SSE2_ROUND(a, b, c, d)
+					// diagonal round
+					b = _mm_shuffle_epi32(b, 0x39);
+					c = _mm_shuffle_epi32(c, 0x4E);
+					d = _mm_shuffle_epi32(d, 0x93);
+					CHACHA_SSE2_ROUND(a, b, c, d)
+					b = _mm_shuffle_epi32(b, 0x93);
+					c = _mm_shuffle_epi32(c, 0x4E);
+					d = _mm_shuffle_epi32(d, 0x39);
+				}
+				a = _mm_add_epi32(a, s0);
+				b = _mm_add_epi32(b, s1);
+				c = _mm_add_epi32(c, s2);
+				d = _mm_add_epi32(d, s3);
+				if (data) {
+					a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i*)data));
+					b = _mm_xor_si128(b, _mm_loadu_si128((const __m128i*)(data + 16)));
+					c = _mm_xor_si128(c, _mm_loadu_si128((const __m128i*)(data + 32)));
+					d = _mm_xor_si128(d, _mm_loadu_si128((const __m128i*)(data + 48)));
+				}
+				_mm_storeu_si128((__m128i*)output, a);
+				_mm_storeu_si128((__m128i*)(output + 16), b);
+				_mm_storeu_si128((__m128i*)(output + 32), c);
+				_mm_storeu_si128((__m128i*)(output + 48), d);
+			}
+
+			// 4 blocks (256 bytes)
+			static void EncryptBlocks4_SSE2(const sl_uint32* input, const sl_uint32* nonce, const sl_uint8* src, sl_uint8* dst) noexcept
+			{
+				__m128i s[16], x[16];
+				sl_uint32 i;
+				for (i = 0; i < 12; i++) {
+					s[i] = _mm_set1_epi32((int)(input[i]));
+				}
+				s[12] = _mm_add_epi32(_mm_set1_epi32((int)(nonce[0])), _mm_set_epi32(3, 2, 1, 0));
+				s[13] = _mm_set1_epi32((int)(nonce[1]));
+				s[14] = _mm_set1_epi32((int)(nonce[2]));
+				s[15] = _mm_set1_epi32((int)(nonce[3]));
+				for (i = 0; i < 16; i++) {
+					x[i] = s[i];
+				}
+				for (i = ROUNDS; i > 0; i -= 2) {
+					CHACHA_SSE2_QUARTERROUND(0, 4, 8, 12)
+					CHACHA_SSE2_QUARTERROUND(1, 5, 9, 13)
+					CHACHA_SSE2_QUARTERROUND(2, 6, 10, 14)
+					CHACHA_SSE2_QUARTERROUND(3, 7, 11, 15)
+					CHACHA_SSE2_QUARTERROUND(0, 5, 10, 15)
+					CHACHA_SSE2_QUARTERROUND(1, 6, 11, 12)
+					CHACHA_SSE2_QUARTERROUND(2, 7, 8, 13)
+					CHACHA_SSE2_QUARTERROUND(3, 4, 9, 14)
+				}
+				for (i = 0; i < 16; i++) {
+					x[i] = _mm_add_epi32(x[i], s[i]);
+				}
+				for (i = 0; i < 4; i++) {
+					// transpose: words (4i ~ 4i+3) of each block
+					__m128i* v = x + (i << 2);
+					__m128i t0 = _mm_unpacklo_epi32(v[0], v[1]);
+					__m128i t1 = _mm_unpacklo_epi32(v[2], v[3]);
+					__m128i t2 = _mm_unpackhi_epi32(v[0], v[1]);
+					__m128i t3 = _mm_unpackhi_epi32(v[2], v[3]);
+					__m128i b[4];
+					b[0] = _mm_unpacklo_epi64(t0, t1);
+					b[1] = _mm_unpackhi_epi64(t0, t1);
+					b[2] = _mm_unpacklo_epi64(t2, t3);
+					b[3] = _mm_unpackhi_epi64(t2, t3);
+					for (sl_uint32 k = 0; k < 4; k++) {
+						sl_uint32 offset = (k << 6) + (i << 4);
+						_mm_storeu_si128((__m128i*)(dst + offset), _mm_xor_si128(b[k], _mm_loadu_si128((const __m128i*)(src + offset))));
+					}
+				}
+			}
+#endif
+
+#if defined(SLIB_CHACHA_USE_AVX2)
+#define CHACHA_AVX2_ROTATE(v, c) _mm256_or_si256(_mm256_slli_epi32(v, c), _mm256_srli_epi32(v, 32 - (c)))
+#define CHACHA_AVX2_QUARTERROUND(a,b,c,d) \
+	x[a] = _mm256_add_epi32(x[a], x[b]); x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot16); \
+	x[c] = _mm256_add_epi32(x[c], x[d]); x[b] = CHACHA_AVX2_ROTATE(_mm256_xor_si256(x[b], x[c]), 12); \
+	x[a] = _mm256_add_epi32(x[a], x[b]); x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot8); \
+	x[c] = _mm256_add_epi32(x[c], x[d]); x[b] = CHACHA_AVX2_ROTATE(_mm256_xor_si256(x[b], x[c]), 7);
+
+			// 8 blocks (512 bytes)
+			SLIB_CHACHA_TARGET_AVX2 static void EncryptBlocks8_AVX2(const sl_uint32* input, const sl_uint32* nonce, const sl_uint8* src, sl_uint8* dst) noexcept
+			{
+				__m256i s[16], x[16];
+				sl_uint32 i;
+				__m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+				__m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+				for (i = 0; i < 12; i++) {
+					s[i] = _mm256_set1_epi32((int)(input[i]));
+				}
+				s[12] = _mm256_add_epi32(_mm256_set1_epi32((int)(nonce[0])), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+				s[13] = _mm256_set1_epi32((int)(nonce[1]));
+				s[14] = _mm256_set1_epi32((int)(nonce[2]));
+				s[15] = _mm256_set1_epi32((int)(nonce[3]));
+				for (i = 0; i < 16; i++) {
+					x[i] = s[i];
+				}
+				for (i = ROUNDS; i > 0; i -= 2) {
+					CHACHA_AVX2_QUARTERROUND(0, 4, 8, 12)
+					CHACHA_AVX2_QUARTERROUND(1, 5, 9, 13)
+					CHACHA_AVX2_QUARTERROUND(2, 6, 10, 14)
+					CHACHA_AVX2_QUARTERROUND(3, 7, 11, 15)
+					CHACHA_AVX2_QUARTERROUND(0, 5, 10, 15)
+					CHACHA_AVX2_QUARTERROUND(1, 6, 11, 12)
+					CHACHA_AVX2_QUARTERROUND(2, 7, 8, 13)
+					CHACHA_AVX2_QUARTERROUND(3, 4, 9, 14)
+				}
+				for (i = 0; i < 16; i++) {
+					x[i] = _mm256_add_epi32(x[i], s[i]);
+				}
+				// transpose in 128-bit lanes: b[i][k] = words (4i ~ 4i+3) of block k (low lane) and block k+4 (high lane)
+				__m256i b[4][4];
+				for (i = 0; i < 4; i++) {
+					__m256i* v = x + (i << 2);
+					__m256i t0 = _mm256_unpacklo_epi32(v[0], v[1]);
+					__m256i t1 = _mm256_unpacklo_epi32(v[2], v[3]);
+					__m256i t2 = _mm256_unpackhi_epi32(v[0], v[1]);
+					__m256i t3 = _mm256_unpackhi_epi32(v[2], v[3]);
+					b[i][0] = _mm256_unpacklo_epi64(t0, t1);
+					b[i][1] = _mm256_unpackhi_epi64(t0, t1);
+					b[i][2] = _mm256_unpacklo_epi64(t2, t3);
+					b[i][3] = _mm256_unpackhi_epi64(t2, t3);
+				}
+				for (sl_uint32 k = 0; k < 4; k++) {
+					for (i = 0; i < 4; i += 2) {
+						sl_uint32 offset = (k << 6) + (i << 4);
+						__m256i lo = _mm256_permute2x128_si256(b[i][k], b[i + 1][k], 0x20);
+						__m256i hi = _mm256_permute2x128_si256(b[i][k], b[i + 1][k], 0x31);
+						_mm256_storeu_si256((__m256i*)(dst + offset), _mm256_xor_si256(lo, _mm256_loadu_si256((const __m256i*)(src + offset))));
+						_mm256_storeu_si256((__m256i*)(dst + offset + 256), _mm256_xor_si256(hi, _mm256_loadu_si256((const __m256i*)(src + offset + 256))));
+					}
+				}
+			}
+#endif
+
+#if defined(SLIB_CHACHA_USE_NEON)
+#define CHACHA_NEON_ROTATE(v, c) vsriq_n_u32(vshlq_n_u32(v, c), v, 32 - (c))
+#define CHACHA_NEON_ROTATE16(v) vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(v)))
+#define CHACHA_NEON_QUARTERROUND(a,b,c,d) \
+	x[a] = vaddq_u32(x[a], x[b]); x[d] = CHACHA_NEON_ROTATE16(veorq_u32(x[d], x[a])); \
+	x[c] = vaddq_u32(x[c], x[d]); x[b] = CHACHA_NEON_ROTATE(veorq_u32(x[b], x[c]), 12); \
+	x[a] = vaddq_u32(x[a], x[b]); x[d] = CHACHA_NEON_ROTATE(veorq_u32(x[d], x[a]), 8); \
+	x[c] = vaddq_u32(x[c], x[d]); x[b] = CHACHA_NEON_ROTATE(veorq_u32(x[b], x[c]), 7);
+
+#define CHACHA_NEON_ROUND(a, b, c, d) \
+	a = vaddq_u32(a, b); d = CHACHA_NEON_ROTATE16(veorq_u32(d, a)); \
+	c = vaddq_u32(c, d); b = CHACHA_NEON_ROTATE(veorq_u32(b, c), 12); \
+	a = vaddq_u32(a, b); d = CHACHA_NEON_ROTATE(veorq_u32(d, a), 8); \
+	c = vaddq_u32(c, d); b = CHACHA_NEON_ROTATE(veorq_u32(b, c), 7);
+
+			// 1 block: each vector holds a row of the state. `data` can be null to output the key stream
+			static void EncryptBlock_NEON(const sl_uint8* data, sl_uint8* output, const sl_uint32* input, sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3) noexcept
+			{
+				sl_uint32 nonce[4] = { nonce0, nonce1, nonce2, nonce3 };
+				uint32x4_t s0 = vld1q_u32(input);
+				uint32x4_t s1 = vld1q_u32(input + 4);
+				uint32x4_t s2 = vld1q_u32(input + 8);
+				uint32x4_t s3 = vld1q_u32(nonce);
+				uint32x4_t a = s0, b = s1, c = s2, d = s3;
+				for (sl_uint32 i = ROUNDS; i > 0; i -= 2) {
+					// column round
+					CHACHA_NEON_ROUND(a, b, c, d)
+					// diagonal round
+					b = vextq_u32(b, b, 1);
+					c = vextq_u32(c, c, 2);
+					d = vextq_u32(d, d, 3);
+					CHACHA_NEON_ROUND(a, b, c, d)
+					b = vextq_u32(b, b, 3);
+					c = vextq_u32(c, c, 2);
+					d = vextq_u32(d, d, 1);
+				}
+				uint8x16_t r0 = vreinterpretq_u8_u32(vaddq_u32(a, s0));
+				uint8x16_t r1 = vreinterpretq_u8_u32(vaddq_u32(b, s1));
+				uint8x16_t r2 = vreinterpretq_u8_u32(vaddq_u32(c, s2));
+				uint8x16_t r3 = vreinterpretq_u8_u32(vaddq_u32(d, s3));
+				if (data) {
+					r0 = veorq_u8(r0, vld1q_u8(data));
+					r1 = veorq_u8(r1, vld1q_u8(data + 16));
+					r2 = veorq_u8(r2, vld1q_u8(data + 32));
+					r3 = veorq_u8(r3, vld1q_u8(data + 48));
+				}
+				vst1q_u8(output, r0);
+				vst1q_u8(output + 16, r1);
+				vst1q_u8(output + 32, r2);
+				vst1q_u8(output + 48, r3);
+			}
+
+			// 4 blocks (256 bytes)
+			static void EncryptBlocks4_NEON(const sl_uint32* input, const sl_uint32* nonce, const sl_uint8* src, sl_uint8* dst) noexcept
+			{
+				static const sl_uint32 increments[4] = { 0, 1, 2, 3 };
+				uint32x4_t s[16], x[16];
+				sl_uint32 i;
+				for (i = 0; i < 12; i++) {
+					s[i] = vdupq_n_u32(input[i]);
+				}
+				s[12] = vaddq_u32(vdupq_n_u32(nonce[0]), vld1q_u32(increments));
+				s[13] = vdupq_n_u32(nonce[1]);
+				s[14] = vdupq_n_u32(nonce[2]);
+				s[15] = vdupq_n_u32(nonce[3]);
+				for (i = 0; i < 16; i++) {
+					x[i] = s[i];
+				}
+				for (i = ROUNDS; i > 0; i -= 2) {
+					CHACHA_NEON_QUARTERROUND(0, 4, 8, 12)
+					CHACHA_NEON_QUARTERROUND(1, 5, 9, 13)
+					CHACHA_NEON_QUARTERROUND(2, 6, 10, 14)
+					CHACHA_NEON_QUARTERROUND(3, 7, 11, 15)
+					CHACHA_NEON_QUARTERROUND(0, 5, 10, 15)
+					CHACHA_NEON_QUARTERROUND(1, 6, 11, 12)
+					CHACHA_NEON_QUARTERROUND(2, 7, 8, 13)
+					CHACHA_NEON_QUARTERROUND(3, 4, 9, 14)
+				}
+				for (i = 0; i < 16; i++) {
+					x[i] = vaddq_u32(x[i], s[i]);
+				}
+				for (i = 0; i < 4; i++) {
+					// transpose: words (4i ~ 4i+3) of each block
+					uint32x4_t* v = x + (i << 2);
+					uint32x4x2_t t01 = vtrnq_u32(v[0], v[1]);
+					uint32x4x2_t t23 = vtrnq_u32(v[2], v[3]);
+					uint32x4_t b[4];
+					b[0] = vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0]));
+					b[1] = vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1]));
+					b[2] = vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0]));
+					b[3] = vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]));
+					for (sl_uint32 k = 0; k < 4; k++) {
+						sl_uint32 offset = (k << 6) + (i << 4);
+						vst1q_u8(dst + offset, veorq_u8(vreinterpretq_u8_u32(b[k]), vld1q_u8(src + offset)));
+					}
+				}
+			}
+#endif
+
+			// `data` can be null to output the key stream
+			static void EncryptBlock(const sl_uint8* data, sl_uint8* output, const sl_uint32* input, sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3)
+			{
+#if defined(SLIB_CHACHA_USE_SSE2)
+				EncryptBlock_SSE2(data, output, input, nonce0, nonce1, nonce2, nonce3);
+#elif defined(SLIB_CHACHA_USE_NEON)
+				EncryptBlock_NEON(data, output, input, nonce0, nonce1, nonce2, nonce3);
+#else
+				if (data) {
+					salsa20_wordtobyte(data, output, input, nonce0, nonce1, nonce2, nonce3);
+				} else {
+					salsa20_wordtobyte(output, input, nonce0, nonce1, nonce2, nonce3);
+				}
+#endif
+			}
+
+			// nonce: inout
+			static void EncryptBlocks(const sl_uint32* input, sl_uint32* nonce, sl_bool flagCounter32, const sl_uint8* src, sl_uint8* dst, sl_size nBlocks)
+			{
+#if defined(SLIB_CHACHA_USE_AVX2)
+				static sl_bool flagAvx2 = CanUseAvx2();
+#endif
+				while (nBlocks) {
+#if defined(SLIB_CHACHA_USE_AVX2)
+					if (flagAvx2 && nBlocks >= 8 && nonce[0] <= 0xfffffff8) {
+						EncryptBlocks8_AVX2(input, nonce, src, dst);
+						IncreaseNonce(nonce, 8, flagCounter32);
+						src += 512;
+						dst += 512;
+						nBlocks -= 8;
+						continue;
+					}
+#endif
+#if defined(SLIB_CHACHA_USE_SSE2) || defined(SLIB_CHACHA_USE_NEON)
+					if (nBlocks >= 4 && nonce[0] <= 0xfffffffc) {
+#	if defined(SLIB_CHACHA_USE_SSE2)
+						EncryptBlocks4_SSE2(input, nonce, src, dst);
+#	else
+						EncryptBlocks4_NEON(input, nonce, src, dst);
+#	endif
+						IncreaseNonce(nonce, 4, flagCounter32);
+						src += 256;
+						dst += 256;
+						nBlocks -= 4;
+						continue;
+					}
+#endif
+					EncryptBlock(src, dst, input, nonce[0], nonce[1], nonce[2], nonce[3]);
+					IncreaseNonce(nonce, flagCounter32);
+					src += 64;
+					dst += 64;
+					nBlocks--;
+				}
+			}
 			
 		}
 		
@@ -162,17 +524,17 @@ namespace slib
 	
 	void ChaCha20_Core::generateBlock(sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3, void* output) const
 	{
-		priv::chacha::salsa20_wordtobyte((sl_uint8*)output, m_input, nonce0, nonce1, nonce2, nonce3);
+		priv::chacha::EncryptBlock(sl_null, (sl_uint8*)output, m_input, nonce0, nonce1, nonce2, nonce3);
 	}
 	
 	void ChaCha20_Core::encryptBlock(sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3, const void* input, void* output) const
 	{
-		priv::chacha::salsa20_wordtobyte((const sl_uint8*)input, (sl_uint8*)output, m_input, nonce0, nonce1, nonce2, nonce3);
+		priv::chacha::EncryptBlock((const sl_uint8*)input, (sl_uint8*)output, m_input, nonce0, nonce1, nonce2, nonce3);
 	}
 	
 	void ChaCha20_Core::decryptBlock(sl_uint32 nonce0, sl_uint32 nonce1, sl_uint32 nonce2, sl_uint32 nonce3, const void* input, void* output) const
 	{
-		priv::chacha::salsa20_wordtobyte((const sl_uint8*)input, (sl_uint8*)output, m_input, nonce0, nonce1, nonce2, nonce3);
+		priv::chacha::EncryptBlock((const sl_uint8*)input, (sl_uint8*)output, m_input, nonce0, nonce1, nonce2, nonce3);
 	}
 	
 	
@@ -235,18 +597,29 @@ namespace slib
 		sl_uint8* dst = (sl_uint8*)_dst;
 		sl_uint8* y = m_output;
 		sl_uint32 pos = m_pos;
-		for (sl_size k = 0; k < len; k++) {
-			if (!pos) {
-				priv::chacha::salsa20_wordtobyte(y, m_input, m_nonce[0], m_nonce[1], m_nonce[2], m_nonce[3]);
-				m_nonce[0]++;
-				if (!m_flagCounter32) {
-					if (!m_nonce[0]) {
-						m_nonce[1]++;
-					}
-				}
+		if (pos) {
+			// remaining key stream of the last block
+			while (len && pos < 64) {
+				*(dst++) = *(src++) ^ y[pos++];
+				len--;
+			}
+			pos &= 0x3F;
+		}
+		if (len >= 64) {
+			sl_size nBlocks = len >> 6;
+			priv::chacha::EncryptBlocks(m_input, m_nonce, m_flagCounter32, src, dst, nBlocks);
+			sl_size n = nBlocks << 6;
+			src += n;
+			dst += n;
+			len -= n;
+		}
+		if (len) {
+			priv::chacha::EncryptBlock(sl_null, y, m_input, m_nonce[0], m_nonce[1], m_nonce[2], m_nonce[3]);
+			priv::chacha::IncreaseNonce(m_nonce, m_flagCounter32);
+			for (sl_size k = 0; k < len; k++) {
+				dst[k] = src[k] ^ y[k];
 			}
-			dst[k] = src[k] ^ y[pos];
-			pos = (pos + 1) & 0x3F;
+			pos = (sl_uint32)len;
 		}
 		m_pos = pos;
 	}
@@ -308,24 +681,47 @@ namespace slib
 		}
 	}
 
-	void ChaCha20_Poly1305::encrypt(const void* src, void* dst, sl_size len)
+	void ChaCha20_Poly1305::encrypt(const void* _src, void* _dst, sl_size len)
 	{
 		if (!len) {
 			return;
 		}
-		m_cipher.encrypt(src, dst, len);
-		m_auth.update(dst, len);
+		const sl_uint8* src = (const sl_uint8*)_src;
+		sl_uint8* dst = (sl_uint8*)_dst;
 		m_lenInput += len;
+		// authenticates each chunk while the cipher text is still in the cache
+		while (len) {
+			sl_size n = len;
+			if (n > CHACHA20_POLY1305_CHUNK_SIZE) {
+				n = CHACHA20_POLY1305_CHUNK_SIZE;
+			}
+			m_cipher.encrypt(src, dst, n);
+			m_auth.update(dst, n);
+			src += n;
+			dst += n;
+			len -= n;
+		}
 	}
 	
-	void ChaCha20_Poly1305::decrypt(const void* src, void* dst, sl_size len)
+	void ChaCha20_Poly1305::decrypt(const void* _src, void* _dst, sl_size len)
 	{
 		if (!len) {
 			return;
 		}
-		m_auth.update(src, len);
-		m_cipher.encrypt(src, dst, len);
+		const sl_uint8* src = (const sl_uint8*)_src;
+		sl_uint8* dst = (sl_uint8*)_dst;
 		m_lenInput += len;
+		while (len) {
+			sl_size n = len;
+			if (n > CHACHA20_POLY1305_CHUNK_SIZE) {
+				n = CHACHA20_POLY1305_CHUNK_SIZE;
+			}
+			m_auth.update(src, n);
+			m_cipher.encrypt(src, dst, n);
+			src += n;
+			dst += n;
+			len -= n;
+		}
 	}
 	
 	void ChaCha20_Poly1305::check(const void* src, sl_size len)
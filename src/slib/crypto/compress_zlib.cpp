@@ -124,7 +124,7 @@ namespace slib
 	sl_int32 ZlibCompress::compress(
 		const void* input, sl_uint32 sizeInputAvailable, sl_uint32& sizeInputPassed
 		, void* output, sl_uint32 sizeOutputAvailable, sl_uint32& sizeOutputUsed
-		, sl_bool flagFinish)
+		, sl_bool flagFinish, sl_bool flagSyncFlush)
 	{
 		if (!m_flagStarted) {
 			return Z_STREAM_ERROR;
@@ -136,7 +136,7 @@ namespace slib
 		stream->avail_in = sizeInputAvailable;
 		stream->next_out = (Bytef*)output;
 		stream->avail_out = sizeOutputAvailable;
-		int iRet = deflate(stream, flagFinish ? Z_FINISH : Z_NO_FLUSH);
+		int iRet = deflate(stream, flagFinish ? Z_FINISH : (flagSyncFlush ? Z_SYNC_FLUSH : Z_NO_FLUSH));
 		if (iRet < 0) {
 			abort();
 			return iRet;
@@ -26,6 +26,8 @@
 
 #include "slib/core/string_buffer.h"
 #include "slib/core/safe_static.h"
+#include "slib/core/scoped.h"
+#include "slib/core/mio.h"
 
 #include "ecc_secp256k1.inc"
 
@@ -191,6 +193,12 @@ namespace slib
 	
 	ECPoint EllipticCurve::multiplyPoint(const ECPoint& pt, const BigInt& _k) const
 	{
+		if (priv::secp256k1::GetEngine(*this)) {
+			ECPoint ret;
+			if (priv::secp256k1::MultiplyPoint(ret, pt, _k)) {
+				return ret;
+			}
+		}
 		CBigInt* k = _k.ref.get();
 		if (!k) {
 			return ECPoint();
@@ -215,6 +223,13 @@ namespace slib
 	
 	ECPoint EllipticCurve::multiplyG(const BigInt& _k) const
 	{
+		const priv::secp256k1::GeneratorTable* table = priv::secp256k1::GetEngine(*this);
+		if (table) {
+			ECPoint ret;
+			if (priv::secp256k1::MultiplyG(ret, _k, table)) {
+				return ret;
+			}
+		}
 		if (pow2g.isNull()) {
 			return multiplyPoint(G, _k);
 		}
@@ -252,6 +267,9 @@ namespace slib
 	
 	sl_bool ECPublicKey::checkValid(const EllipticCurve& curve) const
 	{
+		if (priv::secp256k1::GetEngine(curve)) {
+			return priv::secp256k1::CheckPublicKey(Q);
+		}
 		if (Q.isO()) {
 			return sl_false;
 		}
@@ -334,6 +352,10 @@ namespace slib
 	
 	ECDSA_Signature ECDSA::sign(const EllipticCurve& curve, const ECPrivateKey& key, const BigInt& z, BigInt* _k)
 	{
+		const priv::secp256k1::GeneratorTable* table = priv::secp256k1::GetEngine(curve);
+		if (table) {
+			return priv::secp256k1::Sign(key, z, _k, table);
+		}
 		if (curve.G.isO()) {
 			return ECDSA_Signature();
 		}
@@ -404,6 +426,10 @@ namespace slib
 	
 	sl_bool ECDSA::verify(const EllipticCurve& curve, const ECPublicKey& key, const BigInt& z, const ECDSA_Signature& signature)
 	{
+		const priv::secp256k1::GeneratorTable* table = priv::secp256k1::GetEngine(curve);
+		if (table) {
+			return priv::secp256k1::Verify(key, z, signature, table);
+		}
 		if (!(key.checkValid(curve))) {
 			return sl_false;
 		}
@@ -443,8 +469,45 @@ namespace slib
 		return verify(curve, key, priv::ecdsa::makeZ(curve, hash, SHA256::HashSize), signature);
 	}
 	
+	sl_bool ECDSA::verifyBatch(const EllipticCurve& curve, const ECPublicKey* keys, const BigInt* z, const ECDSA_Signature* signatures, sl_size n)
+	{
+		const priv::secp256k1::GeneratorTable* table = priv::secp256k1::GetEngine(curve);
+		if (table) {
+			return priv::secp256k1::VerifyBatch(keys, z, signatures, n, table);
+		}
+		for (sl_size i = 0; i < n; i++) {
+			if (!(verify(curve, keys[i], z[i], signatures[i]))) {
+				return sl_false;
+			}
+		}
+		return sl_true;
+	}
+	
+	sl_bool ECDSA::verifyBatch(const EllipticCurve& curve, const ECPublicKey* keys, const void* const* hashes, const sl_size* sizeHashes, const ECDSA_Signature* signatures, sl_size n)
+	{
+		while (n) {
+			BigInt z[32];
+			sl_size m = Math::min(n, (sl_size)32);
+			for (sl_size i = 0; i < m; i++) {
+				z[i] = priv::ecdsa::makeZ(curve, hashes[i], sizeHashes[i]);
+			}
+			if (!(verifyBatch(curve, keys, z, signatures, m))) {
+				return sl_false;
+			}
+			keys += m;
+			hashes += m;
+			sizeHashes += m;
+			signatures += m;
+			n -= m;
+		}
+		return sl_true;
+	}
+	
 	BigInt ECDH::getSharedKey(const EllipticCurve& curve, const ECPrivateKey& keyLocal, const ECPublicKey& keyRemote)
 	{
+		if (priv::secp256k1::GetEngine(curve)) {
+			return priv::secp256k1::GetSharedKey(keyLocal, keyRemote);
+		}
 		if (!(keyRemote.checkValid(curve))) {
 			return BigInt::null();
 		}
@@ -22,9 +22,294 @@
 
 #include "slib/crypto/gcm.h"
 
+#include "slib/core/mio.h"
+
+#if defined(SLIB_ARCH_IS_X64)
+#	define SLIB_GCM_SUPPORT_HW
+#	define SLIB_GCM_USE_PCLMUL
+#	include "slib/core/asm.h"
+#	include <immintrin.h>
+#	if defined(SLIB_COMPILER_IS_GCC)
+#		define SLIB_GCM_TARGET_HW __attribute__((target("pclmul,ssse3")))
+#	else
+#		define SLIB_GCM_TARGET_HW
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#	define SLIB_GCM_SUPPORT_HW
+#	define SLIB_GCM_USE_PMULL
+#	include <arm_neon.h>
+#	define SLIB_GCM_TARGET_HW
+#endif
+
 namespace slib
 {
 
+#if defined(SLIB_GCM_SUPPORT_HW)
+	namespace priv
+	{
+		namespace gcm
+		{
+
+/*
+	Carry-less multiplication on byte-reversed operands, followed by shift-left and reduction
+	(Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode, Algorithm 5)
+*/
+
+#	if defined(SLIB_GCM_USE_PCLMUL)
+			typedef __m128i HwBlock;
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock LoadBlock(const void* p) noexcept
+			{
+				return _mm_loadu_si128((const __m128i*)p);
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static void StoreBlock(void* p, HwBlock b) noexcept
+			{
+				_mm_storeu_si128((__m128i*)p, b);
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock LoadBlockReversed(const void* p) noexcept
+			{
+				return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)p), _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static void StoreBlockReversed(void* p, HwBlock b) noexcept
+			{
+				_mm_storeu_si128((__m128i*)p, _mm_shuffle_epi8(b, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)));
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock ZeroBlock() noexcept
+			{
+				return _mm_setzero_si128();
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock Xor(HwBlock a, HwBlock b) noexcept
+			{
+				return _mm_xor_si128(a, b);
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock Or(HwBlock a, HwBlock b) noexcept
+			{
+				return _mm_or_si128(a, b);
+			}
+
+			template <int IMM>
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock Clmul(HwBlock a, HwBlock b) noexcept
+			{
+				return _mm_clmulepi64_si128(a, b, IMM);
+			}
+
+			template <int N>
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock ShiftLeft32(HwBlock a) noexcept
+			{
+				return _mm_slli_epi32(a, N);
+			}
+
+			template <int N>
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock ShiftRight32(HwBlock a) noexcept
+			{
+				return _mm_srli_epi32(a, N);
+			}
+
+			template <int N>
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock ShiftLeftBytes(HwBlock a) noexcept
+			{
+				return _mm_slli_si128(a, N);
+			}
+
+			template <int N>
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock ShiftRightBytes(HwBlock a) noexcept
+			{
+				return _mm_srli_si128(a, N);
+			}
+
+			static sl_bool IsHardwareEnabled()
+			{
+				static sl_bool flag = CanUsePclmul();
+				return flag;
+			}
+#	elif defined(SLIB_GCM_USE_PMULL)
+			typedef uint8x16_t HwBlock;
+
+			SLIB_INLINE static HwBlock LoadBlock(const void* p) noexcept
+			{
+				return vld1q_u8((const uint8_t*)p);
+			}
+
+			SLIB_INLINE static void StoreBlock(void* p, HwBlock b) noexcept
+			{
+				vst1q_u8((uint8_t*)p, b);
+			}
+
+			SLIB_INLINE static HwBlock ReverseBytes(HwBlock b) noexcept
+			{
+				b = vrev64q_u8(b);
+				return vextq_u8(b, b, 8);
+			}
+
+			SLIB_INLINE static HwBlock LoadBlockReversed(const void* p) noexcept
+			{
+				return ReverseBytes(vld1q_u8((const uint8_t*)p));
+			}
+
+			SLIB_INLINE static void StoreBlockReversed(void* p, HwBlock b) noexcept
+			{
+				vst1q_u8((uint8_t*)p, ReverseBytes(b));
+			}
+
+			SLIB_INLINE static HwBlock ZeroBlock() noexcept
+			{
+				return vdupq_n_u8(0);
+			}
+
+			SLIB_INLINE static HwBlock Xor(HwBlock a, HwBlock b) noexcept
+			{
+				return veorq_u8(a, b);
+			}
+
+			SLIB_INLINE static HwBlock Or(HwBlock a, HwBlock b) noexcept
+			{
+				return vorrq_u8(a, b);
+			}
+
+			// same selector as PCLMULQDQ: bit 0 for `a`, bit 4 for `b`
+			template <int IMM>
+			SLIB_INLINE static HwBlock Clmul(HwBlock a, HwBlock b) noexcept
+			{
+				poly64_t x = (poly64_t)(vgetq_lane_u64(vreinterpretq_u64_u8(a), IMM & 1));
+				poly64_t y = (poly64_t)(vgetq_lane_u64(vreinterpretq_u64_u8(b), (IMM >> 4) & 1));
+				return vreinterpretq_u8_p128(vmull_p64(x, y));
+			}
+
+			template <int N>
+			SLIB_INLINE static HwBlock ShiftLeft32(HwBlock a) noexcept
+			{
+				return vreinterpretq_u8_u32(vshlq_n_u32(vreinterpretq_u32_u8(a), N));
+			}
+
+			template <int N>
+			SLIB_INLINE static HwBlock ShiftRight32(HwBlock a) noexcept
+			{
+				return vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(a), N));
+			}
+
+			template <int N>
+			SLIB_INLINE static HwBlock ShiftLeftBytes(HwBlock a) noexcept
+			{
+				return vextq_u8(vdupq_n_u8(0), a, 16 - N);
+			}
+
+			template <int N>
+			SLIB_INLINE static HwBlock ShiftRightBytes(HwBlock a) noexcept
+			{
+				return vextq_u8(a, vdupq_n_u8(0), N);
+			}
+
+			static sl_bool IsHardwareEnabled()
+			{
+				return sl_true;
+			}
+#	endif
+
+			// (hi:lo) ^= a * b
+			SLIB_GCM_TARGET_HW SLIB_INLINE static void MultiplyUnreduced(HwBlock a, HwBlock b, HwBlock& lo, HwBlock& hi) noexcept
+			{
+				HwBlock t0 = Clmul<0x00>(a, b);
+				HwBlock t1 = Xor(Clmul<0x10>(a, b), Clmul<0x01>(a, b));
+				HwBlock t3 = Clmul<0x11>(a, b);
+				lo = Xor(lo, Xor(t0, ShiftLeftBytes<8>(t1)));
+				hi = Xor(hi, Xor(t3, ShiftRightBytes<8>(t1)));
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock Reduce(HwBlock lo, HwBlock hi) noexcept
+			{
+				// shift (hi:lo) left by 1 bit
+				HwBlock t7 = ShiftRight32<31>(lo);
+				HwBlock t8 = ShiftRight32<31>(hi);
+				lo = ShiftLeft32<1>(lo);
+				hi = ShiftLeft32<1>(hi);
+				HwBlock t9 = ShiftRightBytes<12>(t7);
+				t8 = ShiftLeftBytes<4>(t8);
+				t7 = ShiftLeftBytes<4>(t7);
+				lo = Or(lo, t7);
+				hi = Or(Or(hi, t8), t9);
+				// reduce modulo x^128 + x^7 + x^2 + x + 1
+				t7 = Xor(Xor(ShiftLeft32<31>(lo), ShiftLeft32<30>(lo)), ShiftLeft32<25>(lo));
+				t8 = ShiftRightBytes<4>(t7);
+				t7 = ShiftLeftBytes<12>(t7);
+				lo = Xor(lo, t7);
+				HwBlock t2 = Xor(Xor(ShiftRight32<1>(lo), ShiftRight32<2>(lo)), Xor(ShiftRight32<7>(lo), t8));
+				lo = Xor(lo, t2);
+				return Xor(hi, lo);
+			}
+
+			SLIB_GCM_TARGET_HW SLIB_INLINE static HwBlock Multiply(HwBlock a, HwBlock b) noexcept
+			{
+				HwBlock lo = ZeroBlock();
+				HwBlock hi = ZeroBlock();
+				MultiplyUnreduced(a, b, lo, hi);
+				return Reduce(lo, hi);
+			}
+
+			SLIB_GCM_TARGET_HW static void GenerateTable_HW(const void* H, sl_uint8 (*HP)[16]) noexcept
+			{
+				HwBlock h = LoadBlockReversed(H);
+				HwBlock p = h;
+				StoreBlock(HP[0], p);
+				for (sl_uint32 i = 1; i < 4; i++) {
+					p = Multiply(p, h);
+					StoreBlock(HP[i], p);
+				}
+			}
+
+			SLIB_GCM_TARGET_HW static void MultiplyH_HW(const sl_uint8 (*HP)[16], const void* X, void* O) noexcept
+			{
+				StoreBlockReversed(O, Multiply(LoadBlockReversed(X), LoadBlock(HP[0])));
+			}
+
+			// 4 blocks are aggregated before each reduction: X = (((X + D0) * H^4) + (D1 * H^3) + (D2 * H^2) + (D3 * H))
+			SLIB_GCM_TARGET_HW static void MultiplyData_HW(const sl_uint8 (*HP)[16], void* _X, const sl_uint8* D, sl_size lenD) noexcept
+			{
+				HwBlock X = LoadBlockReversed(_X);
+				HwBlock H1 = LoadBlock(HP[0]);
+				sl_size nBlocks = lenD >> 4;
+				if (nBlocks >= 4) {
+					HwBlock H2 = LoadBlock(HP[1]);
+					HwBlock H3 = LoadBlock(HP[2]);
+					HwBlock H4 = LoadBlock(HP[3]);
+					do {
+						HwBlock lo = ZeroBlock();
+						HwBlock hi = ZeroBlock();
+						MultiplyUnreduced(Xor(X, LoadBlockReversed(D)), H4, lo, hi);
+						MultiplyUnreduced(LoadBlockReversed(D + 16), H3, lo, hi);
+						MultiplyUnreduced(LoadBlockReversed(D + 32), H2, lo, hi);
+						MultiplyUnreduced(LoadBlockReversed(D + 48), H1, lo, hi);
+						X = Reduce(lo, hi);
+						D += 64;
+						nBlocks -= 4;
+					} while (nBlocks >= 4);
+				}
+				while (nBlocks) {
+					X = Multiply(Xor(X, LoadBlockReversed(D)), H1);
+					D += 16;
+					nBlocks--;
+				}
+				sl_uint32 n = (sl_uint32)(lenD & 15);
+				if (n) {
+					sl_uint8 last[16] = { 0 };
+					Base::copyMemory(last, D, n);
+					X = Multiply(Xor(X, LoadBlockReversed(last)), H1);
+				}
+				StoreBlockReversed(_X, X);
+			}
+
+		}
+	}
+
+	using namespace priv::gcm;
+#endif
+
+
 	void GCM_Table::generateTable(const void* inH)
 	{
 		sl_uint32 i, j;
@@ -60,10 +345,22 @@ namespace slib
 			}
 			i <<= 1;
 		}
+
+#if defined(SLIB_GCM_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			GenerateTable_HW(inH, HP);
+		}
+#endif
 	}
 
 	void GCM_Table::multiplyH(const void* inX, void* inO) const
 	{
+#if defined(SLIB_GCM_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			MultiplyH_HW(HP, inX, inO);
+			return;
+		}
+#endif
 		const sl_uint8* X = (const sl_uint8*)inX;
 		sl_uint8* O = (sl_uint8*)inO;
 		Uint128 Z;
@@ -125,6 +422,12 @@ namespace slib
 
 	void GCM_Table::multiplyData(void* inX, const void* inD, sl_size lenD) const
 	{
+#if defined(SLIB_GCM_SUPPORT_HW)
+		if (IsHardwareEnabled()) {
+			MultiplyData_HW(HP, inX, (const sl_uint8*)inD, lenD);
+			return;
+		}
+#endif
 		sl_uint8* X = (sl_uint8*)inX;
 		const sl_uint8* D = (const sl_uint8*)inD;
 		sl_size i, k, n;
@@ -213,6 +516,19 @@ namespace slib
 		}
 	}
 
+	sl_size GCM_Base::reserveCounterBlocks(sl_size nBlocks, void* counter)
+	{
+		increaseCIV();
+		sl_uint32 c = MIO::readUint32BE(CIV + 12);
+		sl_uint64 nMax = SLIB_UINT64(0x100000000) - c;
+		if ((sl_uint64)nBlocks > nMax) {
+			nBlocks = (sl_size)nMax;
+		}
+		Base::copyMemory(counter, CIV, 16);
+		MIO::writeUint32BE(CIV + 12, c + (sl_uint32)(nBlocks - 1));
+		return nBlocks;
+	}
+
 	void GCM_Base::putBlock(const void* src, sl_uint32 n)
 	{
 		const sl_uint8* A = (const sl_uint8*)src;
@@ -26,11 +26,14 @@
  
  https://github.com/floodyberry/poly1305-donna
  
+ 64-bit platforms use the 44-bit limbs (poly1305-donna-64), and others use the 26-bit limbs (poly1305-donna-32)
+
  */
 
 #include "slib/crypto/poly1305.h"
 
 #include "slib/core/mio.h"
+#include "slib/core/math.h"
 
 namespace slib
 {
@@ -45,6 +48,245 @@ namespace slib
 	{
 	}
 	
+#if defined(SLIB_ARCH_IS_64BIT)
+	namespace priv
+	{
+		namespace poly1305
+		{
+
+			// 128-bit accumulator of the products
+			class Accumulator
+			{
+			public:
+#if defined(SLIB_COMPILER_IS_GCC) && defined(__SIZEOF_INT128__)
+				unsigned __int128 value;
+
+			public:
+				SLIB_INLINE void setProduct(sl_uint64 a, sl_uint64 b) noexcept
+				{
+					value = (unsigned __int128)a * b;
+				}
+
+				SLIB_INLINE void addProduct(sl_uint64 a, sl_uint64 b) noexcept
+				{
+					value += (unsigned __int128)a * b;
+				}
+
+				SLIB_INLINE void add(sl_uint64 v) noexcept
+				{
+					value += v;
+				}
+
+				SLIB_INLINE sl_uint64 getLow() const noexcept
+				{
+					return (sl_uint64)value;
+				}
+
+				SLIB_INLINE sl_uint64 shiftRight(sl_uint32 n) const noexcept
+				{
+					return (sl_uint64)(value >> n);
+				}
+#else
+				sl_uint64 low;
+				sl_uint64 high;
+
+			public:
+				SLIB_INLINE void setProduct(sl_uint64 a, sl_uint64 b) noexcept
+				{
+					Math::mul64(a, b, high, low);
+				}
+
+				SLIB_INLINE void addProduct(sl_uint64 a, sl_uint64 b) noexcept
+				{
+					sl_uint64 h, l;
+					Math::mul64(a, b, h, l);
+					add(l);
+					high += h;
+				}
+
+				SLIB_INLINE void add(sl_uint64 v) noexcept
+				{
+					low += v;
+					high += (low < v) ? 1 : 0;
+				}
+
+				SLIB_INLINE sl_uint64 getLow() const noexcept
+				{
+					return low;
+				}
+
+				SLIB_INLINE sl_uint64 shiftRight(sl_uint32 n) const noexcept
+				{
+					return (low >> n) | (high << (64 - n));
+				}
+#endif
+			};
+
+			// (partial) d %= p
+			SLIB_INLINE static void Reduce(Accumulator& d0, Accumulator& d1, Accumulator& d2, sl_uint64* h) noexcept
+			{
+				sl_uint64 c = d0.shiftRight(44);
+				h[0] = d0.getLow() & SLIB_UINT64(0xfffffffffff);
+				d1.add(c);
+				c = d1.shiftRight(44);
+				h[1] = d1.getLow() & SLIB_UINT64(0xfffffffffff);
+				d2.add(c);
+				c = d2.shiftRight(42);
+				h[2] = d2.getLow() & SLIB_UINT64(0x3ffffffffff);
+				h[0] += c * 5;
+				c = h[0] >> 44;
+				h[0] &= SLIB_UINT64(0xfffffffffff);
+				h[1] += c;
+			}
+
+			// o = a * r (partially reduced)
+			static void Multiply(const sl_uint64* a, const sl_uint64* r, sl_uint64* o) noexcept
+			{
+				sl_uint64 s1 = r[1] * (5 << 2);
+				sl_uint64 s2 = r[2] * (5 << 2);
+				Accumulator d0, d1, d2;
+				d0.setProduct(a[0], r[0]);
+				d0.addProduct(a[1], s2);
+				d0.addProduct(a[2], s1);
+				d1.setProduct(a[0], r[1]);
+				d1.addProduct(a[1], r[0]);
+				d1.addProduct(a[2], s2);
+				d2.setProduct(a[0], r[2]);
+				d2.addProduct(a[1], r[1]);
+				d2.addProduct(a[2], r[0]);
+				Reduce(d0, d1, d2, o);
+			}
+
+		}
+	}
+
+	void Poly1305::start(const void* _key)
+	{
+		const sl_uint8* key = (const sl_uint8*)_key;
+		sl_uint64* r = m_r[0];
+		sl_uint64* h = m_h;
+		sl_uint32* pad = m_pad;
+
+		// r &= 0xffffffc0ffffffc0ffffffc0fffffff
+		sl_uint64 t0 = MIO::readUint64LE(key);
+		sl_uint64 t1 = MIO::readUint64LE(key + 8);
+		r[0] = t0 & SLIB_UINT64(0xffc0fffffff);
+		r[1] = ((t0 >> 44) | (t1 << 20)) & SLIB_UINT64(0xfffffc0ffff);
+		r[2] = (t1 >> 24) & SLIB_UINT64(0x00ffffffc0f);
+
+		// powers of r, used to process 4 blocks with one reduction
+		priv::poly1305::Multiply(m_r[0], m_r[0], m_r[1]);
+		priv::poly1305::Multiply(m_r[1], m_r[0], m_r[2]);
+		priv::poly1305::Multiply(m_r[2], m_r[0], m_r[3]);
+
+		// h = 0
+		h[0] = 0;
+		h[1] = 0;
+		h[2] = 0;
+
+		// save pad for later
+		pad[0] = MIO::readUint32LE(key + 16);
+		pad[1] = MIO::readUint32LE(key + 20);
+		pad[2] = MIO::readUint32LE(key + 24);
+		pad[3] = MIO::readUint32LE(key + 28);
+
+		m_leftOver = 0;
+		m_flagFinal = sl_false;
+	}
+
+	void Poly1305::updateBlocks(const void* input, sl_size nBlocks)
+	{
+		const sl_uint8* m = (const sl_uint8*)input;
+
+		const sl_uint64 hibit = m_flagFinal ? 0 : ((sl_uint64)1 << 40); // 1 << 128
+
+		sl_uint64 h[3];
+		h[0] = m_h[0];
+		h[1] = m_h[1];
+		h[2] = m_h[2];
+
+		priv::poly1305::Accumulator d0, d1, d2;
+
+		if (nBlocks >= 4) {
+			// h = (h + m[0]) * r^4 + m[1] * r^3 + m[2] * r^2 + m[3] * r
+			sl_uint64 r[4][3], s[4][3];
+			sl_uint32 k;
+			for (k = 0; k < 4; k++) {
+				r[k][0] = m_r[3 - k][0];
+				r[k][1] = m_r[3 - k][1];
+				r[k][2] = m_r[3 - k][2];
+				s[k][1] = r[k][1] * (5 << 2);
+				s[k][2] = r[k][2] * (5 << 2);
+			}
+			do {
+				for (k = 0; k < 4; k++) {
+					sl_uint64 t0 = MIO::readUint64LE(m);
+					sl_uint64 t1 = MIO::readUint64LE(m + 8);
+					sl_uint64 a0 = t0 & SLIB_UINT64(0xfffffffffff);
+					sl_uint64 a1 = ((t0 >> 44) | (t1 << 20)) & SLIB_UINT64(0xfffffffffff);
+					sl_uint64 a2 = ((t1 >> 24) & SLIB_UINT64(0x3ffffffffff)) | hibit;
+					if (k) {
+						d0.addProduct(a0, r[k][0]);
+						d0.addProduct(a1, s[k][2]);
+						d0.addProduct(a2, s[k][1]);
+						d1.addProduct(a0, r[k][1]);
+						d1.addProduct(a1, r[k][0]);
+						d1.addProduct(a2, s[k][2]);
+						d2.addProduct(a0, r[k][2]);
+						d2.addProduct(a1, r[k][1]);
+						d2.addProduct(a2, r[k][0]);
+					} else {
+						a0 += h[0];
+						a1 += h[1];
+						a2 += h[2];
+						d0.setProduct(a0, r[0][0]);
+						d0.addProduct(a1, s[0][2]);
+						d0.addProduct(a2, s[0][1]);
+						d1.setProduct(a0, r[0][1]);
+						d1.addProduct(a1, r[0][0]);
+						d1.addProduct(a2, s[0][2]);
+						d2.setProduct(a0, r[0][2]);
+						d2.addProduct(a1, r[0][1]);
+						d2.addProduct(a2, r[0][0]);
+					}
+					m += 16;
+				}
+				priv::poly1305::Reduce(d0, d1, d2, h);
+				nBlocks -= 4;
+			} while (nBlocks >= 4);
+		}
+
+		const sl_uint64* r = m_r[0];
+		sl_uint64 s1 = r[1] * (5 << 2);
+		sl_uint64 s2 = r[2] * (5 << 2);
+
+		for (sl_size i = 0; i < nBlocks; i++) {
+			// h += m[i]
+			sl_uint64 t0 = MIO::readUint64LE(m);
+			sl_uint64 t1 = MIO::readUint64LE(m + 8);
+			h[0] += t0 & SLIB_UINT64(0xfffffffffff);
+			h[1] += ((t0 >> 44) | (t1 << 20)) & SLIB_UINT64(0xfffffffffff);
+			h[2] += ((t1 >> 24) & SLIB_UINT64(0x3ffffffffff)) | hibit;
+			// h *= r
+			d0.setProduct(h[0], r[0]);
+			d0.addProduct(h[1], s2);
+			d0.addProduct(h[2], s1);
+			d1.setProduct(h[0], r[1]);
+			d1.addProduct(h[1], r[0]);
+			d1.addProduct(h[2], s2);
+			d2.setProduct(h[0], r[2]);
+			d2.addProduct(h[1], r[1]);
+			d2.addProduct(h[2], r[0]);
+			// (partial) h %= p
+			priv::poly1305::Reduce(d0, d1, d2, h);
+			m += 16;
+		}
+
+		m_h[0] = h[0];
+		m_h[1] = h[1];
+		m_h[2] = h[2];
+	}
+#else
 	void Poly1305::start(const void* _key)
 	{
 		const sl_uint8* key = (const sl_uint8*)_key;
@@ -135,6 +377,7 @@ namespace slib
 		m_h[3] = h3;
 		m_h[4] = h4;
 	}
+#endif
 	
 	void Poly1305::update(const void* input, sl_size n)
 	{
@@ -192,6 +435,46 @@ namespace slib
 			updateBlocks(m_buffer, 1);
 		}
 		
+#if defined(SLIB_ARCH_IS_64BIT)
+		sl_uint64 h0 = m_h[0];
+		sl_uint64 h1 = m_h[1];
+		sl_uint64 h2 = m_h[2];
+
+		// fully carry h
+		sl_uint64 c = h1 >> 44; h1 &= SLIB_UINT64(0xfffffffffff);
+		h2 += c; c = h2 >> 42; h2 &= SLIB_UINT64(0x3ffffffffff);
+		h0 += c * 5; c = h0 >> 44; h0 &= SLIB_UINT64(0xfffffffffff);
+		h1 += c; c = h1 >> 44; h1 &= SLIB_UINT64(0xfffffffffff);
+		h2 += c; c = h2 >> 42; h2 &= SLIB_UINT64(0x3ffffffffff);
+		h0 += c * 5; c = h0 >> 44; h0 &= SLIB_UINT64(0xfffffffffff);
+		h1 += c;
+
+		// compute h + -p
+		sl_uint64 g0 = h0 + 5; c = g0 >> 44; g0 &= SLIB_UINT64(0xfffffffffff);
+		sl_uint64 g1 = h1 + c; c = g1 >> 44; g1 &= SLIB_UINT64(0xfffffffffff);
+		sl_uint64 g2 = h2 + c - ((sl_uint64)1 << 42);
+
+		// select h if h < p, or h + -p if h >= p
+		c = (g2 >> 63) - 1;
+		g0 &= c;
+		g1 &= c;
+		g2 &= c;
+		c = ~c;
+		h0 = (h0 & c) | g0;
+		h1 = (h1 & c) | g1;
+		h2 = (h2 & c) | g2;
+
+		// h = (h + pad)
+		sl_uint64 t0 = ((sl_uint64)(m_pad[1]) << 32) | m_pad[0];
+		sl_uint64 t1 = ((sl_uint64)(m_pad[3]) << 32) | m_pad[2];
+		h0 += t0 & SLIB_UINT64(0xfffffffffff); c = h0 >> 44; h0 &= SLIB_UINT64(0xfffffffffff);
+		h1 += (((t0 >> 44) | (t1 << 20)) & SLIB_UINT64(0xfffffffffff)) + c; c = h1 >> 44; h1 &= SLIB_UINT64(0xfffffffffff);
+		h2 += ((t1 >> 24) & SLIB_UINT64(0x3ffffffffff)) + c; h2 &= SLIB_UINT64(0x3ffffffffff);
+
+		// mac = h % (2^128)
+		MIO::writeUint64LE(mac, h0 | (h1 << 44));
+		MIO::writeUint64LE(mac + 8, (h1 >> 20) | (h2 << 24));
+#else
 		sl_uint32 h0 = m_h[0];
 		sl_uint32 h1 = m_h[1];
 		sl_uint32 h2 = m_h[2];
@@ -242,6 +525,7 @@ namespace slib
 		MIO::writeUint32LE(mac + 4, h1);
 		MIO::writeUint32LE(mac + 8, h2);
 		MIO::writeUint32LE(mac + 12, h3);
+#endif
 	}
 	
 	void Poly1305::execute(const void* key, const void* message, sl_size lenMessage, void* output)
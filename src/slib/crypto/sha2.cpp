@@ -25,6 +25,23 @@
 #include "slib/core/mio.h"
 #include "slib/core/math.h"
 
+#if defined(SLIB_ARCH_IS_X64)
+#	define SLIB_SHA256_USE_SHANI
+#	define SLIB_SHA256_USE_AVX2
+#	include "slib/core/asm.h"
+#	include <immintrin.h>
+#	if defined(SLIB_COMPILER_IS_GCC)
+#		define SLIB_SHA256_TARGET_SHANI __attribute__((target("sha,sse4.1")))
+#		define SLIB_SHA256_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define SLIB_SHA256_TARGET_SHANI
+#		define SLIB_SHA256_TARGET_AVX2
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#	define SLIB_SHA256_USE_ARMV8
+#	include <arm_neon.h>
+#endif
+
 namespace slib
 {
 
@@ -33,6 +50,398 @@ namespace slib
 		namespace sha2
 		{
 
+			SLIB_ALIGN(16) static const sl_uint32 g_K256[64] = {
+				0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul,
+				0x3956c25bul, 0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul,
+				0xd807aa98ul, 0x12835b01ul, 0x243185beul, 0x550c7dc3ul,
+				0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul, 0xc19bf174ul,
+				0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul,
+				0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul,
+				0x983e5152ul, 0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul,
+				0xc6e00bf3ul, 0xd5a79147ul, 0x06ca6351ul, 0x14292967ul,
+				0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul, 0x53380d13ul,
+				0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
+				0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul,
+				0xd192e819ul, 0xd6990624ul, 0xf40e3585ul, 0x106aa070ul,
+				0x19a4c116ul, 0x1e376c08ul, 0x2748774cul, 0x34b0bcb5ul,
+				0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful, 0x682e6ff3ul,
+				0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul,
+				0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul,
+			};
+
+			static void UpdateSections_Generic(sl_uint32* h, const sl_uint8* input, sl_size nSections)
+			{
+				sl_uint32 W[64];
+				sl_uint32 v[8];
+				sl_uint32 i;
+				for (; nSections; nSections--) {
+					for (i = 0; i < 16; i++) {
+						W[i] = MIO::readUint32BE(input + (i << 2));
+					}
+					for (i = 16; i < 64; i++) {
+						sl_uint32 s0 = Math::rotateRight32(W[i - 15], 7) ^ Math::rotateRight32(W[i - 15], 18) ^ (W[i - 15] >> 3);
+						sl_uint32 s1 = Math::rotateRight32(W[i - 2], 17) ^ Math::rotateRight32(W[i - 2], 19) ^ (W[i - 2] >> 10);
+						W[i] = W[i - 16] + s0 + W[i - 7] + s1;
+					}
+					for (i = 0; i < 8; i++) {
+						v[i] = h[i];
+					}
+					for (i = 0; i < 64; i++) {
+						sl_uint32 S1 = Math::rotateRight32(v[4], 6) ^ Math::rotateRight32(v[4], 11) ^ Math::rotateRight32(v[4], 25);
+						sl_uint32 ch = (v[4] & v[5]) ^ ((~v[4]) & v[6]);
+						sl_uint32 temp1 = v[7] + S1 + ch + g_K256[i] + W[i];
+						sl_uint32 S0 = Math::rotateRight32(v[0], 2) ^ Math::rotateRight32(v[0], 13) ^ Math::rotateRight32(v[0], 22);
+						sl_uint32 maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+						sl_uint32 temp2 = S0 + maj;
+						v[7] = v[6];
+						v[6] = v[5];
+						v[5] = v[4];
+						v[4] = v[3] + temp1;
+						v[3] = v[2];
+						v[2] = v[1];
+						v[1] = v[0];
+						v[0] = temp1 + temp2;
+					}
+					for (i = 0; i < 8; i++) {
+						h[i] += v[i];
+					}
+					input += 64;
+				}
+			}
+
+#if defined(SLIB_SHA256_USE_SHANI)
+/*
+	Intel SHA Extensions: the state is kept as ABEF/CDGH, and each SHA256RNDS2 performs two rounds
+*/
+#define SHA256_SHANI_ROUNDS(M, k) \
+	T = _mm_add_epi32(M, _mm_load_si128((const __m128i*)(g_K256 + (k)))); \
+	state1 = _mm_sha256rnds2_epu32(state1, state0, T); \
+	T = _mm_shuffle_epi32(T, 0x0E); \
+	state0 = _mm_sha256rnds2_epu32(state0, state1, T);
+
+#define SHA256_SHANI_SCHEDULE(M_NEXT, M, M_PREV) \
+	M_NEXT = _mm_sha256msg2_epu32(_mm_add_epi32(M_NEXT, _mm_alignr_epi8(M, M_PREV, 4)), M);
+
+			SLIB_SHA256_TARGET_SHANI
+			static void UpdateSections_SHANI(sl_uint32* h, const sl_uint8* input, sl_size nSections)
+			{
+				const __m128i maskSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+				__m128i T = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)h), 0xB1); // CDAB
+				__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(h + 4)), 0x1B); // EFGH
+				__m128i state0 = _mm_alignr_epi8(T, state1, 8); // ABEF
+				state1 = _mm_blend_epi16(state1, T, 0xF0); // CDGH
+				for (; nSections; nSections--) {
+					__m128i save0 = state0;
+					__m128i save1 = state1;
+					__m128i M0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)input), maskSwap);
+					SHA256_SHANI_ROUNDS(M0, 0)
+					__m128i M1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(input + 16)), maskSwap);
+					SHA256_SHANI_ROUNDS(M1, 4)
+					M0 = _mm_sha256msg1_epu32(M0, M1);
+					__m128i M2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(input + 32)), maskSwap);
+					SHA256_SHANI_ROUNDS(M2, 8)
+					M1 = _mm_sha256msg1_epu32(M1, M2);
+					__m128i M3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(input + 48)), maskSwap);
+					SHA256_SHANI_ROUNDS(M3, 12)
+					SHA256_SHANI_SCHEDULE(M0, M3, M2)
+					M2 = _mm_sha256msg1_epu32(M2, M3);
+					for (sl_uint32 k = 16; k < 48; k += 16) {
+						SHA256_SHANI_ROUNDS(M0, k)
+						SHA256_SHANI_SCHEDULE(M1, M0, M3)
+						M3 = _mm_sha256msg1_epu32(M3, M0);
+						SHA256_SHANI_ROUNDS(M1, k + 4)
+						SHA256_SHANI_SCHEDULE(M2, M1, M0)
+						M0 = _mm_sha256msg1_epu32(M0, M1);
+						SHA256_SHANI_ROUNDS(M2, k + 8)
+						SHA256_SHANI_SCHEDULE(M3, M2, M1)
+						M1 = _mm_sha256msg1_epu32(M1, M2);
+						SHA256_SHANI_ROUNDS(M3, k + 12)
+						SHA256_SHANI_SCHEDULE(M0, M3, M2)
+						M2 = _mm_sha256msg1_epu32(M2, M3);
+					}
+					SHA256_SHANI_ROUNDS(M0, 48)
+					SHA256_SHANI_SCHEDULE(M1, M0, M3)
+					M3 = _mm_sha256msg1_epu32(M3, M0);
+					SHA256_SHANI_ROUNDS(M1, 52)
+					SHA256_SHANI_SCHEDULE(M2, M1, M0)
+					SHA256_SHANI_ROUNDS(M2, 56)
+					SHA256_SHANI_SCHEDULE(M3, M2, M1)
+					SHA256_SHANI_ROUNDS(M3, 60)
+					state0 = _mm_add_epi32(state0, save0);
+					state1 = _mm_add_epi32(state1, save1);
+					input += 64;
+				}
+				T = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+				state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+				_mm_storeu_si128((__m128i*)h, _mm_blend_epi16(T, state1, 0xF0)); // DCBA
+				_mm_storeu_si128((__m128i*)(h + 4), _mm_alignr_epi8(state1, T, 8)); // HGFE
+			}
+
+			static sl_bool IsShaNiEnabled()
+			{
+				static sl_bool flag = CanUseShaNi();
+				return flag;
+			}
+#elif defined(SLIB_SHA256_USE_ARMV8)
+#define SHA256_ARMV8_ROUNDS(M, k) \
+	T = vaddq_u32(M, vld1q_u32(g_K256 + (k))); \
+	save = state0; \
+	state0 = vsha256hq_u32(state0, state1, T); \
+	state1 = vsha256h2q_u32(state1, save, T);
+
+#define SHA256_ARMV8_SCHEDULE(M0, M1, M2, M3) \
+	M0 = vsha256su1q_u32(vsha256su0q_u32(M0, M1), M2, M3);
+
+			static void UpdateSections_ARMv8(sl_uint32* h, const sl_uint8* input, sl_size nSections)
+			{
+				uint32x4_t state0 = vld1q_u32(h); // ABCD
+				uint32x4_t state1 = vld1q_u32(h + 4); // EFGH
+				for (; nSections; nSections--) {
+					uint32x4_t save0 = state0;
+					uint32x4_t save1 = state1;
+					uint32x4_t T, save;
+					uint32x4_t M0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(input)));
+					uint32x4_t M1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(input + 16)));
+					uint32x4_t M2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(input + 32)));
+					uint32x4_t M3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(input + 48)));
+					for (sl_uint32 k = 0; k < 48; k += 16) {
+						SHA256_ARMV8_ROUNDS(M0, k)
+						SHA256_ARMV8_SCHEDULE(M0, M1, M2, M3)
+						SHA256_ARMV8_ROUNDS(M1, k + 4)
+						SHA256_ARMV8_SCHEDULE(M1, M2, M3, M0)
+						SHA256_ARMV8_ROUNDS(M2, k + 8)
+						SHA256_ARMV8_SCHEDULE(M2, M3, M0, M1)
+						SHA256_ARMV8_ROUNDS(M3, k + 12)
+						SHA256_ARMV8_SCHEDULE(M3, M0, M1, M2)
+					}
+					SHA256_ARMV8_ROUNDS(M0, 48)
+					SHA256_ARMV8_ROUNDS(M1, 52)
+					SHA256_ARMV8_ROUNDS(M2, 56)
+					SHA256_ARMV8_ROUNDS(M3, 60)
+					state0 = vaddq_u32(state0, save0);
+					state1 = vaddq_u32(state1, save1);
+					input += 64;
+				}
+				vst1q_u32(h, state0);
+				vst1q_u32(h + 4, state1);
+			}
+#endif
+
+			static void UpdateSections(sl_uint32* h, const sl_uint8* input, sl_size nSections)
+			{
+#if defined(SLIB_SHA256_USE_SHANI)
+				if (IsShaNiEnabled()) {
+					UpdateSections_SHANI(h, input, nSections);
+					return;
+				}
+#elif defined(SLIB_SHA256_USE_ARMV8)
+				UpdateSections_ARMv8(h, input, nSections);
+				return;
+#endif
+				UpdateSections_Generic(h, input, nSections);
+			}
+
+#if defined(SLIB_SHA256_USE_AVX2)
+/*
+	Multi-buffer SHA-256: every 32-bit lane of the AVX2 registers runs an independent message.
+	A lane is refilled with the next message as soon as its current message is finished.
+*/
+#define SHA256_AVX2_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+#define SHA256_AVX2_ROUND(a, b, c, d, e, f, g, h, i) \
+	if ((i) >= 16) { \
+		__m256i w15 = W[((i) + 1) & 15]; \
+		__m256i w2 = W[((i) + 14) & 15]; \
+		__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(SHA256_AVX2_ROTR(w15, 7), SHA256_AVX2_ROTR(w15, 18)), _mm256_srli_epi32(w15, 3)); \
+		__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(SHA256_AVX2_ROTR(w2, 17), SHA256_AVX2_ROTR(w2, 19)), _mm256_srli_epi32(w2, 10)); \
+		W[(i) & 15] = _mm256_add_epi32(_mm256_add_epi32(W[(i) & 15], s0), _mm256_add_epi32(W[((i) + 9) & 15], s1)); \
+	} \
+	{ \
+		__m256i S1 = _mm256_xor_si256(_mm256_xor_si256(SHA256_AVX2_ROTR(e, 6), SHA256_AVX2_ROTR(e, 11)), SHA256_AVX2_ROTR(e, 25)); \
+		__m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g)); \
+		__m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32((int)(g_K256[(i)])), W[(i) & 15]))); \
+		__m256i S0 = _mm256_xor_si256(_mm256_xor_si256(SHA256_AVX2_ROTR(a, 2), SHA256_AVX2_ROTR(a, 13)), SHA256_AVX2_ROTR(a, 22)); \
+		__m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b))); \
+		d = _mm256_add_epi32(d, t1); \
+		h = _mm256_add_epi32(t1, _mm256_add_epi32(S0, maj)); \
+	}
+
+			SLIB_SHA256_TARGET_AVX2
+			static void Transpose8_AVX2(__m256i* r)
+			{
+				__m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+				__m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+				__m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+				__m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+				__m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+				__m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+				__m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+				__m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+				__m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+				__m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+				__m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+				__m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+				__m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+				__m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+				__m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+				__m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+				r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+				r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+				r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+				r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+				r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+				r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+				r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+				r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+			}
+
+			// `state[j]` holds the word `j` of the state for each lane, `mask` selects the lanes to be updated
+			SLIB_SHA256_TARGET_AVX2
+			static void UpdateSection8_AVX2(__m256i* state, const sl_uint8* const* inputs, __m256i mask)
+			{
+				const __m256i maskSwap = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+				__m256i W[16];
+				sl_uint32 i;
+				for (i = 0; i < 8; i++) {
+					W[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(inputs[i])), maskSwap);
+					W[i + 8] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(inputs[i] + 32)), maskSwap);
+				}
+				Transpose8_AVX2(W);
+				Transpose8_AVX2(W + 8);
+				__m256i a = state[0];
+				__m256i b = state[1];
+				__m256i c = state[2];
+				__m256i d = state[3];
+				__m256i e = state[4];
+				__m256i f = state[5];
+				__m256i g = state[6];
+				__m256i h = state[7];
+				for (i = 0; i < 64; i += 8) {
+					SHA256_AVX2_ROUND(a, b, c, d, e, f, g, h, i)
+					SHA256_AVX2_ROUND(h, a, b, c, d, e, f, g, i + 1)
+					SHA256_AVX2_ROUND(g, h, a, b, c, d, e, f, i + 2)
+					SHA256_AVX2_ROUND(f, g, h, a, b, c, d, e, i + 3)
+					SHA256_AVX2_ROUND(e, f, g, h, a, b, c, d, i + 4)
+					SHA256_AVX2_ROUND(d, e, f, g, h, a, b, c, i + 5)
+					SHA256_AVX2_ROUND(c, d, e, f, g, h, a, b, i + 6)
+					SHA256_AVX2_ROUND(b, c, d, e, f, g, h, a, i + 7)
+				}
+				state[0] = _mm256_add_epi32(state[0], _mm256_and_si256(a, mask));
+				state[1] = _mm256_add_epi32(state[1], _mm256_and_si256(b, mask));
+				state[2] = _mm256_add_epi32(state[2], _mm256_and_si256(c, mask));
+				state[3] = _mm256_add_epi32(state[3], _mm256_and_si256(d, mask));
+				state[4] = _mm256_add_epi32(state[4], _mm256_and_si256(e, mask));
+				state[5] = _mm256_add_epi32(state[5], _mm256_and_si256(f, mask));
+				state[6] = _mm256_add_epi32(state[6], _mm256_and_si256(g, mask));
+				state[7] = _mm256_add_epi32(state[7], _mm256_and_si256(h, mask));
+			}
+
+			class BatchLane
+			{
+			public:
+				const sl_uint8* data;
+				sl_size nSections;
+				sl_size nDataSections;
+				sl_size iSection;
+				sl_uint8* output;
+				sl_uint8 tail[128];
+
+			public:
+				void start(const void* input, sl_size size, sl_uint64 sizePrefix, sl_uint8* _output)
+				{
+					data = (const sl_uint8*)input;
+					nDataSections = size >> 6;
+					sl_uint32 n = (sl_uint32)(size & 63);
+					Base::copyMemory(tail, data + (nDataSections << 6), n);
+					tail[n] = 0x80;
+					sl_uint32 nTail = n < 56 ? 64 : 128;
+					Base::zeroMemory(tail + n + 1, nTail - 9 - n);
+					MIO::writeUint64BE(tail + nTail - 8, (sizePrefix + size) << 3);
+					nSections = nDataSections + (nTail >> 6);
+					iSection = 0;
+					output = _output;
+				}
+
+				const sl_uint8* getSection()
+				{
+					if (iSection < nDataSections) {
+						return data + (iSection << 6);
+					} else {
+						return tail + ((iSection - nDataSections) << 6);
+					}
+				}
+
+			};
+
+			SLIB_SHA256_TARGET_AVX2
+			static void HashBatch_AVX2(const sl_uint32* hInit, sl_uint64 sizePrefix, const void* const* inputs, const sl_size* sizes, sl_size n, sl_uint8* output)
+			{
+				__m256i state[8];
+				sl_uint32* S = (sl_uint32*)state;
+				BatchLane lanes[8];
+				const sl_uint8* sections[8];
+				SLIB_ALIGN(32) sl_int32 masks[8];
+				sl_size iMessage = 0;
+				sl_uint32 nActive = 0;
+				sl_uint32 i, j;
+				for (j = 0; j < 8; j++) {
+					state[j] = _mm256_set1_epi32((int)(hInit[j]));
+				}
+				for (i = 0; i < 8; i++) {
+					if (iMessage < n) {
+						lanes[i].start(inputs[iMessage], sizes[iMessage], sizePrefix, output + (iMessage << 5));
+						iMessage++;
+						nActive++;
+						masks[i] = -1;
+					} else {
+						lanes[i].data = lanes[i].tail;
+						lanes[i].nSections = 0;
+						lanes[i].nDataSections = 1;
+						lanes[i].iSection = 0;
+						masks[i] = 0;
+					}
+				}
+				while (nActive) {
+					for (i = 0; i < 8; i++) {
+						sections[i] = lanes[i].getSection();
+					}
+					UpdateSection8_AVX2(state, sections, _mm256_load_si256((const __m256i*)masks));
+					for (i = 0; i < 8; i++) {
+						BatchLane& lane = lanes[i];
+						if (!(masks[i])) {
+							continue;
+						}
+						lane.iSection++;
+						if (lane.iSection < lane.nSections) {
+							continue;
+						}
+						for (j = 0; j < 8; j++) {
+							MIO::writeUint32BE(lane.output + (j << 2), S[(j << 3) + i]);
+						}
+						if (iMessage < n) {
+							lane.start(inputs[iMessage], sizes[iMessage], sizePrefix, output + (iMessage << 5));
+							iMessage++;
+							for (j = 0; j < 8; j++) {
+								S[(j << 3) + i] = hInit[j];
+							}
+						} else {
+							lane.data = lane.tail;
+							lane.nDataSections = 1;
+							lane.iSection = 0;
+							masks[i] = 0;
+							nActive--;
+						}
+					}
+				}
+			}
+
+			static sl_bool IsAvx2Enabled()
+			{
+				static sl_bool flag = CanUseAvx2();
+				return flag;
+			}
+#endif
+
 			SHA256Base::SHA256Base()
 			{
 				rdata_len = 0;
@@ -75,10 +484,12 @@ namespace slib
 						}
 					}
 				}
-				while (sizeInput >= 64) {
-					_updateSection(input);
-					sizeInput -= 64;
-					input += 64;
+				if (sizeInput >= 64) {
+					sl_size nSections = sizeInput >> 6;
+					UpdateSections(h, input, nSections);
+					nSections <<= 6;
+					sizeInput -= nSections;
+					input += nSections;
 				}
 				if (sizeInput) {
 					Base::copyMemory(rdata, input, sizeInput);
@@ -108,58 +519,7 @@ namespace slib
 
 			void SHA256Base::_updateSection(const sl_uint8* input)
 			{
-				static sl_uint32 K[64] = {
-					0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul,
-					0x3956c25bul, 0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul,
-					0xd807aa98ul, 0x12835b01ul, 0x243185beul, 0x550c7dc3ul,
-					0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul, 0xc19bf174ul,
-					0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul,
-					0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul,
-					0x983e5152ul, 0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul,
-					0xc6e00bf3ul, 0xd5a79147ul, 0x06ca6351ul, 0x14292967ul,
-					0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul, 0x53380d13ul,
-					0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
-					0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul,
-					0xd192e819ul, 0xd6990624ul, 0xf40e3585ul, 0x106aa070ul,
-					0x19a4c116ul, 0x1e376c08ul, 0x2748774cul, 0x34b0bcb5ul,
-					0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful, 0x682e6ff3ul,
-					0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul,
-					0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul,
-				};
-
-				sl_uint32 W[64];
-				sl_uint32 v[8];
-				sl_uint32 i;
-				for (i = 0; i < 16; i++) {
-					W[i] = MIO::readUint32BE(input + (i << 2));
-				}
-				for (i = 16; i < 64; i++) {
-					sl_uint32 s0 = Math::rotateRight32(W[i - 15], 7) ^ Math::rotateRight32(W[i - 15], 18) ^ (W[i - 15] >> 3);
-					sl_uint32 s1 = Math::rotateRight32(W[i - 2], 17) ^ Math::rotateRight32(W[i - 2], 19) ^ (W[i - 2] >> 10);
-					W[i] = W[i - 16] + s0 + W[i - 7] + s1;
-				}
-				for (i = 0; i < 8; i++) {
-					v[i] = h[i];
-				}
-				for (i = 0; i < 64; i++) {
-					sl_uint32 S1 = Math::rotateRight32(v[4], 6) ^ Math::rotateRight32(v[4], 11) ^ Math::rotateRight32(v[4], 25);
-					sl_uint32 ch = (v[4] & v[5]) ^ ((~v[4]) & v[6]);
-					sl_uint32 temp1 = v[7] + S1 + ch + K[i] + W[i];
-					sl_uint32 S0 = Math::rotateRight32(v[0], 2) ^ Math::rotateRight32(v[0], 13) ^ Math::rotateRight32(v[0], 22);
-					sl_uint32 maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
-					sl_uint32 temp2 = S0 + maj;
-					v[7] = v[6];
-					v[6] = v[5];
-					v[5] = v[4];
-					v[4] = v[3] + temp1;
-					v[3] = v[2];
-					v[2] = v[1];
-					v[1] = v[0];
-					v[0] = temp1 + temp2;
-				}
-				for (i = 0; i < 8; i++) {
-					h[i] += v[i];
-				}
+				UpdateSections(h, input, 1);
 			}
 
 			SHA512Base::SHA512Base()
@@ -431,4 +791,30 @@ namespace slib
 		return MIO::readUint32LE(hash);
 	}
 
+	void SHA256::hashBatch(const void* const* inputs, const sl_size* sizes, sl_size n, void* outputs)
+	{
+		hashBatch(sl_null, 0, inputs, sizes, n, outputs);
+	}
+
+	void SHA256::hashBatch(const void* prefix, sl_size sizePrefix, const void* const* inputs, const sl_size* sizes, sl_size n, void* _outputs)
+	{
+		sl_uint8* outputs = (sl_uint8*)_outputs;
+		SHA256 base;
+		base.start();
+		base.update(prefix, sizePrefix);
+#if defined(SLIB_SHA256_USE_AVX2)
+		// A single SHA-NI stream outruns eight AVX2 lanes, so the multi-buffer path is used only without SHA-NI
+		if (n > 1 && !(sizePrefix & 63) && !(priv::sha2::IsShaNiEnabled()) && priv::sha2::IsAvx2Enabled()) {
+			priv::sha2::HashBatch_AVX2(base.h, sizePrefix, inputs, sizes, n, outputs);
+			return;
+		}
+#endif
+		for (sl_size i = 0; i < n; i++) {
+			SHA256 hash(base);
+			hash.update(inputs[i], sizes[i]);
+			hash.finish(outputs);
+			outputs += HashSize;
+		}
+	}
+
 }
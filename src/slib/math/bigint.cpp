@@ -1702,6 +1702,349 @@ namespace slib
 		return sub(*this, v);
 	}
 
+	/*
+		Multiplication on 64-bit limbs
+
+		The 32-bit elements are packed into 64-bit limbs before multiplying, so that every step
+		uses a full 64x64->128 multiplication. Comba (column-wise) multiplication is used for
+		small operands, and Karatsuba above BIGINT_KARATSUBA_THRESHOLD limbs.
+	*/
+
+#define BIGINT_KARATSUBA_THRESHOLD 32
+
+#define BIGINT_COMBA_MULADD(x, y) \
+	{ \
+		sl_uint64 lo, hi; \
+		Math::mul64(x, y, hi, lo); \
+		c0 += lo; \
+		hi += (c0 < lo); \
+		c1 += hi; \
+		c2 += (c1 < hi); \
+	}
+
+#define BIGINT_COMBA_MULADD2(x, y) \
+	{ \
+		sl_uint64 lo, hi; \
+		Math::mul64(x, y, hi, lo); \
+		c2 += hi >> 63; \
+		hi = (hi << 1) | (lo >> 63); \
+		lo <<= 1; \
+		c0 += lo; \
+		hi += (c0 < lo); \
+		c1 += hi; \
+		c2 += (c1 < hi); \
+	}
+
+	namespace priv
+	{
+		namespace bigint
+		{
+
+			SLIB_INLINE static sl_size get_limbs_count(sl_size nElements) noexcept
+			{
+				return (nElements + 1) >> 1;
+			}
+
+			// `c` receives `nc` limbs, `na` <= `nc` * 2
+			static void limbs_from_elements(sl_uint64* c, sl_size nc, const sl_uint32* a, sl_size na) noexcept
+			{
+				sl_size i = 0;
+				sl_size n = na >> 1;
+				for (; i < n; i++) {
+					c[i] = ((sl_uint64)(a[i << 1])) | (((sl_uint64)(a[(i << 1) + 1])) << 32);
+				}
+				if (na & 1) {
+					c[i] = a[i << 1];
+					i++;
+				}
+				for (; i < nc; i++) {
+					c[i] = 0;
+				}
+			}
+
+			// `c` receives `na` * 2 elements
+			static void limbs_to_elements(sl_uint32* c, const sl_uint64* a, sl_size na) noexcept
+			{
+				for (sl_size i = 0; i < na; i++) {
+					c[i << 1] = (sl_uint32)(a[i]);
+					c[(i << 1) + 1] = (sl_uint32)(a[i] >> 32);
+				}
+			}
+
+			SLIB_INLINE static sl_size mse_limbs(const sl_uint64* a, sl_size n) noexcept
+			{
+				for (sl_size ni = n; ni > 0; ni--) {
+					if (a[ni - 1] != 0) {
+						return ni;
+					}
+				}
+				return 0;
+			}
+
+			SLIB_INLINE static sl_compare_result compare_limbs(const sl_uint64* a, const sl_uint64* b, sl_size n) noexcept
+			{
+				for (sl_size i = n; i > 0; i--) {
+					if (a[i - 1] > b[i - 1]) {
+						return 1;
+					}
+					if (a[i - 1] < b[i - 1]) {
+						return -1;
+					}
+				}
+				return 0;
+			}
+
+			// returns carry
+			SLIB_INLINE static sl_uint64 add_limbs(sl_uint64* c, const sl_uint64* a, const sl_uint64* b, sl_size n, sl_uint64 carry) noexcept
+			{
+				for (sl_size i = 0; i < n; i++) {
+					sl_uint64 s = a[i] + carry;
+					carry = s < carry;
+					sl_uint64 t = b[i];
+					s += t;
+					carry += s < t;
+					c[i] = s;
+				}
+				return carry;
+			}
+
+			// returns borrow
+			SLIB_INLINE static sl_uint64 sub_limbs(sl_uint64* c, const sl_uint64* a, const sl_uint64* b, sl_size n, sl_uint64 borrow) noexcept
+			{
+				for (sl_size i = 0; i < n; i++) {
+					sl_uint64 x = a[i];
+					sl_uint64 y = b[i];
+					sl_uint64 d = x - y;
+					sl_uint64 o = x < y;
+					o += d < borrow;
+					c[i] = d - borrow;
+					borrow = o;
+				}
+				return borrow;
+			}
+
+			// c[0..n) += v, returns carry
+			SLIB_INLINE static sl_uint64 increase_limbs(sl_uint64* c, sl_size n, sl_uint64 v) noexcept
+			{
+				for (sl_size i = 0; i < n && v; i++) {
+					sl_uint64 s = c[i] + v;
+					v = s < v;
+					c[i] = s;
+				}
+				return v;
+			}
+
+			// c[0..n) -= v, returns borrow
+			SLIB_INLINE static sl_uint64 decrease_limbs(sl_uint64* c, sl_size n, sl_uint64 v) noexcept
+			{
+				for (sl_size i = 0; i < n && v; i++) {
+					sl_uint64 x = c[i];
+					c[i] = x - v;
+					v = x < v;
+				}
+				return v;
+			}
+
+			// c[0..n) += a[0..n) * b, returns carry
+			SLIB_INLINE static sl_uint64 muladd_limb(sl_uint64* c, const sl_uint64* a, sl_size n, sl_uint64 b) noexcept
+			{
+				sl_uint64 carry = 0;
+				for (sl_size i = 0; i < n; i++) {
+					sl_uint64 lo, hi;
+					Math::mul64(a[i], b, hi, lo);
+					lo += carry;
+					hi += lo < carry;
+					sl_uint64 t = c[i];
+					lo += t;
+					hi += lo < t;
+					c[i] = lo;
+					carry = hi;
+				}
+				return carry;
+			}
+
+			// c[0..na+nb) = a * b, `c` must not overlap with the operands
+			static void mul_comba(sl_uint64* c, const sl_uint64* a, sl_size na, const sl_uint64* b, sl_size nb) noexcept
+			{
+				sl_uint64 c0 = 0, c1 = 0, c2 = 0;
+				sl_size n = na + nb - 1;
+				for (sl_size k = 0; k < n; k++) {
+					sl_size iStart = k < nb ? 0 : k - nb + 1;
+					sl_size iEnd = k < na ? k + 1 : na;
+					for (sl_size i = iStart; i < iEnd; i++) {
+						BIGINT_COMBA_MULADD(a[i], b[k - i])
+					}
+					c[k] = c0;
+					c0 = c1;
+					c1 = c2;
+					c2 = 0;
+				}
+				c[n] = c0;
+			}
+
+			// c[0..2n) = a * a, `c` must not overlap with the operand
+			static void sqr_comba(sl_uint64* c, const sl_uint64* a, sl_size n) noexcept
+			{
+				sl_uint64 c0 = 0, c1 = 0, c2 = 0;
+				sl_size m = (n << 1) - 1;
+				for (sl_size k = 0; k < m; k++) {
+					sl_size i = k < n ? 0 : k - n + 1;
+					sl_size j = k - i;
+					for (; i < j; i++, j--) {
+						BIGINT_COMBA_MULADD2(a[i], a[j])
+					}
+					if (i == j) {
+						BIGINT_COMBA_MULADD(a[i], a[i])
+					}
+					c[k] = c0;
+					c0 = c1;
+					c1 = c2;
+					c2 = 0;
+				}
+				c[m] = c0;
+			}
+
+			static sl_size get_karatsuba_scratch_size(sl_size n) noexcept
+			{
+				sl_size s = 0;
+				while (n >= BIGINT_KARATSUBA_THRESHOLD) {
+					n -= n >> 1;
+					s += 6 * n + 1;
+				}
+				return s;
+			}
+
+			// c[0..nx) = |x - y|, `nx` >= `ny`, returns sl_true when x < y
+			static sl_bool sub_abs_limbs(sl_uint64* c, const sl_uint64* x, sl_size nx, const sl_uint64* y, sl_size ny) noexcept
+			{
+				if (!(mse_limbs(x + ny, nx - ny)) && compare_limbs(x, y, ny) < 0) {
+					sub_limbs(c, y, x, ny, 0);
+					for (sl_size i = ny; i < nx; i++) {
+						c[i] = 0;
+					}
+					return sl_true;
+				} else {
+					sl_uint64 borrow = sub_limbs(c, x, y, ny, 0);
+					for (sl_size i = ny; i < nx; i++) {
+						sl_uint64 t = x[i];
+						c[i] = t - borrow;
+						borrow = t < borrow;
+					}
+					return sl_false;
+				}
+			}
+
+			/*
+				Adds the middle term of Karatsuba to `c` (2n limbs), where z0 = c[0..2h), z2 = c[2h..2n)
+				mid = z0 + z2 - zm (flagAdd: mid = z0 + z2 + zm)
+			*/
+			static void karatsuba_combine(sl_uint64* c, sl_size n, sl_size h, const sl_uint64* zm, sl_bool flagAdd, sl_uint64* mid) noexcept
+			{
+				sl_size k = n - h;
+				sl_size h2 = h << 1;
+				sl_size k2 = k << 1;
+				Base::copyMemory(mid, c + h2, k2 << 3);
+				mid[k2] = increase_limbs(mid + h2, k2 - h2, add_limbs(mid, mid, c, h2, 0));
+				if (flagAdd) {
+					mid[k2] += add_limbs(mid, mid, zm, k2, 0);
+				} else {
+					mid[k2] -= sub_limbs(mid, mid, zm, k2, 0);
+				}
+				sl_uint64 carry = add_limbs(c + h, c + h, mid, k2 + 1, 0);
+				increase_limbs(c + h + k2 + 1, n + k - k2 - 1, carry);
+			}
+
+			// c[0..2n) = a * b, `t` is scratch memory of get_karatsuba_scratch_size(n) limbs
+			static void mul_karatsuba(sl_uint64* c, const sl_uint64* a, const sl_uint64* b, sl_size n, sl_uint64* t) noexcept
+			{
+				if (n < BIGINT_KARATSUBA_THRESHOLD) {
+					mul_comba(c, a, n, b, n);
+					return;
+				}
+				sl_size h = n >> 1;
+				sl_size k = n - h;
+				sl_uint64* da = t;
+				sl_uint64* db = t + k;
+				sl_uint64* zm = t + (k << 1);
+				sl_uint64* next = zm + (k << 1);
+				// (a1 - a0) * (b1 - b0) = z2 + z0 - (a1*b0 + a0*b1)
+				sl_bool fa = sub_abs_limbs(da, a + h, k, a, h);
+				sl_bool fb = sub_abs_limbs(db, b + h, k, b, h);
+				mul_karatsuba(c, a, b, h, next);
+				mul_karatsuba(c + (h << 1), a + h, b + h, k, next);
+				mul_karatsuba(zm, da, db, k, next);
+				karatsuba_combine(c, n, h, zm, fa != fb, next);
+			}
+
+			// c[0..2n) = a * a, `t` is scratch memory of get_karatsuba_scratch_size(n) limbs
+			static void sqr_karatsuba(sl_uint64* c, const sl_uint64* a, sl_size n, sl_uint64* t) noexcept
+			{
+				if (n < BIGINT_KARATSUBA_THRESHOLD) {
+					sqr_comba(c, a, n);
+					return;
+				}
+				sl_size h = n >> 1;
+				sl_size k = n - h;
+				sl_uint64* da = t;
+				sl_uint64* zm = t + (k << 1);
+				sl_uint64* next = zm + (k << 1);
+				sub_abs_limbs(da, a + h, k, a, h);
+				sqr_karatsuba(c, a, h, next);
+				sqr_karatsuba(c + (h << 1), a + h, k, next);
+				sqr_karatsuba(zm, da, k, next);
+				karatsuba_combine(c, n, h, zm, sl_false, next);
+			}
+
+			SLIB_INLINE static sl_size get_mul_scratch_size(sl_size na, sl_size nb) noexcept
+			{
+				sl_size n = Math::min(na, nb);
+				if (n < BIGINT_KARATSUBA_THRESHOLD) {
+					return 0;
+				}
+				return (n << 1) + get_karatsuba_scratch_size(n);
+			}
+
+			// c[0..na+nb) = a * b, `t` is scratch memory of get_mul_scratch_size(na, nb) limbs
+			static void mul_limbs(sl_uint64* c, const sl_uint64* a, sl_size na, const sl_uint64* b, sl_size nb, sl_uint64* t) noexcept
+			{
+				if (na < nb) {
+					Swap(a, b);
+					Swap(na, nb);
+				}
+				if (nb < BIGINT_KARATSUBA_THRESHOLD) {
+					mul_comba(c, a, na, b, nb);
+					return;
+				}
+				if (na == nb) {
+					mul_karatsuba(c, a, b, na, t);
+					return;
+				}
+				// unbalanced: multiply by the slices of `a` with the size of `b`
+				Base::zeroMemory(c, (na + nb) << 3);
+				sl_uint64* p = t;
+				t += nb << 1;
+				for (sl_size offset = 0; offset < na; offset += nb) {
+					sl_size m = Math::min(nb, na - offset);
+					if (m == nb) {
+						mul_karatsuba(p, a + offset, b, nb, t);
+					} else {
+						mul_comba(p, b, nb, a + offset, m);
+					}
+					sl_size np = m + nb;
+					sl_uint64 carry = add_limbs(c + offset, c + offset, p, np, 0);
+					increase_limbs(c + offset + np, na + nb - offset - np, carry);
+				}
+			}
+
+			// c[0..2n) = a * a, `t` is scratch memory of get_mul_scratch_size(n, n) limbs
+			SLIB_INLINE static void sqr_limbs(sl_uint64* c, const sl_uint64* a, sl_size n, sl_uint64* t) noexcept
+			{
+				sqr_karatsuba(c, a, n, t);
+			}
+
+		}
+	}
+
 	sl_bool CBigInt::mulAbs(const CBigInt& a, const CBigInt& b) noexcept
 	{
 		sl_size na = a.getMostSignificantElements();
@@ -1718,35 +2061,37 @@ namespace slib
 		} else {
 			nd = getMostSignificantElements();
 		}
-		sl_size n = na + nb;
-		SLIB_SCOPED_BUFFER(sl_uint64, STACK_BUFFER_SIZE, out, n);
-		if (!out) {
+		sl_size la = priv::bigint::get_limbs_count(na);
+		sl_size lb = priv::bigint::get_limbs_count(nb);
+		sl_size n = la + lb;
+		SLIB_SCOPED_BUFFER(sl_uint64, STACK_BUFFER_SIZE, buf, la + lb + n + priv::bigint::get_mul_scratch_size(la, lb));
+		if (!buf) {
 			return sl_false;
 		}
-		Base::zeroMemory(out, 8 * n);
-		for (sl_size ib = 0; ib < nb; ib++) {
-			for (sl_size ia = 0; ia < na; ia++) {
-				sl_uint64 c = a.elements[ia];
-				c *= b.elements[ib];
-				out[ia + ib] += (sl_uint32)c;
-				out[ia + ib + 1] += (sl_uint32)(c >> 32);
-			}
+		sl_uint64* A = buf;
+		sl_uint64* B = A + la;
+		sl_uint64* out = B + lb;
+		priv::bigint::limbs_from_elements(A, la, a.elements, na);
+		if (&a == &b) {
+			priv::bigint::sqr_limbs(out, A, la, out + n);
+		} else {
+			priv::bigint::limbs_from_elements(B, lb, b.elements, nb);
+			priv::bigint::mul_limbs(out, A, la, B, lb, out + n);
 		}
-		sl_uint32 o = 0;
-		sl_size i;
-		sl_size m = 0;
-		for (i = 0; i < n; i++) {
-			sl_uint64 c = out[i] + o;
-			sl_uint32 t = (sl_uint32)c;
-			out[i] = t;
-			if (t) {
-				m = i;
-			}
-			o = (sl_uint32)(c >> 32);
+		n = priv::bigint::mse_limbs(out, n);
+		sl_size m = n << 1;
+		if ((out[n - 1] >> 32) == 0) {
+			m--;
 		}
-		if (growLength(m + 1)) {
-			for (i = 0; i <= m; i++) {
-				elements[i] = (sl_uint32)(out[i]);
+		if (growLength(m)) {
+			sl_size i;
+			for (i = 0; i + 1 < m; i += 2) {
+				elements[i] = (sl_uint32)(out[i >> 1]);
+				elements[i + 1] = (sl_uint32)(out[i >> 1] >> 32);
+			}
+			if (i < m) {
+				elements[i] = (sl_uint32)(out[i >> 1]);
+				i++;
 			}
 			for (; i < nd; i++) {
 				elements[i] = 0;
@@ -2307,181 +2652,270 @@ namespace slib
 	{
 		namespace bigint
 		{
-			
-			// Montgomery multiplication: A = A * B * R^-1 mod M
-			static sl_bool mont_mul(CBigInt& A, const CBigInt& B, const CBigInt& M, sl_uint32 MI) noexcept
+
+			/*
+				Montgomery arithmetic on 64-bit limbs
+					M: an odd modulus of `n` limbs
+					R = 2^(64*n)
+				The context keeps R^2 mod M and can be reused for the exponentiations with the same modulus.
+			*/
+			class MontgomeryContext
 			{
-				sl_size nM = M.length;
-				sl_size nB = Math::min(nM, B.length);
-				
-				sl_size nOut = nM * 2 + 1;
-				SLIB_SCOPED_BUFFER(sl_uint32, STACK_BUFFER_SIZE, out, nOut);
-				if (!out) {
-					return sl_false;
-				}
-				Base::zeroMemory(out, nOut * 4);
-				for (sl_size i = 0; i < nM; i++) {
-					// T = (T + cB*B + cM*M) / 2^(32*nM)
-					sl_uint32 cB = i < A.length ? A.elements[i] : 0;
-					sl_uint32 cM = (out[0] + cB * B.elements[0]) * MI;
-					priv::bigint::muladd_uint32(out, out, nOut, B.elements, nB, cB, 0);
-					priv::bigint::muladd_uint32(out, out, nOut, M.elements, nM, cM, 0);
-					*out = cB;
-					nOut--;
-					out++;
-				}
-				if (!A.setValueFromElements(out, nM + 1)) {
-					return sl_false;
+			public:
+				sl_size n;
+				// -(M^-1) mod 2^64
+				sl_uint64 MI;
+				const sl_uint64* M;
+				// R^2 mod M
+				const sl_uint64* R2;
+				CBigInt modulus;
+
+			private:
+				Memory m_memory;
+
+			public:
+				MontgomeryContext() noexcept: n(0), MI(0), M(sl_null), R2(sl_null)
+				{
 				}
-				if (A.compareAbs(M) >= 0) {
-					if (!A.subAbs(A, M)) {
+
+			public:
+				sl_bool setModulus(const CBigInt& _M) noexcept
+				{
+					n = 0;
+					sl_size nElements = _M.getMostSignificantElements();
+					if (!nElements || _M.sign < 0 || !(_M.elements[0] & 1)) {
 						return sl_false;
 					}
-				}
-				return sl_true;
-			}
-			
-			// Montgomery reduction: A = A * R^-1 mod M
-			SLIB_INLINE static sl_bool mont_reduction(CBigInt& A, const CBigInt& M, sl_uint32 MI) noexcept
-			{
-				CBIGINT_UINT32(o, 1);
-				return priv::bigint::mont_mul(A, o, M, MI);
-			}
-			
-			struct PowMontgomeryContext
-			{
-				CBigInt M;
-				CBigInt R2;
-				CBigInt T;
-			};
-			
-			static sl_bool pow_montgomery(priv::bigint::PowMontgomeryContext& context, CBigInt& ret, const CBigInt& A, const CBigInt& inE, const CBigInt& inM) noexcept
-			{
-				CBigInt& M = context.M;
-				CBigInt& R2 = context.R2;
-				CBigInt& T = context.T;
-				
-				M.copyFrom(inM);
-				if (!M.compact()) {
-					return sl_false;
-				}
-				sl_size nM = M.getMostSignificantElements();
-				if (nM == 0) {
-					return sl_false;
-				}
-				if (M.sign < 0) {
-					return sl_false;
-				}
-				const CBigInt* pE;
-				CBigInt _t_E;
-				if (&inE == &ret) {
-					pE = &_t_E;
-					if (!_t_E.copyFrom(inE)) {
+					if (!(modulus.copyFrom(_M))) {
 						return sl_false;
 					}
-				} else {
-					pE = &inE;
-				}
-				const CBigInt& E = *pE;
-				sl_size nE = E.getMostSignificantElements();
-				if (nE == 0) {
-					if (!(ret.setValue((sl_uint32)1))) {
+					sl_size nLimbs = get_limbs_count(nElements);
+					m_memory = Memory::create(nLimbs << 4);
+					if (m_memory.isNull()) {
 						return sl_false;
 					}
-					ret.sign = 1;
+					sl_uint64* limbs = (sl_uint64*)(m_memory.getData());
+					limbs_from_elements(limbs, nLimbs, _M.elements, nElements);
+					n = nLimbs;
+					M = limbs;
+
+					// Newton's iteration: x = x * (2 - M0 * x), doubling the correct bits from 3 bits
+					sl_uint64 M0 = limbs[0];
+					sl_uint64 x = M0;
+					for (sl_uint32 i = 0; i < 5; i++) {
+						x *= 2 - M0 * x;
+					}
+					MI = 0 - x;
+
+					SLIB_SCOPED_BUFFER(sl_uint64, STACK_BUFFER_SIZE, t, getScratchSize());
+					if (!t) {
+						n = 0;
+						return sl_false;
+					}
+					// 64*n = s * 2^k
+					sl_size s = n;
+					sl_uint32 k = 6;
+					while (!(s & 1)) {
+						s >>= 1;
+						k++;
+					}
+					// X = 2^(64*n+s) mod M = 2^s * R mod M, by doubling from the highest power of 2 below M
+					sl_uint64* X = limbs + n;
+					Base::zeroMemory(X, n << 3);
+					sl_size nBits = (n - 1) << 6;
+					for (sl_uint64 v = M[n - 1]; v; v >>= 1) {
+						nBits++;
+					}
+					X[(nBits - 1) >> 6] = ((sl_uint64)1) << ((nBits - 1) & 63);
+					sl_size nTotal = (n << 6) + s;
+					for (sl_size i = nBits - 1; i < nTotal; i++) {
+						sl_uint64 top = X[n - 1] >> 63;
+						for (sl_size j = n - 1; j > 0; j--) {
+							X[j] = (X[j] << 1) | (X[j - 1] >> 63);
+						}
+						X[0] <<= 1;
+						if (top || compare_limbs(X, M, n) >= 0) {
+							sub_limbs(X, X, M, n, 0);
+						}
+					}
+					// squaring in Montgomery form: 2^s*R => 2^(2s)*R => ... => 2^(s*2^k)*R = R^2 mod M
+					for (sl_uint32 i = 0; i < k; i++) {
+						sqr(X, X, t);
+					}
+					R2 = X;
 					return sl_true;
 				}
-				if (E.sign < 0) {
-					return sl_false;
-				}
-				sl_size nA = A.getMostSignificantElements();
-				if (nA == 0) {
-					ret.setZero();
-					return sl_true;
+
+				SLIB_INLINE sl_size getScratchSize() const noexcept
+				{
+					return (n << 1) + get_mul_scratch_size(n, n);
 				}
-				
-				// MI = -(M0^-1) mod (2^32)
-				sl_uint32 MI;
-				// initialize montgomery
+
+				// out = T * R^-1 mod M, T (2n limbs, T < M * R) is destroyed
+				void reduce(sl_uint64* out, sl_uint64* T) const noexcept
 				{
-					sl_uint32 M0 = M.elements[0];
-					sl_uint32 K = M0;
-					K += ((M0 + 2) & 4) << 1;
-					for (sl_uint32 i = 32; i >= 8; i /= 2) {
-						K *= (2 - (M0 * K));
+					sl_uint64 carry = 0;
+					for (sl_size i = 0; i < n; i++) {
+						sl_uint64 c = muladd_limb(T + i, M, n, T[i] * MI);
+						sl_uint64 s = T[i + n] + c;
+						sl_uint64 o = s < c;
+						s += carry;
+						o += s < carry;
+						T[i + n] = s;
+						carry = o;
+					}
+					if (carry || compare_limbs(T + n, M, n) >= 0) {
+						sub_limbs(out, T + n, M, n, 0);
+					} else {
+						Base::copyMemory(out, T + n, n << 3);
 					}
-					MI = 0 - K;
 				}
-				
-				// pre-compute R^2 mod M
-				// R = 2^(nM*32)
+
+				// out = a * b * R^-1 mod M, `t` is scratch memory of getScratchSize() limbs
+				SLIB_INLINE void mul(sl_uint64* out, const sl_uint64* a, const sl_uint64* b, sl_uint64* t) const noexcept
 				{
-					if (!R2.setValue((sl_uint32)1)) {
+					mul_limbs(t, a, n, b, n, t + (n << 1));
+					reduce(out, t);
+				}
+
+				// out = a * a * R^-1 mod M, `t` is scratch memory of getScratchSize() limbs
+				SLIB_INLINE void sqr(sl_uint64* out, const sl_uint64* a, sl_uint64* t) const noexcept
+				{
+					sqr_limbs(t, a, n, t + (n << 1));
+					reduce(out, t);
+				}
+
+				// ret = A^E mod M, sliding window exponentiation
+				sl_bool pow(CBigInt& ret, const CBigInt& A, const CBigInt& E) const noexcept
+				{
+					if (!n) {
 						return sl_false;
 					}
-					if (!R2.shiftLeft(nM * 64)) {
+					if (E.sign < 0) {
 						return sl_false;
 					}
-					if (!CBigInt::divAbs(R2, M, sl_null, &R2)) {
+					sl_size nbE = E.getMostSignificantBits();
+					if (nbE == 0) {
+						if (!(ret.setValue((sl_uint32)1))) {
+							return sl_false;
+						}
+						ret.sign = 1;
+						return sl_true;
+					}
+					sl_size nA = A.getMostSignificantElements();
+					if (nA == 0) {
+						ret.setZero();
+						return sl_true;
+					}
+					sl_bool flagNegative = A.sign < 0 && E.getBit(0);
+
+					// window size referenced from OpenSSL (BN_window_bits_for_exponent_size)
+					sl_uint32 w = nbE > 671 ? 6 : nbE > 239 ? 5 : nbE > 79 ? 4 : nbE > 23 ? 3 : 1;
+					sl_size nTable = ((sl_size)1) << (w - 1);
+					sl_size lA = get_limbs_count(nA);
+					sl_size nT = Math::max(lA, n << 1);
+					SLIB_SCOPED_BUFFER(sl_uint64, STACK_BUFFER_SIZE, buf, (nTable + 1) * n + nT + getScratchSize());
+					if (!buf) {
 						return sl_false;
 					}
-				}
-				
-				sl_bool flagNegative = A.sign < 0;
-				// T = A * R^2 * R^-1 mod M = A * R mod M
-				if (!CBigInt::divAbs(A, M, sl_null, &T)) {
-					return sl_false;
-				}
-				if (!priv::bigint::mont_mul(T, R2, M, MI)) {
-					return sl_false;
-				}
-				
-				// C = R^2 * R^-1 mod M = R mod M
-				if (!(ret.copyFrom(R2))) {
-					return sl_false;
-				}
-				if (!priv::bigint::mont_reduction(ret, M, MI)) {
-					return sl_false;
-				}
-				
-				sl_size nbE = E.getMostSignificantBits();
-				for (sl_size ib = 0; ib < nbE; ib++) {
-					sl_size ke = ib >> 5;
-					sl_uint32 kb = (sl_uint32)(ib & 31);
-					if (((E.elements[ke]) >> kb) & 1) {
-						// C = C * T * R^-1 mod M
-						if (!priv::bigint::mont_mul(ret, T, M, MI)) {
-							return sl_false;
+					sl_uint64* table = buf;
+					sl_uint64* C = table + nTable * n;
+					sl_uint64* T = C + n;
+					sl_uint64* scratch = T + nT;
+
+					// table[0] = A * R mod M
+					if (lA <= n) {
+						limbs_from_elements(T, n, A.elements, nA);
+						mul(table, T, R2, scratch);
+					} else {
+						limbs_from_elements(T, lA, A.elements, nA);
+						if (lA <= (n << 1) && compare_limbs(T + n, M, n) < 0) {
+							// A * R^-1 => A => A * R
+							for (sl_size i = lA; i < (n << 1); i++) {
+								T[i] = 0;
+							}
+							reduce(table, T);
+							mul(table, table, R2, scratch);
+							mul(table, table, R2, scratch);
+						} else {
+							CBigInt R;
+							if (!(CBigInt::divAbs(A, modulus, sl_null, &R))) {
+								return sl_false;
+							}
+							limbs_from_elements(T, n, R.elements, R.getMostSignificantElements());
+							mul(table, T, R2, scratch);
+						}
+					}
+					// table[i] = A^(2i+1) * R mod M
+					if (nTable > 1) {
+						sqr(C, table, scratch);
+						for (sl_size i = 1; i < nTable; i++) {
+							mul(table + i * n, table + (i - 1) * n, C, scratch);
 						}
 					}
-					// T = T * T * R^-1 mod M
-					if (!priv::bigint::mont_mul(T, T, M, MI)) {
+
+					sl_bool flagFirst = sl_true;
+					sl_size iBit = nbE;
+					while (iBit > 0) {
+						if (!(E.getBit(iBit - 1))) {
+							sqr(C, C, scratch);
+							iBit--;
+							continue;
+						}
+						// window: bits [j, iBit), ending with 1
+						sl_size j = iBit > w ? iBit - w : 0;
+						while (!(E.getBit(j))) {
+							j++;
+						}
+						sl_size value = 0;
+						for (sl_size k = iBit; k > j; k--) {
+							value = (value << 1) | (E.getBit(k - 1) ? 1 : 0);
+						}
+						if (flagFirst) {
+							Base::copyMemory(C, table + (value >> 1) * n, n << 3);
+							flagFirst = sl_false;
+						} else {
+							for (sl_size k = j; k < iBit; k++) {
+								sqr(C, C, scratch);
+							}
+							mul(C, C, table + (value >> 1) * n, scratch);
+						}
+						iBit = j;
+					}
+
+					// C = C * R^-1 mod M
+					Base::copyMemory(T, C, n << 3);
+					Base::zeroMemory(T + n, n << 3);
+					reduce(C, T);
+					if (flagNegative && mse_limbs(C, n)) {
+						sub_limbs(C, M, C, n, 0);
+					}
+					SLIB_SCOPED_BUFFER(sl_uint32, STACK_BUFFER_SIZE, elements, n << 1);
+					if (!elements) {
 						return sl_false;
 					}
-				}
-				if (!priv::bigint::mont_reduction(ret, M, MI)) {
-					return sl_false;
-				}
-				if (flagNegative && (E.elements[0] & 1) != 0) {
-					ret.sign = -1;
-					if (!(ret.add(M))) {
+					limbs_to_elements(elements, C, n);
+					if (!(ret.setValueFromElements(elements, n << 1))) {
 						return sl_false;
 					}
-				} else {
 					ret.sign = 1;
+					return sl_true;
 				}
-				return sl_true;
-			}
-			
+
+			};
+
 		}
 	}
-	
-	sl_bool CBigInt::pow_montgomery(const CBigInt& A, const CBigInt& inE, const CBigInt& inM) noexcept
+
+	sl_bool CBigInt::pow_montgomery(const CBigInt& A, const CBigInt& E, const CBigInt& M) noexcept
 	{
-		priv::bigint::PowMontgomeryContext context;
-		return priv::bigint::pow_montgomery(context, *this, A, inE, inM);
+		priv::bigint::MontgomeryContext context;
+		if (!(context.setModulus(M))) {
+			return sl_false;
+		}
+		return context.pow(*this, A, E);
 	}
-	
+
 	sl_bool CBigInt::pow_montgomery(const CBigInt& E, const CBigInt& M) noexcept
 	{
 		return pow_montgomery(*this, E, M);
@@ -2729,7 +3163,7 @@ namespace slib
 				CBigInt x;
 				CBigInt y;
 				
-				priv::bigint::PowMontgomeryContext contextPowMontgomery;
+				priv::bigint::MontgomeryContext montgomery;
 			};
 			
 			static sl_bool isProbablePrime(priv::bigint::ProbablePrimeCheckContext& context, const CBigInt& n, sl_uint32 nChecks, sl_bool* pFlagError) noexcept
@@ -2761,6 +3195,10 @@ namespace slib
 				sl_size nBits = n.getMostSignificantBits();
 				n3.sub(n, 3); // n-3
 				
+				if (!(context.montgomery.setModulus(n))) {
+					RETURN_ERROR;
+				}
+				
 				for (sl_uint32 i = 0; i < nChecks; i++) {
 					// find random a in range [2, n-2]   =>   (random % (n-3)) + 2
 					if (!(a.random(nBits))) {
@@ -2774,7 +3212,7 @@ namespace slib
 					if (!(a.add(2))) {
 						RETURN_ERROR;
 					}
-					if (!(priv::bigint::pow_montgomery(context.contextPowMontgomery, x, a, d, n))) {
+					if (!(context.montgomery.pow(x, a, d))) {
 						RETURN_ERROR;
 					}
 					if (!(x.equals((sl_uint32)1)) && !(x.equals(n1))) { // x = 1 or x = n − 1 => probably prime
@@ -216,6 +216,7 @@ namespace slib
 	DEFINE_HTTP_HEADER(Cookie, "Cookie")
 	DEFINE_HTTP_HEADER(Range, "Range")
 	DEFINE_HTTP_HEADER(IfModifiedSince, "If-Modified-Since")
+	DEFINE_HTTP_HEADER(IfNoneMatch, "If-None-Match")
 
 	DEFINE_HTTP_HEADER(TransferEncoding, "Transfer-Encoding")
 	DEFINE_HTTP_HEADER(AccessControlAllowOrigin, "Access-Control-Allow-Origin")
@@ -223,7 +224,9 @@ namespace slib
 	DEFINE_HTTP_HEADER(AcceptRanges, "Accept-Ranges")
 	DEFINE_HTTP_HEADER(ContentRange, "Content-Range")
 	DEFINE_HTTP_HEADER(LastModified, "Last-Modified")
+	DEFINE_HTTP_HEADER(ETag, "ETag")
 	DEFINE_HTTP_HEADER(Location, "Location")
+	DEFINE_HTTP_HEADER(Vary, "Vary")
 
 	sl_reg HttpHeaderHelper::parseHeaders(HttpHeaderMap& map, const void* _data, sl_size size)
 	{
@@ -929,6 +932,16 @@ namespace slib
 		setRequestHeader(HttpHeader::Range, String::format("bytes=-%d", length));
 	}
 
+	String HttpRequest::getRequestAcceptEncoding() const
+	{
+		return getRequestHeader(HttpHeader::AcceptEncoding);
+	}
+
+	void HttpRequest::setRequestAcceptEncoding(const String& encodings)
+	{
+		setRequestHeader(HttpHeader::AcceptEncoding, encodings);
+	}
+
 	String HttpRequest::getRequestOrigin() const
 	{
 		return getRequestHeader(HttpHeader::Origin);
@@ -957,6 +970,28 @@ namespace slib
 		}
 	}
 	
+	String HttpRequest::getRequestIfNoneMatch() const
+	{
+		String value = m_requestHeaders.getValue_NoLock(HttpHeader::IfNoneMatch, String::null());
+		if (value.contains('\"')) {
+			return value.replaceAll("\"", String::null());
+		}
+		return value;
+	}
+	
+	void HttpRequest::setRequestIfNoneMatch(const String& etag)
+	{
+		if (etag.isNotEmpty()) {
+			if (etag == "*") {
+				setRequestHeader(HttpHeader::IfNoneMatch, etag);
+			} else {
+				setRequestHeader(HttpHeader::IfNoneMatch, "\"" + etag + "\"");
+			}
+		} else {
+			removeRequestHeader(HttpHeader::IfNoneMatch);
+		}
+	}
+	
 	HttpCacheControlRequest HttpRequest::getRequestCacheControl() const
 	{
 		HttpCacheControlRequest cc;
@@ -1841,6 +1876,20 @@ namespace slib
 		}
 	}
 	
+	String HttpResponse::getResponseETag() const
+	{
+		return getResponseHeader(HttpHeader::ETag);
+	}
+	
+	void HttpResponse::setResponseETag(const String& etag)
+	{
+		if (etag.isNotEmpty()) {
+			setResponseHeader(HttpHeader::ETag, "\"" + etag + "\"");
+		} else {
+			removeResponseHeader(HttpHeader::ETag);
+		}
+	}
+	
 	HttpCacheControlResponse HttpResponse::getResponseCacheControl() const
 	{
 		HttpCacheControlResponse cc;
@@ -71,6 +71,16 @@ namespace slib
 		m_bufferOutput.copyFromFile(path, dispatcher);
 	}
 
+	void HttpOutputBuffer::sendFileRegion(const Ref<File>& file, sl_uint64 offset, sl_uint64 size)
+	{
+		m_bufferOutput.sendFileRegion(file, offset, size, Ref<Dispatcher>::null());
+	}
+
+	void HttpOutputBuffer::sendFileRegion(const Ref<File>& file, sl_uint64 offset, sl_uint64 size, const Ref<Dispatcher>& dispatcher)
+	{
+		m_bufferOutput.sendFileRegion(file, offset, size, dispatcher);
+	}
+
 	sl_uint64 HttpOutputBuffer::getOutputLength() const
 	{
 		return m_bufferOutput.getOutputLength();
@@ -507,4 +517,181 @@ namespace slib
 		}
 	}
 
+/***********************************************************************
+						HttpContentEncoder
+***********************************************************************/
+
+	SLIB_DEFINE_OBJECT(HttpContentEncoder, AsyncStreamFilter)
+
+	HttpContentEncoder::HttpContentEncoder()
+	{
+		m_flagChunked = sl_false;
+	}
+
+	HttpContentEncoder::~HttpContentEncoder()
+	{
+	}
+
+	Ref<HttpContentEncoder> HttpContentEncoder::create(const Ref<AsyncStream>& io, const String& encoding, sl_bool flagChunked, sl_int32 level)
+	{
+		if (io.isNull()) {
+			return sl_null;
+		}
+		if (level < 0) {
+			level = 6;
+		} else if (level > 9) {
+			level = 9;
+		}
+		Ref<HttpContentEncoder> ret = new HttpContentEncoder;
+		if (ret.isNotNull()) {
+			if (encoding.equalsIgnoreCase("gzip")) {
+				if (!(ret->m_zlib.startGzip(level))) {
+					return sl_null;
+				}
+			} else if (encoding.equalsIgnoreCase("deflate")) {
+				// `deflate` coding is the zlib format (RFC 1950)
+				if (!(ret->m_zlib.start(level))) {
+					return sl_null;
+				}
+			} else {
+				return sl_null;
+			}
+			ret->m_bufEncode = Memory::create(SLIB_ASYNC_STREAM_FILTER_DEFAULT_BUFFER_SIZE);
+			if (ret->m_bufEncode.isNull()) {
+				return sl_null;
+			}
+			ret->m_encoding = encoding;
+			ret->m_flagChunked = flagChunked;
+			ret->setSourceStream(io);
+			return ret;
+		}
+		return sl_null;
+	}
+
+	sl_uint32 HttpContentEncoder::getAcceptedQuality(const String& acceptEncoding, const String& encoding)
+	{
+		sl_uint32 qualityAny = 0;
+		ListElements<String> items(acceptEncoding.split(","));
+		for (sl_size i = 0; i < items.count; i++) {
+			String item = items[i];
+			sl_uint32 quality = 1000;
+			sl_reg index = item.indexOf(';');
+			if (index >= 0) {
+				String param = item.substring(index + 1).trim();
+				item = item.substring(0, index);
+				if (param.startsWith("q=") || param.startsWith("Q=")) {
+					double q = param.substring(2).trim().parseDouble(1.0);
+					if (q <= 0) {
+						quality = 0;
+					} else if (q < 1) {
+						quality = (sl_uint32)(q * 1000);
+						if (!quality) {
+							quality = 1;
+						}
+					}
+				}
+			}
+			item = item.trim();
+			if (item.equalsIgnoreCase(encoding)) {
+				return quality;
+			}
+			if (item == "*") {
+				qualityAny = quality;
+			}
+		}
+		return qualityAny;
+	}
+
+	String HttpContentEncoder::selectEncoding(const String& acceptEncoding)
+	{
+		if (acceptEncoding.isEmpty()) {
+			return sl_null;
+		}
+		SLIB_STATIC_STRING(gzip, "gzip")
+		SLIB_STATIC_STRING(deflate, "deflate")
+		sl_uint32 qGzip = getAcceptedQuality(acceptEncoding, gzip);
+		sl_uint32 qDeflate = getAcceptedQuality(acceptEncoding, deflate);
+		if (qGzip && qGzip >= qDeflate) {
+			return gzip;
+		}
+		if (qDeflate) {
+			return deflate;
+		}
+		return sl_null;
+	}
+
+	const String& HttpContentEncoder::getEncoding()
+	{
+		return m_encoding;
+	}
+
+	sl_bool HttpContentEncoder::finish(const Function<void(AsyncStreamResult&)>& callback)
+	{
+		MutexLocker lock(&m_lockWriting);
+		Ref<AsyncStream> stream = m_stream;
+		if (stream.isNull() || m_flagWritingError || m_flagWritingEnded) {
+			return sl_false;
+		}
+		Memory mem = encodeData(sl_null, 0, sl_true);
+		setWritingEnded();
+		if (mem.isNull()) {
+			setWritingError();
+			return sl_false;
+		}
+		return stream->writeFromMemory(mem, callback);
+	}
+
+	Memory HttpContentEncoder::filterWrite(const void* data, sl_uint32 size, Referable* userObject)
+	{
+		Memory mem = encodeData(data, size, sl_false);
+		if (mem.isNull()) {
+			setWritingError();
+		}
+		return mem;
+	}
+
+	Memory HttpContentEncoder::encodeData(const void* _data, sl_uint32 size, sl_bool flagFinish)
+	{
+		// every write is flushed (Z_SYNC_FLUSH), so the encoded output is never empty and the receiver can decode the data written so far
+		const sl_uint8* data = (const sl_uint8*)_data;
+		sl_uint8* bufEncode = (sl_uint8*)(m_bufEncode.getData());
+		sl_uint32 sizeBufEncode = (sl_uint32)(m_bufEncode.getSize());
+		MemoryBuffer output;
+		sl_size sizeOutput = 0;
+		for (;;) {
+			sl_uint32 sizeInputPassed = 0;
+			sl_uint32 sizeOutputUsed = 0;
+			sl_int32 iRet = m_zlib.compress(data, size, sizeInputPassed, bufEncode, sizeBufEncode, sizeOutputUsed, flagFinish, !flagFinish);
+			if (iRet < 0) {
+				return sl_null;
+			}
+			if (sizeOutputUsed) {
+				output.add(Memory::create(bufEncode, sizeOutputUsed));
+				sizeOutput += sizeOutputUsed;
+			}
+			data += sizeInputPassed;
+			size -= sizeInputPassed;
+			if (!iRet) {
+				break;
+			}
+			if (!size && sizeOutputUsed < sizeBufEncode) {
+				break;
+			}
+		}
+		if (m_flagChunked) {
+			MemoryBuffer chunk;
+			if (sizeOutput) {
+				chunk.add(String::fromUint64(sizeOutput, 16, 0, sl_true).toMemory());
+				chunk.addStatic("\r\n", 2);
+				chunk.link(output);
+				chunk.addStatic("\r\n", 2);
+			}
+			if (flagFinish) {
+				chunk.addStatic("0\r\n\r\n", 5);
+			}
+			return chunk.merge();
+		}
+		return output.merge();
+	}
+
 }
@@ -104,7 +104,14 @@ namespace slib
 				{
 					Ref<HttpServer> server = getServer();
 					if (server.isNotNull()) {
-						Ref<AsyncIoLoop> loop = m_loop;
+						// the handshakes and the connections are spread across the I/O loops of the server
+						Ref<AsyncIoLoop> loop;
+						Ref<AsyncIoLoopGroup> loops = server->getAsyncIoLoopGroup();
+						if (loops.isNotNull()) {
+							loop = loops->getNextLoop();
+						} else {
+							loop = m_loop;
+						}
 						if (loop.isNull()) {
 							return;
 						}
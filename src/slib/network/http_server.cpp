@@ -45,11 +45,19 @@ namespace slib
 	HttpServerContext::HttpServerContext()
 	{
 		m_requestContentLength = 0;
+		m_sizeRequestBodyReceived = 0;
+		m_flagRequestBodyChunked = sl_false;
+		m_stateRequestBodyChunk = 0;
+		m_sizeRequestBodyChunk = 0;
+		m_flagRequestBodyChunkSize = sl_false;
+		m_flagRequestBodyCompleted = sl_false;
+		m_flagRequestBodyPaused = sl_false;
 		
 		m_flagProcessed = sl_false;
 		m_flagClosingConnection = sl_false;
 		m_flagProcessingByThread = sl_true;
 		m_flagKeepAlive = sl_true;
+		m_flagCompressionEnabled = sl_true;
 		
 		m_flagBeganProcessing = sl_false;
 	}
@@ -196,11 +204,60 @@ namespace slib
 		m_flagKeepAlive = flag;
 	}
 
+	sl_bool HttpServerContext::isCompressionEnabled() const
+	{
+		return m_flagCompressionEnabled;
+	}
+
+	void HttpServerContext::setCompressionEnabled(sl_bool flag)
+	{
+		m_flagCompressionEnabled = flag;
+	}
+
+	sl_bool HttpServerContext::isStreamingRequestBody() const
+	{
+		return m_requestBodyHandler.isNotNull();
+	}
+
+	HttpServerRequestBodyHandler HttpServerContext::getRequestBodyHandler() const
+	{
+		return m_requestBodyHandler;
+	}
+
+	void HttpServerContext::setRequestBodyHandler(const HttpServerRequestBodyHandler& handler)
+	{
+		m_requestBodyHandler = handler;
+	}
+
+	void HttpServerContext::pauseRequestBody()
+	{
+		m_flagRequestBodyPaused = sl_true;
+	}
+
+	void HttpServerContext::resumeRequestBody()
+	{
+		if (!m_flagRequestBodyPaused) {
+			return;
+		}
+		m_flagRequestBodyPaused = sl_false;
+		Ref<HttpServerConnection> connection = m_connection;
+		if (connection.isNotNull()) {
+			// resumes on the I/O thread, not in the body handler
+			connection->getIO()->addTask(SLIB_FUNCTION_WEAKREF(HttpServerConnection, _resumeInput, connection));
+		}
+	}
+
+	sl_bool HttpServerContext::isRequestBodyPaused() const
+	{
+		return m_flagRequestBodyPaused;
+	}
+
 /******************************************************
 			HttpServerConnection
 ******************************************************/
 #define SIZE_READ_BUF 0x10000
 #define SIZE_COPY_BUF 0x10000
+#define SIZE_INITIAL_REQUEST_BODY 0x10000
 	
 	SLIB_DEFINE_OBJECT(HttpServerConnection, Object)
 
@@ -256,13 +313,20 @@ namespace slib
 		}
 		m_io->close();
 		m_output->close();
+		Ref<AsyncOutput> outputEncoding = m_outputEncoding;
+		if (outputEncoding.isNotNull()) {
+			outputEncoding->close();
+			m_outputEncoding.setNull();
+		}
+		m_contextEncoding.setNull();
+		m_encoder.setNull();
 		m_bufReadUnprocessed.setNull();
 	}
 
 	void HttpServerConnection::start()
 	{
 		m_contextCurrent.setNull();
-		if (m_bufReadUnprocessed.isNotEmpty()) {
+		if (m_bufReadUnprocessed.isNotNull()) {
 			_processInput(sl_null, 0);
 		} else {
 			_read();
@@ -300,7 +364,7 @@ namespace slib
 		}
 	}
 
-	void HttpServerConnection::_processInput(const void* _data, sl_uint32 size)
+	void HttpServerConnection::_processInput(const void* _data, sl_uint32 _size)
 	{
 		Ref<HttpServer> server = m_server;
 		if (server.isNull()) {
@@ -313,16 +377,25 @@ namespace slib
 			return;
 		}
 		
-		char* data = (char*)_data;
-		if (m_bufReadUnprocessed.isNotEmpty()) {
+		const char* data = (const char*)_data;
+		sl_size size = _size;
+		Memory memUnprocessed = m_bufReadUnprocessed;
+		if (memUnprocessed.isNotNull()) {
+			m_bufReadUnprocessed.setNull();
 			if (size) {
-				if (!(m_bufReadUnprocessed.addElements_NoLock((char*)data, size))) {
+				MemoryBuffer buf;
+				if (!(buf.add(memUnprocessed)) || !(buf.addStatic(data, size))) {
+					close();
+					return;
+				}
+				memUnprocessed = buf.merge();
+				if (memUnprocessed.isNull()) {
 					close();
 					return;
 				}
 			}
-			data = m_bufReadUnprocessed.getData();
-			size = (sl_uint32)(m_bufReadUnprocessed.getCount());
+			data = (const char*)(memUnprocessed.getData());
+			size = memUnprocessed.getSize();
 		}
 		
 		if (!size) {
@@ -345,6 +418,10 @@ namespace slib
 			_context->setProcessingByThread(param.flagProcessByThreads);
 		}
 		HttpServerContext* context = _context.get();
+		if (context->m_flagBeganProcessing) {
+			m_bufReadUnprocessed = Memory::create(data, size);
+			return;
+		}
 		if (context->m_requestHeader.isNull()) {
 			sl_size posBody;
 			if (context->m_requestHeaderReader.add(data, size, posBody)) {
@@ -364,115 +441,282 @@ namespace slib
 					sendResponseAndClose_BadRequest();
 					return;
 				}
-				context->m_requestContentLength = context->getRequestContentLengthHeader();
-				if (context->m_requestContentLength > maxRequestBodySize) {
-					sendResponseAndClose_BadRequest();
-					return;
-				}
 				context->setKeepAlive(context->isRequestKeepAlive());
-				if (size > posBody) {
-					sl_size sizeRemain = (sl_size)size - posBody;
-					sl_size sizeRequired = (sl_size)(context->m_requestContentLength);
-					if (sizeRequired) {
-						if (sizeRequired < sizeRemain) {
-							context->m_requestBody = Memory::create(data + posBody, sizeRequired);
-							m_bufReadUnprocessed = List<char>::create(data + posBody + sizeRequired, sizeRemain - sizeRequired);
-						} else {
-							context->m_requestBody = Memory::create(data + posBody, sizeRemain);
-							m_bufReadUnprocessed.setNull();
-						}
-						if (!(context->m_requestBodyBuffer.add(context->m_requestBody))) {
-							sendResponseAndClose_ServerError();
-							return;
-						}
-					} else {
-						m_bufReadUnprocessed = List<char>::create(data + posBody, sizeRemain);
-					}
-				} else {
-					m_bufReadUnprocessed.setNull();
-				}
+				data += posBody;
+				size -= posBody;
 				context->applyQueryToParameters();
 				if (server->preprocessRequest(context)) {
+					if (size) {
+						m_bufReadUnprocessed = Memory::create(data, size);
+					}
+					return;
+				}
+				if (context->m_requestBodyHandler.isNull()) {
+					context->m_requestBodyHandler = server->getRequestBodyHandler(context);
+				}
+				if (!(_beginRequestBody(context, maxRequestBodySize))) {
 					return;
 				}
 			} else {
-				m_bufReadUnprocessed.setNull();
 				if (context->m_requestHeaderReader.getHeaderSize() > maxRequestHeadersSize) {
 					sendResponseAndClose_BadRequest();
 					return;
 				}
+				_read();
+				return;
 			}
-		} else {
-			sl_size sizeBody = (sl_size)(context->m_requestContentLength);
-			sl_size sizeCurrent = context->m_requestBodyBuffer.getSize();
-			if (sizeCurrent < sizeBody) {
-				sl_size sizeRemain = sizeBody - sizeCurrent;
-				if (sizeRemain < size) {
-					if (!(context->m_requestBodyBuffer.add(Memory::create(data, sizeRemain)))) {
-						sendResponseAndClose_ServerError();
-						return;
-					}
-					m_bufReadUnprocessed = List<char>::create(data + sizeRemain, size - sizeRemain);
-				} else {
-					if (!(context->m_requestBodyBuffer.add(Memory::create(data, size)))) {
-						sendResponseAndClose_ServerError();
-						return;
-					}
-					m_bufReadUnprocessed.setNull();
-				}
+		}
+		
+		if (!(context->m_flagRequestBodyCompleted)) {
+			sl_reg n = _processRequestBody(context, data, size, maxRequestBodySize);
+			if (n < 0) {
+				return;
 			}
+			data += n;
+			size -= n;
+			if (m_flagClosed) {
+				return;
+			}
+		}
+		if (size) {
+			m_bufReadUnprocessed = Memory::create(data, size);
+		}
+		if (!(context->m_flagRequestBodyCompleted)) {
+			if (!(context->m_flagRequestBodyPaused)) {
+				_read();
+			}
+			return;
 		}
 		
-		if (!(context->m_flagBeganProcessing)) {
+		context->m_flagBeganProcessing = sl_true;
+		
+		if (context->m_requestBodyHandler.isNull()) {
+			if (context->m_flagRequestBodyChunked) {
+				context->m_requestBody = context->m_requestBodyBuffer.merge();
+				context->m_requestContentLength = context->m_sizeRequestBodyReceived;
+			}
+			context->m_requestBodyBuffer.clear();
 			
-			if (context->m_requestHeader.isNotNull()) {
-				
-				sl_size sizeBody = (sl_size)(context->m_requestContentLength);
-				sl_size sizeCurrent = context->m_requestBodyBuffer.getSize();
+			String multipartBoundary = context->getRequestMultipartFormDataBoundary();
+			if (multipartBoundary.isNotEmpty()) {
+				Memory body = context->getRequestBody();
+				context->applyMultipartFormData(multipartBoundary, body);
+			} else if (context->getMethod() == HttpMethod::POST) {
+				String reqContentType = context->getRequestContentTypeNoParams();
+				if (reqContentType == ContentType::WebForm) {
+					Memory body = context->getRequestBody();
+					context->applyFormUrlEncoded(body.getData(), body.getSize());
+				}
+			}
+		}
+		
+		if (context->isProcessingByThread()) {
+			Ref<ThreadPool> threadPool = server->getThreadPool();
+			if (threadPool.isNotNull()) {
+				threadPool->addTask(SLIB_BIND_WEAKREF(void(), HttpServerConnection, _processContext, this, _context));
+			} else {
+				sendResponseAndClose_ServerError();
+			}
+		} else {
+			_processContext(context);
+		}
+	}
 
-				if (sizeCurrent >= sizeBody) {
-					
-					context->m_flagBeganProcessing = sl_true;
-
-					if (sizeBody) {
-						if (context->m_requestBody.getSize() < sizeBody) {
-							context->m_requestBody = context->m_requestBodyBuffer.merge();
-							if (context->m_requestBody.isNull()) {
-								sendResponseAndClose_ServerError();
-								return;
+	sl_bool HttpServerConnection::_beginRequestBody(HttpServerContext* context, sl_uint64 maxRequestBodySize)
+	{
+		context->m_sizeRequestBodyReceived = 0;
+		if (context->isChunkedRequest()) {
+			context->m_flagRequestBodyChunked = sl_true;
+			context->m_requestContentLength = 0;
+			return sl_true;
+		}
+		sl_uint64 contentLength = context->getRequestContentLengthHeader();
+		context->m_requestContentLength = contentLength;
+		if (!contentLength) {
+			context->m_flagRequestBodyCompleted = sl_true;
+			return sl_true;
+		}
+		if (context->m_requestBodyHandler.isNotNull()) {
+			return sl_true;
+		}
+		if (contentLength > maxRequestBodySize || contentLength > SLIB_SIZE_MAX) {
+			sendResponseAndClose_BadRequest();
+			return sl_false;
+		}
+		// the body is received into a single block which grows as the data arrives, so the declared length is not trusted for the allocation
+		sl_size sizeInitial = (sl_size)contentLength;
+		if (sizeInitial > SIZE_INITIAL_REQUEST_BODY) {
+			sizeInitial = SIZE_INITIAL_REQUEST_BODY;
+		}
+		Memory body = Memory::create(sizeInitial);
+		if (body.isNull()) {
+			sendResponseAndClose_ServerError();
+			return sl_false;
+		}
+		context->m_requestBody = body;
+		return sl_true;
+	}
+
+	/*
+		Chunked Transfer Coding (RFC 7230 4.1)
+
+		chunked-body   = *chunk last-chunk trailer-part CRLF
+		chunk          = chunk-size [ chunk-ext ] CRLF chunk-data CRLF
+		last-chunk     = 1*("0") [ chunk-ext ] CRLF
+	*/
+#define CHUNK_STATE_SIZE 0
+#define CHUNK_STATE_EXTENSION 1
+#define CHUNK_STATE_DATA 2
+#define CHUNK_STATE_DATA_END 3
+#define CHUNK_STATE_TRAILER_BEGIN 4
+#define CHUNK_STATE_TRAILER 5
+
+	sl_reg HttpServerConnection::_processRequestBody(HttpServerContext* context, const char* data, sl_size size, sl_uint64 maxRequestBodySize)
+	{
+		if (!(context->m_flagRequestBodyChunked)) {
+			sl_uint64 sizeRemain = context->m_requestContentLength - context->m_sizeRequestBodyReceived;
+			if (size > sizeRemain) {
+				size = (sl_size)sizeRemain;
+			}
+			if (!(_receiveRequestBody(context, data, size, maxRequestBodySize))) {
+				return -1;
+			}
+			if (context->m_sizeRequestBodyReceived >= context->m_requestContentLength) {
+				context->m_flagRequestBodyCompleted = sl_true;
+			}
+			return size;
+		}
+		sl_size pos = 0;
+		while (pos < size && !(context->m_flagRequestBodyPaused)) {
+			char ch = data[pos];
+			switch (context->m_stateRequestBodyChunk) {
+				case CHUNK_STATE_SIZE:
+				case CHUNK_STATE_EXTENSION:
+					if (ch == '\n') {
+						// chunk-size = 1*HEXDIG
+						if (!(context->m_flagRequestBodyChunkSize)) {
+							sendResponseAndClose_BadRequest();
+							return -1;
+						}
+						if (context->m_sizeRequestBodyChunk) {
+							context->m_stateRequestBodyChunk = CHUNK_STATE_DATA;
+						} else {
+							context->m_stateRequestBodyChunk = CHUNK_STATE_TRAILER_BEGIN;
+						}
+					} else if (context->m_stateRequestBodyChunk == CHUNK_STATE_SIZE) {
+						sl_uint32 v = SLIB_CHAR_HEX_TO_INT(ch);
+						if (v < 16) {
+							if (context->m_sizeRequestBodyChunk >> 59) {
+								sendResponseAndClose_BadRequest();
+								return -1;
 							}
+							context->m_sizeRequestBodyChunk = (context->m_sizeRequestBodyChunk << 4) | v;
+							context->m_flagRequestBodyChunkSize = sl_true;
+						} else if (ch == ';' || ch == ' ' || ch == '\t' || ch == '\r') {
+							context->m_stateRequestBodyChunk = CHUNK_STATE_EXTENSION;
+						} else {
+							sendResponseAndClose_BadRequest();
+							return -1;
 						}
 					}
-					context->m_requestBodyBuffer.clear();
-
-					String multipartBoundary = context->getRequestMultipartFormDataBoundary();
-					if (multipartBoundary.isNotEmpty()) {
-						Memory body = context->getRequestBody();
-						context->applyMultipartFormData(multipartBoundary, body);
-					} else if (context->getMethod() == HttpMethod::POST) {
-						String reqContentType = context->getRequestContentTypeNoParams();
-						if (reqContentType == ContentType::WebForm) {
-							Memory body = context->getRequestBody();
-							context->applyFormUrlEncoded(body.getData(), body.getSize());
+					pos++;
+					break;
+				case CHUNK_STATE_DATA:
+					{
+						sl_uint64 n = context->m_sizeRequestBodyChunk;
+						if (n > size - pos) {
+							n = size - pos;
 						}
-					}
-					
-					if (context->isProcessingByThread()) {
-						Ref<ThreadPool> threadPool = server->getThreadPool();
-						if (threadPool.isNotNull()) {
-							threadPool->addTask(SLIB_BIND_WEAKREF(void(), HttpServerConnection, _processContext, this, _context));
-						} else {
-							sendResponseAndClose_ServerError();
+						if (!(_receiveRequestBody(context, data + pos, (sl_size)n, maxRequestBodySize))) {
+							return -1;
+						}
+						pos += (sl_size)n;
+						context->m_sizeRequestBodyChunk -= n;
+						if (!(context->m_sizeRequestBodyChunk)) {
+							context->m_stateRequestBodyChunk = CHUNK_STATE_DATA_END;
 						}
-					} else {
-						_processContext(context);
 					}
-					return;
+					break;
+				case CHUNK_STATE_DATA_END:
+					if (ch == '\n') {
+						context->m_stateRequestBodyChunk = CHUNK_STATE_SIZE;
+						context->m_flagRequestBodyChunkSize = sl_false;
+					} else if (ch != '\r') {
+						sendResponseAndClose_BadRequest();
+						return -1;
+					}
+					pos++;
+					break;
+				case CHUNK_STATE_TRAILER_BEGIN:
+					pos++;
+					if (ch == '\n') {
+						context->m_flagRequestBodyCompleted = sl_true;
+						return pos;
+					} else if (ch != '\r') {
+						context->m_stateRequestBodyChunk = CHUNK_STATE_TRAILER;
+					}
+					break;
+				case CHUNK_STATE_TRAILER:
+					pos++;
+					if (ch == '\n') {
+						context->m_stateRequestBodyChunk = CHUNK_STATE_TRAILER_BEGIN;
+					}
+					break;
+			}
+		}
+		return pos;
+	}
+
+	sl_bool HttpServerConnection::_receiveRequestBody(HttpServerContext* context, const char* data, sl_size size, sl_uint64 maxRequestBodySize)
+	{
+		if (!size) {
+			return sl_true;
+		}
+		HttpServerRequestBodyHandler handler = context->m_requestBodyHandler;
+		if (handler.isNotNull()) {
+			context->m_sizeRequestBodyReceived += size;
+			handler(context, data, size);
+			return sl_true;
+		}
+		if (context->m_flagRequestBodyChunked) {
+			if (context->m_sizeRequestBodyReceived + size > maxRequestBodySize) {
+				sendResponseAndClose_BadRequest();
+				return sl_false;
+			}
+			if (!(context->m_requestBodyBuffer.add(Memory::create(data, size)))) {
+				sendResponseAndClose_ServerError();
+				return sl_false;
+			}
+		} else {
+			Memory body = context->m_requestBody;
+			sl_size sizeReceived = (sl_size)(context->m_sizeRequestBodyReceived);
+			sl_size sizeRequired = sizeReceived + size;
+			if (sizeRequired > body.getSize()) {
+				sl_size sizeNew = body.getSize() << 1;
+				if (sizeNew > context->m_requestContentLength) {
+					sizeNew = (sl_size)(context->m_requestContentLength);
+				}
+				if (sizeNew < sizeRequired) {
+					sizeNew = sizeRequired;
 				}
+				Memory bodyNew = Memory::create(sizeNew);
+				if (bodyNew.isNull()) {
+					sendResponseAndClose_ServerError();
+					return sl_false;
+				}
+				Base::copyMemory(bodyNew.getData(), body.getData(), sizeReceived);
+				body = bodyNew;
+				context->m_requestBody = body;
 			}
-			
+			Base::copyMemory((char*)(body.getData()) + sizeReceived, data, size);
 		}
-		_read();
+		context->m_sizeRequestBodyReceived += size;
+		return sl_true;
+	}
+
+	void HttpServerConnection::_resumeInput()
+	{
+		_processInput(sl_null, 0);
 	}
 
 	void HttpServerConnection::_processContext(const Ref<HttpServerContext>& context)
@@ -495,6 +739,20 @@ namespace slib
 			close();
 			return;
 		}
+		if (context->m_encoderOutput.isNotNull()) {
+			// the body is encoded after the header (and the previous responses) is written. See `onAsyncOutputEnd`
+			ObjectLocker lockOutput(m_output.get());
+			if (!(m_output->write(header))) {
+				close();
+				return;
+			}
+			if (!(context->isKeepAlive())) {
+				m_flagKeepAlive = sl_false;
+			}
+			m_contextEncoding = context;
+			m_output->startWriting();
+			return;
+		}
 		if (!(m_output->write(header))) {
 			close();
 			return;
@@ -522,11 +780,67 @@ namespace slib
 
 	void HttpServerConnection::onAsyncOutputEnd(AsyncOutput* output, sl_bool flagError)
 	{
-		if (flagError || !m_flagKeepAlive) {
+		if (flagError) {
+			close();
+			return;
+		}
+		Ref<HttpServerContext> context = m_contextEncoding;
+		if (context.isNotNull()) {
+			m_contextEncoding.setNull();
+			_writeEncodedBody(context.get());
+			return;
+		}
+		if (!m_flagKeepAlive) {
 			close();
 		}
 	}
 
+	void HttpServerConnection::_writeEncodedBody(HttpServerContext* context)
+	{
+		Ref<HttpContentEncoder> encoder = context->m_encoderOutput;
+		context->m_encoderOutput.setNull();
+		if (encoder.isNull()) {
+			close();
+			return;
+		}
+		AsyncOutputParam op;
+		op.stream = encoder;
+		op.onEnd = SLIB_FUNCTION_WEAKREF(HttpServerConnection, onEncodingOutputEnd, this);
+		op.bufferSize = SIZE_COPY_BUF;
+		Ref<AsyncOutput> output = AsyncOutput::create(op);
+		if (output.isNull()) {
+			close();
+			return;
+		}
+		m_encoder = encoder;
+		m_outputEncoding = output;
+		output->mergeBuffer(&(context->m_bufferOutput));
+		output->startWriting();
+	}
+
+	void HttpServerConnection::onEncodingOutputEnd(AsyncOutput* output, sl_bool flagError)
+	{
+		Ref<HttpContentEncoder> encoder = m_encoder;
+		if (flagError || encoder.isNull()) {
+			close();
+			return;
+		}
+		if (!(encoder->finish(SLIB_FUNCTION_WEAKREF(HttpServerConnection, onEncodingFinish, this)))) {
+			close();
+		}
+	}
+
+	void HttpServerConnection::onEncodingFinish(AsyncStreamResult& result)
+	{
+		m_outputEncoding.setNull();
+		m_encoder.setNull();
+		if (result.flagError || !m_flagKeepAlive) {
+			close();
+			return;
+		}
+		start();
+	}
+
 	void HttpServerConnection::sendResponseAndRestart(const Memory& mem)
 	{
 		if (mem.isNotNull()) {
@@ -637,12 +951,14 @@ namespace slib
 			class DefaultConnectionProvider : public HttpServerConnectionProvider
 			{
 			public:
-				Ref<AsyncTcpServer> m_server;
-				Ref<AsyncIoLoop> m_loop;
+				List< Ref<AsyncTcpServer> > m_servers;
+				Ref<AsyncIoLoopGroup> m_loops;
+				sl_bool m_flagSharded;
 
 			public:
 				DefaultConnectionProvider()
 				{
+					m_flagSharded = sl_false;
 				}
 
 				~DefaultConnectionProvider()
@@ -653,21 +969,34 @@ namespace slib
 			public:
 				static Ref<HttpServerConnectionProvider> create(HttpServer* server, const SocketAddress& addressListen)
 				{
-					Ref<AsyncIoLoop> loop = server->getAsyncIoLoop();
-					if (loop.isNotNull()) {
+					Ref<AsyncIoLoopGroup> loops = server->getAsyncIoLoopGroup();
+					if (loops.isNotNull()) {
 						Ref<DefaultConnectionProvider> ret = new DefaultConnectionProvider;
 						if (ret.isNotNull()) {
-							ret->m_loop = loop;
+							ret->m_loops = loops;
 							ret->setServer(server);
-							AsyncTcpServerParam sp;
-							sp.bindAddress = addressListen;
-							sp.onAccept = SLIB_FUNCTION_WEAKREF(DefaultConnectionProvider, onAccept, ret);
-							sp.ioLoop = loop;
-							Ref<AsyncTcpServer> server = AsyncTcpServer::create(sp);
-							if (server.isNotNull()) {
-								ret->m_server = server;
-								return ret;
+							sl_uint32 nLoops = loops->getLoopsCount();
+#if defined(SLIB_PLATFORM_IS_LINUX) && defined(SLIB_PLATFORM_IS_DESKTOP)
+							// the kernel distributes the connections across the SO_REUSEPORT listeners, one per loop
+							if (nLoops > 1) {
+								ret->m_flagSharded = sl_true;
 							}
+#endif
+							sl_uint32 nServers = ret->m_flagSharded ? nLoops : 1;
+							for (sl_uint32 i = 0; i < nServers; i++) {
+								AsyncTcpServerParam sp;
+								sp.bindAddress = addressListen;
+								sp.flagReusePort = ret->m_flagSharded;
+								sp.onAccept = SLIB_FUNCTION_WEAKREF(DefaultConnectionProvider, onAccept, ret);
+								sp.ioLoop = loops->getLoop(i);
+								Ref<AsyncTcpServer> server = AsyncTcpServer::create(sp);
+								if (server.isNull()) {
+									ret->release();
+									return sl_null;
+								}
+								ret->m_servers.add_NoLock(server);
+							}
+							return ret;
 						}
 					}
 					return sl_null;
@@ -676,8 +1005,9 @@ namespace slib
 				void release() override
 				{
 					ObjectLocker lock(this);
-					if (m_server.isNotNull()) {
-						m_server->close();
+					ListElements< Ref<AsyncTcpServer> > servers(m_servers);
+					for (sl_size i = 0; i < servers.count; i++) {
+						servers[i]->close();
 					}
 				}
 
@@ -685,7 +1015,12 @@ namespace slib
 				{
 					Ref<HttpServer> server = getServer();
 					if (server.isNotNull()) {
-						Ref<AsyncIoLoop> loop = m_loop;
+						Ref<AsyncIoLoop> loop;
+						if (m_flagSharded) {
+							loop = socketListen->getIoLoop();
+						} else {
+							loop = m_loops->getNextLoop();
+						}
 						if (loop.isNull()) {
 							return;
 						}
@@ -863,6 +1198,16 @@ namespace slib
 		route->onRequest = onRequest;
 	}
 	
+	HttpServerRequestBodyHandler HttpServerRoute::getRequestBodyHandler(const String& path)
+	{
+		HashMap<String, String> params;
+		HttpServerRoute* route = getRoute(path, params);
+		if (route) {
+			return route->onRequestBodyData;
+		}
+		return sl_null;
+	}
+
 	Variant HttpServerRoute::processRequest(const String& path, HttpServerContext* context)
 	{
 		HashMap<String, String> params;
@@ -908,6 +1253,25 @@ namespace slib
 		return sl_false;
 	}
 	
+	HttpServerRequestBodyHandler HttpServerRouter::getRequestBodyHandler(const String& path, HttpServerContext* context)
+	{
+		if (routes.isNull()) {
+			return sl_null;
+		}
+		HttpServerRoute* route = routes.getItemPointer(context->getMethod());
+		if (route) {
+			HttpServerRequestBodyHandler handler = route->getRequestBodyHandler(path);
+			if (handler.isNotNull()) {
+				return handler;
+			}
+		}
+		route = routes.getItemPointer(HttpMethod::Unknown);
+		if (route) {
+			return route->getRequestBodyHandler(path);
+		}
+		return sl_null;
+	}
+
 	Variant HttpServerRouter::preProcessRequest(const String& path, HttpServerContext* context)
 	{
 		if (preRoutes.isNull()) {
@@ -1080,6 +1444,8 @@ namespace slib
 		
 		maxThreadsCount = 32;
 		flagProcessByThreads = sl_true;
+		ioThreadsCount = 1;
+		flagUseIoUring = sl_false;
 		
 		flagUseWebRoot = sl_false;
 		flagUseAsset = sl_false;
@@ -1093,6 +1459,23 @@ namespace slib
 		flagCacheControlNoCache = sl_false;
 		cacheControlMaxAge = 600;
 		
+		flagUseStaticCache = sl_false;
+		
+		flagUseCompression = sl_false;
+		compressionLevel = 6;
+		compressionMinimumSize = 1024;
+		compressionContentTypes.add(ContentType::TextHtml);
+		compressionContentTypes.add(ContentType::TextPlain);
+		compressionContentTypes.add(ContentType::TextCss);
+		compressionContentTypes.add(ContentType::TextXml);
+		compressionContentTypes.add(ContentType::TextJavascript);
+		compressionContentTypes.add(ContentType::TextCsv);
+		compressionContentTypes.add(ContentType::Json);
+		compressionContentTypes.add("application/javascript");
+		compressionContentTypes.add("application/xml");
+		compressionContentTypes.add("image/svg+xml");
+		flagUsePrecompressedFiles = sl_false;
+		
 		flagLogDebug = sl_false;
 		
 		flagAutoStart = sl_true;
@@ -1101,6 +1484,8 @@ namespace slib
 	void HttpServerParam::setJson(const Json& conf)
 	{
 		port = (sl_uint16)(conf["port"].getUint32(port));
+		ioThreadsCount = conf["io_threads"].getUint32(ioThreadsCount);
+		flagUseIoUring = conf["io_uring"].getBoolean(flagUseIoUring);
 		{
 			String s = conf["root"].getString();
 			if (s.isNotNull()) {
@@ -1130,6 +1515,39 @@ namespace slib
 			cacheControlMaxAge = cacheControl["max_age"].getUint32(cacheControlMaxAge);
 		}
 		
+		Json jsonStaticCache = conf["static_cache"];
+		if (jsonStaticCache.isNotNull()) {
+			if (jsonStaticCache.isJsonMap()) {
+				flagUseStaticCache = sl_true;
+				staticCache.maxEntriesCount = jsonStaticCache["max_entries"].getUint32(staticCache.maxEntriesCount);
+				staticCache.maxContentsSize = jsonStaticCache["max_size"].getUint64(staticCache.maxContentsSize);
+				staticCache.maxContentSize = jsonStaticCache["max_file_size"].getUint32(staticCache.maxContentSize);
+				staticCache.revalidateInterval = jsonStaticCache["revalidate"].getUint32(staticCache.revalidateInterval);
+			} else {
+				flagUseStaticCache = jsonStaticCache.getBoolean(flagUseStaticCache);
+			}
+		}
+		
+		Json jsonCompression = conf["compression"];
+		if (jsonCompression.isNotNull()) {
+			if (jsonCompression.isJsonMap()) {
+				flagUseCompression = sl_true;
+				compressionLevel = jsonCompression["level"].getUint32(compressionLevel);
+				if (compressionLevel > 9) {
+					compressionLevel = 9;
+				}
+				compressionMinimumSize = jsonCompression["min_size"].getUint32(compressionMinimumSize);
+				List<String> types;
+				jsonCompression["types"].get(types);
+				if (types.isNotNull()) {
+					compressionContentTypes = types;
+				}
+			} else {
+				flagUseCompression = jsonCompression.getBoolean(flagUseCompression);
+			}
+		}
+		flagUsePrecompressedFiles = conf["precompressed"].getBoolean(flagUsePrecompressedFiles);
+		
 		{
 			sl_uint32 n;
 			if (conf["max_request_body"].getString().parseUint32(10, &n)) {
@@ -1179,11 +1597,15 @@ namespace slib
 	sl_bool HttpServer::_init(const HttpServerParam& param)
 	{
 		m_param = param;
-		Ref<AsyncIoLoop> ioLoop = AsyncIoLoop::create(sl_false);
-		if (ioLoop.isNull()) {
+		Ref<AsyncIoLoopGroup> ioLoopGroup = AsyncIoLoopGroup::create(param.ioThreadsCount, sl_false, param.flagUseIoUring);
+		if (ioLoopGroup.isNull()) {
 			return sl_false;
 		}
-		m_ioLoop = ioLoop;
+		m_ioLoopGroup = ioLoopGroup;
+		m_ioLoop = ioLoopGroup->getLoop(0);
+		if (param.flagUseStaticCache) {
+			m_staticCache = HttpStaticCache::create(param.staticCache);
+		}
 		if (param.port) {
 			if (!(addHttpBinding(param.addressBind, param.port))) {
 				return sl_false;
@@ -1206,13 +1628,13 @@ namespace slib
 		if (m_flagRunning) {
 			return sl_true;
 		}
-		Ref<AsyncIoLoop> loop = m_ioLoop;
-		if (loop.isNotNull()) {
+		Ref<AsyncIoLoopGroup> loops = m_ioLoopGroup;
+		if (loops.isNotNull()) {
 			Ref<ThreadPool> threadPool = ThreadPool::create();
 			if (threadPool.isNotNull()) {
 				threadPool->setMaximumThreadsCount(m_param.maxThreadsCount);
 				m_threadPool = threadPool;
-				loop->start();
+				loops->start();
 				return sl_true;
 			}
 		}
@@ -1238,11 +1660,12 @@ namespace slib
 		}
 		m_connectionProviders.removeAll();
 		
-		Ref<AsyncIoLoop> ioLoop = m_ioLoop;
-		if (ioLoop.isNotNull()) {
-			ioLoop->release();
-			m_ioLoop.setNull();
+		Ref<AsyncIoLoopGroup> ioLoopGroup = m_ioLoopGroup;
+		if (ioLoopGroup.isNotNull()) {
+			ioLoopGroup->release();
+			m_ioLoopGroup.setNull();
 		}
+		m_ioLoop.setNull();
 		Ref<ThreadPool> threadPool = m_threadPool;
 		if (threadPool.isNotNull()) {
 			threadPool->release();
@@ -1261,11 +1684,21 @@ namespace slib
 		return m_ioLoop;
 	}
 
+	Ref<AsyncIoLoopGroup> HttpServer::getAsyncIoLoopGroup()
+	{
+		return m_ioLoopGroup;
+	}
+
 	Ref<ThreadPool> HttpServer::getThreadPool()
 	{
 		return m_threadPool;
 	}
 
+	Ref<HttpStaticCache> HttpServer::getStaticCache()
+	{
+		return m_staticCache;
+	}
+
 	const HttpServerParam& HttpServer::getParam()
 	{
 		return m_param;
@@ -1276,6 +1709,11 @@ namespace slib
 		return sl_false;
 	}
 
+	HttpServerRequestBodyHandler HttpServer::getRequestBodyHandler(HttpServerContext* context)
+	{
+		return m_param.router.getRequestBodyHandler(context->getPath(), context);
+	}
+
 	void HttpServer::processRequest(HttpServerContext* context, HttpServerConnection* connection)
 	{
 		if (m_param.flagLogDebug) {
@@ -1457,22 +1895,67 @@ namespace slib
 		return sl_false;
 	}
 
+	namespace priv
+	{
+		namespace http_server
+		{
+			static void AddVaryAcceptEncoding(HttpServerContext* context)
+			{
+				String vary = context->getResponseHeader(HttpHeader::Vary);
+				if (vary.isEmpty()) {
+					context->setResponseHeader(HttpHeader::Vary, HttpHeader::AcceptEncoding);
+				} else if (vary.indexOf(HttpHeader::AcceptEncoding) < 0) {
+					context->setResponseHeader(HttpHeader::Vary, vary + ", " + HttpHeader::AcceptEncoding);
+				}
+			}
+		}
+	}
+
 	sl_bool HttpServer::processFile(HttpServerContext* context, const String& path)
 	{
+		if (m_param.flagUsePrecompressedFiles) {
+			priv::http_server::AddVaryAcceptEncoding(context);
+			SLIB_STATIC_STRING(gzip, "gzip")
+			if (context->getRequestRange().isEmpty() && HttpContentEncoder::getAcceptedQuality(context->getRequestAcceptEncoding(), gzip)) {
+				String pathGzip = path + ".gz";
+				sl_bool flagExists;
+				Ref<HttpStaticCache> cache = m_staticCache;
+				if (cache.isNotNull()) {
+					flagExists = cache->get(pathGzip).isNotNull();
+				} else {
+					flagExists = File::exists(pathGzip) && !(File::isDirectory(pathGzip));
+				}
+				if (flagExists) {
+					// content type of the original file
+					_processContentType(context, path);
+					if (_processFile(context, pathGzip)) {
+						context->setResponseContentEncoding(gzip);
+						return sl_true;
+					}
+				}
+			}
+		}
+		return _processFile(context, path);
+	}
+
+	sl_bool HttpServer::_processFile(HttpServerContext* context, const String& path)
+	{
+		Ref<HttpStaticCache> cache = m_staticCache;
+		if (cache.isNotNull()) {
+			Ref<HttpStaticCacheEntry> entry = cache->get(path);
+			if (entry.isNotNull()) {
+				return _processCachedFile(context, path, entry.get());
+			}
+			return sl_false;
+		}
+		
 		if (File::exists(path) && !(File::isDirectory(path))) {
 
+			context->setCompressionEnabled(sl_false);
+
 			sl_uint64 totalSize = File::getSize(path);
 
-			String ext = File::getFileExtension(path);
-			
-			String oldResponseContentType = context->getResponseContentType();
-			if (oldResponseContentType.isEmpty()) {
-				String contentType = ContentTypeHelper::getFromFileExtension(ext);
-				if (contentType.isEmpty()) {
-					contentType = ContentType::OctetStream;
-				}
-				context->setResponseContentType(contentType);
-			}
+			_processContentType(context, path);
 
 			context->setResponseAcceptRanges(sl_true);
 			
@@ -1495,10 +1978,9 @@ namespace slib
 				
 				if (processRangeRequest(context, totalSize, rangeHeader, start, len)) {
 
-					Ref<AsyncFile> file = AsyncFile::openForRead(path, m_threadPool);
+					Ref<File> file = File::openForRead(path);
 					if (file.isNotNull()) {
-						file->seek(start);
-						context->copyFrom(file.get(), len);
+						context->sendFileRegion(file, start, len, m_threadPool);
 						return sl_true;
 					}
 					
@@ -1508,8 +1990,11 @@ namespace slib
 				
 			} else {
 				if (totalSize > 100000) {
-					context->copyFromFile(path, m_threadPool);
-					return sl_true;
+					Ref<File> file = File::openForRead(path);
+					if (file.isNotNull()) {
+						context->sendFileRegion(file, 0, totalSize, m_threadPool);
+						return sl_true;
+					}
 				} else {
 					Memory mem = File::readAllBytes(path);
 					if (mem.isNotNull()) {
@@ -1523,6 +2008,71 @@ namespace slib
 		return sl_false;
 	}
 	
+	sl_bool HttpServer::_processCachedFile(HttpServerContext* context, const String& path, HttpStaticCacheEntry* entry)
+	{
+		context->setCompressionEnabled(sl_false);
+		
+		_processContentType(context, path);
+		
+		context->setResponseAcceptRanges(sl_true);
+		
+		_processCacheControl(context);
+		
+		context->setResponseHeader(HttpHeader::LastModified, entry->lastModified);
+		context->setResponseETag(entry->etag);
+		String ifNoneMatch = context->getRequestIfNoneMatch();
+		if (ifNoneMatch.isNotEmpty()) {
+			// `If-Modified-Since` is ignored when `If-None-Match` is present
+			if (entry->matchETag(ifNoneMatch)) {
+				context->setResponseCode(HttpStatus::NotModified);
+				return sl_true;
+			}
+		} else if (entry->isNotModifiedSince(context->getRequestIfModifiedSince())) {
+			context->setResponseCode(HttpStatus::NotModified);
+			return sl_true;
+		}
+		
+		sl_uint64 start = 0;
+		sl_uint64 len = entry->size;
+		String rangeHeader = context->getRequestRange();
+		if (rangeHeader.isNotEmpty()) {
+			if (!(processRangeRequest(context, entry->size, rangeHeader, start, len))) {
+				return sl_true;
+			}
+		}
+		
+		if (entry->isContentLoaded()) {
+			if (len) {
+				context->write(entry->content.sub((sl_size)start, (sl_size)len));
+			}
+			return sl_true;
+		}
+		
+		// the cached file is shared only by the streams writing with `sendfile`, which does not move the file position
+		Ref<File> file = entry->file;
+		Ref<AsyncStream> io = context->getIO();
+		if (io.isNull() || !(io->isSupportingSendFile())) {
+			file = File::openForRead(path);
+			if (file.isNull()) {
+				return sl_false;
+			}
+		}
+		context->sendFileRegion(file, start, len, m_threadPool);
+		return sl_true;
+	}
+	
+	void HttpServer::_processContentType(HttpServerContext* context, const String& path)
+	{
+		String oldResponseContentType = context->getResponseContentType();
+		if (oldResponseContentType.isEmpty()) {
+			String contentType = ContentTypeHelper::getFromFileExtension(File::getFileExtension(path));
+			if (contentType.isEmpty()) {
+				contentType = ContentType::OctetStream;
+			}
+			context->setResponseContentType(contentType);
+		}
+	}
+	
 	void HttpServer::_processCacheControl(HttpServerContext* context)
 	{
 		if (m_param.flagUseCacheControl) {
@@ -1563,7 +2113,7 @@ namespace slib
 				return sl_false;
 			}
 		}
-		if (indexSplit == 0) {
+		if (s1.isEmpty()) {
 			if (n2 == 0) {
 				context->setResponseCode(HttpStatus::NoContent);
 				return sl_false;
@@ -1574,7 +2124,7 @@ namespace slib
 				return sl_false;
 			}
 			outStart = totalLength - n2;
-			outLength = totalLength - 1;
+			outLength = n2;
 		} else {
 			if (n1 >= totalLength) {
 				context->setResponseCode(HttpStatus::RequestRangeNotSatisfiable);
@@ -1665,10 +2215,65 @@ namespace slib
 			context->setResponseContentType(ContentType::TextHtml_Utf8);
 		}
 
-		context->setResponseContentLengthHeader(context->getResponseContentLength());
+		if (!(_processCompression(context))) {
+			context->setResponseContentLengthHeader(context->getResponseContentLength());
+		}
 
 	}
 
+	sl_bool HttpServer::_processCompression(HttpServerContext* context)
+	{
+		if (!(m_param.flagUseCompression) || !(context->isCompressionEnabled())) {
+			return sl_false;
+		}
+		if (context->getMethod() == HttpMethod::HEAD) {
+			return sl_false;
+		}
+		// chunked transfer coding is required to send the encoded body of unknown length
+		if (context->getRequestVersion() != "HTTP/1.1") {
+			return sl_false;
+		}
+		sl_uint32 status = (sl_uint32)(context->getResponseCode());
+		if (status < 200 || status >= 300 || status == (sl_uint32)(HttpStatus::NoContent) || status == (sl_uint32)(HttpStatus::PartialContent)) {
+			return sl_false;
+		}
+		sl_uint64 size = context->getResponseContentLength();
+		if (!size || size < m_param.compressionMinimumSize) {
+			return sl_false;
+		}
+		if (context->containsResponseHeader(HttpHeader::ContentEncoding) || context->containsResponseHeader(HttpHeader::TransferEncoding)) {
+			return sl_false;
+		}
+		String contentType = context->getResponseContentType();
+		sl_reg index = contentType.indexOf(';');
+		if (index >= 0) {
+			contentType = contentType.substring(0, index);
+		}
+		contentType = contentType.trim().toLower();
+		if (!(m_param.compressionContentTypes.contains(contentType))) {
+			return sl_false;
+		}
+		priv::http_server::AddVaryAcceptEncoding(context);
+		String encoding = HttpContentEncoder::selectEncoding(context->getRequestAcceptEncoding());
+		if (encoding.isEmpty()) {
+			return sl_false;
+		}
+		// the encoder is created before the headers are changed, so that the body is sent as is on failure
+		sl_uint32 level = m_param.compressionLevel;
+		if (level > 9) {
+			level = 9;
+		}
+		Ref<HttpContentEncoder> encoder = HttpContentEncoder::create(context->getIO(), encoding, sl_true, (sl_int32)level);
+		if (encoder.isNull()) {
+			return sl_false;
+		}
+		context->setResponseContentEncoding(encoding);
+		context->removeResponseHeader(HttpHeader::ContentLength);
+		context->setResponseTransferEncoding("chunked");
+		context->m_encoderOutput = encoder;
+		return sl_true;
+	}
+
 	Ref<HttpServerConnection> HttpServer::addConnection(const Ref<AsyncStream>& stream, const SocketAddress& remoteAddress, const SocketAddress& localAddress)
 	{
 		Ref<HttpServerConnection> connection = HttpServerConnection::create(this, stream.get());
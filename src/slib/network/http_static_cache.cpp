@@ -0,0 +1,291 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include "slib/network/http_static_cache.h"
+
+#include "slib/core/system.h"
+
+namespace slib
+{
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(HttpStaticCacheParam)
+	
+	HttpStaticCacheParam::HttpStaticCacheParam()
+	{
+		maxEntriesCount = 1024;
+		maxContentsSize = 0x2000000; // 32MB
+		maxContentSize = 100000;
+		revalidateInterval = 1000;
+	}
+	
+	
+	HttpStaticCacheEntry::HttpStaticCacheEntry()
+	{
+		size = 0;
+		m_tickCheck = 0;
+		m_link = sl_null;
+	}
+	
+	HttpStaticCacheEntry::~HttpStaticCacheEntry()
+	{
+	}
+	
+	sl_bool HttpStaticCacheEntry::isContentLoaded()
+	{
+		return file.isNull();
+	}
+	
+	sl_bool HttpStaticCacheEntry::matchETag(const String& ifNoneMatch)
+	{
+		if (ifNoneMatch.isEmpty()) {
+			return sl_false;
+		}
+		if (ifNoneMatch == "*") {
+			return sl_true;
+		}
+		ListElements<String> tags(ifNoneMatch.split(","));
+		for (sl_size i = 0; i < tags.count; i++) {
+			String tag = tags[i].trim();
+			if (tag.startsWith("W/")) {
+				tag = tag.substring(2);
+			}
+			if (tag == etag) {
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+	
+	sl_bool HttpStaticCacheEntry::isNotModifiedSince(const Time& ifModifiedSince)
+	{
+		if (ifModifiedSince.isZero()) {
+			return sl_false;
+		}
+		// `Last-Modified` has the precision of seconds
+		return modifiedTime.getSecondsCount() <= ifModifiedSince.getSecondsCount();
+	}
+	
+	
+	SLIB_DEFINE_OBJECT(HttpStaticCache, Object)
+	
+	HttpStaticCache::HttpStaticCache()
+	{
+		m_sizeContents = 0;
+		m_nHits = 0;
+		m_nMisses = 0;
+	}
+	
+	HttpStaticCache::~HttpStaticCache()
+	{
+	}
+	
+	Ref<HttpStaticCache> HttpStaticCache::create(const HttpStaticCacheParam& param)
+	{
+		Ref<HttpStaticCache> ret = new HttpStaticCache;
+		if (ret.isNotNull()) {
+			ret->m_param = param;
+			return ret;
+		}
+		return sl_null;
+	}
+	
+	Ref<HttpStaticCache> HttpStaticCache::create()
+	{
+		HttpStaticCacheParam param;
+		return create(param);
+	}
+	
+	Ref<HttpStaticCacheEntry> HttpStaticCache::get(const String& path)
+	{
+		sl_uint64 tick = System::getTickCount64();
+		Ref<HttpStaticCacheEntry> entry;
+		{
+			ObjectLocker lock(this);
+			if (m_map.get_NoLock(path, &entry)) {
+				if (tick < entry->m_tickCheck + m_param.revalidateInterval) {
+					m_nHits++;
+					if (entry->m_link) {
+						m_listLRU.removeAt_NoLock(entry->m_link);
+						entry->m_link = m_listLRU.pushBack_NoLock(entry.get());
+					}
+					return entry;
+				}
+			}
+		}
+		if (entry.isNotNull()) {
+			// revalidates by the path, because the file could be replaced while it is opened
+			if (File::getModifiedTime(path) == entry->modifiedTime && File::getSize(path) == entry->size) {
+				ObjectLocker lock(this);
+				m_nHits++;
+				entry->m_tickCheck = tick;
+				if (entry->m_link) {
+					m_listLRU.removeAt_NoLock(entry->m_link);
+					entry->m_link = m_listLRU.pushBack_NoLock(entry.get());
+				}
+				return entry;
+			}
+		}
+		{
+			ObjectLocker lock(this);
+			m_nMisses++;
+		}
+		entry = _load(path);
+		if (entry.isNotNull()) {
+			entry->m_tickCheck = tick;
+			_put(path, entry);
+		} else {
+			remove(path);
+		}
+		return entry;
+	}
+	
+	void HttpStaticCache::remove(const String& path)
+	{
+		ObjectLocker lock(this);
+		Ref<HttpStaticCacheEntry> entry;
+		if (m_map.get_NoLock(path, &entry)) {
+			_remove(entry.get());
+		}
+	}
+	
+	void HttpStaticCache::clear()
+	{
+		ObjectLocker lock(this);
+		Link<HttpStaticCacheEntry*>* link = m_listLRU.getFront();
+		while (link) {
+			link->value->m_link = sl_null;
+			link = link->next;
+		}
+		m_listLRU.removeAll_NoLock();
+		m_map.removeAll_NoLock();
+		m_sizeContents = 0;
+	}
+	
+	const HttpStaticCacheParam& HttpStaticCache::getParam()
+	{
+		return m_param;
+	}
+	
+	sl_size HttpStaticCache::getEntriesCount()
+	{
+		return m_map.getCount();
+	}
+	
+	sl_uint64 HttpStaticCache::getContentsSize()
+	{
+		return m_sizeContents;
+	}
+	
+	sl_uint64 HttpStaticCache::getHitsCount()
+	{
+		return m_nHits;
+	}
+	
+	sl_uint64 HttpStaticCache::getMissesCount()
+	{
+		return m_nMisses;
+	}
+	
+	void HttpStaticCache::resetCounters()
+	{
+		ObjectLocker lock(this);
+		m_nHits = 0;
+		m_nMisses = 0;
+	}
+	
+	Ref<HttpStaticCacheEntry> HttpStaticCache::_load(const String& path)
+	{
+		FileAttributes attrs = File::getAttributes(path);
+		if (attrs & (FileAttributes::NotExist | FileAttributes::Directory)) {
+			return sl_null;
+		}
+		Ref<File> file = File::openForRead(path);
+		if (file.isNull()) {
+			return sl_null;
+		}
+		Ref<HttpStaticCacheEntry> entry = new HttpStaticCacheEntry;
+		if (entry.isNull()) {
+			return sl_null;
+		}
+		sl_uint64 size = file->getSize();
+		Time modifiedTime = file->getModifiedTime();
+		entry->path = path;
+		entry->size = size;
+		entry->modifiedTime = modifiedTime;
+		entry->lastModified = modifiedTime.toHttpDate();
+		entry->etag = String::fromUint64(modifiedTime.toInt(), 16) + "-" + String::fromUint64(size, 16);
+		if (size <= m_param.maxContentSize && size <= m_param.maxContentsSize) {
+			if (size) {
+				Memory content = file->readAllBytes();
+				if (content.getSize() != size) {
+					return sl_null;
+				}
+				entry->content = content;
+			}
+			file->close();
+		} else {
+			entry->file = file;
+		}
+		return entry;
+	}
+	
+	void HttpStaticCache::_put(const String& path, const Ref<HttpStaticCacheEntry>& entry)
+	{
+		if (!(m_param.maxEntriesCount)) {
+			return;
+		}
+		ObjectLocker lock(this);
+		Ref<HttpStaticCacheEntry> old;
+		if (m_map.get_NoLock(path, &old)) {
+			_remove(old.get());
+		}
+		entry->m_link = m_listLRU.pushBack_NoLock(entry.get());
+		if (!(entry->m_link)) {
+			return;
+		}
+		m_map.put_NoLock(path, entry);
+		m_sizeContents += entry->content.getSize();
+		for (;;) {
+			if (m_map.getCount() <= m_param.maxEntriesCount && m_sizeContents <= m_param.maxContentsSize) {
+				break;
+			}
+			Link<HttpStaticCacheEntry*>* front = m_listLRU.getFront();
+			if (!front || front->value == entry.get()) {
+				break;
+			}
+			_remove(front->value);
+		}
+	}
+	
+	void HttpStaticCache::_remove(HttpStaticCacheEntry* entry)
+	{
+		if (entry->m_link) {
+			m_listLRU.removeAt_NoLock(entry->m_link);
+			entry->m_link = sl_null;
+		}
+		m_sizeContents -= entry->content.getSize();
+		// may free the entry
+		m_map.remove_NoLock(entry->path);
+	}
+
+}
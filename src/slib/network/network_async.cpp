@@ -135,18 +135,20 @@ namespace slib
 			}
 		}
 
-		Ref<AsyncTcpSocketInstance> instance = _createInstance(socket);
-		if (instance.isNotNull()) {
-			Ref<AsyncIoLoop> loop = param.ioLoop;
+		Ref<AsyncIoLoop> loop = param.ioLoop;
+		if (loop.isNull()) {
+			loop = AsyncIoLoop::getDefault();
 			if (loop.isNull()) {
-				loop = AsyncIoLoop::getDefault();
-				if (loop.isNull()) {
-					return sl_null;
-				}
+				return sl_null;
 			}
+		}
+		sl_bool flagIoUring = loop->isUsingIoUring();
+		Ref<AsyncTcpSocketInstance> instance = _createInstance(socket, flagIoUring);
+		if (instance.isNotNull()) {
 			Ref<AsyncTcpSocket> ret = new AsyncTcpSocket;
 			if (ret.isNotNull()) {
-				if (ret->_initialize(instance.get(), AsyncIoMode::InOut, loop)) {
+				// io_uring loops complete the operations submitted by the instance instead of polling
+				if (ret->_initialize(instance.get(), flagIoUring ? AsyncIoMode::None : AsyncIoMode::InOut, loop)) {
 					ret->m_onConnect = param.onConnect;
 					ret->m_onError = param.onError;
 					if (param.connectAddress.isValid()) {
@@ -336,6 +338,7 @@ namespace slib
 		
 		flagAutoStart = sl_true;
 		flagLogError = sl_true;
+		flagReusePort = sl_false;
 	}
 
 
@@ -378,6 +381,9 @@ namespace slib
 			 */
 			socket->setOption_ReuseAddress(sl_true);
 #endif
+			if (param.flagReusePort) {
+				socket->setOption_ReusePort(sl_true);
+			}
 
 			if (!(socket->bind(param.bindAddress))) {
 				if (param.flagLogError) {
@@ -388,15 +394,16 @@ namespace slib
 		}
 		
 		if (socket->listen()) {
-			Ref<AsyncTcpServerInstance> instance = _createInstance(socket);
-			if (instance.isNotNull()) {
-				Ref<AsyncIoLoop> loop = param.ioLoop;
+			Ref<AsyncIoLoop> loop = param.ioLoop;
+			if (loop.isNull()) {
+				loop = AsyncIoLoop::getDefault();
 				if (loop.isNull()) {
-					loop = AsyncIoLoop::getDefault();
-					if (loop.isNull()) {
-						return sl_null;
-					}
+					return sl_null;
 				}
+			}
+			sl_bool flagIoUring = loop->isUsingIoUring();
+			Ref<AsyncTcpServerInstance> instance = _createInstance(socket, flagIoUring);
+			if (instance.isNotNull()) {
 				Ref<AsyncTcpServer> ret = new AsyncTcpServer;
 				if (ret.isNotNull()) {
 					ret->m_onAccept = param.onAccept;
@@ -404,7 +411,7 @@ namespace slib
 					instance->setObject(ret.get());
 					ret->setIoInstance(instance.get());
 					ret->setIoLoop(loop);
-					if (loop->attachInstance(instance.get(), AsyncIoMode::In)) {
+					if (loop->attachInstance(instance.get(), flagIoUring ? AsyncIoMode::None : AsyncIoMode::In)) {
 						if (param.flagAutoStart) {
 							instance->start();
 						}
@@ -26,6 +26,18 @@
 
 #include "network_async.h"
 
+#if defined(SLIB_PLATFORM_IS_LINUX)
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <signal.h>
+#include <pthread.h>
+#endif
+
+#define SIZE_SEND_FILE_BUFFER 0x10000
+#define ACCEPT_RETRY_DELAY 100
+
 namespace slib
 {
 	
@@ -149,15 +161,21 @@ namespace slib
 								return;
 							}
 						}
-						if (request->data && request->size) {
+						if ((request->data || request->file != SLIB_FILE_INVALID_HANDLE) && request->size) {
 							sl_uint32 size = request->size - m_sizeWritten;
-							sl_int32 n = socket->send((char*)(request->data) + m_sizeWritten, size);
+							sl_int32 n;
+							if (request->data) {
+								n = socket->send((char*)(request->data) + m_sizeWritten, size);
+							} else {
+								n = sendFile(socket.get(), request.get(), size);
+							}
 							if (n > 0) {
 								m_sizeWritten += n;
 								if (m_sizeWritten >= request->size) {
 									_onSend(request.get(), request->size, flagError);
 								} else {
-									m_requestWriting = request;
+									// edge-triggered: keep writing the rest until the socket would block
+									continue;
 								}
 							} else if (n < 0) {
 								_onSend(request.get(), m_sizeWritten, sl_true);
@@ -177,6 +195,50 @@ namespace slib
 					}
 				}
 				
+				// returns 0 when the socket would block, negative on error
+				sl_int32 sendFile(Socket* socket, AsyncStreamRequest* request, sl_uint32 size)
+				{
+#if defined(SLIB_PLATFORM_IS_LINUX)
+					// `sendfile` has no `MSG_NOSIGNAL`: holds the SIGPIPE raised on the closed connection, and discards it
+					sigset_t setPipe, setOld;
+					sigemptyset(&setPipe);
+					sigaddset(&setPipe, SIGPIPE);
+					pthread_sigmask(SIG_BLOCK, &setPipe, &setOld);
+					off_t offset = (off_t)(request->fileOffset + m_sizeWritten);
+					ssize_t n = ::sendfile((int)(socket->getHandle()), (int)(request->file), &offset, size);
+					int err = errno;
+					if (n < 0 && err == EPIPE && !sigismember(&setOld, SIGPIPE)) {
+						timespec ts = {0, 0};
+						sigtimedwait(&setPipe, sl_null, &ts);
+					}
+					pthread_sigmask(SIG_SETMASK, &setOld, sl_null);
+					if (n > 0) {
+						return (sl_int32)n;
+					}
+					if (n < 0 && (err == EAGAIN || err == EWOULDBLOCK)) {
+						return 0;
+					}
+#endif
+					// `n == 0`: the file is shorter than the request
+					return -1;
+				}
+				
+#if defined(SLIB_PLATFORM_IS_LINUX)
+				sl_bool sendFile(sl_file file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject) override
+				{
+					Ref<AsyncStreamRequest> request = AsyncStreamRequest::createSendFile(file, offset, size, userObject, callback);
+					if (request.isNotNull()) {
+						return addWriteRequest(request);
+					}
+					return sl_false;
+				}
+				
+				sl_bool isSupportingSendFile() override
+				{
+					return sl_true;
+				}
+#endif
+				
 				void onOrder() override
 				{
 					Ref<Socket> socket = m_socket;
@@ -309,6 +371,353 @@ namespace slib
 				}
 			};
 			
+#if defined(SLIB_PLATFORM_IS_LINUX)
+			// completion-based socket on io_uring loops: one receive and one send are in flight at a time
+			class AsyncTcpSocketInstanceUring : public AsyncTcpSocketInstance
+			{
+			public:
+				Ref<AsyncStreamRequest> m_requestReading;
+				Ref<AsyncStreamRequest> m_requestWriting;
+				sl_uint32 m_sizeWritten;
+				// the file regions are read into this buffer and sent, because io_uring has no `sendfile`
+				Memory m_bufferSendFile;
+				
+				AsyncIoOperation m_operationRead;
+				AsyncIoOperation m_operationWrite;
+				AsyncIoOperation m_operationConnect;
+				sockaddr_storage m_addressConnect;
+				sl_bool m_flagConnecting;
+				
+			public:
+				AsyncTcpSocketInstanceUring()
+				{
+					m_sizeWritten = 0;
+					m_flagConnecting = sl_false;
+					Base::zeroMemory(&m_operationRead, sizeof(m_operationRead));
+					m_operationRead.code = AsyncIoOperationCode::Receive;
+					Base::zeroMemory(&m_operationWrite, sizeof(m_operationWrite));
+					m_operationWrite.code = AsyncIoOperationCode::Send;
+					Base::zeroMemory(&m_operationConnect, sizeof(m_operationConnect));
+					m_operationConnect.code = AsyncIoOperationCode::Connect;
+				}
+				
+				~AsyncTcpSocketInstanceUring()
+				{
+					close();
+				}
+				
+			public:
+				static Ref<AsyncTcpSocketInstanceUring> create(const Ref<Socket>& socket)
+				{
+					if (socket.isNotNull()) {
+						// io_uring waits for the blocking sockets internally, without returning `EAGAIN`
+						if (socket->setNonBlockingMode(sl_false)) {
+							sl_file handle = (sl_file)(socket->getHandle());
+							if (handle != SLIB_FILE_INVALID_HANDLE) {
+								Ref<AsyncTcpSocketInstanceUring> ret = new AsyncTcpSocketInstanceUring();
+								if (ret.isNotNull()) {
+									ret->m_socket = socket;
+									ret->setHandle(handle);
+									return ret;
+								}
+							}
+						}
+					}
+					return sl_null;
+				}
+				
+				void close() override
+				{
+					AsyncTcpSocketInstance::close();
+					setHandle(SLIB_FILE_INVALID_HANDLE);
+					m_socket.setNull();
+				}
+				
+				void processRead(AsyncIoLoop* loop)
+				{
+					if (m_requestReading.isNotNull()) {
+						return;
+					}
+					sl_size nQueue = getReadRequestsCount();
+					while (nQueue > 0) {
+						nQueue--;
+						Ref<AsyncStreamRequest> request;
+						popReadRequest(request);
+						if (request.isNull()) {
+							return;
+						}
+						if (request->data && request->size) {
+							m_operationRead.data = request->data;
+							m_operationRead.size = request->size;
+							m_requestReading = request;
+							if (!(loop->submitOperation(this, &m_operationRead))) {
+								m_requestReading.setNull();
+								_onReceive(request.get(), 0, sl_true);
+							}
+							return;
+						} else {
+							_onReceive(request.get(), request->size, sl_false);
+						}
+					}
+				}
+				
+				void processWrite(AsyncIoLoop* loop)
+				{
+					if (m_requestWriting.isNotNull()) {
+						return;
+					}
+					sl_size nQueue = getWriteRequestsCount();
+					while (nQueue > 0) {
+						nQueue--;
+						Ref<AsyncStreamRequest> request;
+						popWriteRequest(request);
+						if (request.isNull()) {
+							return;
+						}
+						if ((request->data || request->file != SLIB_FILE_INVALID_HANDLE) && request->size) {
+							m_sizeWritten = 0;
+							m_requestWriting = request;
+							if (!(submitWrite(loop))) {
+								m_requestWriting.setNull();
+								_onSend(request.get(), 0, sl_true);
+							}
+							return;
+						} else {
+							_onSend(request.get(), request->size, sl_false);
+						}
+					}
+				}
+				
+				sl_bool submitWrite(AsyncIoLoop* loop)
+				{
+					AsyncStreamRequest* request = m_requestWriting.get();
+					sl_uint32 size = request->size - m_sizeWritten;
+					if (request->data) {
+						m_operationWrite.data = (char*)(request->data) + m_sizeWritten;
+					} else {
+						if (m_bufferSendFile.isNull()) {
+							m_bufferSendFile = Memory::create(SIZE_SEND_FILE_BUFFER);
+							if (m_bufferSendFile.isNull()) {
+								return sl_false;
+							}
+						}
+						if (size > SIZE_SEND_FILE_BUFFER) {
+							size = SIZE_SEND_FILE_BUFFER;
+						}
+						// `pread` does not move the file position, same as `sendfile`
+						ssize_t n = ::pread((int)(request->file), m_bufferSendFile.getData(), size, (off_t)(request->fileOffset + m_sizeWritten));
+						if (n <= 0) {
+							// `n == 0`: the file is shorter than the request
+							return sl_false;
+						}
+						m_operationWrite.data = m_bufferSendFile.getData();
+						size = (sl_uint32)n;
+					}
+					m_operationWrite.size = size;
+					return loop->submitOperation(this, &m_operationWrite);
+				}
+				
+				sl_bool sendFile(sl_file file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject) override
+				{
+					Ref<AsyncStreamRequest> request = AsyncStreamRequest::createSendFile(file, offset, size, userObject, callback);
+					if (request.isNotNull()) {
+						return addWriteRequest(request);
+					}
+					return sl_false;
+				}
+				
+				sl_bool isSupportingSendFile() override
+				{
+					return sl_true;
+				}
+				
+				void onOrder() override
+				{
+					if (m_socket.isNull()) {
+						return;
+					}
+					Ref<AsyncIoLoop> loop = getLoop();
+					if (loop.isNull()) {
+						return;
+					}
+					if (m_flagConnecting) {
+						return;
+					}
+					if (m_flagRequestConnect) {
+						m_flagRequestConnect = sl_false;
+						sl_uint32 size = m_addressRequestConnect.getSystemSocketAddress(&m_addressConnect);
+						if (size) {
+							m_operationConnect.address = &m_addressConnect;
+							m_operationConnect.addressLength = size;
+							if (loop->submitOperation(this, &m_operationConnect)) {
+								m_flagConnecting = sl_true;
+								return;
+							}
+						}
+						_onConnect(sl_true);
+						return;
+					}
+					processRead(loop.get());
+					processWrite(loop.get());
+				}
+				
+				void onEvent(EventDesc* pev) override
+				{
+					sl_int32 result = pev->result;
+					if (pev->pOperation == &m_operationRead) {
+						Ref<AsyncStreamRequest> request = m_requestReading;
+						m_requestReading.setNull();
+						if (request.isNotNull()) {
+							if (result > 0) {
+								_onReceive(request.get(), result, sl_false);
+							} else {
+								// 0: closed by the peer
+								_onReceive(request.get(), 0, sl_true);
+							}
+						}
+					} else if (pev->pOperation == &m_operationWrite) {
+						Ref<AsyncStreamRequest> request = m_requestWriting;
+						if (request.isNotNull()) {
+							if (result > 0) {
+								m_sizeWritten += result;
+								if (m_sizeWritten < request->size) {
+									// sends the rest
+									Ref<AsyncIoLoop> loop = getLoop();
+									if (loop.isNotNull() && submitWrite(loop.get())) {
+										return;
+									}
+									m_requestWriting.setNull();
+									_onSend(request.get(), m_sizeWritten, sl_true);
+								} else {
+									m_requestWriting.setNull();
+									_onSend(request.get(), request->size, sl_false);
+								}
+							} else {
+								m_requestWriting.setNull();
+								_onSend(request.get(), m_sizeWritten, sl_true);
+							}
+						}
+					} else if (pev->pOperation == &m_operationConnect) {
+						m_flagConnecting = sl_false;
+						_onConnect(result < 0);
+					}
+					requestOrder();
+				}
+			};
+			
+			class AsyncTcpServerInstanceUring : public AsyncTcpServerInstance
+			{
+			public:
+				AsyncIoOperation m_operationAccept;
+				sockaddr_storage m_addressAccept;
+				sl_bool m_flagAccepting;
+				
+			public:
+				AsyncTcpServerInstanceUring()
+				{
+					m_flagAccepting = sl_false;
+					Base::zeroMemory(&m_operationAccept, sizeof(m_operationAccept));
+					m_operationAccept.code = AsyncIoOperationCode::Accept;
+					m_operationAccept.address = &m_addressAccept;
+				}
+				
+				~AsyncTcpServerInstanceUring()
+				{
+					close();
+				}
+				
+			public:
+				static Ref<AsyncTcpServerInstanceUring> create(const Ref<Socket>& socket)
+				{
+					if (socket.isNotNull()) {
+						if (socket->setNonBlockingMode(sl_false)) {
+							sl_file handle = (sl_file)(socket->getHandle());
+							if (handle != SLIB_FILE_INVALID_HANDLE) {
+								Ref<AsyncTcpServerInstanceUring> ret = new AsyncTcpServerInstanceUring();
+								if (ret.isNotNull()) {
+									ret->m_socket = socket;
+									ret->setHandle(handle);
+									return ret;
+								}
+							}
+						}
+					}
+					return sl_null;
+				}
+				
+				void close() override
+				{
+					AsyncTcpServerInstance::close();
+					m_socket.setNull();
+					setHandle(SLIB_FILE_INVALID_HANDLE);
+				}
+				
+				void onOrder() override
+				{
+					if (m_flagAccepting || m_socket.isNull()) {
+						return;
+					}
+					Ref<AsyncIoLoop> loop = getLoop();
+					if (loop.isNull()) {
+						return;
+					}
+					m_operationAccept.addressLength = sizeof(m_addressAccept);
+					if (loop->submitOperation(this, &m_operationAccept)) {
+						m_flagAccepting = sl_true;
+					} else {
+						_onError();
+					}
+				}
+				
+				void onEvent(EventDesc* pev) override
+				{
+					if (pev->pOperation != &m_operationAccept) {
+						return;
+					}
+					m_flagAccepting = sl_false;
+					sl_int32 result = pev->result;
+					if (result >= 0) {
+						Ref<Socket> socket = m_socket;
+						if (socket.isNull()) {
+							::close(result);
+							return;
+						}
+						SocketAddress address;
+						address.setSystemSocketAddress(&m_addressAccept, m_operationAccept.addressLength);
+						Ref<Socket> socketAccept = Socket::create(socket->getType(), (sl_socket)result);
+						if (socketAccept.isNotNull()) {
+							_onAccept(socketAccept, address);
+						}
+					} else {
+						if (result == -EMFILE || result == -ENFILE || result == -ENOBUFS || result == -ENOMEM) {
+							// out of the resources for now: keeps listening after a while, as the epoll loop keeps polling
+							_onError();
+							Ref<AsyncIoLoop> loop = getLoop();
+							if (loop.isNotNull()) {
+								m_flagAccepting = sl_true;
+								if (loop->setTimeout(SLIB_FUNCTION_WEAKREF(AsyncTcpServerInstanceUring, onRetryAccept, this), ACCEPT_RETRY_DELAY).isNotNull()) {
+									return;
+								}
+								m_flagAccepting = sl_false;
+							}
+							return;
+						}
+						if (result != -EINTR && result != -EAGAIN && result != -ECONNABORTED) {
+							_onError();
+							return;
+						}
+					}
+					onOrder();
+				}
+				
+				void onRetryAccept()
+				{
+					m_flagAccepting = sl_false;
+					onOrder();
+				}
+			};
+#endif
+			
 			class AsyncUdpSocketInstanceImpl : public AsyncUdpSocketInstance
 			{
 			public:
@@ -393,13 +802,23 @@ namespace slib
 		}
 	}
 
-	Ref<AsyncTcpSocketInstance> AsyncTcpSocket::_createInstance(const Ref<Socket>& socket)
+	Ref<AsyncTcpSocketInstance> AsyncTcpSocket::_createInstance(const Ref<Socket>& socket, sl_bool flagIoUring)
 	{
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		if (flagIoUring) {
+			return priv::network_async::AsyncTcpSocketInstanceUring::create(socket);
+		}
+#endif
 		return priv::network_async::AsyncTcpSocketInstanceImpl::create(socket);
 	}
 
-	Ref<AsyncTcpServerInstance> AsyncTcpServer::_createInstance(const Ref<Socket>& socket)
+	Ref<AsyncTcpServerInstance> AsyncTcpServer::_createInstance(const Ref<Socket>& socket, sl_bool flagIoUring)
 	{
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		if (flagIoUring) {
+			return priv::network_async::AsyncTcpServerInstanceUring::create(socket);
+		}
+#endif
 		return priv::network_async::AsyncTcpServerInstanceImpl::create(socket);
 	}
 
@@ -588,13 +588,13 @@ namespace slib
 		}
 	}
 
-	Ref<AsyncTcpSocketInstance> AsyncTcpSocket::_createInstance(const Ref<Socket>& socket)
+	Ref<AsyncTcpSocketInstance> AsyncTcpSocket::_createInstance(const Ref<Socket>& socket, sl_bool flagIoUring)
 	{
 		return priv::network_async::AsyncTcpSocketInstanceImpl::create(socket);
 	}
 
 
-	Ref<AsyncTcpServerInstance> AsyncTcpServer::_createInstance(const Ref<Socket>& socket)
+	Ref<AsyncTcpServerInstance> AsyncTcpServer::_createInstance(const Ref<Socket>& socket, sl_bool flagIoUring)
 	{
 		return priv::network_async::AsyncTcpServerInstanceImpl::create(socket);
 	}
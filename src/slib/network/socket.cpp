@@ -252,6 +252,20 @@ namespace slib
 		return sl_null;
 	}
 
+	Ref<Socket> Socket::create(SocketType type, sl_socket handle)
+	{
+		if (handle != SLIB_SOCKET_INVALID_HANDLE) {
+			Ref<Socket> ret = new Socket();
+			if (ret.isNotNull()) {
+				ret->m_socket = handle;
+				ret->m_type = type;
+				return ret;
+			}
+			priv::socket::closeHandle(handle);
+		}
+		return sl_null;
+	}
+
 	Ref<Socket> Socket::openStream(NetworkInternetProtocol internetProtocol)
 	{
 		return open(SocketType::Stream, (sl_uint32)internetProtocol);
@@ -316,7 +316,7 @@ namespace slib
 	
 	SLIB_DEFINE_OBJECT(IPv4Fragmentation, Object)
 	
-	IPv4Fragmentation::IPv4Fragmentation()
+	IPv4Fragmentation::IPv4Fragmentation(): m_packets(4096)
 	{
 	}
 	
@@ -326,12 +326,12 @@ namespace slib
 	
 	void IPv4Fragmentation::setupExpiringDuration(sl_uint32 ms, const Ref<DispatchLoop>& loop)
 	{
-		m_packets.setupTimer(ms, loop);
+		m_packets.setDefaultTTL(ms);
 	}
 	
 	void IPv4Fragmentation::setupExpiringDuration(sl_uint32 ms)
 	{
-		m_packets.setupTimer(ms);
+		m_packets.setDefaultTTL(ms);
 	}
 	
 	sl_bool IPv4Fragmentation::isNeededReassembly(const IPv4Packet* ip)
@@ -97,7 +97,7 @@ namespace slib
 
 	SLIB_DEFINE_OBJECT(OAuthTokenMemoryRepository, OAuthTokenRepository)
 
-	OAuthTokenMemoryRepository::OAuthTokenMemoryRepository()
+	OAuthTokenMemoryRepository::OAuthTokenMemoryRepository(sl_uint32 expirySeconds, sl_size maxTokensCount): m_repo(maxTokensCount, expirySeconds > 0xFFFFFFFF / 1000 ? 0xFFFFFFFF : expirySeconds * 1000)
 	{
 	}
 
@@ -117,7 +117,7 @@ namespace slib
 
 	sl_bool OAuthTokenMemoryRepository::isValid(const String& code)
 	{
-		return m_repo.find(code);
+		return m_repo.contains(code);
 	}
 
 	Json OAuthTokenMemoryRepository::getTokenData(const String& code)